@@ -0,0 +1,120 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* walking a telemetry batch by position with and without the array index, which needs ENABLE_CJSON_INDEX */
+
+/* sum of pm25 over the batch by position, the way batch processing code typically walks an array */
+static double sum_by_position(const cJSON * const batch)
+{
+    double sum = 0;
+    int i = 0;
+
+    for (i = 0; i < cJSON_GetArraySize(batch); i++)
+    {
+        sum += cJSON_GetObjectItemCaseSensitive(cJSON_GetArrayItem(batch, i), "pm25")->valuedouble;
+    }
+
+    return sum;
+}
+
+static double sum_by_iteration(const cJSON * const batch)
+{
+    double sum = 0;
+    const cJSON *record = NULL;
+
+    cJSON_ArrayForEach(record, batch)
+    {
+        sum += cJSON_GetObjectItemCaseSensitive(record, "pm25")->valuedouble;
+    }
+
+    return sum;
+}
+
+static void benchmark_walk(const char *name, const cJSON * const batch, size_t count, double (*walk)(const cJSON * const batch), unsigned long iterations)
+{
+    char label[64];
+    double sum = 0;
+    unsigned long i = 0;
+    clock_t start;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        sum += walk(batch);
+    }
+    sprintf(label, "%u records: %s", (unsigned int)count, name);
+    print_result(label, iterations, seconds_since(start), 0);
+
+    if (sum != (12.75 * (double)count * (double)iterations))
+    {
+        fprintf(stderr, "%s: wrong sum\n", name);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void benchmark_batch(size_t count, unsigned long iterations, unsigned long linear_iterations)
+{
+    char *json = create_telemetry_batch(count);
+    cJSON *batch = NULL;
+
+    if (json == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    batch = cJSON_Parse(json);
+    if (batch == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    cJSON_SetIndexThreshold(0);
+    benchmark_walk("cJSON_ArrayForEach", batch, count, sum_by_iteration, iterations);
+    if (linear_iterations > 0)
+    {
+        benchmark_walk("by position, no index", batch, count, sum_by_position, linear_iterations);
+    }
+
+    cJSON_SetIndexThreshold(1024);
+    benchmark_walk("by position, indexed", batch, count, sum_by_position, iterations);
+    cJSON_SetIndexThreshold(0);
+
+    cJSON_Delete(batch);
+    free(json);
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 20);
+
+    use_counting_hooks();
+
+    benchmark_batch(10000, iterations * 10, 1);
+    /* walking 100 K records by position without the index takes minutes */
+    benchmark_batch(100000, iterations, 0);
+
+    cJSON_InitHooks(NULL);
+
+    return EXIT_SUCCESS;
+}
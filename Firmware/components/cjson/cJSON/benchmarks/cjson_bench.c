@@ -0,0 +1,770 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+#ifdef CJSON_BENCH_UTILS
+#include "../cJSON_Utils.h"
+#endif
+
+/* The whole suite over a corpus: parse, print, lookups, duplicate, compare, minify and JSON patches for every
+ * document of tests/inputs, the json-patch-tests files and synthetic telemetry and large documents.
+ *
+ * usage: cjson_bench [--corpus directory] [--min-time seconds] [--filter text] [--json file]
+ *
+ * Every measurement is repeated with twice the iterations until it takes at least min-time seconds. --json writes the
+ * results in a form that can be diffed between runs. */
+
+/* a JSON patch test: apply patch to doc to get expected, or generate the patch from doc and expected */
+typedef struct
+{
+    cJSON *doc;
+    cJSON *patch;
+    cJSON *expected;
+} patch_case;
+
+typedef struct
+{
+    char name[64];
+    char *json;
+    size_t length;
+    cJSON *tree;
+    cJSON *copy;
+    char *scratch; /* room for minifying a copy of json */
+    cJSON_KeyTable *key_table; /* kept between the parses, like it would be for a stream of documents */
+    size_t unformatted_length;
+    size_t formatted_length;
+    /* objects and the keys that are looked up in them */
+    const cJSON **lookup_objects;
+    const char **lookup_keys;
+    size_t lookups;
+    patch_case *patches;
+    size_t patch_count;
+    size_t patch_bytes;
+} bench_document;
+
+typedef struct
+{
+    char operation[32];
+    char document[64];
+    size_t bytes;
+    unsigned long iterations;
+    double ns_per_op;
+    double mb_per_s;
+    double allocs_per_op;
+    size_t peak_heap;
+} bench_result;
+
+/* one operation on a document, returns how many ops it did (0 on failure) */
+typedef size_t (*bench_operation)(bench_document *document);
+
+static bench_result *results = NULL;
+static size_t result_count = 0;
+static size_t result_capacity = 0;
+
+/* copies as much of source as fits into a buffer of the given size */
+static void copy_name(char *destination, size_t size, const char *source)
+{
+    size_t length = strlen(source);
+
+    if (length >= size)
+    {
+        length = size - 1;
+    }
+    memcpy(destination, source, length);
+    destination[length] = '\0';
+}
+
+static char *read_file(const char *path, size_t *length)
+{
+    FILE *file = fopen(path, "rb");
+    char *content = NULL;
+    long size = 0;
+
+    if (file == NULL)
+    {
+        return NULL;
+    }
+    if ((fseek(file, 0, SEEK_END) != 0) || ((size = ftell(file)) < 0) || (fseek(file, 0, SEEK_SET) != 0))
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    content = (char*)malloc((size_t)size + 1);
+    if ((content != NULL) && (fread(content, 1, (size_t)size, file) != (size_t)size))
+    {
+        free(content);
+        content = NULL;
+    }
+    fclose(file);
+
+    if (content != NULL)
+    {
+        content[size] = '\0';
+        *length = (size_t)size;
+    }
+
+    return content;
+}
+
+/* sample up to 64 member names of every object in the tree, so that huge objects don't take quadratic time */
+static void collect_lookups(bench_document *document, const cJSON *item, cJSON_bool count_only)
+{
+    for (; item != NULL; item = item->next)
+    {
+        if (cJSON_IsObject(item))
+        {
+            size_t size = (size_t)cJSON_GetArraySize(item);
+            size_t step = (size > 64) ? (size / 64) : 1;
+            size_t index = 0;
+            const cJSON *member = item->child;
+
+            for (index = 0; member != NULL; index++, member = member->next)
+            {
+                if ((index % step) != 0)
+                {
+                    continue;
+                }
+                if (!count_only)
+                {
+                    document->lookup_objects[document->lookups] = item;
+                    document->lookup_keys[document->lookups] = member->string;
+                }
+                document->lookups++;
+            }
+        }
+        collect_lookups(document, item->child, count_only);
+    }
+}
+
+static void prepare_patches(bench_document *document)
+{
+    cJSON *test = NULL;
+    size_t count = 0;
+
+    if (!cJSON_IsArray(document->tree))
+    {
+        return;
+    }
+
+    document->patches = (patch_case*)malloc(sizeof(patch_case) * ((size_t)cJSON_GetArraySize(document->tree) + 1));
+    if (document->patches == NULL)
+    {
+        return;
+    }
+
+    cJSON_ArrayForEach(test, document->tree)
+    {
+        patch_case *entry = &document->patches[count];
+        char *printed = NULL;
+
+        entry->doc = cJSON_GetObjectItemCaseSensitive(test, "doc");
+        entry->patch = cJSON_GetObjectItemCaseSensitive(test, "patch");
+        entry->expected = cJSON_GetObjectItemCaseSensitive(test, "expected");
+        /* only the tests that are expected to work */
+        if ((entry->doc == NULL) || !cJSON_IsArray(entry->patch) || (entry->expected == NULL)
+            || cJSON_HasObjectItem(test, "error") || cJSON_HasObjectItem(test, "disabled"))
+        {
+            continue;
+        }
+
+        printed = cJSON_PrintUnformatted(entry->doc);
+        if (printed != NULL)
+        {
+            document->patch_bytes += strlen(printed);
+            cJSON_free(printed);
+        }
+        count++;
+    }
+    document->patch_count = count;
+}
+
+static cJSON_bool prepare_document(bench_document *document)
+{
+    char *printed = NULL;
+
+    document->tree = cJSON_ParseWithLength(document->json, document->length);
+    if (document->tree == NULL)
+    {
+        fprintf(stderr, "%s: isn't JSON, skipped\n", document->name);
+        return 0;
+    }
+    document->copy = cJSON_Duplicate(document->tree, 1);
+    document->scratch = (char*)malloc(document->length + 1);
+    document->key_table = cJSON_CreateKeyTable(0);
+    if ((document->copy == NULL) || (document->scratch == NULL) || (document->key_table == NULL))
+    {
+        return 0;
+    }
+
+    printed = cJSON_PrintUnformatted(document->tree);
+    document->unformatted_length = (printed != NULL) ? strlen(printed) : 0;
+    cJSON_free(printed);
+    printed = cJSON_Print(document->tree);
+    document->formatted_length = (printed != NULL) ? strlen(printed) : 0;
+    cJSON_free(printed);
+
+    collect_lookups(document, document->tree, 1);
+    document->lookup_objects = (const cJSON**)malloc(sizeof(cJSON*) * (document->lookups + 1));
+    document->lookup_keys = (const char**)malloc(sizeof(char*) * (document->lookups + 1));
+    if ((document->lookup_objects == NULL) || (document->lookup_keys == NULL))
+    {
+        return 0;
+    }
+    document->lookups = 0;
+    collect_lookups(document, document->tree, 0);
+
+    return 1;
+}
+
+static void release_document(bench_document *document)
+{
+    /* the synthetic patch case owns its trees, the test files only point into their tree */
+    if ((document->patches != NULL) && (document->patch_count == 1) && (document->patches[0].doc == document->tree))
+    {
+        cJSON_Delete(document->patches[0].patch);
+        cJSON_Delete(document->patches[0].expected);
+    }
+    cJSON_Delete(document->tree);
+    cJSON_Delete(document->copy);
+    free(document->json);
+    free(document->scratch);
+    cJSON_DeleteKeyTable(document->key_table);
+    free((void*)document->lookup_objects);
+    free((void*)document->lookup_keys);
+    free(document->patches);
+    memset(document, '\0', sizeof(*document));
+}
+
+static size_t run_parse(bench_document *document)
+{
+    cJSON *tree = cJSON_ParseWithLength(document->json, document->length);
+
+    if (tree == NULL)
+    {
+        return 0;
+    }
+    cJSON_Delete(tree);
+
+    return 1;
+}
+
+static size_t run_parse_with_key_table(bench_document *document)
+{
+    cJSON *tree = cJSON_ParseWithKeyTable(document->json, document->length, document->key_table);
+
+    if (tree == NULL)
+    {
+        return 0;
+    }
+    cJSON_Delete(tree);
+
+    return 1;
+}
+
+static size_t run_print_unformatted(bench_document *document)
+{
+    char *printed = cJSON_PrintUnformatted(document->tree);
+
+    if (printed == NULL)
+    {
+        return 0;
+    }
+    cJSON_free(printed);
+
+    return 1;
+}
+
+static size_t run_print_formatted(bench_document *document)
+{
+    char *printed = cJSON_Print(document->tree);
+
+    if (printed == NULL)
+    {
+        return 0;
+    }
+    cJSON_free(printed);
+
+    return 1;
+}
+
+static size_t run_get_object_item(bench_document *document)
+{
+    size_t i = 0;
+
+    for (i = 0; i < document->lookups; i++)
+    {
+        if (cJSON_GetObjectItem(document->lookup_objects[i], document->lookup_keys[i]) == NULL)
+        {
+            return 0;
+        }
+    }
+
+    return document->lookups;
+}
+
+static size_t run_duplicate(bench_document *document)
+{
+    cJSON *copy = cJSON_Duplicate(document->tree, 1);
+
+    if (copy == NULL)
+    {
+        return 0;
+    }
+    cJSON_Delete(copy);
+
+    return 1;
+}
+
+static size_t run_duplicate_compact(bench_document *document)
+{
+    cJSON *copy = cJSON_DuplicateCompact(document->tree);
+
+    if (copy == NULL)
+    {
+        return 0;
+    }
+    cJSON_DeleteCompact(copy);
+
+    return 1;
+}
+
+static size_t run_compare(bench_document *document)
+{
+    return cJSON_Compare(document->tree, document->copy, 1) ? 1 : 0;
+}
+
+static size_t run_minify(bench_document *document)
+{
+    memcpy(document->scratch, document->json, document->length + 1);
+    cJSON_Minify(document->scratch);
+
+    return 1;
+}
+
+static size_t run_minify_with_length(bench_document *document)
+{
+    return (cJSON_MinifyWithLength(document->json, document->length, document->scratch) > 0) ? 1 : 0;
+}
+
+#ifdef CJSON_BENCH_UTILS
+static size_t run_apply_patches(bench_document *document)
+{
+    size_t i = 0;
+
+    for (i = 0; i < document->patch_count; i++)
+    {
+        cJSON *target = cJSON_Duplicate(document->patches[i].doc, 1);
+
+        if ((target == NULL) || (cJSONUtils_ApplyPatchesCaseSensitive(target, document->patches[i].patch) != 0))
+        {
+            cJSON_Delete(target);
+            return 0;
+        }
+        cJSON_Delete(target);
+    }
+
+    return document->patch_count;
+}
+
+/* GeneratePatches leaves both documents as they are, every run does the same work */
+static size_t run_generate_patches(bench_document *document)
+{
+    size_t i = 0;
+
+    for (i = 0; i < document->patch_count; i++)
+    {
+        cJSON *patches = cJSONUtils_GeneratePatchesCaseSensitive(document->patches[i].doc, document->patches[i].expected);
+
+        if (patches == NULL)
+        {
+            return 0;
+        }
+        cJSON_Delete(patches);
+    }
+
+    return document->patch_count;
+}
+#endif
+
+static bench_result *add_result(void)
+{
+    if (result_count == result_capacity)
+    {
+        size_t capacity = (result_capacity == 0) ? 64 : (result_capacity * 2);
+        bench_result *grown = (bench_result*)realloc(results, capacity * sizeof(bench_result));
+
+        if (grown == NULL)
+        {
+            return NULL;
+        }
+        results = grown;
+        result_capacity = capacity;
+    }
+
+    memset(&results[result_count], '\0', sizeof(bench_result));
+    return &results[result_count++];
+}
+
+static void measure(const char *operation, bench_document *document, bench_operation run, size_t bytes_per_op, double min_time, const char *filter)
+{
+    char label[128];
+    unsigned long iterations = 1;
+    unsigned long i = 0;
+    size_t ops = 0;
+    size_t ops_per_call = 0;
+    double seconds = 0;
+    clock_t start;
+    bench_result *result = NULL;
+
+    sprintf(label, "%s/%s", operation, document->name);
+    if ((filter != NULL) && (strstr(label, filter) == NULL))
+    {
+        return;
+    }
+
+    /* warm up, and make sure the operation works on this document at all */
+    ops_per_call = run(document);
+    if (ops_per_call == 0)
+    {
+        printf("%-56s skipped\n", label);
+        return;
+    }
+
+    for (;;)
+    {
+        reset_allocation_stats();
+        reset_peak_bytes();
+        ops = 0;
+        start = clock();
+        for (i = 0; i < iterations; i++)
+        {
+            ops += run(document);
+        }
+        seconds = seconds_since(start);
+        if ((seconds >= min_time) || (iterations >= 0x40000000UL))
+        {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    result = add_result();
+    if (result == NULL)
+    {
+        return;
+    }
+    copy_name(result->operation, sizeof(result->operation), operation);
+    copy_name(result->document, sizeof(result->document), document->name);
+    result->bytes = bytes_per_op;
+    result->iterations = iterations;
+    result->ns_per_op = seconds * 1e9 / (double)ops;
+    result->mb_per_s = (seconds > 0) ? ((double)bytes_per_op * (double)iterations / seconds / 1e6) : 0;
+    result->allocs_per_op = (double)benchmark_allocations.allocations / (double)ops;
+    result->peak_heap = benchmark_peak_bytes - benchmark_live_bytes;
+
+    printf("%-56s %12.1f ns/op %10.2f MB/s %10.2f allocs/op %10lu peak bytes\n",
+        label, result->ns_per_op, result->mb_per_s, result->allocs_per_op, (unsigned long)result->peak_heap);
+}
+
+static void run_suite(bench_document *document, double min_time, const char *filter)
+{
+    measure("parse", document, run_parse, document->length, min_time, filter);
+    measure("parse_with_key_table", document, run_parse_with_key_table, document->length, min_time, filter);
+    measure("print_unformatted", document, run_print_unformatted, document->unformatted_length, min_time, filter);
+    measure("print_formatted", document, run_print_formatted, document->formatted_length, min_time, filter);
+    if (document->lookups > 0)
+    {
+        measure("get_object_item", document, run_get_object_item, 0, min_time, filter);
+    }
+    measure("duplicate", document, run_duplicate, document->unformatted_length, min_time, filter);
+    measure("duplicate_compact", document, run_duplicate_compact, document->unformatted_length, min_time, filter);
+    measure("compare", document, run_compare, document->unformatted_length, min_time, filter);
+    measure("minify", document, run_minify, document->length, min_time, filter);
+    measure("minify_with_length", document, run_minify_with_length, document->length, min_time, filter);
+#ifdef CJSON_BENCH_UTILS
+    if (document->patch_count > 0)
+    {
+        measure("apply_patches", document, run_apply_patches, document->patch_bytes, min_time, filter);
+        measure("generate_patches", document, run_generate_patches, document->patch_bytes, min_time, filter);
+    }
+#endif
+}
+
+/* a document the suite owns, json is taken over */
+static void bench_text(const char *name, char *json, size_t length, cJSON_bool is_patch_test, double min_time, const char *filter)
+{
+    bench_document document;
+
+    memset(&document, '\0', sizeof(document));
+    copy_name(document.name, sizeof(document.name), name);
+    document.json = json;
+    document.length = length;
+
+    if ((json != NULL) && prepare_document(&document))
+    {
+        if (is_patch_test)
+        {
+            prepare_patches(&document);
+        }
+        run_suite(&document, min_time, filter);
+    }
+    release_document(&document);
+}
+
+/* every 10th record gets another fan speed, as a patch of the whole batch */
+static void bench_telemetry_batch(const char *name, size_t records, double min_time, const char *filter)
+{
+    bench_document document;
+    cJSON *record = NULL;
+    size_t index = 0;
+
+    memset(&document, '\0', sizeof(document));
+    copy_name(document.name, sizeof(document.name), name);
+    document.json = create_telemetry_batch(records);
+    document.length = (document.json != NULL) ? strlen(document.json) : 0;
+
+    if ((document.json != NULL) && prepare_document(&document))
+    {
+#ifdef CJSON_BENCH_UTILS
+        document.patches = (patch_case*)malloc(sizeof(patch_case));
+        if (document.patches != NULL)
+        {
+            document.patches[0].doc = document.tree;
+            document.patches[0].expected = cJSON_Duplicate(document.tree, 1);
+            cJSON_ArrayForEach(record, document.patches[0].expected)
+            {
+                if ((index++ % 10) == 0)
+                {
+                    cJSON_SetNumberValue(cJSON_GetObjectItemCaseSensitive(record, "fanSpeed"), 10);
+                }
+            }
+            document.patches[0].patch = cJSONUtils_GeneratePatchesCaseSensitive(document.patches[0].doc, document.patches[0].expected);
+            document.patch_count = 1;
+            document.patch_bytes = document.length;
+        }
+#else
+        (void)record;
+        (void)index;
+#endif
+        run_suite(&document, min_time, filter);
+    }
+    release_document(&document);
+}
+
+/* one object with count members that have a bit of everything: nesting, escapes, numbers, literals */
+static char *create_large_object(size_t count, size_t *length)
+{
+    size_t size = count * 160 + 16;
+    char *json = (char*)malloc(size);
+    cJSON_Writer writer;
+    char key[32];
+    size_t i = 0;
+
+    if (json == NULL)
+    {
+        return NULL;
+    }
+
+    cJSON_InitWriter(&writer, json, size);
+    cJSON_WriterBeginObject(&writer);
+    for (i = 0; i < count; i++)
+    {
+        sprintf(key, "device_%06lu", (unsigned long)i);
+        cJSON_WriterKey(&writer, key);
+        cJSON_WriterBeginObject(&writer);
+        cJSON_WriterKey(&writer, "id");
+        cJSON_WriterNumber(&writer, (double)i);
+        cJSON_WriterKey(&writer, "name");
+        cJSON_WriterString(&writer, "purifier \"living room\"\n\tfloor 2");
+        cJSON_WriterKey(&writer, "readings");
+        cJSON_WriterBeginArray(&writer);
+        cJSON_WriterNumber(&writer, (double)i * 0.5);
+        cJSON_WriterNumber(&writer, -(double)i);
+        cJSON_WriterNumber(&writer, (double)i * 1e-3);
+        cJSON_WriterEndArray(&writer);
+        cJSON_WriterKey(&writer, "active");
+        cJSON_WriterBool(&writer, (i % 2) == 0);
+        cJSON_WriterKey(&writer, "tags");
+        cJSON_WriterNull(&writer);
+        cJSON_WriterEndObject(&writer);
+    }
+
+    if (!cJSON_WriterEndObject(&writer))
+    {
+        free(json);
+        return NULL;
+    }
+    *length = cJSON_WriterLength(&writer);
+
+    return json;
+}
+
+static cJSON_bool write_results(const char *path, double min_time)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON *list = NULL;
+    char *printed = NULL;
+    FILE *file = NULL;
+    size_t i = 0;
+    cJSON_bool written = 0;
+
+    cJSON_AddStringToObject(root, "benchmark", "cjson_bench");
+    cJSON_AddStringToObject(root, "version", cJSON_Version());
+    cJSON_AddNumberToObject(root, "min_time", min_time);
+    list = cJSON_AddArrayToObject(root, "results");
+    for (i = 0; i < result_count; i++)
+    {
+        cJSON *result = cJSON_CreateObject();
+
+        cJSON_AddStringToObject(result, "operation", results[i].operation);
+        cJSON_AddStringToObject(result, "document", results[i].document);
+        cJSON_AddNumberToObject(result, "bytes", (double)results[i].bytes);
+        cJSON_AddNumberToObject(result, "iterations", (double)results[i].iterations);
+        cJSON_AddNumberToObject(result, "ns_per_op", results[i].ns_per_op);
+        cJSON_AddNumberToObject(result, "mb_per_s", results[i].mb_per_s);
+        cJSON_AddNumberToObject(result, "allocs_per_op", results[i].allocs_per_op);
+        cJSON_AddNumberToObject(result, "peak_heap_bytes", (double)results[i].peak_heap);
+        cJSON_AddItemToArray(list, result);
+    }
+
+    printed = cJSON_Print(root);
+    file = fopen(path, "w");
+    if ((printed != NULL) && (file != NULL))
+    {
+        written = (fputs(printed, file) >= 0) && (fputc('\n', file) != EOF);
+    }
+    if (file != NULL)
+    {
+        written = (fclose(file) == 0) && written;
+    }
+    cJSON_free(printed);
+    cJSON_Delete(root);
+
+    return written;
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    const char *corpus = CJSON_BENCH_CORPUS;
+    const char *json_path = NULL;
+    const char *filter = NULL;
+    double min_time = 0.1;
+    char path[1024];
+    char name[64];
+    size_t length = 0;
+    int i = 0;
+    static const char * const patch_files[] = { "tests.json", "spec_tests.json", "cjson-utils-tests.json" };
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--corpus") == 0) && ((i + 1) < argc))
+        {
+            corpus = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--json") == 0) && ((i + 1) < argc))
+        {
+            json_path = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--filter") == 0) && ((i + 1) < argc))
+        {
+            filter = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--min-time") == 0) && ((i + 1) < argc))
+        {
+            min_time = atof(argv[++i]);
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--corpus directory] [--min-time seconds] [--filter text] [--json file]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (strlen(corpus) > (sizeof(path) - 64))
+    {
+        return EXIT_FAILURE;
+    }
+
+    use_tracking_hooks();
+
+    for (i = 1; i < 100; i++)
+    {
+        char *json = NULL;
+
+        sprintf(path, "%s/inputs/test%d", corpus, i);
+        json = read_file(path, &length);
+        if (json != NULL)
+        {
+            sprintf(name, "inputs/test%d", i);
+            bench_text(name, json, length, 0, min_time, filter);
+        }
+    }
+
+    for (i = 0; i < (int)(sizeof(patch_files) / sizeof(patch_files[0])); i++)
+    {
+        char *json = NULL;
+
+        sprintf(path, "%s/json-patch-tests/%s", corpus, patch_files[i]);
+        json = read_file(path, &length);
+        if (json == NULL)
+        {
+            fprintf(stderr, "%s: can't be read\n", path);
+            continue;
+        }
+        sprintf(name, "json-patch-tests/%s", patch_files[i]);
+        bench_text(name, json, length, 1, min_time, filter);
+    }
+
+    {
+        char *telemetry = (char*)malloc(sizeof(benchmark_telemetry));
+        char *command = (char*)malloc(sizeof(benchmark_command));
+
+        if (telemetry != NULL)
+        {
+            memcpy(telemetry, benchmark_telemetry, sizeof(benchmark_telemetry));
+        }
+        if (command != NULL)
+        {
+            memcpy(command, benchmark_command, sizeof(benchmark_command));
+        }
+        bench_text("telemetry", telemetry, sizeof(benchmark_telemetry) - 1, 0, min_time, filter);
+        bench_text("command", command, sizeof(benchmark_command) - 1, 0, min_time, filter);
+    }
+    bench_telemetry_batch("telemetry x1000", 1000, min_time, filter);
+    bench_telemetry_batch("telemetry x4500 (1 MB)", 4500, min_time, filter);
+    {
+        char *json = create_large_object(10000, &length);
+        bench_text("object x10000", json, length, 0, min_time, filter);
+    }
+
+    cJSON_InitHooks(NULL);
+    if ((json_path != NULL) && !write_results(json_path, min_time))
+    {
+        fprintf(stderr, "%s: can't be written\n", json_path);
+        free(results);
+        return EXIT_FAILURE;
+    }
+    free(results);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,216 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#ifndef CJSON_BENCHMARKS_COMMON_H
+#define CJSON_BENCHMARKS_COMMON_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../cJSON.h"
+
+/* allocation statistics of everything that goes through the counting hooks */
+typedef struct
+{
+    size_t allocations;
+    size_t frees;
+    size_t bytes;
+} allocation_stats;
+
+extern allocation_stats benchmark_allocations;
+allocation_stats benchmark_allocations = { 0, 0, 0 };
+
+void * CJSON_CDECL counting_malloc(size_t size);
+void * CJSON_CDECL counting_malloc(size_t size)
+{
+    benchmark_allocations.allocations++;
+    benchmark_allocations.bytes += size;
+    return malloc(size);
+}
+
+void CJSON_CDECL counting_free(void *pointer);
+void CJSON_CDECL counting_free(void *pointer)
+{
+    if (pointer != NULL)
+    {
+        benchmark_allocations.frees++;
+    }
+    free(pointer);
+}
+
+/* route all cJSON allocations through the counters */
+void use_counting_hooks(void);
+void use_counting_hooks(void)
+{
+    cJSON_Hooks hooks;
+    hooks.malloc_fn = counting_malloc;
+    hooks.free_fn = counting_free;
+    cJSON_InitHooks(&hooks);
+}
+
+/* like the counting hooks, but every block remembers its size in front of it, so live and peak bytes are known too.
+ * A block has to be freed with the hooks it was allocated with. */
+typedef union
+{
+    size_t size;
+    double alignment;
+} block_header;
+
+extern size_t benchmark_live_bytes;
+size_t benchmark_live_bytes = 0;
+extern size_t benchmark_peak_bytes;
+size_t benchmark_peak_bytes = 0;
+
+void * CJSON_CDECL tracking_malloc(size_t size);
+void * CJSON_CDECL tracking_malloc(size_t size)
+{
+    block_header *block = (block_header*)malloc(sizeof(block_header) + size);
+
+    if (block == NULL)
+    {
+        return NULL;
+    }
+    block->size = size;
+    benchmark_allocations.allocations++;
+    benchmark_allocations.bytes += size;
+    benchmark_live_bytes += size;
+    if (benchmark_live_bytes > benchmark_peak_bytes)
+    {
+        benchmark_peak_bytes = benchmark_live_bytes;
+    }
+
+    return block + 1;
+}
+
+void CJSON_CDECL tracking_free(void *pointer);
+void CJSON_CDECL tracking_free(void *pointer)
+{
+    block_header *block = (block_header*)pointer;
+
+    if (block == NULL)
+    {
+        return;
+    }
+    block--;
+    benchmark_allocations.frees++;
+    benchmark_live_bytes -= block->size;
+    free(block);
+}
+
+void use_tracking_hooks(void);
+void use_tracking_hooks(void)
+{
+    cJSON_Hooks hooks;
+    hooks.malloc_fn = tracking_malloc;
+    hooks.free_fn = tracking_free;
+    cJSON_InitHooks(&hooks);
+}
+
+/* peak bytes are counted from what is live right now */
+void reset_peak_bytes(void);
+void reset_peak_bytes(void)
+{
+    benchmark_peak_bytes = benchmark_live_bytes;
+}
+
+void reset_allocation_stats(void);
+void reset_allocation_stats(void)
+{
+    memset(&benchmark_allocations, 0, sizeof(benchmark_allocations));
+}
+
+double seconds_since(clock_t start);
+double seconds_since(clock_t start)
+{
+    return (double)(clock() - start) / (double)CLOCKS_PER_SEC;
+}
+
+/* optional first argument overrides the number of iterations */
+unsigned long iterations_from_arguments(int argc, char **argv, unsigned long default_iterations);
+unsigned long iterations_from_arguments(int argc, char **argv, unsigned long default_iterations)
+{
+    unsigned long iterations = 0;
+
+    if (argc < 2)
+    {
+        return default_iterations;
+    }
+
+    iterations = strtoul(argv[1], NULL, 10);
+    return (iterations > 0) ? iterations : default_iterations;
+}
+
+void print_result(const char *name, unsigned long iterations, double seconds, size_t document_size);
+void print_result(const char *name, unsigned long iterations, double seconds, size_t document_size)
+{
+    double per_operation = (iterations > 0) ? (seconds / (double)iterations) : 0.0;
+    double megabytes_per_second = (seconds > 0.0) ? (((double)document_size * (double)iterations) / seconds / 1e6) : 0.0;
+
+    printf("%-40s %12.1f ns/op %10.2f MB/s %10.2f allocs/op %12.1f bytes/op\n",
+        name,
+        per_operation * 1e9,
+        megabytes_per_second,
+        (double)benchmark_allocations.allocations / (double)iterations,
+        (double)benchmark_allocations.bytes / (double)iterations);
+}
+
+/* command as received by the firmware over MQTT */
+extern const char benchmark_command[];
+const char benchmark_command[] = "{\"commandId\":\"6f1c2a9e-8d4b-4a57-9e2f-3b1d7c0a5e11\",\"commandType\":\"SET_FAN_SPEED\",\"payload\":{\"fanSpeed\":75},\"timestamp\":\"2025-01-15T10:30:00.000Z\"}";
+
+/* telemetry as published by the firmware */
+extern const char benchmark_telemetry[];
+const char benchmark_telemetry[] = "{\"deviceId\":\"device_esp32_001\",\"temperature\":24.5,\"humidity\":48.25,\"pm1\":8.5,\"pm25\":12.75,\"pm10\":20.125,\"voc\":0.34999999403953552,\"soundLevel\":42.5,\"wifiRssi\":-61,\"wifiSsid\":\"praan-office\",\"fanSpeed\":75,\"powerState\":\"ON\"}";
+
+/* build an array of count telemetry records, the caller frees the result */
+char *create_telemetry_batch(size_t count);
+char *create_telemetry_batch(size_t count)
+{
+    size_t record_length = strlen(benchmark_telemetry);
+    char *batch = (char*)malloc(count * (record_length + 1) + 3);
+    char *position = batch;
+    size_t i = 0;
+
+    if (batch == NULL)
+    {
+        return NULL;
+    }
+
+    *position++ = '[';
+    for (i = 0; i < count; i++)
+    {
+        if (i > 0)
+        {
+            *position++ = ',';
+        }
+        memcpy(position, benchmark_telemetry, record_length);
+        position += record_length;
+    }
+    *position++ = ']';
+    *position = '\0';
+
+    return batch;
+}
+
+#endif
@@ -0,0 +1,177 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+#include "../cJSON_Utils.h"
+
+/* resolving the same few paths of a device shadow over and over, from the pointer string or compiled once,
+ * and applying patches, which compile their paths once per operation */
+
+static const char *paths[] = {
+    "/state/reported/pm25",
+    "/state/reported/fanSpeed",
+    "/state/reported/filters/3/life",
+    "/state/desired/powerState",
+    "/metadata/reported/wifiRssi/timestamp",
+    NULL
+};
+
+static cJSON *create_shadow(void)
+{
+    cJSON *shadow = cJSON_CreateObject();
+    cJSON *state = cJSON_AddObjectToObject(shadow, "state");
+    cJSON *metadata = cJSON_AddObjectToObject(shadow, "metadata");
+    cJSON *reported = cJSON_Parse(benchmark_telemetry);
+    cJSON *filters = cJSON_CreateArray();
+    cJSON *member = NULL;
+    cJSON *timestamps = NULL;
+    int i = 0;
+
+    if ((shadow == NULL) || (reported == NULL) || (filters == NULL))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < 8; i++)
+    {
+        cJSON *filter = cJSON_CreateObject();
+        cJSON_AddNumberToObject(filter, "id", i);
+        cJSON_AddNumberToObject(filter, "life", 100 - 10 * i);
+        cJSON_AddItemToArray(filters, filter);
+    }
+    cJSON_AddItemToObject(reported, "filters", filters);
+
+    timestamps = cJSON_AddObjectToObject(metadata, "reported");
+    cJSON_ArrayForEach(member, reported)
+    {
+        cJSON *timestamp = cJSON_AddObjectToObject(timestamps, member->string);
+        cJSON_AddNumberToObject(timestamp, "timestamp", 1700000000);
+    }
+
+    cJSON_AddItemToObject(state, "desired", cJSON_Parse("{\"powerState\":\"ON\",\"fanSpeed\":50}"));
+    cJSON_AddItemToObject(state, "reported", reported);
+
+    return shadow;
+}
+
+static void benchmark_lookups(const char *name, cJSON *shadow, unsigned long iterations)
+{
+    char label[64];
+    cJSONUtils_Pointer *compiled[sizeof(paths) / sizeof(paths[0])];
+    unsigned long i = 0;
+    size_t path = 0;
+    size_t found = 0;
+    clock_t start;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        for (path = 0; paths[path] != NULL; path++)
+        {
+            found += (cJSONUtils_GetPointerCaseSensitive(shadow, paths[path]) != NULL);
+        }
+    }
+    sprintf(label, "%s: get pointer", name);
+    print_result(label, iterations * path, seconds_since(start), 0);
+
+    for (path = 0; paths[path] != NULL; path++)
+    {
+        compiled[path] = cJSONUtils_CompilePointer(paths[path]);
+        if (compiled[path] == NULL)
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        for (path = 0; paths[path] != NULL; path++)
+        {
+            found += (cJSONUtils_GetCompiledPointerCaseSensitive(shadow, compiled[path]) != NULL);
+        }
+    }
+    sprintf(label, "%s: get compiled pointer", name);
+    print_result(label, iterations * path, seconds_since(start), 0);
+
+    for (path = 0; paths[path] != NULL; path++)
+    {
+        cJSONUtils_DeletePointer(compiled[path]);
+    }
+
+    if (found != (2 * iterations * path))
+    {
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void benchmark_patches(const char *name, cJSON *shadow, unsigned long iterations)
+{
+    char label[64];
+    cJSON *patches = cJSON_CreateArray();
+    unsigned long i = 0;
+    size_t path = 0;
+    clock_t start;
+
+    for (path = 0; paths[path] != NULL; path++)
+    {
+        cJSONUtils_AddPatchToArray(patches, "replace", paths[path], cJSONUtils_GetPointerCaseSensitive(shadow, paths[path]));
+    }
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        if (cJSONUtils_ApplyPatchesCaseSensitive(shadow, patches) != 0)
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+    sprintf(label, "%s: apply 5 replace operations", name);
+    print_result(label, iterations, seconds_since(start), 0);
+
+    cJSON_Delete(patches);
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 1000000);
+    cJSON *shadow = create_shadow();
+
+    use_counting_hooks();
+
+    benchmark_lookups("linear", shadow, iterations);
+    benchmark_patches("linear", shadow, iterations / 10 + 1);
+
+    /* with an index the pre-hashed keys of compiled pointers skip the walk over the members */
+    cJSON_SetIndexThreshold(8);
+    benchmark_lookups("indexed", shadow, iterations);
+    benchmark_patches("indexed", shadow, iterations / 10 + 1);
+    cJSON_SetIndexThreshold(0);
+
+    cJSON_InitHooks(NULL);
+    cJSON_Delete(shadow);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* snapshotting a device shadow: cJSON_Duplicate + cJSON_Delete against cJSON_DuplicateCompact + cJSON_DeleteCompact */
+
+static void benchmark_snapshot(const char *name, const cJSON *shadow, size_t size, unsigned long iterations)
+{
+    char label[64];
+    cJSON *copy = NULL;
+    unsigned long i = 0;
+    clock_t start;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        copy = cJSON_Duplicate(shadow, 1);
+        if (copy == NULL)
+        {
+            exit(EXIT_FAILURE);
+        }
+        cJSON_Delete(copy);
+    }
+    sprintf(label, "%s: duplicate", name);
+    print_result(label, iterations, seconds_since(start), size);
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        copy = cJSON_DuplicateCompact(shadow);
+        if (copy == NULL)
+        {
+            exit(EXIT_FAILURE);
+        }
+        cJSON_DeleteCompact(copy);
+    }
+    sprintf(label, "%s: duplicate compact", name);
+    print_result(label, iterations, seconds_since(start), size);
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 20000);
+    char *batch = create_telemetry_batch(100);
+    cJSON *device = cJSON_Parse(benchmark_telemetry);
+    cJSON *devices = (batch != NULL) ? cJSON_Parse(batch) : NULL;
+
+    if ((device == NULL) || (devices == NULL))
+    {
+        return EXIT_FAILURE;
+    }
+
+    use_counting_hooks();
+
+    benchmark_snapshot("device shadow", device, strlen(benchmark_telemetry), iterations);
+    benchmark_snapshot("100 device shadows", devices, strlen(batch), iterations / 100 + 1);
+
+    cJSON_InitHooks(NULL);
+    cJSON_Delete(devices);
+    cJSON_Delete(device);
+    free(batch);
+
+    return EXIT_SUCCESS;
+}
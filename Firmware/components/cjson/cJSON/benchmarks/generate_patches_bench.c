@@ -0,0 +1,124 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+#include "../cJSON_Utils.h"
+
+/* diffing a shadow of 1000 telemetry records against typical updates of it: time per diff and size of the patch */
+
+static cJSON *create_shadow(void)
+{
+    char *batch = create_telemetry_batch(1000);
+    cJSON *shadow = NULL;
+    cJSON *record = NULL;
+    int sequence = 0;
+
+    if (batch == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    shadow = cJSON_Parse(batch);
+    free(batch);
+    if (shadow == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    /* make the records distinct */
+    cJSON_ArrayForEach(record, shadow)
+    {
+        cJSON_AddNumberToObject(record, "sequence", sequence++);
+    }
+
+    return shadow;
+}
+
+static void benchmark_update(const char *name, cJSON *from, cJSON *to, unsigned long iterations)
+{
+    char label[64];
+    cJSON *patches = NULL;
+    char *printed = NULL;
+    unsigned long i = 0;
+    clock_t start;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        patches = cJSONUtils_GeneratePatchesCaseSensitive(from, to);
+        if (patches == NULL)
+        {
+            exit(EXIT_FAILURE);
+        }
+        if ((i + 1) < iterations)
+        {
+            cJSON_Delete(patches);
+        }
+    }
+    sprintf(label, "%s: generate", name);
+    print_result(label, iterations, seconds_since(start), 0);
+
+    printed = cJSON_PrintUnformatted(patches);
+    if (printed == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    printf("%-40s %12d patches %10lu bytes\n", "", cJSON_GetArraySize(patches), (unsigned long)strlen(printed));
+
+    cJSON_free(printed);
+    cJSON_Delete(patches);
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 100);
+    cJSON *from = create_shadow();
+    cJSON *to = NULL;
+
+    use_tracking_hooks();
+
+    to = cJSON_Duplicate(from, 1);
+    benchmark_update("unchanged", from, to, iterations);
+    cJSON_Delete(to);
+
+    to = cJSON_Duplicate(from, 1);
+    cJSON_ReplaceItemInObject(cJSON_GetArrayItem(to, 500), "pm25", cJSON_CreateNumber(13.5));
+    benchmark_update("one value changed", from, to, iterations);
+    cJSON_Delete(to);
+
+    to = cJSON_Duplicate(from, 1);
+    cJSON_InsertItemInArray(to, 0, cJSON_Duplicate(cJSON_GetArrayItem(from, 999), 1));
+    cJSON_DeleteItemFromArray(to, 1000);
+    benchmark_update("record rotated to the front", from, to, iterations);
+    cJSON_Delete(to);
+
+    to = cJSON_Duplicate(from, 1);
+    cJSON_DeleteItemFromArray(to, 10);
+    cJSON_AddItemToArray(to, cJSON_Duplicate(cJSON_GetArrayItem(from, 0), 1));
+    benchmark_update("record removed, one appended", from, to, iterations);
+    cJSON_Delete(to);
+
+    cJSON_InitHooks(NULL);
+    cJSON_Delete(from);
+
+    return EXIT_SUCCESS;
+}
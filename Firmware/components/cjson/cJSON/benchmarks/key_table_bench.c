@@ -0,0 +1,99 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* parsing batches of telemetry records with and without a cJSON_KeyTable that is kept between the documents */
+
+static void benchmark_batch(const char *name, const char *batch, unsigned long iterations)
+{
+    char label[64];
+    size_t length = strlen(batch) + sizeof("");
+    cJSON_KeyTable *table = NULL;
+    cJSON *item = NULL;
+    size_t tree_bytes = 0;
+    unsigned long i = 0;
+    clock_t start;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        item = cJSON_ParseWithLengthOpts(batch, length, NULL, 0);
+        if (item == NULL)
+        {
+            exit(EXIT_FAILURE);
+        }
+        tree_bytes = benchmark_live_bytes;
+        cJSON_Delete(item);
+    }
+    sprintf(label, "%s: parse", name);
+    print_result(label, iterations, seconds_since(start), length);
+    printf("%-40s %12lu bytes per tree\n", "", (unsigned long)tree_bytes);
+
+    table = cJSON_CreateKeyTable(0);
+    if (table == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        item = cJSON_ParseWithKeyTable(batch, length, table);
+        if (item == NULL)
+        {
+            exit(EXIT_FAILURE);
+        }
+        tree_bytes = benchmark_live_bytes;
+        cJSON_Delete(item);
+    }
+    sprintf(label, "%s: parse with key table", name);
+    print_result(label, iterations, seconds_since(start), length);
+    printf("%-40s %12lu bytes per tree (including %lu keys in the table)\n", "", (unsigned long)tree_bytes, (unsigned long)cJSON_GetKeyTableSize(table));
+
+    cJSON_DeleteKeyTable(table);
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 1000);
+    char *small = create_telemetry_batch(100);
+    char *large = create_telemetry_batch(10000);
+
+    if ((small == NULL) || (large == NULL))
+    {
+        return EXIT_FAILURE;
+    }
+
+    use_tracking_hooks();
+
+    benchmark_batch("100 records", small, iterations);
+    benchmark_batch("10000 records", large, iterations / 100 + 1);
+
+    cJSON_InitHooks(NULL);
+    free(large);
+    free(small);
+
+    return EXIT_SUCCESS;
+}
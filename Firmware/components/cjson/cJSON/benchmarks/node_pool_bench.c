@@ -0,0 +1,110 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* creating and deleting the same small trees over and over, with and without the node pool */
+
+static cJSON *create_telemetry(void)
+{
+    cJSON *root = cJSON_CreateObject();
+
+    cJSON_AddStringToObject(root, "deviceId", "device_esp32_001");
+    cJSON_AddNumberToObject(root, "temperature", 24.5);
+    cJSON_AddNumberToObject(root, "humidity", 48.25);
+    cJSON_AddNumberToObject(root, "pm1", 8.5);
+    cJSON_AddNumberToObject(root, "pm25", 12.75);
+    cJSON_AddNumberToObject(root, "pm10", 20.125);
+    cJSON_AddNumberToObject(root, "voc", 0.35);
+    cJSON_AddNumberToObject(root, "soundLevel", 42.5);
+    cJSON_AddNumberToObject(root, "wifiRssi", -61);
+    cJSON_AddStringToObject(root, "wifiSsid", "praan-office");
+    cJSON_AddNumberToObject(root, "fanSpeed", 75);
+    cJSON_AddStringToObject(root, "powerState", "ON");
+
+    return root;
+}
+
+static void benchmark_shapes(const char *name, unsigned long iterations)
+{
+    char label[64];
+    cJSON *item = NULL;
+    unsigned long i = 0;
+    clock_t start;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        item = create_telemetry();
+        if (item == NULL)
+        {
+            exit(EXIT_FAILURE);
+        }
+        cJSON_Delete(item);
+    }
+    sprintf(label, "%s: build telemetry", name);
+    print_result(label, iterations, seconds_since(start), 0);
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        item = cJSON_Parse(benchmark_command);
+        if (item == NULL)
+        {
+            exit(EXIT_FAILURE);
+        }
+        cJSON_Delete(item);
+    }
+    sprintf(label, "%s: parse command", name);
+    print_result(label, iterations, seconds_since(start), strlen(benchmark_command));
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 500000);
+    cJSON_Hooks hooks;
+    cJSON_PoolConfig pool;
+    cJSON_PoolStats stats;
+
+    hooks.malloc_fn = counting_malloc;
+    hooks.free_fn = counting_free;
+
+    cJSON_InitHooks(&hooks);
+    benchmark_shapes("malloc", iterations);
+
+    pool.nodes_per_slab = 64;
+    pool.lock = NULL;
+    pool.unlock = NULL;
+    pool.lock_context = NULL;
+    cJSON_InitHooksWithPool(&hooks, &pool);
+    benchmark_shapes("pool", iterations);
+
+    cJSON_GetPoolStats(&stats);
+    printf("pool: %lu hits, %lu misses, %lu slabs, high water %lu nodes\n",
+        (unsigned long)stats.hits, (unsigned long)stats.misses, (unsigned long)stats.slabs, (unsigned long)stats.high_water);
+
+    cJSON_InitHooks(NULL);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,124 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* key lookups in objects of different sizes with and without the object index, which needs ENABLE_CJSON_INDEX */
+
+/* an object with count members, their keys are stored in keys */
+static cJSON *create_object(char (*keys)[16], size_t count)
+{
+    cJSON *object = cJSON_CreateObject();
+    size_t i = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        sprintf(keys[i], "member_%u", (unsigned int)i);
+        if (cJSON_AddNumberToObject(object, keys[i], (double)i) == NULL)
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return object;
+}
+
+/* look up lookups pseudo random members of object, keys holds the key of every member */
+static void benchmark_lookups(const char *name, const cJSON *object, const char (*keys)[16], size_t count, unsigned long lookups)
+{
+    char label[64];
+    unsigned long state = 12345;
+    unsigned long i = 0;
+    clock_t start;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < lookups; i++)
+    {
+        state = state * 1103515245UL + 12345UL;
+        if (cJSON_GetObjectItemCaseSensitive(object, keys[(state >> 8) % count]) == NULL)
+        {
+            fprintf(stderr, "%s: lookup failed\n", name);
+            exit(EXIT_FAILURE);
+        }
+    }
+    sprintf(label, "%u keys: %s", (unsigned int)count, name);
+    print_result(label, lookups, seconds_since(start), 0);
+}
+
+static void benchmark_index_build(cJSON *object, size_t count, unsigned long builds)
+{
+    char label[64];
+    unsigned long i = 0;
+    clock_t start;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < builds; i++)
+    {
+        cJSON_InvalidateIndex(object);
+        if (cJSON_GetObjectItemCaseSensitive(object, "member_0") == NULL)
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+    sprintf(label, "%u keys: build index", (unsigned int)count);
+    print_result(label, builds, seconds_since(start), 0);
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    const size_t sizes[] = { 8, 64, 1024, 65536 };
+    unsigned long iterations = iterations_from_arguments(argc, argv, 1000000);
+    size_t i = 0;
+
+    use_counting_hooks();
+
+    for (i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++)
+    {
+        char (*keys)[16] = (char (*)[16])malloc(sizes[i] * 16);
+        cJSON *object = NULL;
+        /* linear lookups get slow quickly, scale them down with the size */
+        unsigned long linear_lookups = iterations / (unsigned long)(sizes[i] / 8);
+
+        if (keys == NULL)
+        {
+            return EXIT_FAILURE;
+        }
+        object = create_object(keys, sizes[i]);
+
+        cJSON_SetIndexThreshold(0);
+        benchmark_lookups("linear lookup", object, (const char (*)[16])keys, sizes[i], (linear_lookups > 100) ? linear_lookups : 100);
+
+        cJSON_SetIndexThreshold(1);
+        benchmark_index_build(object, sizes[i], (iterations / (unsigned long)sizes[i]) + 1);
+        benchmark_lookups("indexed lookup", object, (const char (*)[16])keys, sizes[i], iterations);
+
+        cJSON_Delete(object);
+        free(keys);
+    }
+
+    cJSON_SetIndexThreshold(0);
+    cJSON_InitHooks(NULL);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* case insensitive lookups of every telemetry key, by name and with keys prepared by cJSON_InitKey */
+
+static const char * const names[] = {
+    "deviceId", "temperature", "humidity", "pm1", "pm25", "pm10", "voc", "soundLevel", "wifiRssi", "wifiSsid", "fanSpeed", "powerState"
+};
+
+#define NAME_COUNT (sizeof(names) / sizeof(names[0]))
+
+static void benchmark_names(const char *name, const cJSON *object, cJSON *(*lookup)(const cJSON * const, const char * const), unsigned long iterations)
+{
+    unsigned long i = 0;
+    size_t j = 0;
+    clock_t start;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        for (j = 0; j < NAME_COUNT; j++)
+        {
+            if (lookup(object, names[j]) == NULL)
+            {
+                fprintf(stderr, "%s: %s not found\n", name, names[j]);
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+    print_result(name, iterations * NAME_COUNT, seconds_since(start), 0);
+}
+
+static void benchmark_keys(const char *name, const cJSON *object, const cJSON_Key *keys, unsigned long iterations)
+{
+    unsigned long i = 0;
+    size_t j = 0;
+    clock_t start;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        for (j = 0; j < NAME_COUNT; j++)
+        {
+            if (cJSON_GetObjectItemKey(object, &keys[j]) == NULL)
+            {
+                fprintf(stderr, "%s: %s not found\n", name, keys[j].string);
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+    print_result(name, iterations * NAME_COUNT, seconds_since(start), 0);
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 500000);
+    cJSON *object = cJSON_Parse(benchmark_telemetry);
+    cJSON_Key keys[NAME_COUNT];
+    size_t i = 0;
+
+    if (object == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < NAME_COUNT; i++)
+    {
+        cJSON_InitKey(&keys[i], names[i]);
+    }
+
+    use_counting_hooks();
+
+    benchmark_names("cJSON_GetObjectItemCaseSensitive", object, cJSON_GetObjectItemCaseSensitive, iterations);
+    benchmark_names("cJSON_GetObjectItem", object, cJSON_GetObjectItem, iterations);
+    benchmark_keys("cJSON_GetObjectItemKey", object, keys, iterations);
+    cJSON_SetIndexThreshold(8);
+    benchmark_names("cJSON_GetObjectItem, indexed", object, cJSON_GetObjectItem, iterations);
+    benchmark_keys("cJSON_GetObjectItemKey, indexed", object, keys, iterations);
+    cJSON_SetIndexThreshold(0);
+
+    cJSON_InitHooks(NULL);
+    cJSON_Delete(object);
+
+    return EXIT_SUCCESS;
+}
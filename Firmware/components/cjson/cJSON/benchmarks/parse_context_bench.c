@@ -0,0 +1,141 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+/* clock_gettime */
+#define _POSIX_C_SOURCE 199309L
+
+#include <pthread.h>
+
+#include "common.h"
+
+/* parsing telemetry on 1 to N threads at once, through cJSON_ParseWithLength (which updates the error of
+ * cJSON_GetErrorPtr on every parse) and through cJSON_ParseWithContext with a context per thread */
+
+#define max_threads 64
+
+typedef struct
+{
+    cJSON_bool with_context;
+    unsigned long iterations;
+    unsigned long failures;
+} parse_worker;
+
+static void *parse_telemetry(void *argument)
+{
+    parse_worker *worker = (parse_worker*)argument;
+    cJSON_ParseContext context;
+    cJSON *item = NULL;
+    unsigned long i = 0;
+
+    cJSON_InitParseContext(&context);
+    for (i = 0; i < worker->iterations; i++)
+    {
+        if (worker->with_context)
+        {
+            item = cJSON_ParseWithContext(benchmark_telemetry, sizeof(benchmark_telemetry), &context);
+        }
+        else
+        {
+            item = cJSON_ParseWithLength(benchmark_telemetry, sizeof(benchmark_telemetry));
+        }
+        if (item == NULL)
+        {
+            worker->failures++;
+        }
+        cJSON_Delete(item);
+    }
+
+    return NULL;
+}
+
+static double wall_seconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + ((double)now.tv_nsec / 1e9);
+}
+
+/* returns parses per second over all threads */
+static double benchmark_threads(const char *name, size_t thread_count, unsigned long iterations, cJSON_bool with_context, double single_thread)
+{
+    parse_worker workers[max_threads];
+    pthread_t threads[max_threads];
+    char label[64];
+    double start = 0;
+    double seconds = 0;
+    double throughput = 0;
+    size_t i = 0;
+
+    start = wall_seconds();
+    for (i = 0; i < thread_count; i++)
+    {
+        workers[i].with_context = with_context;
+        workers[i].iterations = iterations;
+        workers[i].failures = 0;
+        if (pthread_create(&threads[i], NULL, parse_telemetry, &workers[i]) != 0)
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (i = 0; i < thread_count; i++)
+    {
+        pthread_join(threads[i], NULL);
+        if (workers[i].failures != 0)
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+    seconds = wall_seconds() - start;
+
+    throughput = (seconds > 0) ? ((double)thread_count * (double)iterations / seconds) : 0;
+    sprintf(label, "%s, %lu threads", name, (unsigned long)thread_count);
+    printf("%-40s %12.0f parses/s %8.2fx\n", label, throughput, (single_thread > 0) ? (throughput / single_thread) : 1.0);
+
+    return throughput;
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 200000);
+    size_t thread_limit = (argc > 2) ? (size_t)strtoul(argv[2], NULL, 10) : 8;
+    double legacy = 0;
+    double context = 0;
+    size_t thread_count = 0;
+
+    if ((thread_limit == 0) || (thread_limit > max_threads))
+    {
+        thread_limit = max_threads;
+    }
+
+    /* the speedup is relative to one thread with the same function */
+    legacy = benchmark_threads("cJSON_ParseWithLength", 1, iterations, 0, 0);
+    context = benchmark_threads("cJSON_ParseWithContext", 1, iterations, 1, 0);
+    for (thread_count = 2; thread_count <= thread_limit; thread_count *= 2)
+    {
+        benchmark_threads("cJSON_ParseWithLength", thread_count, iterations, 0, legacy);
+        benchmark_threads("cJSON_ParseWithContext", thread_count, iterations, 1, context);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* compares cJSON_ParseSAX on the whole message with cJSON_ParserFeed on pieces of it,
+ * the way a message arrives in several MQTT data events */
+
+static cJSON_bool on_number(void *user_data, double number)
+{
+    *(double*)user_data += number;
+    return 1;
+}
+
+static const cJSON_SAXHandler sum_handler = {
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    on_number,
+    NULL,
+    NULL
+};
+
+static void benchmark_whole(const char *name, const char *json, size_t length, unsigned long iterations)
+{
+    unsigned long i = 0;
+    clock_t start;
+    double sum = 0;
+    char scratch[128];
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        if (!cJSON_ParseSAX(json, length, &sum_handler, &sum, scratch, sizeof(scratch)))
+        {
+            fprintf(stderr, "%s: parse failed\n", name);
+            exit(EXIT_FAILURE);
+        }
+    }
+    print_result(name, iterations, seconds_since(start), length);
+}
+
+static void benchmark_pieces(const char *name, const char *json, size_t length, size_t piece, unsigned long iterations)
+{
+    unsigned long i = 0;
+    size_t offset = 0;
+    clock_t start;
+    double sum = 0;
+    char scratch[128];
+    cJSON_Parser *parser = cJSON_CreateParser(&sum_handler, &sum, scratch, sizeof(scratch));
+
+    if (parser == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        cJSON_ResetParser(parser);
+        for (offset = 0; offset < length; offset += piece)
+        {
+            if (!cJSON_ParserFeed(parser, json + offset, ((length - offset) < piece) ? (length - offset) : piece))
+            {
+                fprintf(stderr, "%s: parse failed\n", name);
+                exit(EXIT_FAILURE);
+            }
+        }
+        if (!cJSON_ParserFinish(parser))
+        {
+            fprintf(stderr, "%s: incomplete\n", name);
+            exit(EXIT_FAILURE);
+        }
+    }
+    print_result(name, iterations, seconds_since(start), length);
+
+    cJSON_DeleteParser(parser);
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 200000);
+    char *batch = create_telemetry_batch(1000);
+    size_t batch_length = 0;
+
+    if (batch == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+    batch_length = strlen(batch);
+
+    use_counting_hooks();
+
+    benchmark_whole("command: cJSON_ParseSAX", benchmark_command, strlen(benchmark_command), iterations);
+    benchmark_pieces("command: cJSON_ParserFeed, 16 byte pieces", benchmark_command, strlen(benchmark_command), 16, iterations);
+    benchmark_pieces("command: cJSON_ParserFeed, 64 byte pieces", benchmark_command, strlen(benchmark_command), 64, iterations);
+
+    benchmark_whole("1000 records: cJSON_ParseSAX", batch, batch_length, iterations / 1000 + 1);
+    benchmark_pieces("1000 records: cJSON_ParserFeed, 64 byte pieces", batch, batch_length, 64, iterations / 1000 + 1);
+    benchmark_pieces("1000 records: cJSON_ParserFeed, 512 byte pieces", batch, batch_length, 512, iterations / 1000 + 1);
+    benchmark_pieces("1000 records: cJSON_ParserFeed, 4096 byte pieces", batch, batch_length, 4096, iterations / 1000 + 1);
+
+    cJSON_InitHooks(NULL);
+    free(batch);
+
+    return EXIT_SUCCESS;
+}
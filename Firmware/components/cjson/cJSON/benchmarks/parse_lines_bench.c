@@ -0,0 +1,130 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+/* clock_gettime */
+#define _POSIX_C_SOURCE 199309L
+
+#include "common.h"
+#include "../cJSON_Lines.h"
+
+/* cJSON_ParseLines over a generated file of telemetry records (1 GB unless a size in MB is given),
+ * on the calling thread and on 1 to 8 parsing threads */
+
+typedef struct
+{
+    unsigned long documents;
+    unsigned long invalid;
+} line_counts;
+
+static cJSON_bool count_line(void *user_data, cJSON_Line * const line)
+{
+    line_counts *counts = (line_counts*)user_data;
+
+    if (line->item == NULL)
+    {
+        counts->invalid++;
+    }
+    counts->documents++;
+    cJSON_Delete(line->item);
+
+    return 1;
+}
+
+static double wall_seconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)now.tv_sec + ((double)now.tv_nsec / 1e9);
+}
+
+/* returns the size of the file */
+static size_t write_telemetry(const char *path, size_t megabytes)
+{
+    size_t record_length = strlen(benchmark_telemetry);
+    size_t size = 0;
+    FILE *file = fopen(path, "wb");
+
+    if (file == NULL)
+    {
+        return 0;
+    }
+    while (size < (megabytes * 1024 * 1024))
+    {
+        if ((fwrite(benchmark_telemetry, 1, record_length, file) != record_length) || (fputc('\n', file) == EOF))
+        {
+            fclose(file);
+            return 0;
+        }
+        size += record_length + 1;
+    }
+    fclose(file);
+
+    return size;
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    static const size_t threads[] = { 0, 1, 2, 4, 8 };
+    size_t megabytes = (argc > 1) ? (size_t)strtoul(argv[1], NULL, 10) : 1024;
+    const char *path = (argc > 2) ? argv[2] : "parse_lines_bench.ndjson";
+    cJSON_LinesOptions options;
+    line_counts counts;
+    double start = 0;
+    double seconds = 0;
+    size_t size = 0;
+    size_t i = 0;
+
+    if (megabytes == 0)
+    {
+        megabytes = 1024;
+    }
+    size = write_telemetry(path, megabytes);
+    if (size == 0)
+    {
+        fprintf(stderr, "can't write %s\n", path);
+        return EXIT_FAILURE;
+    }
+
+    for (i = 0; i < (sizeof(threads) / sizeof(threads[0])); i++)
+    {
+        options.threads = threads[i];
+        options.chunk_size = 0;
+        memset(&counts, '\0', sizeof(counts));
+
+        start = wall_seconds();
+        if (!cJSON_ParseLines(path, &options, count_line, &counts) || (counts.invalid != 0))
+        {
+            remove(path);
+            return EXIT_FAILURE;
+        }
+        seconds = wall_seconds() - start;
+
+        printf("%lu parsing threads %20.2f MB/s %12.0f lines/s\n", (unsigned long)threads[i],
+            (double)size / seconds / 1e6, (double)counts.documents / seconds);
+    }
+
+    remove(path);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* number parsing throughput for the kinds of numbers found in telemetry */
+
+#define NUMBER_COUNT 1000
+
+/* builds "[n,n,...]" with integers, readings with a few decimals and full precision doubles */
+static char *create_number_array(void)
+{
+    char *json = (char*)malloc(NUMBER_COUNT * 32 + 3);
+    char *position = json;
+    unsigned long state = 12345;
+    size_t i = 0;
+
+    if (json == NULL)
+    {
+        return NULL;
+    }
+
+    *position++ = '[';
+    for (i = 0; i < NUMBER_COUNT; i++)
+    {
+        state = state * 1103515245UL + 12345UL;
+        if (i > 0)
+        {
+            *position++ = ',';
+        }
+        switch (i % 3)
+        {
+            case 0:
+                position += sprintf(position, "%d", (int)(state % 200UL) - 100);
+                break;
+            case 1:
+                position += sprintf(position, "%.2f", (double)(state % 100000UL) / 100.0);
+                break;
+            default:
+                position += sprintf(position, "%.17g", (double)(state % 1000000UL) / 7.0);
+                break;
+        }
+    }
+    *position++ = ']';
+    *position = '\0';
+
+    return json;
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 2000);
+    char *json = create_number_array();
+    size_t length = 0;
+    unsigned long i = 0;
+    clock_t start;
+    double seconds = 0;
+
+    if (json == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+    length = strlen(json) + 1;
+
+    use_counting_hooks();
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        cJSON *array = cJSON_ParseWithLength(json, length);
+        if (array == NULL)
+        {
+            fprintf(stderr, "parse failed\n");
+            return EXIT_FAILURE;
+        }
+        cJSON_Delete(array);
+    }
+    seconds = seconds_since(start);
+
+    print_result("1000 numbers: cJSON_ParseWithLength", iterations, seconds, length);
+    printf("%-40s %12.0f numbers/s\n", "", (seconds > 0.0) ? ((double)iterations * NUMBER_COUNT / seconds) : 0.0);
+
+    cJSON_InitHooks(NULL);
+    free(json);
+
+    return EXIT_SUCCESS;
+}
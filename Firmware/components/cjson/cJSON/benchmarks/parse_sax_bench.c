@@ -0,0 +1,234 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* compares pulling the fields of a command out of a parsed tree with cJSON_ParseSAX */
+
+typedef struct
+{
+    char command_id[64];
+    char command_type[32];
+    double fan_speed;
+    int depth;
+    int field;
+    double sum;
+} command_fields;
+
+/* keys only live until the callback returns, so they are classified right away */
+enum { other_field, command_id_field, command_type_field, fan_speed_field };
+
+static int key_is(const char *key, size_t length, const char *name)
+{
+    return (length == strlen(name)) && (strncmp(key, name, length) == 0);
+}
+
+static void copy_field(char *destination, size_t size, const char *string, size_t length)
+{
+    if (length >= size)
+    {
+        length = size - 1;
+    }
+    memcpy(destination, string, length);
+    destination[length] = '\0';
+}
+
+static cJSON_bool on_start(void *user_data)
+{
+    ((command_fields*)user_data)->depth++;
+    return 1;
+}
+
+static cJSON_bool on_end(void *user_data)
+{
+    ((command_fields*)user_data)->depth--;
+    return 1;
+}
+
+static cJSON_bool on_key(void *user_data, const char *key, size_t length)
+{
+    command_fields *fields = (command_fields*)user_data;
+
+    fields->field = other_field;
+    if ((fields->depth == 1) && key_is(key, length, "commandId"))
+    {
+        fields->field = command_id_field;
+    }
+    else if ((fields->depth == 1) && key_is(key, length, "commandType"))
+    {
+        fields->field = command_type_field;
+    }
+    else if ((fields->depth == 2) && key_is(key, length, "fanSpeed"))
+    {
+        fields->field = fan_speed_field;
+    }
+
+    return 1;
+}
+
+static cJSON_bool on_string(void *user_data, const char *string, size_t length)
+{
+    command_fields *fields = (command_fields*)user_data;
+
+    if (fields->field == command_id_field)
+    {
+        copy_field(fields->command_id, sizeof(fields->command_id), string, length);
+    }
+    else if (fields->field == command_type_field)
+    {
+        copy_field(fields->command_type, sizeof(fields->command_type), string, length);
+    }
+
+    return 1;
+}
+
+static cJSON_bool on_number(void *user_data, double number)
+{
+    command_fields *fields = (command_fields*)user_data;
+
+    if (fields->field == fan_speed_field)
+    {
+        fields->fan_speed = number;
+    }
+    fields->sum += number;
+
+    return 1;
+}
+
+static const cJSON_SAXHandler command_handler = {
+    on_start,
+    on_end,
+    on_start,
+    on_end,
+    on_key,
+    on_string,
+    on_number,
+    NULL,
+    NULL
+};
+
+static void extract_from_tree(const cJSON *root, command_fields *fields)
+{
+    const cJSON *id = cJSON_GetObjectItem(root, "commandId");
+    const cJSON *type = cJSON_GetObjectItem(root, "commandType");
+    const cJSON *fan_speed = cJSON_GetObjectItem(cJSON_GetObjectItem(root, "payload"), "fanSpeed");
+
+    if (cJSON_IsString(id))
+    {
+        copy_field(fields->command_id, sizeof(fields->command_id), id->valuestring, strlen(id->valuestring));
+    }
+    if (cJSON_IsString(type))
+    {
+        copy_field(fields->command_type, sizeof(fields->command_type), type->valuestring, strlen(type->valuestring));
+    }
+    if (cJSON_IsNumber(fan_speed))
+    {
+        fields->fan_speed = fan_speed->valuedouble;
+    }
+}
+
+/* add up all numbers of the tree, the tree equivalent of a number callback */
+static void sum_tree(const cJSON *item, command_fields *fields)
+{
+    for (; item != NULL; item = item->next)
+    {
+        if (cJSON_IsNumber(item))
+        {
+            fields->sum += item->valuedouble;
+        }
+        sum_tree(item->child, fields);
+    }
+}
+
+static void benchmark_tree(const char *name, const char *json, size_t length, unsigned long iterations)
+{
+    unsigned long i = 0;
+    clock_t start;
+    command_fields fields;
+    cJSON *root = NULL;
+
+    memset(&fields, 0, sizeof(fields));
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        root = cJSON_ParseWithLength(json, length);
+        if (root == NULL)
+        {
+            fprintf(stderr, "%s: parse failed\n", name);
+            exit(EXIT_FAILURE);
+        }
+        extract_from_tree(root, &fields);
+        sum_tree(root, &fields);
+        cJSON_Delete(root);
+    }
+    print_result(name, iterations, seconds_since(start), length);
+}
+
+static void benchmark_sax(const char *name, const char *json, size_t length, unsigned long iterations)
+{
+    unsigned long i = 0;
+    clock_t start;
+    command_fields fields;
+    char scratch[128];
+
+    memset(&fields, 0, sizeof(fields));
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        fields.depth = 0;
+        if (!cJSON_ParseSAX(json, length, &command_handler, &fields, scratch, sizeof(scratch)))
+        {
+            fprintf(stderr, "%s: parse failed\n", name);
+            exit(EXIT_FAILURE);
+        }
+    }
+    print_result(name, iterations, seconds_since(start), length);
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 200000);
+    char *batch = create_telemetry_batch(1000);
+
+    if (batch == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+
+    use_counting_hooks();
+
+    benchmark_tree("command: tree + cJSON_GetObjectItem", benchmark_command, sizeof(benchmark_command), iterations);
+    benchmark_sax("command: cJSON_ParseSAX", benchmark_command, sizeof(benchmark_command), iterations);
+
+    benchmark_tree("telemetry: tree walk", benchmark_telemetry, sizeof(benchmark_telemetry), iterations);
+    benchmark_sax("telemetry: cJSON_ParseSAX", benchmark_telemetry, sizeof(benchmark_telemetry), iterations);
+
+    benchmark_tree("1000 records: tree walk", batch, strlen(batch) + 1, iterations / 1000 + 1);
+    benchmark_sax("1000 records: cJSON_ParseSAX", batch, strlen(batch) + 1, iterations / 1000 + 1);
+
+    cJSON_InitHooks(NULL);
+    free(batch);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,226 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* compares cJSON_Parse with cJSON_ParseTape: time to parse and sum up one field of every record, and memory per document */
+
+/* an array of count commands */
+static char *create_command_batch(size_t count)
+{
+    size_t record_length = strlen(benchmark_command);
+    char *batch = (char*)malloc(count * (record_length + 1) + 3);
+    char *position = batch;
+    size_t i = 0;
+
+    if (batch == NULL)
+    {
+        return NULL;
+    }
+
+    *position++ = '[';
+    for (i = 0; i < count; i++)
+    {
+        if (i > 0)
+        {
+            *position++ = ',';
+        }
+        memcpy(position, benchmark_command, record_length);
+        position += record_length;
+    }
+    *position++ = ']';
+    *position = '\0';
+
+    return batch;
+}
+
+/* the field (of the member object, if it isn't NULL) is summed up over the records of a batch, or taken from a single record */
+static double tree_field(const cJSON *record, const char *member, const char *field)
+{
+    if (member != NULL)
+    {
+        record = cJSON_GetObjectItemCaseSensitive(record, member);
+    }
+
+    return cJSON_GetNumberValue(cJSON_GetObjectItemCaseSensitive(record, field));
+}
+
+static double sum_tree(const cJSON *root, const char *member, const char *field)
+{
+    const cJSON *record = NULL;
+    double sum = 0;
+
+    if (!cJSON_IsArray(root))
+    {
+        return tree_field(root, member, field);
+    }
+
+    cJSON_ArrayForEach(record, root)
+    {
+        sum += tree_field(record, member, field);
+    }
+
+    return sum;
+}
+
+static double tape_field(cJSON_TapeIterator record, const char *member, const char *field)
+{
+    cJSON_TapeIterator value;
+
+    if ((member != NULL) && !cJSON_TapeGetObjectItemCaseSensitive(&record, member, &record))
+    {
+        return 0;
+    }
+
+    return cJSON_TapeGetObjectItemCaseSensitive(&record, field, &value) ? cJSON_TapeGetNumber(&value) : 0;
+}
+
+static double sum_tape(const cJSON_Tape *tape, const char *member, const char *field)
+{
+    cJSON_TapeIterator root;
+    cJSON_TapeIterator record;
+    double sum = 0;
+
+    cJSON_GetTapeRoot(tape, &root);
+    if (cJSON_TapeType(&root) != cJSON_Array)
+    {
+        return tape_field(root, member, field);
+    }
+
+    if (cJSON_TapeChild(&root, &record))
+    {
+        do
+        {
+            sum += tape_field(record, member, field);
+        }
+        while (cJSON_TapeNext(&record));
+    }
+
+    return sum;
+}
+
+static void measure_memory(const char *name, const char *json, size_t length)
+{
+    cJSON *root = NULL;
+    cJSON_Tape *tape = NULL;
+    size_t tree_peak = 0;
+    size_t tree_retained = 0;
+
+    use_tracking_hooks();
+
+    reset_peak_bytes();
+    root = cJSON_ParseWithLength(json, length);
+    tree_peak = benchmark_peak_bytes;
+    tree_retained = benchmark_live_bytes;
+    cJSON_Delete(root);
+
+    reset_peak_bytes();
+    tape = cJSON_ParseTape(json, length);
+    printf("%-40s input %lu bytes, tree %lu bytes (peak %lu), tape %lu bytes (peak %lu)\n",
+        name,
+        (unsigned long)length,
+        (unsigned long)tree_retained,
+        (unsigned long)tree_peak,
+        (unsigned long)benchmark_live_bytes,
+        (unsigned long)benchmark_peak_bytes);
+    cJSON_DeleteTape(tape);
+
+    use_counting_hooks();
+}
+
+static void benchmark(const char *name, const char *json, const char *member, const char *field, unsigned long iterations)
+{
+    const size_t length = strlen(json);
+    char label[64];
+    unsigned long i = 0;
+    clock_t start;
+    double tree_sum = 0;
+    double tape_sum = 0;
+    double seconds = 0;
+
+    measure_memory(name, json, length);
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        cJSON *root = cJSON_ParseWithLength(json, length);
+        if (root == NULL)
+        {
+            fprintf(stderr, "%s: parse failed\n", name);
+            exit(EXIT_FAILURE);
+        }
+        tree_sum += sum_tree(root, member, field);
+        cJSON_Delete(root);
+    }
+    sprintf(label, "%s: cJSON_Parse", name);
+    print_result(label, iterations, seconds_since(start), length);
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        cJSON_Tape *tape = cJSON_ParseTape(json, length);
+        if (tape == NULL)
+        {
+            fprintf(stderr, "%s: tape parse failed\n", name);
+            exit(EXIT_FAILURE);
+        }
+        tape_sum += sum_tape(tape, member, field);
+        cJSON_DeleteTape(tape);
+    }
+    seconds = seconds_since(start);
+    sprintf(label, "%s: cJSON_ParseTape", name);
+    print_result(label, iterations, seconds, length);
+    printf("%-40s %12.2f GB/s\n", label, (seconds > 0.0) ? ((double)length * (double)iterations / seconds / 1e9) : 0.0);
+
+    if (tree_sum != tape_sum)
+    {
+        fprintf(stderr, "%s: results differ\n", name);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 100000);
+    char *telemetry_batch = create_telemetry_batch(10000);
+    char *command_batch = create_command_batch(1000);
+
+    if ((telemetry_batch == NULL) || (command_batch == NULL))
+    {
+        return EXIT_FAILURE;
+    }
+
+    use_counting_hooks();
+
+    benchmark("command", benchmark_command, "payload", "fanSpeed", iterations);
+    benchmark("telemetry", benchmark_telemetry, NULL, "pm25", iterations);
+    benchmark("1000 commands", command_batch, "payload", "fanSpeed", iterations / 1000 + 1);
+    benchmark("10000 records", telemetry_batch, NULL, "pm25", iterations / 10000 + 1);
+
+    cJSON_InitHooks(NULL);
+    free(command_batch);
+    free(telemetry_batch);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* compares the regular heap backed parse with cJSON_ParseWithArena */
+
+static void benchmark_heap(const char *name, const char *json, size_t length, unsigned long iterations)
+{
+    unsigned long i = 0;
+    clock_t start;
+    cJSON *item = NULL;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        item = cJSON_ParseWithLengthOpts(json, length, NULL, 0);
+        if (item == NULL)
+        {
+            fprintf(stderr, "%s: parse failed\n", name);
+            exit(EXIT_FAILURE);
+        }
+        cJSON_Delete(item);
+    }
+    print_result(name, iterations, seconds_since(start), length);
+}
+
+static void benchmark_arena(const char *name, const char *json, size_t length, unsigned long iterations, void *memory, size_t memory_size)
+{
+    unsigned long i = 0;
+    clock_t start;
+    cJSON_Arena arena;
+    size_t high_water = 0;
+
+    cJSON_InitArena(&arena, memory, memory_size);
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        if (cJSON_ParseWithArena(json, length, &arena) == NULL)
+        {
+            fprintf(stderr, "%s: parse failed\n", name);
+            exit(EXIT_FAILURE);
+        }
+        high_water = arena.used;
+        cJSON_ResetArena(&arena);
+    }
+    print_result(name, iterations, seconds_since(start), length);
+    printf("%-40s %12lu bytes of arena per document\n", "", (unsigned long)high_water);
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 200000);
+    size_t arena_size = 4 * 1024 * 1024;
+    void *arena_memory = malloc(arena_size);
+    char *batch = create_telemetry_batch(1000);
+
+    if ((arena_memory == NULL) || (batch == NULL))
+    {
+        return EXIT_FAILURE;
+    }
+
+    use_counting_hooks();
+
+    benchmark_heap("command: cJSON_ParseWithLengthOpts", benchmark_command, sizeof(benchmark_command), iterations);
+    benchmark_arena("command: cJSON_ParseWithArena", benchmark_command, sizeof(benchmark_command), iterations, arena_memory, 2048);
+
+    benchmark_heap("telemetry: cJSON_ParseWithLengthOpts", benchmark_telemetry, sizeof(benchmark_telemetry), iterations);
+    benchmark_arena("telemetry: cJSON_ParseWithArena", benchmark_telemetry, sizeof(benchmark_telemetry), iterations, arena_memory, 4096);
+
+    benchmark_heap("1000 records: cJSON_ParseWithLengthOpts", batch, strlen(batch) + 1, iterations / 1000 + 1);
+    benchmark_arena("1000 records: cJSON_ParseWithArena", batch, strlen(batch) + 1, iterations / 1000 + 1, arena_memory, arena_size);
+
+    cJSON_InitHooks(NULL);
+    free(batch);
+    free(arena_memory);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,126 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* allocations made by printing telemetry sized and megabyte sized documents */
+
+static void benchmark_print(const char *name, cJSON * const item, const cJSON_bool format, unsigned long iterations)
+{
+    char label[64];
+    size_t length = cJSON_PrintedLength(item, format);
+    char *printed = NULL;
+    char *buffer = NULL;
+    unsigned long i = 0;
+    clock_t start;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        if (cJSON_PrintedLength(item, format) != length)
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+    sprintf(label, "%s: measure", name);
+    print_result(label, iterations, seconds_since(start), length);
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        printed = format ? cJSON_Print(item) : cJSON_PrintUnformatted(item);
+        if (printed == NULL)
+        {
+            exit(EXIT_FAILURE);
+        }
+        cJSON_free(printed);
+    }
+    sprintf(label, "%s: print", name);
+    print_result(label, iterations, seconds_since(start), length);
+
+    /* the growing buffer print used before measuring, starting at 256 bytes and doubling */
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        printed = cJSON_PrintBuffered(item, 256, format);
+        if (printed == NULL)
+        {
+            exit(EXIT_FAILURE);
+        }
+        cJSON_free(printed);
+    }
+    sprintf(label, "%s: growing buffer", name);
+    print_result(label, iterations, seconds_since(start), length);
+
+    buffer = (char*)malloc(length + 1);
+    if (buffer == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        if (!cJSON_PrintPreallocated(item, buffer, (int)length + 1, format))
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+    sprintf(label, "%s: preallocated", name);
+    print_result(label, iterations, seconds_since(start), length);
+    free(buffer);
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 100000);
+    char *batch = create_telemetry_batch(4500);
+    cJSON *telemetry = cJSON_Parse(benchmark_telemetry);
+    cJSON *document = NULL;
+
+    if ((batch == NULL) || (telemetry == NULL))
+    {
+        return EXIT_FAILURE;
+    }
+    document = cJSON_Parse(batch);
+    if (document == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+
+    use_counting_hooks();
+
+    benchmark_print("telemetry", telemetry, 0, iterations);
+    benchmark_print("telemetry formatted", telemetry, 1, iterations);
+    benchmark_print("1 MB batch", document, 0, (iterations / 4000) + 1);
+    benchmark_print("1 MB batch formatted", document, 1, (iterations / 4000) + 1);
+
+    cJSON_InitHooks(NULL);
+    cJSON_Delete(document);
+    cJSON_Delete(telemetry);
+    free(batch);
+
+    return EXIT_SUCCESS;
+}
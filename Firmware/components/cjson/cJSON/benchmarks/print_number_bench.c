@@ -0,0 +1,119 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <math.h>
+
+#include "common.h"
+
+/* compares the number formatting of cJSON_Print with the sprintf/sscanf round trip it used before */
+
+#define NUMBER_COUNT 1000
+
+/* the former print_number: %1.15g, checked with sscanf and redone with %1.17g if it doesn't round trip */
+static int print_with_sprintf(char *buffer, double number)
+{
+    double test = 0.0;
+    int length = sprintf(buffer, "%1.15g", number);
+
+    if ((sscanf(buffer, "%lg", &test) != 1) || (fabs(test - number) > 0.0))
+    {
+        length = sprintf(buffer, "%1.17g", number);
+    }
+
+    return length;
+}
+
+static void fill_numbers(double *numbers, cJSON *array)
+{
+    size_t i = 0;
+    unsigned long state = 12345;
+
+    for (i = 0; i < NUMBER_COUNT; i++)
+    {
+        /* sensor readings with a few decimals and some arbitrary doubles */
+        state = state * 1103515245UL + 12345UL;
+        if ((i % 4) == 3)
+        {
+            numbers[i] = (double)(state % 1000000UL) / 7.0;
+        }
+        else
+        {
+            numbers[i] = (double)(state % 100000UL) / 100.0 + 0.25;
+        }
+        cJSON_AddItemToArray(array, cJSON_CreateNumber(numbers[i]));
+    }
+}
+
+static void print_numbers_per_second(const char *name, unsigned long iterations, double seconds)
+{
+    printf("%-40s %12.0f numbers/s %10.1f ns/number\n",
+        name,
+        (seconds > 0.0) ? ((double)iterations * NUMBER_COUNT / seconds) : 0.0,
+        seconds * 1e9 / ((double)iterations * NUMBER_COUNT));
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 2000);
+    double *numbers = (double*)malloc(NUMBER_COUNT * sizeof(double));
+    char *output = (char*)malloc(NUMBER_COUNT * 32);
+    cJSON *array = cJSON_CreateArray();
+    unsigned long i = 0;
+    size_t j = 0;
+    size_t length = 0;
+    clock_t start;
+
+    if ((numbers == NULL) || (output == NULL) || (array == NULL))
+    {
+        return EXIT_FAILURE;
+    }
+    fill_numbers(numbers, array);
+
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        length = 0;
+        for (j = 0; j < NUMBER_COUNT; j++)
+        {
+            length += (size_t)print_with_sprintf(output + length, numbers[j]);
+            output[length++] = ',';
+        }
+    }
+    print_numbers_per_second("sprintf + sscanf", iterations, seconds_since(start));
+
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        if (!cJSON_PrintPreallocated(array, output, NUMBER_COUNT * 32, 0))
+        {
+            fprintf(stderr, "cJSON_PrintPreallocated failed\n");
+            return EXIT_FAILURE;
+        }
+    }
+    print_numbers_per_second("cJSON_PrintPreallocated", iterations, seconds_since(start));
+
+    cJSON_Delete(array);
+    free(output);
+    free(numbers);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,209 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* building telemetry and acks the way the firmware did (tree + cJSON_PrintUnformatted) and with cJSON_Writer */
+
+typedef struct
+{
+    double temperature;
+    double humidity;
+    double pm1;
+    double pm25;
+    double pm10;
+    double voc;
+    double sound_level;
+    int wifi_rssi;
+    int fan_speed;
+    int power_state;
+} telemetry;
+
+static const telemetry sample = { 24.5, 48.25, 8.5, 12.75, 20.125, (double)0.35f, 42.5, -61, 75, 1 };
+
+static size_t telemetry_tree(const telemetry *values, char *output, size_t size)
+{
+    cJSON *root = cJSON_CreateObject();
+    char *printed = NULL;
+    size_t length = 0;
+
+    cJSON_AddStringToObject(root, "deviceId", "device_esp32_001");
+    cJSON_AddNumberToObject(root, "temperature", values->temperature);
+    cJSON_AddNumberToObject(root, "humidity", values->humidity);
+    cJSON_AddNumberToObject(root, "pm1", values->pm1);
+    cJSON_AddNumberToObject(root, "pm25", values->pm25);
+    cJSON_AddNumberToObject(root, "pm10", values->pm10);
+    cJSON_AddNumberToObject(root, "voc", values->voc);
+    cJSON_AddNumberToObject(root, "soundLevel", values->sound_level);
+    cJSON_AddNumberToObject(root, "wifiRssi", values->wifi_rssi);
+    cJSON_AddStringToObject(root, "wifiSsid", "praan-office");
+    cJSON_AddNumberToObject(root, "fanSpeed", values->fan_speed);
+    cJSON_AddStringToObject(root, "powerState", values->power_state ? "ON" : "OFF");
+
+    printed = cJSON_PrintUnformatted(root);
+    if (printed != NULL)
+    {
+        length = strlen(printed);
+        if (length < size)
+        {
+            memcpy(output, printed, length + 1);
+        }
+        cJSON_free(printed);
+    }
+    cJSON_Delete(root);
+
+    return length;
+}
+
+static size_t telemetry_writer(const telemetry *values, char *output, size_t size)
+{
+    cJSON_Writer writer;
+
+    cJSON_InitWriter(&writer, output, size);
+    cJSON_WriterBeginObject(&writer);
+    cJSON_WriterKey(&writer, "deviceId");
+    cJSON_WriterString(&writer, "device_esp32_001");
+    cJSON_WriterKey(&writer, "temperature");
+    cJSON_WriterNumber(&writer, values->temperature);
+    cJSON_WriterKey(&writer, "humidity");
+    cJSON_WriterNumber(&writer, values->humidity);
+    cJSON_WriterKey(&writer, "pm1");
+    cJSON_WriterNumber(&writer, values->pm1);
+    cJSON_WriterKey(&writer, "pm25");
+    cJSON_WriterNumber(&writer, values->pm25);
+    cJSON_WriterKey(&writer, "pm10");
+    cJSON_WriterNumber(&writer, values->pm10);
+    cJSON_WriterKey(&writer, "voc");
+    cJSON_WriterNumber(&writer, values->voc);
+    cJSON_WriterKey(&writer, "soundLevel");
+    cJSON_WriterNumber(&writer, values->sound_level);
+    cJSON_WriterKey(&writer, "wifiRssi");
+    cJSON_WriterNumber(&writer, values->wifi_rssi);
+    cJSON_WriterKey(&writer, "wifiSsid");
+    cJSON_WriterString(&writer, "praan-office");
+    cJSON_WriterKey(&writer, "fanSpeed");
+    cJSON_WriterNumber(&writer, values->fan_speed);
+    cJSON_WriterKey(&writer, "powerState");
+    cJSON_WriterString(&writer, values->power_state ? "ON" : "OFF");
+    cJSON_WriterEndObject(&writer);
+
+    return cJSON_WriterLength(&writer);
+}
+
+static size_t ack_tree(const telemetry *values, char *output, size_t size)
+{
+    cJSON *root = cJSON_CreateObject();
+    char *printed = NULL;
+    size_t length = 0;
+
+    (void)values;
+    cJSON_AddStringToObject(root, "commandId", "6f1c2a9e-8d4b-4a57-9e2f-3b1d7c0a5e11");
+    cJSON_AddStringToObject(root, "status", "failed");
+    cJSON_AddStringToObject(root, "message", "Execution Failed");
+
+    printed = cJSON_PrintUnformatted(root);
+    if (printed != NULL)
+    {
+        length = strlen(printed);
+        if (length < size)
+        {
+            memcpy(output, printed, length + 1);
+        }
+        cJSON_free(printed);
+    }
+    cJSON_Delete(root);
+
+    return length;
+}
+
+static size_t ack_writer(const telemetry *values, char *output, size_t size)
+{
+    cJSON_Writer writer;
+
+    (void)values;
+    cJSON_InitWriter(&writer, output, size);
+    cJSON_WriterBeginObject(&writer);
+    cJSON_WriterKey(&writer, "commandId");
+    cJSON_WriterString(&writer, "6f1c2a9e-8d4b-4a57-9e2f-3b1d7c0a5e11");
+    cJSON_WriterKey(&writer, "status");
+    cJSON_WriterString(&writer, "failed");
+    cJSON_WriterKey(&writer, "message");
+    cJSON_WriterString(&writer, "Execution Failed");
+    cJSON_WriterEndObject(&writer);
+
+    return cJSON_WriterLength(&writer);
+}
+
+typedef size_t (*build_function)(const telemetry *values, char *output, size_t size);
+
+/* MB/s are bytes written */
+static void benchmark_build(const char *name, build_function build, const char *expected, unsigned long iterations)
+{
+    char output[512];
+    size_t length = 0;
+    unsigned long i = 0;
+    clock_t start;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        length = build(&sample, output, sizeof(output));
+        if (length == 0)
+        {
+            fprintf(stderr, "%s: failed\n", name);
+            exit(EXIT_FAILURE);
+        }
+    }
+    print_result(name, iterations, seconds_since(start), length);
+
+    if (strcmp(output, expected) != 0)
+    {
+        fprintf(stderr, "%s: unexpected output %s\n", name, output);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 200000);
+    char expected_telemetry[512];
+    char expected_ack[512];
+
+    /* the writer has to produce exactly what the tree prints */
+    if ((telemetry_tree(&sample, expected_telemetry, sizeof(expected_telemetry)) == 0)
+        || (ack_tree(&sample, expected_ack, sizeof(expected_ack)) == 0))
+    {
+        return EXIT_FAILURE;
+    }
+
+    use_counting_hooks();
+
+    benchmark_build("telemetry: tree + PrintUnformatted", telemetry_tree, expected_telemetry, iterations);
+    benchmark_build("telemetry: cJSON_Writer", telemetry_writer, expected_telemetry, iterations);
+    benchmark_build("ack: tree + PrintUnformatted", ack_tree, expected_ack, iterations);
+    benchmark_build("ack: cJSON_Writer", ack_writer, expected_ack, iterations);
+
+    cJSON_InitHooks(NULL);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* parse, print and minify throughput of string and whitespace heavy documents, build with and without ENABLE_CJSON_SIMD to compare */
+
+#define STRING_COUNT 2000
+
+/* an array of long log line like strings, escape_every > 0 puts an escape sequence in every so many characters */
+static char *create_string_array(size_t escape_every)
+{
+    const char text[] = "sensor pm25 reading above threshold on device_esp32_001, fan speed raised to 75 percent; ";
+    char *json = (char*)malloc(STRING_COUNT * 2100 + 3);
+    char *position = json;
+    unsigned long state = 12345;
+    size_t i = 0;
+    size_t j = 0;
+
+    if (json == NULL)
+    {
+        return NULL;
+    }
+
+    *position++ = '[';
+    for (i = 0; i < STRING_COUNT; i++)
+    {
+        size_t length = 0;
+
+        state = state * 1103515245UL + 12345UL;
+        length = 200 + (size_t)(state % 1800UL);
+
+        if (i > 0)
+        {
+            *position++ = ',';
+        }
+        *position++ = '\"';
+        for (j = 0; j < length; j++)
+        {
+            if ((escape_every > 0) && ((j % escape_every) == (escape_every - 1)))
+            {
+                *position++ = '\\';
+                *position++ = 'n';
+                j++;
+                continue;
+            }
+            *position++ = text[j % (sizeof(text) - 1)];
+        }
+        *position++ = '\"';
+    }
+    *position++ = ']';
+    *position = '\0';
+
+    return json;
+}
+
+static void benchmark_document(const char *name, const char *json, unsigned long iterations)
+{
+    char label[64];
+    size_t length = strlen(json) + 1;
+    size_t printed_length = 0;
+    char *printed = NULL;
+    cJSON *root = NULL;
+    unsigned long i = 0;
+    clock_t start;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        root = cJSON_ParseWithLength(json, length);
+        if (root == NULL)
+        {
+            fprintf(stderr, "%s: parse failed\n", name);
+            exit(EXIT_FAILURE);
+        }
+        cJSON_Delete(root);
+    }
+    sprintf(label, "%s: parse", name);
+    print_result(label, iterations, seconds_since(start), length);
+
+    root = cJSON_ParseWithLength(json, length);
+    printed_length = length * 2;
+    printed = (char*)malloc(printed_length);
+    if ((root == NULL) || (printed == NULL))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        if (!cJSON_PrintPreallocated(root, printed, (int)printed_length, 1))
+        {
+            fprintf(stderr, "%s: print failed\n", name);
+            exit(EXIT_FAILURE);
+        }
+    }
+    sprintf(label, "%s: print", name);
+    print_result(label, iterations, seconds_since(start), strlen(printed));
+
+    /* out of place, printed has room for the input */
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        if (cJSON_MinifyWithLength(json, length - 1, printed) == 0)
+        {
+            fprintf(stderr, "%s: minify failed\n", name);
+            exit(EXIT_FAILURE);
+        }
+    }
+    sprintf(label, "%s: minify", name);
+    print_result(label, iterations, seconds_since(start), length - 1);
+
+    free(printed);
+    cJSON_Delete(root);
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 50);
+    char *plain = create_string_array(0);
+    char *escaped = create_string_array(100);
+    char *batch = create_telemetry_batch(5000);
+    cJSON *batch_tree = NULL;
+    char *formatted = NULL;
+
+    if ((plain == NULL) || (escaped == NULL) || (batch == NULL))
+    {
+        return EXIT_FAILURE;
+    }
+
+    /* formatted output is mostly indentation */
+    batch_tree = cJSON_Parse(batch);
+    formatted = cJSON_Print(batch_tree);
+    cJSON_Delete(batch_tree);
+    if (formatted == NULL)
+    {
+        return EXIT_FAILURE;
+    }
+
+    use_counting_hooks();
+
+    benchmark_document("long strings", plain, iterations);
+    benchmark_document("strings with escapes", escaped, iterations);
+    benchmark_document("formatted telemetry", formatted, iterations);
+
+    cJSON_InitHooks(NULL);
+    free(formatted);
+    free(batch);
+    free(escaped);
+    free(plain);
+
+    return EXIT_SUCCESS;
+}
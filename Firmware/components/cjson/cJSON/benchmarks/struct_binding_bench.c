@@ -0,0 +1,298 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+
+/* the firmware's telemetry and command structs, written and read by hand with a tree and with field tables */
+
+typedef struct
+{
+    float temperature;
+    float humidity;
+    float pm1;
+    float pm25;
+    float pm10;
+    float voc;
+    float sound_level;
+    int wifi_rssi;
+} sensor_data;
+
+typedef struct
+{
+    char device_id[32];
+    unsigned char power_state;
+    unsigned char fan_speed;
+    sensor_data sensors;
+} device_state;
+
+typedef enum { set_fan_speed, power_on, power_off, unknown_command } command_type;
+
+typedef struct
+{
+    char command_id[64];
+    command_type type;
+    unsigned char fan_speed;
+} command;
+
+static const char * const power_state_names[] = { "OFF", "ON" };
+static const char * const command_type_names[] = { "SET_FAN_SPEED", "POWER_ON", "POWER_OFF" };
+
+static const cJSON_Field device_state_fields[] = {
+    cJSON_FIELD(cJSON_FieldString, "deviceId", device_state, device_id),
+    cJSON_FIELD(cJSON_FieldFloat, "temperature", device_state, sensors.temperature),
+    cJSON_FIELD(cJSON_FieldFloat, "humidity", device_state, sensors.humidity),
+    cJSON_FIELD(cJSON_FieldFloat, "pm1", device_state, sensors.pm1),
+    cJSON_FIELD(cJSON_FieldFloat, "pm25", device_state, sensors.pm25),
+    cJSON_FIELD(cJSON_FieldFloat, "pm10", device_state, sensors.pm10),
+    cJSON_FIELD(cJSON_FieldFloat, "voc", device_state, sensors.voc),
+    cJSON_FIELD(cJSON_FieldFloat, "soundLevel", device_state, sensors.sound_level),
+    cJSON_FIELD(cJSON_FieldInt, "wifiRssi", device_state, sensors.wifi_rssi),
+    cJSON_FIELD(cJSON_FieldUnsigned, "fanSpeed", device_state, fan_speed),
+    cJSON_ENUM_FIELD("powerState", device_state, power_state, power_state_names)
+};
+
+static const cJSON_Field command_fields[] = {
+    cJSON_FIELD(cJSON_FieldString, "commandId", command, command_id),
+    cJSON_ENUM_FIELD("commandType", command, type, command_type_names),
+    cJSON_OBJECT_FIELD("payload", 1),
+    cJSON_FIELD(cJSON_FieldUnsigned, "fanSpeed", command, fan_speed)
+};
+
+#define field_count(fields) (sizeof(fields) / sizeof((fields)[0]))
+
+static const device_state sample = { "device_esp32_001", 1, 75, { 24.5f, 48.25f, 8.5f, 12.75f, 20.125f, 0.35f, 42.5f, -61 } };
+
+static size_t write_tree(const device_state *state, char *output, size_t size)
+{
+    cJSON *root = cJSON_CreateObject();
+    size_t length = 0;
+
+    cJSON_AddStringToObject(root, "deviceId", state->device_id);
+    cJSON_AddNumberToObject(root, "temperature", state->sensors.temperature);
+    cJSON_AddNumberToObject(root, "humidity", state->sensors.humidity);
+    cJSON_AddNumberToObject(root, "pm1", state->sensors.pm1);
+    cJSON_AddNumberToObject(root, "pm25", state->sensors.pm25);
+    cJSON_AddNumberToObject(root, "pm10", state->sensors.pm10);
+    cJSON_AddNumberToObject(root, "voc", state->sensors.voc);
+    cJSON_AddNumberToObject(root, "soundLevel", state->sensors.sound_level);
+    cJSON_AddNumberToObject(root, "wifiRssi", state->sensors.wifi_rssi);
+    cJSON_AddNumberToObject(root, "fanSpeed", state->fan_speed);
+    cJSON_AddStringToObject(root, "powerState", state->power_state ? "ON" : "OFF");
+
+    if (cJSON_PrintPreallocated(root, output, (int)size, 0))
+    {
+        length = strlen(output);
+    }
+    cJSON_Delete(root);
+
+    return length;
+}
+
+static size_t write_fields(const device_state *state, char *output, size_t size)
+{
+    cJSON_Writer writer;
+
+    cJSON_InitWriter(&writer, output, size);
+    cJSON_WriterBeginObject(&writer);
+    cJSON_WriterFields(&writer, device_state_fields, field_count(device_state_fields), state);
+    cJSON_WriterEndObject(&writer);
+
+    return cJSON_WriterLength(&writer);
+}
+
+static void copy_string(char *destination, size_t size, const cJSON *item)
+{
+    if (cJSON_IsString(item))
+    {
+        strncpy(destination, item->valuestring, size - 1);
+        destination[size - 1] = '\0';
+    }
+}
+
+static int read_state_tree(const char *json, size_t length, device_state *state)
+{
+    cJSON *root = cJSON_ParseWithLength(json, length);
+    const cJSON *power = NULL;
+
+    if (root == NULL)
+    {
+        return 0;
+    }
+    copy_string(state->device_id, sizeof(state->device_id), cJSON_GetObjectItem(root, "deviceId"));
+    state->sensors.temperature = (float)cJSON_GetNumberValue(cJSON_GetObjectItem(root, "temperature"));
+    state->sensors.humidity = (float)cJSON_GetNumberValue(cJSON_GetObjectItem(root, "humidity"));
+    state->sensors.pm1 = (float)cJSON_GetNumberValue(cJSON_GetObjectItem(root, "pm1"));
+    state->sensors.pm25 = (float)cJSON_GetNumberValue(cJSON_GetObjectItem(root, "pm25"));
+    state->sensors.pm10 = (float)cJSON_GetNumberValue(cJSON_GetObjectItem(root, "pm10"));
+    state->sensors.voc = (float)cJSON_GetNumberValue(cJSON_GetObjectItem(root, "voc"));
+    state->sensors.sound_level = (float)cJSON_GetNumberValue(cJSON_GetObjectItem(root, "soundLevel"));
+    state->sensors.wifi_rssi = (int)cJSON_GetNumberValue(cJSON_GetObjectItem(root, "wifiRssi"));
+    state->fan_speed = (unsigned char)cJSON_GetNumberValue(cJSON_GetObjectItem(root, "fanSpeed"));
+    power = cJSON_GetObjectItem(root, "powerState");
+    state->power_state = (unsigned char)(cJSON_IsString(power) && (strcmp(power->valuestring, "ON") == 0));
+    cJSON_Delete(root);
+
+    return 1;
+}
+
+static int read_state_fields(const char *json, size_t length, device_state *state)
+{
+    cJSON_Binding binding;
+    char scratch[64];
+
+    cJSON_InitBinding(&binding, device_state_fields, field_count(device_state_fields), state);
+    return cJSON_ParseSAX(json, length, cJSON_GetBindingHandler(), &binding, scratch, sizeof(scratch));
+}
+
+static int read_command_tree(const char *json, size_t length, command *result)
+{
+    cJSON *root = cJSON_ParseWithLength(json, length);
+    const cJSON *type = NULL;
+    const cJSON *payload = NULL;
+    size_t index = 0;
+
+    if (root == NULL)
+    {
+        return 0;
+    }
+    copy_string(result->command_id, sizeof(result->command_id), cJSON_GetObjectItem(root, "commandId"));
+    type = cJSON_GetObjectItem(root, "commandType");
+    for (index = 0; cJSON_IsString(type) && (index < 3); index++)
+    {
+        if (strcmp(type->valuestring, command_type_names[index]) == 0)
+        {
+            break;
+        }
+    }
+    result->type = (command_type)index;
+    payload = cJSON_GetObjectItem(root, "payload");
+    if (payload != NULL)
+    {
+        result->fan_speed = (unsigned char)cJSON_GetNumberValue(cJSON_GetObjectItem(payload, "fanSpeed"));
+    }
+    cJSON_Delete(root);
+
+    return 1;
+}
+
+static int read_command_fields(const char *json, size_t length, command *result)
+{
+    cJSON_Binding binding;
+    char scratch[64];
+
+    cJSON_InitBinding(&binding, command_fields, field_count(command_fields), result);
+    return cJSON_ParseSAX(json, length, cJSON_GetBindingHandler(), &binding, scratch, sizeof(scratch));
+}
+
+static void benchmark_write(const char *name, size_t (*write)(const device_state*, char*, size_t), unsigned long iterations)
+{
+    char output[512];
+    size_t length = 0;
+    unsigned long i = 0;
+    clock_t start;
+
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        length = write(&sample, output, sizeof(output));
+        if (length == 0)
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+    print_result(name, iterations, seconds_since(start), length);
+}
+
+static void benchmark_read_state(const char *name, int (*read)(const char*, size_t, device_state*), const char *json, unsigned long iterations)
+{
+    device_state state;
+    unsigned long i = 0;
+    clock_t start;
+
+    memset(&state, '\0', sizeof(state));
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        if (!read(json, strlen(json), &state))
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+    print_result(name, iterations, seconds_since(start), strlen(json));
+
+    if ((state.fan_speed != sample.fan_speed) || (state.sensors.pm25 != sample.sensors.pm25) || (strcmp(state.device_id, sample.device_id) != 0))
+    {
+        fprintf(stderr, "%s: wrong values\n", name);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void benchmark_read_command(const char *name, int (*read)(const char*, size_t, command*), unsigned long iterations)
+{
+    command result;
+    unsigned long i = 0;
+    clock_t start;
+
+    memset(&result, '\0', sizeof(result));
+    reset_allocation_stats();
+    start = clock();
+    for (i = 0; i < iterations; i++)
+    {
+        if (!read(benchmark_command, strlen(benchmark_command), &result))
+        {
+            exit(EXIT_FAILURE);
+        }
+    }
+    print_result(name, iterations, seconds_since(start), strlen(benchmark_command));
+
+    if ((result.type != set_fan_speed) || (result.fan_speed != 75))
+    {
+        fprintf(stderr, "%s: wrong values\n", name);
+        exit(EXIT_FAILURE);
+    }
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 200000);
+    char json[512];
+
+    if (write_fields(&sample, json, sizeof(json)) == 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    use_counting_hooks();
+
+    benchmark_write("telemetry write: tree", write_tree, iterations);
+    benchmark_write("telemetry write: field table", write_fields, iterations);
+    benchmark_read_state("telemetry read: tree", read_state_tree, json, iterations);
+    benchmark_read_state("telemetry read: field table", read_state_fields, json, iterations);
+    benchmark_read_command("command read: tree", read_command_tree, iterations);
+    benchmark_read_command("command read: field table", read_command_fields, iterations);
+
+    cJSON_InitHooks(NULL);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,130 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include "common.h"
+#include "../cJSON_Utils.h"
+
+/* All or nothing patching of 10 KB and 1 MB documents: duplicating the document and patching the copy, which is what
+ * callers of cJSONUtils_ApplyPatches have to do, against cJSONUtils_ApplyPatchesTransactional, succeeding and failing */
+
+static cJSON *create_patches(size_t records, size_t operations, cJSON_bool failing)
+{
+    cJSON *patches = cJSON_CreateArray();
+    cJSON *value = NULL;
+    char path[64];
+    size_t i = 0;
+
+    for (i = 0; i < operations; i++)
+    {
+        /* spread over the document, alternating between replacing and adding members */
+        sprintf(path, "/%lu/%s", (unsigned long)((i * 7919) % records), ((i % 2) == 0) ? "fanSpeed" : "pm25");
+        value = cJSON_CreateNumber((double)i);
+        cJSONUtils_AddPatchToArray(patches, ((i % 2) == 0) ? "replace" : "add", path, value);
+        cJSON_Delete(value);
+    }
+    if (failing)
+    {
+        cJSONUtils_AddPatchToArray(patches, "remove", "/missing", NULL);
+    }
+
+    return patches;
+}
+
+static void benchmark_document(const char *name, size_t records, unsigned long iterations)
+{
+    static const size_t operation_counts[] = { 1, 10, 100 };
+    char *batch = create_telemetry_batch(records);
+    size_t length = strlen(batch);
+    cJSON *document = cJSON_Parse(batch);
+    char label[64];
+    size_t count = 0;
+    int failing = 0;
+
+    if (document == NULL)
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    for (failing = 0; failing <= 1; failing++)
+    {
+        for (count = 0; count < (sizeof(operation_counts) / sizeof(operation_counts[0])); count++)
+        {
+            cJSON *patches = create_patches(records, operation_counts[count], (cJSON_bool)failing);
+            unsigned long i = 0;
+            clock_t start;
+
+            reset_allocation_stats();
+            start = clock();
+            for (i = 0; i < iterations; i++)
+            {
+                cJSON *copy = cJSON_Duplicate(document, 1);
+                if ((cJSONUtils_ApplyPatchesCaseSensitive(copy, patches) == 0) != !failing)
+                {
+                    exit(EXIT_FAILURE);
+                }
+                if (failing)
+                {
+                    cJSON_Delete(copy);
+                }
+                else
+                {
+                    cJSON_Delete(document);
+                    document = copy;
+                }
+            }
+            sprintf(label, "%s %3lu ops%s: copy", name, (unsigned long)operation_counts[count], failing ? " failing" : "");
+            print_result(label, iterations, seconds_since(start), length);
+
+            reset_allocation_stats();
+            start = clock();
+            for (i = 0; i < iterations; i++)
+            {
+                if ((cJSONUtils_ApplyPatchesTransactionalCaseSensitive(document, patches) == 0) != !failing)
+                {
+                    exit(EXIT_FAILURE);
+                }
+            }
+            sprintf(label, "%s %3lu ops%s: undo log", name, (unsigned long)operation_counts[count], failing ? " failing" : "");
+            print_result(label, iterations, seconds_since(start), length);
+
+            cJSON_Delete(patches);
+        }
+    }
+
+    cJSON_Delete(document);
+    free(batch);
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    unsigned long iterations = iterations_from_arguments(argc, argv, 1000);
+
+    use_counting_hooks();
+
+    /* about 240 bytes per record */
+    benchmark_document("10 KB", 42, iterations);
+    benchmark_document("1 MB", 4300, iterations / 100 + 1);
+
+    cJSON_InitHooks(NULL);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,8622 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+/* cJSON */
+/* JSON parser in C. */
+
+/* disable warnings about old C89 functions in MSVC */
+#if !defined(_CRT_SECURE_NO_DEPRECATE) && defined(_MSC_VER)
+#define _CRT_SECURE_NO_DEPRECATE
+#endif
+
+#ifdef __GNUC__
+#pragma GCC visibility push(default)
+#endif
+#if defined(_MSC_VER)
+#pragma warning (push)
+/* disable warning about single line comments in system headers */
+#pragma warning (disable : 4001)
+#endif
+
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <float.h>
+#if !defined(_MSC_VER) || (_MSC_VER >= 1600)
+#include <stdint.h>
+#endif
+
+#ifdef ENABLE_LOCALES
+#include <locale.h>
+#endif
+
+#ifdef ENABLE_CJSON_SIMD
+#if defined(__AVX2__)
+#define CJSON_SIMD_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define CJSON_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#if (defined(CJSON_SIMD_AVX2) || defined(CJSON_SIMD_SSE2)) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER)
+#pragma warning (pop)
+#endif
+#ifdef __GNUC__
+#pragma GCC visibility pop
+#endif
+
+#include "cJSON.h"
+
+/* define our own boolean type */
+#ifdef true
+#undef true
+#endif
+#define true ((cJSON_bool)1)
+
+#ifdef false
+#undef false
+#endif
+#define false ((cJSON_bool)0)
+
+/* define isnan and isinf for ANSI C, if in C99 or above, isnan and isinf has been defined in math.h */
+#ifndef isinf
+#define isinf(d) (isnan((d - d)) && !isnan(d))
+#endif
+#ifndef isnan
+#define isnan(d) (d != d)
+#endif
+
+#ifndef NAN
+#ifdef _WIN32
+#define NAN sqrt(-1.0)
+#else
+#define NAN 0.0/0.0
+#endif
+#endif
+
+/* 64 bit arithmetic for the number formatter */
+#if defined(_MSC_VER) && (_MSC_VER < 1600)
+typedef unsigned __int64 cjson_uint64;
+#else
+typedef uint64_t cjson_uint64;
+#endif
+/* ANSI C has no 64 bit literals, so constants are put together from two halves */
+#define cjson_uint64_constant(high, low) ((((cjson_uint64)(high)) << 32) | (cjson_uint64)(low))
+
+typedef struct {
+    const unsigned char *json;
+    size_t position;
+} error;
+static error global_error = { NULL, 0 };
+
+CJSON_PUBLIC(const char *) cJSON_GetErrorPtr(void)
+{
+    return (const char*) (global_error.json + global_error.position);
+}
+
+CJSON_PUBLIC(char *) cJSON_GetStringValue(const cJSON * const item)
+{
+    if (!cJSON_IsString(item))
+    {
+        return NULL;
+    }
+
+    return item->valuestring;
+}
+
+CJSON_PUBLIC(double) cJSON_GetNumberValue(const cJSON * const item)
+{
+    if (!cJSON_IsNumber(item))
+    {
+        return (double) NAN;
+    }
+
+    return item->valuedouble;
+}
+
+/* This is a safeguard to prevent copy-pasters from using incompatible C and header files */
+#if (CJSON_VERSION_MAJOR != 1) || (CJSON_VERSION_MINOR != 7) || (CJSON_VERSION_PATCH != 19)
+    #error cJSON.h and cJSON.c have different versions. Make sure that both have the same.
+#endif
+
+CJSON_PUBLIC(const char*) cJSON_Version(void)
+{
+    static char version[15];
+    sprintf(version, "%i.%i.%i", CJSON_VERSION_MAJOR, CJSON_VERSION_MINOR, CJSON_VERSION_PATCH);
+
+    return version;
+}
+
+/* ASCII case folding, which is what tolower does in the "C" locale, without a function call per byte */
+static const unsigned char lowercase[256] =
+{
+      0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,  15,
+     16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,  31,
+     32,  33,  34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,
+     48,  49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,
+     64,  97,  98,  99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111,
+    112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122,  91,  92,  93,  94,  95,
+     96,  97,  98,  99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111,
+    112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127,
+    128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143,
+    144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159,
+    160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175,
+    176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191,
+    192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207,
+    208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223,
+    224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239,
+    240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254, 255
+};
+
+/* Case insensitive string comparison, doesn't consider two NULL pointers equal though */
+static int case_insensitive_strcmp(const unsigned char *string1, const unsigned char *string2)
+{
+    if ((string1 == NULL) || (string2 == NULL))
+    {
+        return 1;
+    }
+
+    if (string1 == string2)
+    {
+        return 0;
+    }
+
+    /* keys almost always match with the same case, which doesn't need the table */
+    for(; (*string1 == *string2) || (lowercase[*string1] == lowercase[*string2]); (void)string1++, string2++)
+    {
+        if (*string1 == '\0')
+        {
+            return 0;
+        }
+    }
+
+    return lowercase[*string1] - lowercase[*string2];
+}
+
+typedef struct internal_hooks
+{
+    void *(CJSON_CDECL *allocate)(size_t size);
+    void (CJSON_CDECL *deallocate)(void *pointer);
+    void *(CJSON_CDECL *reallocate)(void *pointer, size_t size);
+} internal_hooks;
+
+#if defined(_MSC_VER)
+/* work around MSVC error C2322: '...' address of dllimport '...' is not static */
+static void * CJSON_CDECL internal_malloc(size_t size)
+{
+    return malloc(size);
+}
+static void CJSON_CDECL internal_free(void *pointer)
+{
+    free(pointer);
+}
+static void * CJSON_CDECL internal_realloc(void *pointer, size_t size)
+{
+    return realloc(pointer, size);
+}
+#else
+#define internal_malloc malloc
+#define internal_free free
+#define internal_realloc realloc
+#endif
+
+/* strlen of character literals resolved at compile time */
+#define static_strlen(string_literal) (sizeof(string_literal) - sizeof(""))
+
+static internal_hooks global_hooks = { internal_malloc, internal_free, internal_realloc };
+
+static unsigned char* cJSON_strdup(const unsigned char* string, const internal_hooks * const hooks)
+{
+    size_t length = 0;
+    unsigned char *copy = NULL;
+
+    if (string == NULL)
+    {
+        return NULL;
+    }
+
+    length = strlen((const char*)string) + sizeof("");
+    copy = (unsigned char*)hooks->allocate(length);
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+    memcpy(copy, string, length);
+
+    return copy;
+}
+
+static void pool_destroy(void);
+
+CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
+{
+    /* the slabs are released with the hooks they were allocated with */
+    pool_destroy();
+
+    if (hooks == NULL)
+    {
+        /* Reset hooks */
+        global_hooks.allocate = malloc;
+        global_hooks.deallocate = free;
+        global_hooks.reallocate = realloc;
+        return;
+    }
+
+    global_hooks.allocate = malloc;
+    if (hooks->malloc_fn != NULL)
+    {
+        global_hooks.allocate = hooks->malloc_fn;
+    }
+
+    global_hooks.deallocate = free;
+    if (hooks->free_fn != NULL)
+    {
+        global_hooks.deallocate = hooks->free_fn;
+    }
+
+    /* use realloc only if both free and malloc are used */
+    global_hooks.reallocate = NULL;
+    if ((global_hooks.allocate == malloc) && (global_hooks.deallocate == free))
+    {
+        global_hooks.reallocate = realloc;
+    }
+}
+
+/* Node pool: cJSON structs are carved out of slabs and recycled through free lists linked by their next pointer.
+ * Hosted platforms put a small per thread cache in front of the shared free list, so that most allocations and
+ * frees don't need the lock. FreeRTOS (and platforms without thread local storage) always use the shared list. */
+#if !defined(CJSON_POOL_NO_THREAD_CACHE) && !defined(ESP_PLATFORM)
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define CJSON_POOL_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define CJSON_POOL_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define CJSON_POOL_THREAD_LOCAL __declspec(thread)
+#endif
+#endif
+
+typedef struct
+{
+    size_t nodes_per_slab; /* 0 if the pool is off */
+    void (CJSON_CDECL *lock)(void *context);
+    void (CJSON_CDECL *unlock)(void *context);
+    void *lock_context;
+    cJSON *slabs; /* the first node of every slab links the slabs */
+    cJSON *free_list;
+    unsigned long generation; /* changes whenever the pool is torn down */
+    cJSON_PoolStats stats; /* in_use can wrap around while frees are counted before the allocations of another thread */
+} node_pool;
+
+static node_pool global_pool;
+
+/* nodes of a new slab have prev set to NULL, nodes on a free list point to themselves once they have been used */
+static cJSON_bool pool_node_is_new(const cJSON * const node)
+{
+    return node->prev == NULL;
+}
+
+/* the nodes in use, 0 while frees of other threads are ahead of their allocations. Called with the lock held. */
+static size_t pool_nodes_in_use(void)
+{
+    return (global_pool.stats.in_use > (((size_t)-1) / 2)) ? 0 : global_pool.stats.in_use;
+}
+
+/* count nodes handed out (allocated), given back (freed) and the most that were out at once since the last count
+ * (peak, relative to in_use). Called with the lock held. */
+static void pool_count(const size_t hits, const size_t misses, const size_t allocated, const size_t freed, const size_t peak)
+{
+    if ((pool_nodes_in_use() + peak) > global_pool.stats.high_water)
+    {
+        global_pool.stats.high_water = pool_nodes_in_use() + peak;
+    }
+    global_pool.stats.hits += hits;
+    global_pool.stats.misses += misses;
+    global_pool.stats.in_use = (global_pool.stats.in_use + allocated) - freed;
+}
+
+#ifdef CJSON_POOL_THREAD_LOCAL
+/* nodes moved between a thread cache and the shared free list at once */
+#define CJSON_POOL_CACHE_SIZE 32
+
+typedef struct
+{
+    cJSON *free_list;
+    size_t free_count;
+    /* not yet added to the pool statistics */
+    size_t hits;
+    size_t misses;
+    size_t allocated;
+    size_t freed;
+    size_t peak; /* the most allocated - freed */
+    unsigned long generation; /* of the pool the cached nodes belong to */
+} pool_cache;
+
+static CJSON_POOL_THREAD_LOCAL pool_cache thread_pool_cache;
+
+/* the cache of the calling thread, emptied if it belongs to a pool that has been torn down since */
+static pool_cache *get_pool_cache(void)
+{
+    pool_cache *cache = &thread_pool_cache;
+
+    if (cache->generation != global_pool.generation)
+    {
+        memset(cache, '\0', sizeof(pool_cache));
+        cache->generation = global_pool.generation;
+    }
+
+    return cache;
+}
+
+/* add the counts of the calling thread to the pool statistics. Called with the lock held. */
+static void pool_count_cache(pool_cache * const cache)
+{
+    pool_count(cache->hits, cache->misses, cache->allocated, cache->freed, cache->peak);
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->allocated = 0;
+    cache->freed = 0;
+    cache->peak = 0;
+}
+#endif
+
+static void pool_lock(void)
+{
+    if (global_pool.lock != NULL)
+    {
+        global_pool.lock(global_pool.lock_context);
+    }
+}
+
+static void pool_unlock(void)
+{
+    if (global_pool.unlock != NULL)
+    {
+        global_pool.unlock(global_pool.lock_context);
+    }
+}
+
+/* free all slabs and turn the pool off */
+static void pool_destroy(void)
+{
+    cJSON *slab = global_pool.slabs;
+    cJSON *next = NULL;
+    unsigned long generation = global_pool.generation + 1;
+
+    while (slab != NULL)
+    {
+        next = slab->next;
+        global_hooks.deallocate(slab);
+        slab = next;
+    }
+
+    memset(&global_pool, '\0', sizeof(global_pool));
+    global_pool.generation = generation;
+}
+
+/* take up to count nodes from the shared free list, adding a slab if it is empty. Called with the lock held. */
+static cJSON *pool_take(const size_t count, size_t * const taken)
+{
+    cJSON *first = NULL;
+    cJSON *last = NULL;
+    size_t i = 0;
+
+    if (global_pool.free_list == NULL)
+    {
+        /* the first node of a slab is its header, the others are handed out */
+        cJSON *slab = (cJSON*)global_hooks.allocate((global_pool.nodes_per_slab + 1) * sizeof(cJSON));
+        if (slab == NULL)
+        {
+            return NULL;
+        }
+        for (i = 1; i < global_pool.nodes_per_slab; i++)
+        {
+            slab[i].next = &slab[i + 1];
+            slab[i].prev = NULL;
+        }
+        slab[global_pool.nodes_per_slab].next = NULL;
+        slab[global_pool.nodes_per_slab].prev = NULL;
+        slab->next = global_pool.slabs;
+        global_pool.slabs = slab;
+        global_pool.free_list = &slab[1];
+        global_pool.stats.slabs++;
+    }
+
+    first = global_pool.free_list;
+    last = first;
+    for (i = 1; (i < count) && (last->next != NULL); i++)
+    {
+        last = last->next;
+    }
+    global_pool.free_list = last->next;
+    last->next = NULL;
+
+    *taken = i;
+    return first;
+}
+
+/* return the nodes from first to last to the shared free list. Called with the lock held. */
+static void pool_give(cJSON * const first, cJSON * const last)
+{
+    last->next = global_pool.free_list;
+    global_pool.free_list = first;
+}
+
+static cJSON *pool_allocate(void)
+{
+    cJSON *node = NULL;
+#ifdef CJSON_POOL_THREAD_LOCAL
+    pool_cache *cache = get_pool_cache();
+
+    if (cache->free_list == NULL)
+    {
+        pool_lock();
+        cache->free_list = pool_take(CJSON_POOL_CACHE_SIZE, &cache->free_count);
+        pool_count_cache(cache);
+        pool_unlock();
+        if (cache->free_list == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    node = cache->free_list;
+    cache->free_list = node->next;
+    cache->free_count--;
+    if (pool_node_is_new(node))
+    {
+        cache->misses++;
+    }
+    else
+    {
+        cache->hits++;
+    }
+    cache->allocated++;
+    if ((cache->allocated > cache->freed) && ((cache->allocated - cache->freed) > cache->peak))
+    {
+        cache->peak = cache->allocated - cache->freed;
+    }
+#else
+    size_t taken = 0;
+
+    pool_lock();
+    node = pool_take(1, &taken);
+    if (node != NULL)
+    {
+        pool_count(pool_node_is_new(node) ? 0 : 1, pool_node_is_new(node) ? 1 : 0, 1, 0, 1);
+    }
+    pool_unlock();
+#endif
+
+    return node;
+}
+
+static void pool_deallocate(cJSON * const node)
+{
+#ifdef CJSON_POOL_THREAD_LOCAL
+    pool_cache *cache = get_pool_cache();
+    cJSON *first = NULL;
+    cJSON *last = NULL;
+    size_t i = 0;
+
+    node->prev = node;
+    node->next = cache->free_list;
+    cache->free_list = node;
+    cache->free_count++;
+    cache->freed++;
+    if (cache->free_count <= (2 * CJSON_POOL_CACHE_SIZE))
+    {
+        return;
+    }
+
+    /* give a batch back, so that nodes freed by a different thread than the one that created them circulate */
+    first = cache->free_list;
+    last = first;
+    for (i = 1; i < CJSON_POOL_CACHE_SIZE; i++)
+    {
+        last = last->next;
+    }
+    cache->free_list = last->next;
+    cache->free_count -= CJSON_POOL_CACHE_SIZE;
+
+    pool_lock();
+    pool_give(first, last);
+    pool_count_cache(cache);
+    pool_unlock();
+#else
+    node->prev = node;
+    pool_lock();
+    pool_give(node, node);
+    pool_count(0, 0, 0, 1, 0);
+    pool_unlock();
+#endif
+}
+
+CJSON_PUBLIC(void) cJSON_ReleasePoolCache(void)
+{
+#ifdef CJSON_POOL_THREAD_LOCAL
+    pool_cache *cache = get_pool_cache();
+    cJSON *last = cache->free_list;
+
+    pool_lock();
+    if (last != NULL)
+    {
+        while (last->next != NULL)
+        {
+            last = last->next;
+        }
+        pool_give(cache->free_list, last);
+    }
+    pool_count_cache(cache);
+    pool_unlock();
+
+    cache->free_list = NULL;
+    cache->free_count = 0;
+#endif
+}
+
+CJSON_PUBLIC(void) cJSON_GetPoolStats(cJSON_PoolStats * const stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    pool_lock();
+#ifdef CJSON_POOL_THREAD_LOCAL
+    pool_count_cache(get_pool_cache());
+#endif
+    *stats = global_pool.stats;
+    stats->in_use = pool_nodes_in_use();
+    pool_unlock();
+}
+
+CJSON_PUBLIC(void) cJSON_InitHooksWithPool(cJSON_Hooks* hooks, const cJSON_PoolConfig * const pool)
+{
+    cJSON_InitHooks(hooks);
+
+    if ((pool == NULL) || (pool->nodes_per_slab == 0))
+    {
+        return;
+    }
+
+    global_pool.nodes_per_slab = pool->nodes_per_slab;
+    global_pool.lock = pool->lock;
+    global_pool.unlock = pool->unlock;
+    global_pool.lock_context = pool->lock_context;
+}
+
+/* Internal constructor. */
+static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
+{
+    cJSON* node = (global_pool.nodes_per_slab > 0) ? pool_allocate() : (cJSON*)hooks->allocate(sizeof(cJSON));
+    if (node)
+    {
+        memset(node, '\0', sizeof(cJSON));
+    }
+
+    return node;
+}
+
+/* Delete a cJSON structure. */
+CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
+{
+    cJSON *next = NULL;
+    while (item != NULL)
+    {
+        next = item->next;
+        if (!(item->type & cJSON_IsReference) && (item->child != NULL))
+        {
+            cJSON_Delete(item->child);
+        }
+        if (!(item->type & (cJSON_IsReference | cJSON_ValuestringIsConst)) && (item->valuestring != NULL))
+        {
+            global_hooks.deallocate(item->valuestring);
+            item->valuestring = NULL;
+        }
+        if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
+        {
+            global_hooks.deallocate(item->string);
+            item->string = NULL;
+        }
+#ifdef ENABLE_CJSON_INDEX
+        if (item->index != NULL)
+        {
+            global_hooks.deallocate(item->index);
+            item->index = NULL;
+        }
+#endif
+        if (item->type & cJSON_ItemInArena)
+        {
+            /* released with the arena */
+        }
+        else if (global_pool.nodes_per_slab > 0)
+        {
+            pool_deallocate(item);
+        }
+        else
+        {
+            global_hooks.deallocate(item);
+        }
+        item = next;
+    }
+}
+
+/* get the decimal point character of the current locale */
+static unsigned char get_decimal_point(void)
+{
+#ifdef ENABLE_LOCALES
+    struct lconv *lconv = localeconv();
+    return (unsigned char) lconv->decimal_point[0];
+#else
+    return '.';
+#endif
+}
+
+typedef struct
+{
+    const unsigned char *content;
+    size_t length;
+    size_t offset;
+    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
+    internal_hooks hooks;
+    cJSON_Arena *arena; /* if not NULL, items and strings are placed in the arena instead of using the hooks */
+    int item_flags; /* ownership flags every parsed item is created with */
+    cJSON_bool in_situ; /* strings are unescaped inside of content, which is writable in this case */
+    cJSON_KeyTable *key_table; /* if not NULL, object keys are shared through it */
+    size_t nesting_limit; /* arrays and objects nested deeper are rejected, at most CJSON_NESTING_LIMIT */
+} parse_buffer;
+
+/* check if the given size is left to read in a given parse buffer (starting with 1) */
+#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
+/* check if the buffer can be accessed at the given index (starting with 0) */
+#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
+#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
+/* get a pointer to the buffer at the position */
+#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
+/* set the type of a parsed item without losing the ownership flags it was created with */
+#define set_parsed_type(item, parsed_type) ((item)->type = ((item)->type & ~0xFF) | (parsed_type))
+
+/* every arena allocation is rounded up to this so that the next one is aligned for any cJSON member */
+typedef union
+{
+    double number;
+    void *pointer;
+    size_t size;
+} arena_alignment;
+
+#define arena_round_up(size) ((((size) + sizeof(arena_alignment) - 1) / sizeof(arena_alignment)) * sizeof(arena_alignment))
+
+CJSON_PUBLIC(void) cJSON_InitArena(cJSON_Arena * const arena, void *memory, size_t size)
+{
+    size_t misalignment = 0;
+
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    arena->memory = NULL;
+    arena->size = 0;
+    arena->used = 0;
+    if (memory == NULL)
+    {
+        return;
+    }
+
+    /* skip the start of the block if it isn't aligned */
+    misalignment = (size_t)memory % sizeof(arena_alignment);
+    if (misalignment != 0)
+    {
+        misalignment = sizeof(arena_alignment) - misalignment;
+        if (misalignment >= size)
+        {
+            return;
+        }
+    }
+
+    arena->memory = (unsigned char*)memory + misalignment;
+    arena->size = size - misalignment;
+}
+
+CJSON_PUBLIC(void) cJSON_ResetArena(cJSON_Arena * const arena)
+{
+    if (arena != NULL)
+    {
+        arena->used = 0;
+    }
+}
+
+static void *arena_allocate(cJSON_Arena * const arena, size_t size)
+{
+    unsigned char *allocation = NULL;
+
+    if ((arena->memory == NULL) || (size > arena->size))
+    {
+        return NULL;
+    }
+
+    size = arena_round_up(size);
+    if (size > (arena->size - arena->used))
+    {
+        return NULL; /* arena exhausted */
+    }
+
+    allocation = arena->memory + arena->used;
+    arena->used += size;
+
+    return allocation;
+}
+
+/* the parser only ever frees its most recent allocation, so releasing rolls the arena back to that point */
+static void arena_release(cJSON_Arena * const arena, void *pointer)
+{
+    const unsigned char *allocation = (const unsigned char*)pointer;
+
+    if ((allocation >= arena->memory) && (allocation < (arena->memory + arena->used)))
+    {
+        arena->used = (size_t)(allocation - arena->memory);
+    }
+}
+
+static void *parse_allocate(parse_buffer * const input_buffer, size_t size)
+{
+    if (input_buffer->arena != NULL)
+    {
+        return arena_allocate(input_buffer->arena, size);
+    }
+
+    return input_buffer->hooks.allocate(size);
+}
+
+static void parse_deallocate(parse_buffer * const input_buffer, void *pointer)
+{
+    if (input_buffer->arena != NULL)
+    {
+        arena_release(input_buffer->arena, pointer);
+        return;
+    }
+
+    input_buffer->hooks.deallocate(pointer);
+}
+
+/* create an item for the parser, tagged with the ownership flags of the current parse */
+static cJSON *parse_new_item(parse_buffer * const input_buffer)
+{
+    cJSON *item = NULL;
+
+    if (input_buffer->arena != NULL)
+    {
+        item = (cJSON*)arena_allocate(input_buffer->arena, sizeof(cJSON));
+        if (item != NULL)
+        {
+            memset(item, '\0', sizeof(cJSON));
+        }
+    }
+    else
+    {
+        item = cJSON_New_Item(&input_buffer->hooks);
+    }
+
+    if (item != NULL)
+    {
+        item->type = input_buffer->item_flags;
+    }
+
+    return item;
+}
+
+/* An interned key, hash and length are kept to rule out most other keys without comparing them. */
+typedef struct
+{
+    char *string;
+    size_t length;
+    size_t hash;
+} interned_key;
+
+/* Open addressing with linear probing, keys are never removed. */
+struct cJSON_KeyTable
+{
+    internal_hooks hooks; /* the hooks at creation, they allocate the keys and free them again */
+    size_t count;
+    size_t capacity; /* number of slots, a power of two */
+    size_t max_keys;
+    interned_key *slots;
+};
+
+#define key_table_initial_capacity 16
+
+CJSON_PUBLIC(cJSON_KeyTable *) cJSON_CreateKeyTable(size_t max_keys)
+{
+    cJSON_KeyTable *table = (cJSON_KeyTable*)global_hooks.allocate(sizeof(cJSON_KeyTable));
+    if (table == NULL)
+    {
+        return NULL;
+    }
+
+    table->hooks = global_hooks;
+    table->count = 0;
+    table->capacity = key_table_initial_capacity;
+    table->max_keys = max_keys;
+    table->slots = (interned_key*)table->hooks.allocate(table->capacity * sizeof(interned_key));
+    if (table->slots == NULL)
+    {
+        table->hooks.deallocate(table);
+        return NULL;
+    }
+    memset(table->slots, '\0', table->capacity * sizeof(interned_key));
+
+    return table;
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteKeyTable(cJSON_KeyTable *table)
+{
+    size_t slot = 0;
+
+    if (table == NULL)
+    {
+        return;
+    }
+
+    for (slot = 0; slot < table->capacity; slot++)
+    {
+        if (table->slots[slot].string != NULL)
+        {
+            table->hooks.deallocate(table->slots[slot].string);
+        }
+    }
+    table->hooks.deallocate(table->slots);
+    table->hooks.deallocate(table);
+}
+
+CJSON_PUBLIC(size_t) cJSON_GetKeyTableSize(const cJSON_KeyTable * const table)
+{
+    return (table != NULL) ? table->count : 0;
+}
+
+/* FNV-1a, case sensitive unlike hash_key */
+static size_t hash_bytes(const unsigned char *bytes, size_t length)
+{
+    unsigned long hash = 2166136261UL;
+
+    for (; length > 0; bytes++, length--)
+    {
+        hash ^= (unsigned long)*bytes;
+        hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
+    }
+
+    return (size_t)hash;
+}
+
+/* double the slots once they are half full */
+static cJSON_bool grow_key_table(cJSON_KeyTable * const table)
+{
+    size_t capacity = table->capacity * 2;
+    interned_key *slots = NULL;
+    size_t old_slot = 0;
+    size_t slot = 0;
+
+    if (capacity < table->capacity)
+    {
+        return false; /* overflow */
+    }
+
+    slots = (interned_key*)table->hooks.allocate(capacity * sizeof(interned_key));
+    if (slots == NULL)
+    {
+        return false;
+    }
+    memset(slots, '\0', capacity * sizeof(interned_key));
+
+    for (old_slot = 0; old_slot < table->capacity; old_slot++)
+    {
+        if (table->slots[old_slot].string == NULL)
+        {
+            continue;
+        }
+
+        slot = table->slots[old_slot].hash & (capacity - 1);
+        while (slots[slot].string != NULL)
+        {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        slots[slot] = table->slots[old_slot];
+    }
+
+    table->hooks.deallocate(table->slots);
+    table->slots = slots;
+    table->capacity = capacity;
+
+    return true;
+}
+
+/* A key is looked for at most this many slots after its hash slot. Crafted keys with colliding hashes would
+ * otherwise make interning quadratic, past the limit they are allocated per member instead. */
+#define key_table_max_probes 32
+
+/* The slot that holds the key or the free slot it goes to, NULL if neither is within key_table_max_probes. */
+static interned_key *find_key_slot(const cJSON_KeyTable * const table, const unsigned char * const key, const size_t length, const size_t hash)
+{
+    size_t slot = hash & (table->capacity - 1);
+    size_t probes = 0;
+    interned_key *entry = NULL;
+
+    for (probes = 0; probes < key_table_max_probes; probes++, slot = (slot + 1) & (table->capacity - 1))
+    {
+        entry = &table->slots[slot];
+        if ((entry->string == NULL)
+            || ((entry->hash == hash) && (entry->length == length) && (memcmp(entry->string, key, length) == 0)))
+        {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/* The shared copy of the length bytes at key, which is added if it isn't in the table yet.
+ * Returns NULL if the table is full, the key collides too often or out of memory. */
+static char *intern_key(cJSON_KeyTable * const table, const unsigned char * const key, const size_t length)
+{
+    size_t hash = hash_bytes(key, length);
+    interned_key *entry = find_key_slot(table, key, length, hash);
+
+    if ((entry == NULL) || (entry->string != NULL))
+    {
+        return (entry != NULL) ? entry->string : NULL;
+    }
+
+    if ((table->max_keys != 0) && (table->count >= table->max_keys))
+    {
+        return NULL;
+    }
+
+    if (((table->count + 1) * 2) > table->capacity)
+    {
+        if (!grow_key_table(table))
+        {
+            return NULL;
+        }
+        entry = find_key_slot(table, key, length, hash);
+        if (entry == NULL)
+        {
+            return NULL;
+        }
+    }
+
+    entry->string = (char*)table->hooks.allocate(length + sizeof(""));
+    if (entry->string == NULL)
+    {
+        return NULL;
+    }
+    memcpy(entry->string, key, length);
+    entry->string[length] = '\0';
+    entry->length = length;
+    entry->hash = hash;
+    table->count++;
+
+    return entry->string;
+}
+
+/* A number literal as strtod would read it, split into a decimal mantissa and exponent. */
+typedef struct
+{
+    cjson_uint64 mantissa; /* the first 19 significant digits */
+    int exponent; /* value = mantissa * 10^exponent */
+    size_t length; /* number of characters that belong to the literal */
+    cJSON_bool negative;
+    cJSON_bool is_integer; /* neither a fraction nor an exponent */
+    cJSON_bool truncated; /* there were more significant digits than fit into mantissa */
+} number_literal;
+
+/* Doubles evaluated in higher precision (x87) round twice, which breaks the exactness of the fast path. */
+#if (defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD != 0)) || (defined(__FLT_EVAL_METHOD__) && (__FLT_EVAL_METHOD__ != 0))
+#define CJSON_NO_FAST_NUMBER_PATH
+#endif
+
+#ifndef CJSON_NO_FAST_NUMBER_PATH
+/* all powers of ten that are exactly representable as a double */
+static const double exact_powers_of_ten[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#endif
+
+/* add one more digit of the integral or fractional part to the literal */
+static void accumulate_digit(number_literal * const literal, int * const significant_digits, const unsigned char digit, const cJSON_bool is_fraction)
+{
+    if ((literal->mantissa == 0) && (digit == '0'))
+    {
+        /* leading zeros are not significant */
+        if (is_fraction)
+        {
+            literal->exponent--;
+        }
+        return;
+    }
+
+    if (*significant_digits < 19)
+    {
+        literal->mantissa = literal->mantissa * 10 + (cjson_uint64)(digit - '0');
+        (*significant_digits)++;
+        if (is_fraction)
+        {
+            literal->exponent--;
+        }
+        return;
+    }
+
+    /* the rest only counts as far as the magnitude is concerned */
+    literal->truncated = true;
+    if (!is_fraction && (literal->exponent < 100000))
+    {
+        literal->exponent++;
+    }
+}
+
+/* Read the number at the current offset without converting it, accepting exactly what strtod accepts
+ * with the characters cJSON allows in numbers. Returns false if there is no number. */
+static cJSON_bool scan_number(const parse_buffer * const input_buffer, number_literal * const literal)
+{
+    const unsigned char *number = buffer_at_offset(input_buffer);
+    const size_t available = input_buffer->length - input_buffer->offset;
+    cJSON_bool has_digits = false;
+    int significant_digits = 0;
+    size_t i = 0;
+
+    memset(literal, '\0', sizeof(*literal));
+    literal->is_integer = true;
+
+    if ((i < available) && ((number[i] == '-') || (number[i] == '+')))
+    {
+        literal->negative = (number[i] == '-');
+        i++;
+    }
+
+    for (; (i < available) && (number[i] >= '0') && (number[i] <= '9'); i++)
+    {
+        accumulate_digit(literal, &significant_digits, number[i], false);
+        has_digits = true;
+    }
+
+    if ((i < available) && (number[i] == '.'))
+    {
+        literal->is_integer = false;
+        for (i++; (i < available) && (number[i] >= '0') && (number[i] <= '9'); i++)
+        {
+            accumulate_digit(literal, &significant_digits, number[i], true);
+            has_digits = true;
+        }
+    }
+
+    if (!has_digits)
+    {
+        return false;
+    }
+
+    /* the exponent only belongs to the number if at least one digit follows */
+    if ((i < available) && ((number[i] == 'e') || (number[i] == 'E')))
+    {
+        size_t exponent_end = i + 1;
+        cJSON_bool negative_exponent = false;
+        int exponent = 0;
+
+        if ((exponent_end < available) && ((number[exponent_end] == '-') || (number[exponent_end] == '+')))
+        {
+            negative_exponent = (number[exponent_end] == '-');
+            exponent_end++;
+        }
+
+        if ((exponent_end < available) && (number[exponent_end] >= '0') && (number[exponent_end] <= '9'))
+        {
+            for (; (exponent_end < available) && (number[exponent_end] >= '0') && (number[exponent_end] <= '9'); exponent_end++)
+            {
+                /* anything this large over- or underflows anyway */
+                if (exponent < 100000)
+                {
+                    exponent = exponent * 10 + (number[exponent_end] - '0');
+                }
+            }
+
+            literal->exponent += negative_exponent ? -exponent : exponent;
+            literal->is_integer = false;
+            i = exponent_end;
+        }
+    }
+
+    literal->length = i;
+
+    return true;
+}
+
+/* Convert with strtod, for literals the fast path can't do exactly. */
+static cJSON_bool parse_number_slow(parse_buffer * const input_buffer, const size_t length, double * const number)
+{
+    unsigned char stack_buffer[64];
+    unsigned char *number_c_string = stack_buffer;
+    unsigned char *after_end = NULL;
+    unsigned char decimal_point = get_decimal_point();
+    cJSON_bool success = false;
+    size_t i = 0;
+
+    if (length >= sizeof(stack_buffer))
+    {
+        /* only absurdly long numbers end up here */
+        number_c_string = (unsigned char *) parse_allocate(input_buffer, length + 1);
+        if (number_c_string == NULL)
+        {
+            return false; /* allocation failure */
+        }
+    }
+
+    /* copy the number and replace '.' with the decimal point of the current locale (for strtod)
+     * This also takes care of '\0' not necessarily being available for marking the end of the input */
+    for (i = 0; i < length; i++)
+    {
+        number_c_string[i] = (buffer_at_offset(input_buffer)[i] == '.') ? decimal_point : buffer_at_offset(input_buffer)[i];
+    }
+    number_c_string[length] = '\0';
+
+    *number = strtod((const char*)number_c_string, (char**)&after_end);
+    success = (after_end == (number_c_string + length));
+
+    if (number_c_string != stack_buffer)
+    {
+        parse_deallocate(input_buffer, number_c_string);
+    }
+
+    return success;
+}
+
+/* Parse the input text to generate a number, and populate the result into item. */
+static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
+{
+    number_literal literal;
+    double number = 0;
+
+    if ((input_buffer == NULL) || (input_buffer->content == NULL) || cannot_access_at_index(input_buffer, 0))
+    {
+        return false;
+    }
+
+    if (!scan_number(input_buffer, &literal))
+    {
+        return false; /* parse_error */
+    }
+
+    if (literal.mantissa == 0)
+    {
+        number = literal.negative ? -0.0 : 0.0;
+    }
+#ifndef CJSON_NO_FAST_NUMBER_PATH
+    /* Clinger's fast path: both the mantissa and the power of ten are exact doubles, so one correctly rounded
+     * multiplication or division gives the correctly rounded result. */
+    else if (!literal.truncated
+            && (literal.mantissa <= cjson_uint64_constant(0x00200000, 0x00000000))
+            && (literal.exponent >= -22) && (literal.exponent <= 22))
+    {
+        number = (double)literal.mantissa;
+        if (literal.exponent < 0)
+        {
+            number /= exact_powers_of_ten[-literal.exponent];
+        }
+        else
+        {
+            number *= exact_powers_of_ten[literal.exponent];
+        }
+
+        if (literal.negative)
+        {
+            number = -number;
+        }
+    }
+#endif
+    /* strtod takes care of the sign */
+    else if (!parse_number_slow(input_buffer, literal.length, &number))
+    {
+        return false;
+    }
+
+    item->valuedouble = number;
+
+    if (literal.is_integer)
+    {
+        /* integer literals go straight into valueint, with saturation */
+        if (literal.truncated || (literal.mantissa > ((cjson_uint64)INT_MAX + (literal.negative ? 1 : 0))))
+        {
+            item->valueint = literal.negative ? INT_MIN : INT_MAX;
+        }
+        else if (literal.negative && (literal.mantissa > 0))
+        {
+            item->valueint = -(int)(literal.mantissa - 1) - 1;
+        }
+        else
+        {
+            item->valueint = (int)literal.mantissa;
+        }
+    }
+    /* use saturation in case of overflow */
+    else if (number >= INT_MAX)
+    {
+        item->valueint = INT_MAX;
+    }
+    else if (number <= (double)INT_MIN)
+    {
+        item->valueint = INT_MIN;
+    }
+    else
+    {
+        item->valueint = (int)number;
+    }
+
+    set_parsed_type(item, cJSON_Number);
+
+    input_buffer->offset += literal.length;
+    return true;
+}
+
+/* don't ask me, but the original cJSON_SetNumberValue returns an integer or double */
+CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number)
+{
+    if (number >= INT_MAX)
+    {
+        object->valueint = INT_MAX;
+    }
+    else if (number <= (double)INT_MIN)
+    {
+        object->valueint = INT_MIN;
+    }
+    else
+    {
+        object->valueint = (int)number;
+    }
+
+    return object->valuedouble = number;
+}
+
+/* Note: when passing a NULL valuestring, cJSON_SetValuestring treats this as an error and return NULL */
+CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
+{
+    char *copy = NULL;
+    size_t v1_len;
+    size_t v2_len;
+    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
+    if ((object == NULL) || !(object->type & cJSON_String) || (object->type & cJSON_IsReference))
+    {
+        return NULL;
+    }
+    /* return NULL if the object is corrupted or valuestring is NULL */
+    if (object->valuestring == NULL || valuestring == NULL)
+    {
+        return NULL;
+    }
+
+    v1_len = strlen(valuestring);
+    v2_len = strlen(object->valuestring);
+
+    if (v1_len <= v2_len)
+    {
+        /* strcpy does not handle overlapping string: [X1, X2] [Y1, Y2] => X2 < Y1 or Y2 < X1 */
+        if (!( valuestring + v1_len < object->valuestring || object->valuestring + v2_len < valuestring ))
+        {
+            return NULL;
+        }
+        strcpy(object->valuestring, valuestring);
+        return object->valuestring;
+    }
+    copy = (char*) cJSON_strdup((const unsigned char*)valuestring, &global_hooks);
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+    if ((object->valuestring != NULL) && !(object->type & cJSON_ValuestringIsConst))
+    {
+        cJSON_free(object->valuestring);
+    }
+    object->valuestring = copy;
+    object->type &= ~cJSON_ValuestringIsConst;
+
+    return copy;
+}
+
+typedef struct
+{
+    unsigned char *buffer;
+    size_t length;
+    size_t offset;
+    size_t depth; /* current nesting depth (for formatted printing) */
+    cJSON_bool noalloc;
+    cJSON_bool format; /* is this print a formatted print */
+    internal_hooks hooks;
+} printbuffer;
+
+/* realloc printbuffer if necessary to have room for "needed" more bytes and a terminating zero */
+static unsigned char* ensure(printbuffer * const p, size_t needed)
+{
+    unsigned char *newbuffer = NULL;
+    size_t newsize = 0;
+
+    if ((p == NULL) || (p->buffer == NULL))
+    {
+        return NULL;
+    }
+
+    if ((p->length > 0) && (p->offset >= p->length))
+    {
+        /* make sure that offset is valid */
+        return NULL;
+    }
+
+    if (needed > INT_MAX)
+    {
+        /* sizes bigger than INT_MAX are currently not supported */
+        return NULL;
+    }
+
+    needed += p->offset + 1;
+    if (needed <= p->length)
+    {
+        return p->buffer + p->offset;
+    }
+
+    if (p->noalloc) {
+        return NULL;
+    }
+
+    /* calculate new buffer size */
+    if (needed > (INT_MAX / 2))
+    {
+        /* overflow of int, use INT_MAX if possible */
+        if (needed <= INT_MAX)
+        {
+            newsize = INT_MAX;
+        }
+        else
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        newsize = needed * 2;
+    }
+
+    if (p->hooks.reallocate != NULL)
+    {
+        /* reallocate with realloc if available */
+        newbuffer = (unsigned char*)p->hooks.reallocate(p->buffer, newsize);
+        if (newbuffer == NULL)
+        {
+            p->hooks.deallocate(p->buffer);
+            p->length = 0;
+            p->buffer = NULL;
+
+            return NULL;
+        }
+    }
+    else
+    {
+        /* otherwise reallocate manually */
+        newbuffer = (unsigned char*)p->hooks.allocate(newsize);
+        if (!newbuffer)
+        {
+            p->hooks.deallocate(p->buffer);
+            p->length = 0;
+            p->buffer = NULL;
+
+            return NULL;
+        }
+
+        memcpy(newbuffer, p->buffer, p->offset + 1);
+        p->hooks.deallocate(p->buffer);
+    }
+    p->length = newsize;
+    p->buffer = newbuffer;
+
+    return newbuffer + p->offset;
+}
+
+/* calculate the new length of the string in a printbuffer and update the offset */
+static void update_offset(printbuffer * const buffer)
+{
+    const unsigned char *buffer_pointer = NULL;
+    if ((buffer == NULL) || (buffer->buffer == NULL))
+    {
+        return;
+    }
+    buffer_pointer = buffer->buffer + buffer->offset;
+
+    buffer->offset += strlen((const char*)buffer_pointer);
+}
+
+/* securely comparison of floating-point variables */
+static cJSON_bool compare_double(double a, double b)
+{
+    double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
+    return (fabs(a - b) <= maxVal * DBL_EPSILON);
+}
+
+/* Shortest round trip formatting of doubles (Grisu3, Florian Loitsch: "Printing Floating-Point Numbers Quickly and
+ * Accurately with Integers"). Grisu3 works with 64 bit integers and gives up on about 0.5% of all values, when it can't
+ * prove its result to be the shortest. Those are printed by the exact but slower bignum algorithm, so the result is
+ * always the shortest digit string that reads back as the same number. No locale and no sprintf are involved. */
+typedef struct
+{
+    cjson_uint64 f;
+    int e;
+} diy_fp;
+
+typedef struct
+{
+    cjson_uint64 f;
+    int e;
+    int k;
+} cached_power;
+
+/* normalized powers of ten 10^k for k = -300, -292, ..., 324 */
+static const cached_power cached_powers[] =
+{
+    { cjson_uint64_constant(0xAB70FE17, 0xC79AC6CA), -1060, -300 },
+    { cjson_uint64_constant(0xFF77B1FC, 0xBEBCDC4F), -1034, -292 },
+    { cjson_uint64_constant(0xBE5691EF, 0x416BD60C), -1007, -284 },
+    { cjson_uint64_constant(0x8DD01FAD, 0x907FFC3C),  -980, -276 },
+    { cjson_uint64_constant(0xD3515C28, 0x31559A83),  -954, -268 },
+    { cjson_uint64_constant(0x9D71AC8F, 0xADA6C9B5),  -927, -260 },
+    { cjson_uint64_constant(0xEA9C2277, 0x23EE8BCB),  -901, -252 },
+    { cjson_uint64_constant(0xAECC4991, 0x4078536D),  -874, -244 },
+    { cjson_uint64_constant(0x823C1279, 0x5DB6CE57),  -847, -236 },
+    { cjson_uint64_constant(0xC2109436, 0x4DFB5637),  -821, -228 },
+    { cjson_uint64_constant(0x9096EA6F, 0x3848984F),  -794, -220 },
+    { cjson_uint64_constant(0xD77485CB, 0x25823AC7),  -768, -212 },
+    { cjson_uint64_constant(0xA086CFCD, 0x97BF97F4),  -741, -204 },
+    { cjson_uint64_constant(0xEF340A98, 0x172AACE5),  -715, -196 },
+    { cjson_uint64_constant(0xB23867FB, 0x2A35B28E),  -688, -188 },
+    { cjson_uint64_constant(0x84C8D4DF, 0xD2C63F3B),  -661, -180 },
+    { cjson_uint64_constant(0xC5DD4427, 0x1AD3CDBA),  -635, -172 },
+    { cjson_uint64_constant(0x936B9FCE, 0xBB25C996),  -608, -164 },
+    { cjson_uint64_constant(0xDBAC6C24, 0x7D62A584),  -582, -156 },
+    { cjson_uint64_constant(0xA3AB6658, 0x0D5FDAF6),  -555, -148 },
+    { cjson_uint64_constant(0xF3E2F893, 0xDEC3F126),  -529, -140 },
+    { cjson_uint64_constant(0xB5B5ADA8, 0xAAFF80B8),  -502, -132 },
+    { cjson_uint64_constant(0x87625F05, 0x6C7C4A8B),  -475, -124 },
+    { cjson_uint64_constant(0xC9BCFF60, 0x34C13053),  -449, -116 },
+    { cjson_uint64_constant(0x964E858C, 0x91BA2655),  -422, -108 },
+    { cjson_uint64_constant(0xDFF97724, 0x70297EBD),  -396, -100 },
+    { cjson_uint64_constant(0xA6DFBD9F, 0xB8E5B88F),  -369,  -92 },
+    { cjson_uint64_constant(0xF8A95FCF, 0x88747D94),  -343,  -84 },
+    { cjson_uint64_constant(0xB9447093, 0x8FA89BCF),  -316,  -76 },
+    { cjson_uint64_constant(0x8A08F0F8, 0xBF0F156B),  -289,  -68 },
+    { cjson_uint64_constant(0xCDB02555, 0x653131B6),  -263,  -60 },
+    { cjson_uint64_constant(0x993FE2C6, 0xD07B7FAC),  -236,  -52 },
+    { cjson_uint64_constant(0xE45C10C4, 0x2A2B3B06),  -210,  -44 },
+    { cjson_uint64_constant(0xAA242499, 0x697392D3),  -183,  -36 },
+    { cjson_uint64_constant(0xFD87B5F2, 0x8300CA0E),  -157,  -28 },
+    { cjson_uint64_constant(0xBCE50864, 0x92111AEB),  -130,  -20 },
+    { cjson_uint64_constant(0x8CBCCC09, 0x6F5088CC),  -103,  -12 },
+    { cjson_uint64_constant(0xD1B71758, 0xE219652C),   -77,   -4 },
+    { cjson_uint64_constant(0x9C400000, 0x00000000),   -50,    4 },
+    { cjson_uint64_constant(0xE8D4A510, 0x00000000),   -24,   12 },
+    { cjson_uint64_constant(0xAD78EBC5, 0xAC620000),     3,   20 },
+    { cjson_uint64_constant(0x813F3978, 0xF8940984),    30,   28 },
+    { cjson_uint64_constant(0xC097CE7B, 0xC90715B3),    56,   36 },
+    { cjson_uint64_constant(0x8F7E32CE, 0x7BEA5C70),    83,   44 },
+    { cjson_uint64_constant(0xD5D238A4, 0xABE98068),   109,   52 },
+    { cjson_uint64_constant(0x9F4F2726, 0x179A2245),   136,   60 },
+    { cjson_uint64_constant(0xED63A231, 0xD4C4FB27),   162,   68 },
+    { cjson_uint64_constant(0xB0DE6538, 0x8CC8ADA8),   189,   76 },
+    { cjson_uint64_constant(0x83C7088E, 0x1AAB65DB),   216,   84 },
+    { cjson_uint64_constant(0xC45D1DF9, 0x42711D9A),   242,   92 },
+    { cjson_uint64_constant(0x924D692C, 0xA61BE758),   269,  100 },
+    { cjson_uint64_constant(0xDA01EE64, 0x1A708DEA),   295,  108 },
+    { cjson_uint64_constant(0xA26DA399, 0x9AEF774A),   322,  116 },
+    { cjson_uint64_constant(0xF209787B, 0xB47D6B85),   348,  124 },
+    { cjson_uint64_constant(0xB454E4A1, 0x79DD1877),   375,  132 },
+    { cjson_uint64_constant(0x865B8692, 0x5B9BC5C2),   402,  140 },
+    { cjson_uint64_constant(0xC83553C5, 0xC8965D3D),   428,  148 },
+    { cjson_uint64_constant(0x952AB45C, 0xFA97A0B3),   455,  156 },
+    { cjson_uint64_constant(0xDE469FBD, 0x99A05FE3),   481,  164 },
+    { cjson_uint64_constant(0xA59BC234, 0xDB398C25),   508,  172 },
+    { cjson_uint64_constant(0xF6C69A72, 0xA3989F5C),   534,  180 },
+    { cjson_uint64_constant(0xB7DCBF53, 0x54E9BECE),   561,  188 },
+    { cjson_uint64_constant(0x88FCF317, 0xF22241E2),   588,  196 },
+    { cjson_uint64_constant(0xCC20CE9B, 0xD35C78A5),   614,  204 },
+    { cjson_uint64_constant(0x98165AF3, 0x7B2153DF),   641,  212 },
+    { cjson_uint64_constant(0xE2A0B5DC, 0x971F303A),   667,  220 },
+    { cjson_uint64_constant(0xA8D9D153, 0x5CE3B396),   694,  228 },
+    { cjson_uint64_constant(0xFB9B7CD9, 0xA4A7443C),   720,  236 },
+    { cjson_uint64_constant(0xBB764C4C, 0xA7A44410),   747,  244 },
+    { cjson_uint64_constant(0x8BAB8EEF, 0xB6409C1A),   774,  252 },
+    { cjson_uint64_constant(0xD01FEF10, 0xA657842C),   800,  260 },
+    { cjson_uint64_constant(0x9B10A4E5, 0xE9913129),   827,  268 },
+    { cjson_uint64_constant(0xE7109BFB, 0xA19C0C9D),   853,  276 },
+    { cjson_uint64_constant(0xAC2820D9, 0x623BF429),   880,  284 },
+    { cjson_uint64_constant(0x80444B5E, 0x7AA7CF85),   907,  292 },
+    { cjson_uint64_constant(0xBF21E440, 0x03ACDD2D),   933,  300 },
+    { cjson_uint64_constant(0x8E679C2F, 0x5E44FF8F),   960,  308 },
+    { cjson_uint64_constant(0xD433179D, 0x9C8CB841),   986,  316 },
+    { cjson_uint64_constant(0x9E19DB92, 0xB4E31BA9),  1013,  324 }
+};
+
+#define cached_powers_min_decimal_exponent (-300)
+#define cached_powers_decimal_step 8
+
+static diy_fp diy_fp_make(cjson_uint64 f, int e)
+{
+    diy_fp result;
+    result.f = f;
+    result.e = e;
+    return result;
+}
+
+/* round(x * y / 2^64), both operands have to be normalized */
+static diy_fp diy_fp_multiply(const diy_fp x, const diy_fp y)
+{
+    const cjson_uint64 mask = 0xFFFFFFFFUL;
+    const cjson_uint64 x_low = x.f & mask;
+    const cjson_uint64 x_high = x.f >> 32;
+    const cjson_uint64 y_low = y.f & mask;
+    const cjson_uint64 y_high = y.f >> 32;
+    const cjson_uint64 low_low = x_low * y_low;
+    const cjson_uint64 low_high = x_low * y_high;
+    const cjson_uint64 high_low = x_high * y_low;
+    const cjson_uint64 high_high = x_high * y_high;
+    cjson_uint64 middle = (low_low >> 32) + (low_high & mask) + (high_low & mask);
+
+    /* round up */
+    middle += (cjson_uint64)1 << 31;
+
+    return diy_fp_make(high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32), x.e + y.e + 64);
+}
+
+static diy_fp diy_fp_normalize(diy_fp x)
+{
+    while ((x.f >> 63) == 0)
+    {
+        x.f <<= 1;
+        x.e--;
+    }
+
+    return x;
+}
+
+/* a positive, finite double as significand * 2^exponent */
+typedef struct
+{
+    cjson_uint64 significand;
+    int exponent;
+    /* at powers of two the next smaller value is only half as far away as the next larger one */
+    cJSON_bool lower_boundary_is_closer;
+} binary_float;
+
+static binary_float decompose_double(const double d)
+{
+    binary_float value;
+    cjson_uint64 bits = 0;
+    cjson_uint64 fraction = 0;
+    int biased_exponent = 0;
+
+    memcpy(&bits, &d, sizeof(bits));
+    biased_exponent = (int)((bits >> 52) & 0x7FF);
+    fraction = bits & cjson_uint64_constant(0x000FFFFF, 0xFFFFFFFF);
+
+    if (biased_exponent == 0)
+    {
+        /* subnormal */
+        value.significand = fraction;
+        value.exponent = 1 - 1075;
+    }
+    else
+    {
+        value.significand = fraction | cjson_uint64_constant(0x00100000, 0x00000000);
+        value.exponent = biased_exponent - 1075;
+    }
+    value.lower_boundary_is_closer = (fraction == 0) && (biased_exponent > 1);
+
+    return value;
+}
+
+/* every float is a double, so take that apart and shift it into the precision of a float */
+static binary_float decompose_float(const float f)
+{
+    binary_float value = decompose_double((double)f);
+    /* 52 fraction bits of a double vs 23 of a float, subnormal floats have fewer */
+    int shift = 52 - 23;
+
+    if ((value.exponent + shift) < (1 - 150))
+    {
+        shift = (1 - 150) - value.exponent;
+    }
+    value.significand >>= shift;
+    value.exponent += shift;
+    value.lower_boundary_is_closer = (value.significand == 0x800000UL) && (value.exponent > (1 - 150));
+
+    return value;
+}
+
+/* the exact value and its boundaries m- and m+, the halfway points to the neighbouring doubles */
+static void compute_boundaries(const binary_float * const number, diy_fp * const value, diy_fp * const minus, diy_fp * const plus)
+{
+    const diy_fp v = diy_fp_make(number->significand, number->exponent);
+    diy_fp m_minus;
+    diy_fp m_plus;
+
+    m_plus = diy_fp_make((v.f << 1) + 1, v.e - 1);
+    if (number->lower_boundary_is_closer)
+    {
+        m_minus = diy_fp_make((v.f << 2) - 1, v.e - 2);
+    }
+    else
+    {
+        m_minus = diy_fp_make((v.f << 1) - 1, v.e - 1);
+    }
+
+    *plus = diy_fp_normalize(m_plus);
+    /* m- gets the exponent of m+, it can't overflow because m- < m+ */
+    *minus = diy_fp_make(m_minus.f << (m_minus.e - plus->e), plus->e);
+    *value = diy_fp_normalize(v);
+}
+
+/* find a cached power c = 10^-k such that the binary exponent of the product with 2^e ends up in [-60, -32] */
+static cached_power get_cached_power(int e)
+{
+    const int f = -60 - e - 1;
+    /* 78913 / 2^18 approximates log10(2) */
+    const int k = (f * 78913) / (1 << 18) + ((f > 0) ? 1 : 0);
+    const int index = (-cached_powers_min_decimal_exponent + k + (cached_powers_decimal_step - 1)) / cached_powers_decimal_step;
+
+    return cached_powers[index];
+}
+
+/* largest power of ten <= n, returns the number of digits of n */
+static int find_largest_power_of_ten(const unsigned long n, unsigned long * const power)
+{
+    unsigned long candidate = 1000000000UL;
+    int digits = 10;
+
+    while ((digits > 1) && (n < candidate))
+    {
+        candidate /= 10;
+        digits--;
+    }
+
+    *power = candidate;
+    return digits;
+}
+
+/* Grisu3 only knows the scaled boundaries to within unit. Move the last digit towards w while the result stays inside,
+ * and return false unless the result is then known to be the closest of the shortest ones. */
+static cJSON_bool grisu_round_weed(unsigned char * const buffer, const int length, const cjson_uint64 distance_too_high_w, const cjson_uint64 unsafe_interval, cjson_uint64 rest, const cjson_uint64 ten_kappa, const cjson_uint64 unit)
+{
+    const cjson_uint64 small_distance = distance_too_high_w - unit;
+    const cjson_uint64 big_distance = distance_too_high_w + unit;
+
+    while ((rest < small_distance)
+            && ((unsafe_interval - rest) >= ten_kappa)
+            && (((rest + ten_kappa) < small_distance) || ((small_distance - rest) >= (rest + ten_kappa - small_distance))))
+    {
+        buffer[length - 1]--;
+        rest += ten_kappa;
+    }
+
+    /* the next lower digit might be just as close */
+    if ((rest < big_distance)
+            && ((unsafe_interval - rest) >= ten_kappa)
+            && (((rest + ten_kappa) < big_distance) || ((big_distance - rest) > (rest + ten_kappa - big_distance))))
+    {
+        return false;
+    }
+
+    /* and the result has to be inside of the boundaries even if they are off by unit */
+    return ((2 * unit) <= rest) && (rest <= (unsafe_interval - (4 * unit)));
+}
+
+/* generate the digits of high until they are inside of (low, high) widened by unit, value = digits * 10^decimal_exponent.
+ * Returns false if the result might not be the shortest one. */
+static cJSON_bool grisu_digits(unsigned char * const buffer, int * const length, int * const decimal_exponent, const diy_fp low, const diy_fp w, const diy_fp high)
+{
+    const int shift = -w.e;
+    const cjson_uint64 one = (cjson_uint64)1 << shift;
+    cjson_uint64 unit = 1;
+    const cjson_uint64 too_high = high.f + unit;
+    cjson_uint64 unsafe_interval = too_high - (low.f - unit);
+    /* split too_high into an integral part, which fits into 32 bits, and a fractional part */
+    unsigned long integral = (unsigned long)(too_high >> shift);
+    cjson_uint64 fractional = too_high & (one - 1);
+    unsigned long power = 0;
+    int remaining = find_largest_power_of_ten(integral, &power);
+    int fractional_digits = 0;
+
+    *length = 0;
+    while (remaining > 0)
+    {
+        cjson_uint64 rest = 0;
+
+        buffer[(*length)++] = (unsigned char)('0' + integral / power);
+        integral %= power;
+        remaining--;
+
+        rest = ((cjson_uint64)integral << shift) + fractional;
+        if (rest < unsafe_interval)
+        {
+            *decimal_exponent += remaining;
+            return grisu_round_weed(buffer, *length, too_high - w.f, unsafe_interval, rest, (cjson_uint64)power << shift, unit);
+        }
+
+        power /= 10;
+    }
+
+    for (;;)
+    {
+        fractional *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+        buffer[(*length)++] = (unsigned char)('0' + (fractional >> shift));
+        fractional &= one - 1;
+        fractional_digits++;
+
+        if (fractional < unsafe_interval)
+        {
+            *decimal_exponent -= fractional_digits;
+            return grisu_round_weed(buffer, *length, (too_high - w.f) * unit, unsafe_interval, fractional, one, unit);
+        }
+    }
+}
+
+/* shortest digits of a positive, finite number, false for the rare values that need the exact algorithm */
+static cJSON_bool grisu3(unsigned char * const buffer, int * const length, int * const decimal_exponent, const binary_float * const number)
+{
+    diy_fp value;
+    diy_fp minus;
+    diy_fp plus;
+    diy_fp power;
+    cached_power cached;
+
+    compute_boundaries(number, &value, &minus, &plus);
+    cached = get_cached_power(plus.e);
+    power = diy_fp_make(cached.f, cached.e);
+
+    *decimal_exponent = -cached.k;
+    return grisu_digits(buffer, length, decimal_exponent, diy_fp_multiply(minus, power), diy_fp_multiply(value, power), diy_fp_multiply(plus, power));
+}
+
+/* Arbitrary precision unsigned integers for the exact algorithm, 32 bits per word, least significant word first.
+ * 40 words hold the largest value that comes up, 4 * 2^53 * 10^325 for the smallest subnormal. */
+#define bignum_capacity 40
+
+typedef struct
+{
+    unsigned long words[bignum_capacity];
+    size_t length; /* without leading zero words */
+} bignum;
+
+static void bignum_set(bignum * const number, cjson_uint64 value)
+{
+    number->length = 0;
+    while (value > 0)
+    {
+        number->words[number->length++] = (unsigned long)(value & 0xFFFFFFFFUL);
+        value >>= 32;
+    }
+}
+
+static void bignum_multiply(bignum * const number, const unsigned long factor)
+{
+    cjson_uint64 carry = 0;
+    size_t i = 0;
+
+    for (i = 0; i < number->length; i++)
+    {
+        carry += (cjson_uint64)number->words[i] * factor;
+        number->words[i] = (unsigned long)(carry & 0xFFFFFFFFUL);
+        carry >>= 32;
+    }
+    if (carry > 0)
+    {
+        number->words[number->length++] = (unsigned long)carry;
+    }
+}
+
+static void bignum_multiply_power_of_ten(bignum * const number, int exponent)
+{
+    unsigned long factor = 1;
+
+    for (; exponent >= 9; exponent -= 9)
+    {
+        bignum_multiply(number, 1000000000UL);
+    }
+    for (; exponent > 0; exponent--)
+    {
+        factor *= 10;
+    }
+    bignum_multiply(number, factor);
+}
+
+static void bignum_shift_left(bignum * const number, const int bits)
+{
+    const size_t words = (size_t)bits / 32;
+    const int shift = bits % 32;
+    unsigned long carry = 0;
+    unsigned long word = 0;
+    size_t i = 0;
+
+    if ((number->length == 0) || (bits == 0))
+    {
+        return;
+    }
+
+    if (words > 0)
+    {
+        memmove(number->words + words, number->words, number->length * sizeof(number->words[0]));
+        memset(number->words, '\0', words * sizeof(number->words[0]));
+        number->length += words;
+    }
+
+    if (shift > 0)
+    {
+        for (i = words; i < number->length; i++)
+        {
+            word = number->words[i];
+            number->words[i] = ((word << shift) & 0xFFFFFFFFUL) | carry;
+            carry = word >> (32 - shift);
+        }
+        if (carry > 0)
+        {
+            number->words[number->length++] = carry;
+        }
+    }
+}
+
+static int bignum_compare(const bignum * const a, const bignum * const b)
+{
+    size_t i = 0;
+
+    if (a->length != b->length)
+    {
+        return (a->length < b->length) ? -1 : 1;
+    }
+    for (i = a->length; i > 0; i--)
+    {
+        if (a->words[i - 1] != b->words[i - 1])
+        {
+            return (a->words[i - 1] < b->words[i - 1]) ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+static void bignum_add(bignum * const sum, const bignum * const a, const bignum * const b)
+{
+    cjson_uint64 carry = 0;
+    size_t i = 0;
+
+    for (i = 0; (i < a->length) || (i < b->length); i++)
+    {
+        carry += (i < a->length) ? a->words[i] : 0;
+        carry += (i < b->length) ? b->words[i] : 0;
+        sum->words[i] = (unsigned long)(carry & 0xFFFFFFFFUL);
+        carry >>= 32;
+    }
+    sum->length = i;
+    if (carry > 0)
+    {
+        sum->words[sum->length++] = (unsigned long)carry;
+    }
+}
+
+/* number -= subtrahend, which mustn't be larger */
+static void bignum_subtract(bignum * const number, const bignum * const subtrahend)
+{
+    cjson_uint64 difference = 0;
+    unsigned long borrow = 0;
+    size_t i = 0;
+
+    for (i = 0; i < number->length; i++)
+    {
+        /* borrow 2^32 up front, it is paid back unless the difference needs it */
+        difference = (cjson_uint64)number->words[i] + cjson_uint64_constant(1, 0) - borrow;
+        difference -= (i < subtrahend->length) ? subtrahend->words[i] : 0;
+        number->words[i] = (unsigned long)(difference & 0xFFFFFFFFUL);
+        borrow = ((difference >> 32) == 0) ? 1 : 0;
+    }
+    while ((number->length > 0) && (number->words[number->length - 1] == 0))
+    {
+        number->length--;
+    }
+}
+
+/* Exact shortest digits for the values grisu3 gives up on (free format printing, Burger and Dybvig: "Printing
+ * Floating-Point Numbers Quickly and Accurately"). value = r / s * 10^k and the boundaries are r +- m / s * 10^k. */
+static int bignum_digits(unsigned char * const buffer, int * const decimal_exponent, const binary_float * const number)
+{
+    bignum r;
+    bignum s;
+    bignum m_plus;
+    bignum m_minus;
+    bignum sum;
+    /* round half to even: boundaries of even significands read back as the same value */
+    const cJSON_bool even = (number->significand & 1) == 0;
+    const int boundary_shift = number->lower_boundary_is_closer ? 2 : 1;
+    cjson_uint64 significand = number->significand;
+    long scaled = 0;
+    int k = 0;
+    int length = 0;
+    int comparison = 0;
+    cJSON_bool low = false;
+    cJSON_bool high = false;
+    unsigned char digit = 0;
+
+    if (number->exponent >= 0)
+    {
+        bignum_set(&r, significand);
+        bignum_shift_left(&r, number->exponent + boundary_shift);
+        bignum_set(&s, (cjson_uint64)1 << boundary_shift);
+        bignum_set(&m_minus, 1);
+        bignum_shift_left(&m_minus, number->exponent);
+    }
+    else
+    {
+        bignum_set(&r, significand << boundary_shift);
+        bignum_set(&s, 1);
+        bignum_shift_left(&s, boundary_shift - number->exponent);
+        bignum_set(&m_minus, 1);
+    }
+    m_plus = m_minus;
+    bignum_shift_left(&m_plus, boundary_shift - 1);
+
+    /* k = floor(log2(value) * log10(2)) is at most ceil(log10(value)), 78913 / 2^18 approximates log10(2) */
+    for (k = number->exponent - 1; significand > 0; significand >>= 1)
+    {
+        k++;
+    }
+    scaled = (long)k * 78913L;
+    k = (int)((scaled >= 0) ? (scaled / 262144L) : -((-scaled + 262143L) / 262144L));
+    if (k >= 0)
+    {
+        bignum_multiply_power_of_ten(&s, k);
+    }
+    else
+    {
+        bignum_multiply_power_of_ten(&r, -k);
+        bignum_multiply_power_of_ten(&m_plus, -k);
+        bignum_multiply_power_of_ten(&m_minus, -k);
+    }
+
+    /* correct k until the upper boundary is below 10^k as well */
+    for (;;)
+    {
+        bignum_add(&sum, &r, &m_plus);
+        comparison = bignum_compare(&sum, &s);
+        if ((comparison < 0) || ((comparison == 0) && !even))
+        {
+            break;
+        }
+        bignum_multiply(&s, 10);
+        k++;
+    }
+
+    *decimal_exponent = k;
+    for (;;)
+    {
+        bignum_multiply(&r, 10);
+        bignum_multiply(&m_plus, 10);
+        bignum_multiply(&m_minus, 10);
+        (*decimal_exponent)--;
+
+        digit = 0;
+        while (bignum_compare(&r, &s) >= 0)
+        {
+            bignum_subtract(&r, &s);
+            digit++;
+        }
+
+        /* can the digits end here, rounded down (low) or up (high)? */
+        comparison = bignum_compare(&r, &m_minus);
+        low = (comparison < 0) || ((comparison == 0) && even);
+        bignum_add(&sum, &r, &m_plus);
+        comparison = bignum_compare(&sum, &s);
+        high = (comparison > 0) || ((comparison == 0) && even);
+
+        if (!low && !high)
+        {
+            buffer[length++] = (unsigned char)('0' + digit);
+            continue;
+        }
+
+        if (low && high)
+        {
+            /* both are inside of the boundaries, take the closer one */
+            bignum_add(&sum, &r, &r);
+            comparison = bignum_compare(&sum, &s);
+            if ((comparison > 0) || ((comparison == 0) && ((digit & 1) != 0)))
+            {
+                digit++;
+            }
+        }
+        else if (high)
+        {
+            digit++;
+        }
+        buffer[length++] = (unsigned char)('0' + digit);
+
+        return length;
+    }
+}
+
+/* shortest digits of a positive, finite number that read back as the same double, returns how many */
+static int shortest_digits(unsigned char * const buffer, int * const decimal_exponent, const binary_float * const number)
+{
+    int length = 0;
+
+    if (grisu3(buffer, &length, decimal_exponent, number))
+    {
+        return length;
+    }
+
+    return bignum_digits(buffer, decimal_exponent, number);
+}
+
+/* write digits * 10^decimal_exponent the way printf's %g would with the precision cJSON used to print with */
+static int format_double(unsigned char *output, const unsigned char * const digits, const int length, const int decimal_exponent)
+{
+    const unsigned char * const start = output;
+    /* exponent of the first digit in scientific notation */
+    const int exponent = length + decimal_exponent - 1;
+    /* up to 15 digits were printed with %1.15g and the rest with %1.17g */
+    const int precision = (length <= 15) ? 15 : 17;
+    int i = 0;
+
+    if ((exponent < -4) || (exponent >= precision))
+    {
+        int absolute_exponent = (exponent < 0) ? -exponent : exponent;
+
+        *output++ = digits[0];
+        if (length > 1)
+        {
+            *output++ = '.';
+            memcpy(output, digits + 1, (size_t)(length - 1));
+            output += length - 1;
+        }
+
+        *output++ = 'e';
+        *output++ = (exponent < 0) ? '-' : '+';
+        if (absolute_exponent >= 100)
+        {
+            *output++ = (unsigned char)('0' + absolute_exponent / 100);
+            absolute_exponent %= 100;
+        }
+        *output++ = (unsigned char)('0' + absolute_exponent / 10);
+        *output++ = (unsigned char)('0' + absolute_exponent % 10);
+    }
+    else if (exponent < 0)
+    {
+        *output++ = '0';
+        *output++ = '.';
+        for (i = exponent + 1; i < 0; i++)
+        {
+            *output++ = '0';
+        }
+        memcpy(output, digits, (size_t)length);
+        output += length;
+    }
+    else if (length <= (exponent + 1))
+    {
+        /* integral value, pad with zeros */
+        memcpy(output, digits, (size_t)length);
+        output += length;
+        for (i = length; i <= exponent; i++)
+        {
+            *output++ = '0';
+        }
+    }
+    else
+    {
+        memcpy(output, digits, (size_t)(exponent + 1));
+        output += exponent + 1;
+        *output++ = '.';
+        memcpy(output, digits + exponent + 1, (size_t)(length - exponent - 1));
+        output += length - exponent - 1;
+    }
+
+    return (int)(output - start);
+}
+
+/* print an int without sprintf */
+static int format_integer(unsigned char *output, int integer)
+{
+    unsigned char digits[sizeof(int) * CHAR_BIT / 3 + 1];
+    /* negate as unsigned to support INT_MIN */
+    unsigned int magnitude = (integer < 0) ? (0U - (unsigned int)integer) : (unsigned int)integer;
+    int length = 0;
+    int i = 0;
+
+    do
+    {
+        digits[length++] = (unsigned char)('0' + magnitude % 10);
+        magnitude /= 10;
+    }
+    while (magnitude > 0);
+
+    if (integer < 0)
+    {
+        output[i++] = '-';
+    }
+    while (length > 0)
+    {
+        output[i++] = digits[--length];
+    }
+
+    return i;
+}
+
+/* Render the number of an item into number_buffer, returns the length or -1 if it doesn't fit */
+/* integer is the saturated int of d, the way cJSON_CreateNumber sets valueint */
+static int format_number_value(double d, int integer, unsigned char number_buffer[26])
+{
+    int length = 0;
+
+    /* This checks for NaN and Infinity */
+    if (isnan(d) || isinf(d))
+    {
+        memcpy(number_buffer, "null", sizeof("null"));
+        length = sizeof("null") - 1;
+    }
+    else if(d == (double)integer)
+    {
+        length = format_integer(number_buffer, integer);
+    }
+    else
+    {
+        unsigned char digits[18];
+        int digits_length = 0;
+        int decimal_exponent = 0;
+        binary_float number;
+
+        if (d < 0)
+        {
+            number_buffer[length++] = '-';
+            d = -d;
+        }
+
+        number = decompose_double(d);
+        digits_length = shortest_digits(digits, &decimal_exponent, &number);
+        length += format_double(number_buffer + length, digits, digits_length, decimal_exponent);
+    }
+
+    /* buffer overrun occurred */
+    if ((length < 0) || (length > 25))
+    {
+        return -1;
+    }
+
+    return length;
+}
+
+/* Render a float member of a struct with the shortest digits that read back as the same float */
+static int format_float_value(const float f, unsigned char number_buffer[26])
+{
+    const double d = (double)f;
+    int length = 0;
+
+    if (isnan(d) || isinf(d))
+    {
+        memcpy(number_buffer, "null", sizeof("null"));
+        length = sizeof("null") - 1;
+    }
+    else if ((d > (double)INT_MIN) && (d < (double)INT_MAX) && (d == (double)(int)d))
+    {
+        length = format_integer(number_buffer, (int)d);
+    }
+    else
+    {
+        unsigned char digits[18];
+        int digits_length = 0;
+        int decimal_exponent = 0;
+        binary_float number;
+
+        if (d < 0)
+        {
+            number_buffer[length++] = '-';
+        }
+
+        number = decompose_float((d < 0) ? -f : f);
+        digits_length = shortest_digits(digits, &decimal_exponent, &number);
+        length += format_double(number_buffer + length, digits, digits_length, decimal_exponent);
+    }
+
+    return length;
+}
+
+static int format_number(const cJSON * const item, unsigned char number_buffer[26])
+{
+    return format_number_value(item->valuedouble, item->valueint, number_buffer);
+}
+
+/* Render the number nicely from the given item into a string. */
+static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    int length = 0;
+    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    length = format_number(item, number_buffer);
+    if (length < 0)
+    {
+        return false;
+    }
+
+    /* reserve appropriate space in the output */
+    output_pointer = ensure(output_buffer, (size_t)length);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    memcpy(output_pointer, number_buffer, (size_t)length);
+    output_pointer[length] = '\0';
+
+    output_buffer->offset += (size_t)length;
+
+    return true;
+}
+
+/* parse 4 digit hexadecimal number */
+static unsigned parse_hex4(const unsigned char * const input)
+{
+    unsigned int h = 0;
+    size_t i = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        /* parse digit */
+        if ((input[i] >= '0') && (input[i] <= '9'))
+        {
+            h += (unsigned int) input[i] - '0';
+        }
+        else if ((input[i] >= 'A') && (input[i] <= 'F'))
+        {
+            h += (unsigned int) 10 + input[i] - 'A';
+        }
+        else if ((input[i] >= 'a') && (input[i] <= 'f'))
+        {
+            h += (unsigned int) 10 + input[i] - 'a';
+        }
+        else /* invalid */
+        {
+            return 0;
+        }
+
+        if (i < 3)
+        {
+            /* shift left to make place for the next nibble */
+            h = h << 4;
+        }
+    }
+
+    return h;
+}
+
+/* converts a UTF-16 literal to UTF-8
+ * A literal can be one or two sequences of the form \uXXXX */
+static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer)
+{
+    long unsigned int codepoint = 0;
+    unsigned int first_code = 0;
+    const unsigned char *first_sequence = input_pointer;
+    unsigned char utf8_length = 0;
+    unsigned char utf8_position = 0;
+    unsigned char sequence_length = 0;
+    unsigned char first_byte_mark = 0;
+
+    if ((input_end - first_sequence) < 6)
+    {
+        /* input ends unexpectedly */
+        goto fail;
+    }
+
+    /* get the first utf16 sequence */
+    first_code = parse_hex4(first_sequence + 2);
+
+    /* check that the code is valid */
+    if (((first_code >= 0xDC00) && (first_code <= 0xDFFF)))
+    {
+        goto fail;
+    }
+
+    /* UTF16 surrogate pair */
+    if ((first_code >= 0xD800) && (first_code <= 0xDBFF))
+    {
+        const unsigned char *second_sequence = first_sequence + 6;
+        unsigned int second_code = 0;
+        sequence_length = 12; /* \uXXXX\uXXXX */
+
+        if ((input_end - second_sequence) < 6)
+        {
+            /* input ends unexpectedly */
+            goto fail;
+        }
+
+        if ((second_sequence[0] != '\\') || (second_sequence[1] != 'u'))
+        {
+            /* missing second half of the surrogate pair */
+            goto fail;
+        }
+
+        /* get the second utf16 sequence */
+        second_code = parse_hex4(second_sequence + 2);
+        /* check that the code is valid */
+        if ((second_code < 0xDC00) || (second_code > 0xDFFF))
+        {
+            /* invalid second half of the surrogate pair */
+            goto fail;
+        }
+
+
+        /* calculate the unicode codepoint from the surrogate pair */
+        codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
+    }
+    else
+    {
+        sequence_length = 6; /* \uXXXX */
+        codepoint = first_code;
+    }
+
+    /* encode as UTF-8
+     * takes at maximum 4 bytes to encode:
+     * 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
+    if (codepoint < 0x80)
+    {
+        /* normal ascii, encoding 0xxxxxxx */
+        utf8_length = 1;
+    }
+    else if (codepoint < 0x800)
+    {
+        /* two bytes, encoding 110xxxxx 10xxxxxx */
+        utf8_length = 2;
+        first_byte_mark = 0xC0; /* 11000000 */
+    }
+    else if (codepoint < 0x10000)
+    {
+        /* three bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx */
+        utf8_length = 3;
+        first_byte_mark = 0xE0; /* 11100000 */
+    }
+    else if (codepoint <= 0x10FFFF)
+    {
+        /* four bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx 10xxxxxx */
+        utf8_length = 4;
+        first_byte_mark = 0xF0; /* 11110000 */
+    }
+    else
+    {
+        /* invalid unicode codepoint */
+        goto fail;
+    }
+
+    /* encode as utf8 */
+    for (utf8_position = (unsigned char)(utf8_length - 1); utf8_position > 0; utf8_position--)
+    {
+        /* 10xxxxxx */
+        (*output_pointer)[utf8_position] = (unsigned char)((codepoint | 0x80) & 0xBF);
+        codepoint >>= 6;
+    }
+    /* encode first byte */
+    if (utf8_length > 1)
+    {
+        (*output_pointer)[0] = (unsigned char)((codepoint | first_byte_mark) & 0xFF);
+    }
+    else
+    {
+        (*output_pointer)[0] = (unsigned char)(codepoint & 0x7F);
+    }
+
+    *output_pointer += utf8_length;
+
+    return sequence_length;
+
+fail:
+    return 0;
+}
+
+/* Scanning kernels. With ENABLE_CJSON_SIMD they look at 32 (AVX2), 16 (SSE2) or sizeof(size_t) (SWAR) bytes at a time
+ * and only find the exact position byte by byte, otherwise they are plain loops. */
+#if defined(CJSON_SIMD_AVX2) || defined(CJSON_SIMD_SSE2)
+static size_t first_set_bit(const unsigned int mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return (size_t)index;
+#else
+    return (size_t)__builtin_ctz(mask);
+#endif
+}
+#endif
+
+/* index of the first byte in string[0, length) that is first, second or below limit, length if there is none */
+static size_t find_byte_class(const unsigned char * const string, const size_t length, const unsigned char first, const unsigned char second, const unsigned char limit)
+{
+    size_t i = 0;
+
+#if defined(CJSON_SIMD_AVX2)
+    const __m256i first_bytes = _mm256_set1_epi8((char)first);
+    const __m256i second_bytes = _mm256_set1_epi8((char)second);
+    const __m256i control = _mm256_set1_epi8((char)(limit - 1));
+    for (; (i + 32) <= length; i += 32)
+    {
+        const __m256i chunk = _mm256_loadu_si256((const __m256i*)(const void*)(string + i));
+        /* max(chunk, limit - 1) == limit - 1 for every byte below limit */
+        const __m256i special = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, first_bytes), _mm256_cmpeq_epi8(chunk, second_bytes)),
+                _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, control), control));
+        const unsigned int mask = (unsigned int)_mm256_movemask_epi8(special);
+        if (mask != 0)
+        {
+            return i + first_set_bit(mask);
+        }
+    }
+#elif defined(CJSON_SIMD_SSE2)
+    const __m128i first_bytes = _mm_set1_epi8((char)first);
+    const __m128i second_bytes = _mm_set1_epi8((char)second);
+    const __m128i control = _mm_set1_epi8((char)(limit - 1));
+    for (; (i + 16) <= length; i += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)(string + i));
+        const __m128i special = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, first_bytes), _mm_cmpeq_epi8(chunk, second_bytes)),
+                _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+        const unsigned int mask = (unsigned int)_mm_movemask_epi8(special);
+        if (mask != 0)
+        {
+            return i + first_set_bit(mask);
+        }
+    }
+#elif defined(ENABLE_CJSON_SIMD)
+    /* SWAR: (x - 0x0101..01 * n) & ~x & 0x8080..80 is non zero if a byte of x is below n (n <= 128) */
+    const size_t ones = (size_t)-1 / 255;
+    const size_t high_bits = ones * 0x80;
+    for (; (i + sizeof(size_t)) <= length; i += sizeof(size_t))
+    {
+        size_t word = 0;
+        size_t firsts = 0;
+        size_t seconds = 0;
+
+        memcpy(&word, string + i, sizeof(word));
+        firsts = word ^ (ones * first);
+        seconds = word ^ (ones * second);
+        if ((((firsts - ones) & ~firsts) | ((seconds - ones) & ~seconds) | ((word - ones * limit) & ~word)) & high_bits)
+        {
+            break;
+        }
+    }
+#endif
+
+    while ((i < length) && (string[i] != first) && (string[i] != second) && (string[i] >= limit))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+/* index of the first '"', '\\' or control character in string[0, length), length if there is none */
+static size_t find_string_special(const unsigned char * const string, const size_t length)
+{
+    return find_byte_class(string, length, '\"', '\\', 32);
+}
+
+/* index of the first byte that isn't whitespace (or any other character <= 32) in string[0, length) */
+static size_t skip_whitespace_bytes(const unsigned char * const string, const size_t length)
+{
+    size_t i = 0;
+
+#ifdef ENABLE_CJSON_SIMD
+    /* most runs are a newline and a bit of indentation, which isn't worth loading a block for */
+    for (; (i < length) && (i < 8); i++)
+    {
+        if (string[i] > 32)
+        {
+            return i;
+        }
+    }
+#endif
+
+#if defined(CJSON_SIMD_AVX2)
+    {
+        const __m256i space = _mm256_set1_epi8(32);
+        for (; (i + 32) <= length; i += 32)
+        {
+            const __m256i chunk = _mm256_loadu_si256((const __m256i*)(const void*)(string + i));
+            const unsigned int mask = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(chunk, space), space));
+            if (mask != 0)
+            {
+                return i + first_set_bit(mask);
+            }
+        }
+    }
+#elif defined(CJSON_SIMD_SSE2)
+    {
+        const __m128i space = _mm_set1_epi8(32);
+        for (; (i + 16) <= length; i += 16)
+        {
+            const __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)(string + i));
+            const unsigned int mask = ~(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chunk, space), space)) & 0xFFFFU;
+            if (mask != 0)
+            {
+                return i + first_set_bit(mask);
+            }
+        }
+    }
+#elif defined(ENABLE_CJSON_SIMD)
+    {
+        /* SWAR: ((x + 0x0101..01 * (127 - n)) | x) & 0x8080..80 is non zero if a byte of x is above n */
+        const size_t ones = (size_t)-1 / 255;
+        const size_t high_bits = ones * 0x80;
+        for (; (i + sizeof(size_t)) <= length; i += sizeof(size_t))
+        {
+            size_t word = 0;
+
+            memcpy(&word, string + i, sizeof(word));
+            if (((word + ones * (127 - 32)) | word) & high_bits)
+            {
+                break;
+            }
+        }
+    }
+#endif
+
+    while ((i < length) && (string[i] <= 32))
+    {
+        i++;
+    }
+
+    return i;
+}
+
+/* Find the closing quote of the string literal at the current offset.
+ * skipped_bytes receives the number of escape characters, which bounds how much shorter the unescaped string is. */
+static cJSON_bool find_string_end(const parse_buffer * const input_buffer, const unsigned char **string_end, size_t * const skipped_bytes)
+{
+    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
+    const unsigned char * const buffer_end = input_buffer->content + input_buffer->length;
+
+    *skipped_bytes = 0;
+    for (;;)
+    {
+        input_end += find_string_special(input_end, (size_t)(buffer_end - input_end));
+        if (input_end >= buffer_end)
+        {
+            return false; /* string ended unexpectedly */
+        }
+
+        if (*input_end == '\"')
+        {
+            break;
+        }
+
+        /* is escape sequence */
+        if (input_end[0] == '\\')
+        {
+            if ((input_end + 1) >= buffer_end)
+            {
+                /* prevent buffer overflow when last input character is a backslash */
+                return false;
+            }
+            (*skipped_bytes)++;
+            input_end++;
+        }
+        /* control characters are taken as they are */
+        input_end++;
+    }
+
+    *string_end = input_end;
+    return true;
+}
+
+/* Unescape the string literal from *input_pointer up to input_end into output.
+ * Returns the end of the output or NULL on an invalid escape sequence, in which case *input_pointer is left on it. */
+static unsigned char *unescape_string(const unsigned char **input_pointer, const unsigned char * const input_end, unsigned char *output_pointer)
+{
+    const unsigned char *input = *input_pointer;
+
+    /* loop through the string literal */
+    while (input < input_end)
+    {
+        if (*input != '\\')
+        {
+            *output_pointer++ = *input++;
+        }
+        /* escape sequence */
+        else
+        {
+            unsigned char sequence_length = 2;
+            if ((input_end - input) < 1)
+            {
+                goto fail;
+            }
+
+            switch (input[1])
+            {
+                case 'b':
+                    *output_pointer++ = '\b';
+                    break;
+                case 'f':
+                    *output_pointer++ = '\f';
+                    break;
+                case 'n':
+                    *output_pointer++ = '\n';
+                    break;
+                case 'r':
+                    *output_pointer++ = '\r';
+                    break;
+                case 't':
+                    *output_pointer++ = '\t';
+                    break;
+                case '\"':
+                case '\\':
+                case '/':
+                    *output_pointer++ = input[1];
+                    break;
+
+                /* UTF-16 literal */
+                case 'u':
+                    sequence_length = utf16_literal_to_utf8(input, input_end, &output_pointer);
+                    if (sequence_length == 0)
+                    {
+                        /* failed to convert UTF16-literal to UTF-8 */
+                        goto fail;
+                    }
+                    break;
+
+                default:
+                    goto fail;
+            }
+            input += sequence_length;
+        }
+    }
+
+    *input_pointer = input;
+    return output_pointer;
+
+fail:
+    *input_pointer = input;
+    return NULL;
+}
+
+static void* cast_away_const(const void* string);
+
+/* Parse the input text into an unescaped cinput, and populate item. */
+static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
+{
+    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
+    const unsigned char *input_end = NULL;
+    unsigned char *output_pointer = NULL;
+    unsigned char *output = NULL;
+    size_t skipped_bytes = 0;
+
+    /* not a string */
+    if (buffer_at_offset(input_buffer)[0] != '\"')
+    {
+        goto fail;
+    }
+
+    if (!find_string_end(input_buffer, &input_end, &skipped_bytes))
+    {
+        goto fail;
+    }
+
+    if (input_buffer->in_situ)
+    {
+        /* unescaping never makes a string longer, so it is decoded where it is and terminated at the latest on the closing quote */
+        output = (unsigned char*)cast_away_const(input_pointer);
+    }
+    else
+    {
+        /* This is at most how much we need for the output */
+        size_t allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
+        output = (unsigned char*)parse_allocate(input_buffer, allocation_length + sizeof(""));
+        if (output == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+    }
+
+    if (input_buffer->in_situ && (skipped_bytes == 0))
+    {
+        /* nothing to unescape, the string is already in place */
+        output_pointer = output + (input_end - input_pointer);
+    }
+    else
+    {
+        output_pointer = unescape_string(&input_pointer, input_end, output);
+        if (output_pointer == NULL)
+        {
+            goto fail;
+        }
+    }
+
+    /* zero terminate the output */
+    *output_pointer = '\0';
+
+    set_parsed_type(item, cJSON_String);
+    item->valuestring = (char*)output;
+
+    input_buffer->offset = (size_t) (input_end - input_buffer->content);
+    input_buffer->offset++;
+
+    return true;
+
+fail:
+    if ((output != NULL) && !input_buffer->in_situ)
+    {
+        parse_deallocate(input_buffer, output);
+        output = NULL;
+    }
+
+    if (input_pointer != NULL)
+    {
+        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+    }
+
+    return false;
+}
+
+/* Parse the name of an object member into item->string, sharing it through the key table if there is one. */
+static cJSON_bool parse_key(cJSON * const item, parse_buffer * const input_buffer)
+{
+    const unsigned char *input_end = NULL;
+    size_t skipped_bytes = 0;
+    char *key = NULL;
+
+    if ((input_buffer->key_table != NULL) && (buffer_at_offset(input_buffer)[0] == '\"')
+        && find_string_end(input_buffer, &input_end, &skipped_bytes) && (skipped_bytes == 0))
+    {
+        /* without escape sequences the key is looked up right in the input */
+        key = intern_key(input_buffer->key_table, buffer_at_offset(input_buffer) + 1, (size_t)(input_end - buffer_at_offset(input_buffer)) - 1);
+    }
+
+    if (key == NULL)
+    {
+        if (!parse_string(item, input_buffer))
+        {
+            return false;
+        }
+
+        /* swap valuestring and string, because we parsed the name */
+        item->string = item->valuestring;
+        item->valuestring = NULL;
+
+        return true;
+    }
+
+    item->string = key;
+    item->type |= cJSON_StringIsConst | cJSON_StringIsInterned;
+    input_buffer->offset = (size_t)(input_end - input_buffer->content) + 1;
+
+    return true;
+}
+
+/* numbers of additional characters needed for escaping the string from input to input_end */
+static size_t count_escape_characters(const unsigned char * const input, const unsigned char * const input_end)
+{
+    const unsigned char *input_pointer = NULL;
+    size_t escape_characters = 0;
+
+    /* jump from one character that needs to be escaped to the next */
+    for (input_pointer = input + find_string_special(input, (size_t)(input_end - input));
+         input_pointer < input_end;
+         input_pointer += 1 + find_string_special(input_pointer + 1, (size_t)(input_end - input_pointer - 1)))
+    {
+        switch (*input_pointer)
+        {
+            case '\"':
+            case '\\':
+            case '\b':
+            case '\f':
+            case '\n':
+            case '\r':
+            case '\t':
+                /* one character escape sequence */
+                escape_characters++;
+                break;
+            default:
+                /* UTF-16 escape sequence uXXXX */
+                escape_characters += 5;
+                break;
+        }
+    }
+
+    return escape_characters;
+}
+
+/* Render the cstring provided to an escaped version that can be printed. */
+static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffer * const output_buffer)
+{
+    const unsigned char *input_pointer = NULL;
+    const unsigned char *input_end = NULL;
+    unsigned char *output = NULL;
+    unsigned char *output_pointer = NULL;
+    size_t output_length = 0;
+    /* numbers of additional characters needed for escaping */
+    size_t escape_characters = 0;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* empty string */
+    if (input == NULL)
+    {
+        output = ensure(output_buffer, sizeof("\"\"") - 1);
+        if (output == NULL)
+        {
+            return false;
+        }
+        strcpy((char*)output, "\"\"");
+
+        return true;
+    }
+
+    input_end = input + strlen((const char*)input);
+    escape_characters = count_escape_characters(input, input_end);
+    output_length = (size_t)(input_end - input) + escape_characters;
+
+    output = ensure(output_buffer, output_length + sizeof("\"\"") - 1);
+    if (output == NULL)
+    {
+        return false;
+    }
+
+    /* no characters have to be escaped */
+    if (escape_characters == 0)
+    {
+        output[0] = '\"';
+        memcpy(output + 1, input, output_length);
+        output[output_length + 1] = '\"';
+        output[output_length + 2] = '\0';
+
+        return true;
+    }
+
+    output[0] = '\"';
+    output_pointer = output + 1;
+    /* copy the string in runs of normal characters */
+    for (input_pointer = input; input_pointer < input_end; (void)input_pointer++, output_pointer++)
+    {
+        size_t run_length = find_string_special(input_pointer, (size_t)(input_end - input_pointer));
+        memcpy(output_pointer, input_pointer, run_length);
+        input_pointer += run_length;
+        output_pointer += run_length;
+        if (input_pointer == input_end)
+        {
+            break;
+        }
+
+        /* character needs to be escaped */
+        *output_pointer++ = '\\';
+        switch (*input_pointer)
+        {
+            case '\\':
+                *output_pointer = '\\';
+                break;
+            case '\"':
+                *output_pointer = '\"';
+                break;
+            case '\b':
+                *output_pointer = 'b';
+                break;
+            case '\f':
+                *output_pointer = 'f';
+                break;
+            case '\n':
+                *output_pointer = 'n';
+                break;
+            case '\r':
+                *output_pointer = 'r';
+                break;
+            case '\t':
+                *output_pointer = 't';
+                break;
+            default:
+                /* escape and print as unicode codepoint */
+                sprintf((char*)output_pointer, "u%04x", *input_pointer);
+                output_pointer += 4;
+                break;
+        }
+    }
+    output[output_length + 1] = '\"';
+    output[output_length + 2] = '\0';
+
+    return true;
+}
+
+/* Invoke print_string_ptr (which is useful) on an item. */
+static cJSON_bool print_string(const cJSON * const item, printbuffer * const p)
+{
+    return print_string_ptr((unsigned char*)item->valuestring, p);
+}
+
+/* Predeclare these prototypes. */
+static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool measure_value(const cJSON * const item, const cJSON_bool format, const size_t depth, size_t * const length);
+
+/* Utility to jump whitespace and cr/lf */
+static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL))
+    {
+        return NULL;
+    }
+
+    if (cannot_access_at_index(buffer, 0))
+    {
+        return buffer;
+    }
+
+    if (can_access_at_index(buffer, 0) && (buffer_at_offset(buffer)[0] <= 32))
+    {
+        buffer->offset += skip_whitespace_bytes(buffer_at_offset(buffer), buffer->length - buffer->offset);
+    }
+
+    if (buffer->offset == buffer->length)
+    {
+        buffer->offset--;
+    }
+
+    return buffer;
+}
+
+/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
+static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
+    {
+        return NULL;
+    }
+
+    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
+    {
+        buffer->offset += 3;
+    }
+
+    return buffer;
+}
+
+/* where parsing of the buffer failed, NULL if there is no buffer */
+static const char *parse_error_position(const parse_buffer * const buffer)
+{
+    size_t position = 0;
+
+    if (buffer->content == NULL)
+    {
+        return NULL;
+    }
+
+    if (buffer->offset < buffer->length)
+    {
+        position = buffer->offset;
+    }
+    else if (buffer->length > 0)
+    {
+        position = buffer->length - 1;
+    }
+
+    return (const char*)buffer->content + position;
+}
+
+static void set_context_error(cJSON_ParseContext * const context, const parse_buffer * const buffer)
+{
+    context->error = parse_error_position(buffer);
+    context->end = context->error;
+}
+
+/* Parse an object - create a new root, and populate. The caller sets up content, length and the allocation strategy of the buffer. */
+static cJSON *parse_root(parse_buffer * const buffer, cJSON_ParseContext * const context)
+{
+    const char *value = (const char*)buffer->content;
+    cJSON *item = NULL;
+
+    if (value == NULL || 0 == buffer->length)
+    {
+        goto fail;
+    }
+
+    buffer->offset = 0;
+    buffer->depth = 0;
+
+    item = parse_new_item(buffer);
+    if (item == NULL) /* memory fail */
+    {
+        goto fail;
+    }
+
+    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(buffer))))
+    {
+        /* parse failure. ep is set. */
+        goto fail;
+    }
+
+    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
+    if (context->require_null_terminated)
+    {
+        buffer_skip_whitespace(buffer);
+        if ((buffer->offset >= buffer->length) || buffer_at_offset(buffer)[0] != '\0')
+        {
+            goto fail;
+        }
+    }
+    context->end = (const char*)buffer_at_offset(buffer);
+
+    return item;
+
+fail:
+    if (item != NULL)
+    {
+        cJSON_Delete(item);
+    }
+
+    set_context_error(context, buffer);
+
+    return NULL;
+}
+
+CJSON_PUBLIC(void) cJSON_InitParseContext(cJSON_ParseContext * const context)
+{
+    if (context != NULL)
+    {
+        memset(context, '\0', sizeof(cJSON_ParseContext));
+    }
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithContext(const char *value, size_t buffer_length, cJSON_ParseContext * const context)
+{
+    parse_buffer buffer;
+    size_t arena_used = 0;
+    cJSON *item = NULL;
+
+    if (context == NULL)
+    {
+        return NULL;
+    }
+
+    context->end = NULL;
+    context->error = NULL;
+
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.nesting_limit = CJSON_NESTING_LIMIT;
+    buffer.content = (const unsigned char*)value;
+    buffer.length = buffer_length;
+    buffer.hooks = global_hooks;
+    buffer.arena = context->arena;
+    buffer.key_table = context->key_table;
+    buffer.in_situ = context->in_situ;
+    if ((context->nesting_limit != 0) && (context->nesting_limit < CJSON_NESTING_LIMIT))
+    {
+        buffer.nesting_limit = context->nesting_limit;
+    }
+
+    if (context->in_situ)
+    {
+        buffer.item_flags = cJSON_StringIsConst | cJSON_ValuestringIsConst;
+    }
+    if (context->arena != NULL)
+    {
+        buffer.item_flags = cJSON_ItemInArena | cJSON_StringIsConst | cJSON_ValuestringIsConst;
+        arena_used = context->arena->used;
+    }
+
+    item = parse_root(&buffer, context);
+    if ((item == NULL) && (context->arena != NULL))
+    {
+        /* drop whatever the failed parse left behind */
+        context->arena->used = arena_used;
+    }
+
+    return item;
+}
+
+/* the shortcuts report errors through cJSON_GetErrorPtr, like they always did */
+static void set_global_error(const cJSON_ParseContext * const context)
+{
+    global_error.json = (const unsigned char*)context->error;
+    global_error.position = 0;
+}
+
+static cJSON *parse_with_global_error(const char *value, size_t buffer_length, cJSON_ParseContext * const context)
+{
+    cJSON *item = cJSON_ParseWithContext(value, buffer_length, context);
+
+    set_global_error(context);
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    size_t buffer_length;
+
+    if (NULL == value)
+    {
+        return NULL;
+    }
+
+    /* Adding null character size due to require_null_terminated. */
+    buffer_length = strlen(value) + sizeof("");
+
+    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    cJSON_ParseContext context;
+    cJSON *item = NULL;
+
+    cJSON_InitParseContext(&context);
+    context.require_null_terminated = require_null_terminated;
+
+    item = parse_with_global_error(value, buffer_length, &context);
+    if ((return_parse_end != NULL) && (context.end != NULL))
+    {
+        *return_parse_end = context.end;
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithArena(const char *value, size_t buffer_length, cJSON_Arena * const arena)
+{
+    cJSON_ParseContext context;
+
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+
+    cJSON_InitParseContext(&context);
+    context.arena = arena;
+
+    return parse_with_global_error(value, buffer_length, &context);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSitu(char *value, size_t buffer_length)
+{
+    return cJSON_ParseInSituWithArena(value, buffer_length, NULL);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSituWithArena(char *value, size_t buffer_length, cJSON_Arena * const arena)
+{
+    cJSON_ParseContext context;
+
+    cJSON_InitParseContext(&context);
+    context.arena = arena;
+    context.in_situ = true;
+
+    return parse_with_global_error(value, buffer_length, &context);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithKeyTable(const char *value, size_t buffer_length, cJSON_KeyTable * const table)
+{
+    cJSON_ParseContext context;
+
+    if (table == NULL)
+    {
+        return NULL;
+    }
+
+    cJSON_InitParseContext(&context);
+    context.key_table = table;
+
+    return parse_with_global_error(value, buffer_length, &context);
+}
+
+/* Default options for cJSON_Parse */
+CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+{
+    return cJSON_ParseWithOpts(value, 0, 0);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+{
+    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+}
+
+static unsigned char *print(const cJSON * const item, cJSON_bool format, const internal_hooks * const hooks)
+{
+    printbuffer buffer[1];
+    size_t length = 0;
+
+    /* measure first, so that the output can be allocated once with the exact size */
+    if (!measure_value(item, format, 0, &length) || (length >= INT_MAX))
+    {
+        return NULL;
+    }
+
+    memset(buffer, 0, sizeof(buffer));
+
+    /* create buffer */
+    buffer->buffer = (unsigned char*) hooks->allocate(length + sizeof(""));
+    buffer->length = length + sizeof("");
+    buffer->noalloc = true;
+    buffer->format = format;
+    buffer->hooks = *hooks;
+    if (buffer->buffer == NULL)
+    {
+        return NULL;
+    }
+
+    /* print the value */
+    if (!print_value(item, buffer))
+    {
+        hooks->deallocate(buffer->buffer);
+        return NULL;
+    }
+
+    return buffer->buffer;
+}
+
+/* Render a cJSON item/entity/structure to text. */
+CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item)
+{
+    return (char*)print(item, true, &global_hooks);
+}
+
+CJSON_PUBLIC(char *) cJSON_PrintUnformatted(const cJSON *item)
+{
+    return (char*)print(item, false, &global_hooks);
+}
+
+CJSON_PUBLIC(size_t) cJSON_PrintedLength(const cJSON *item, cJSON_bool format)
+{
+    size_t length = 0;
+
+    if (!measure_value(item, format, 0, &length))
+    {
+        return 0;
+    }
+
+    return length;
+}
+
+CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON_bool fmt)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+
+    if (prebuffer < 0)
+    {
+        return NULL;
+    }
+
+    p.buffer = (unsigned char*)global_hooks.allocate((size_t)prebuffer);
+    if (!p.buffer)
+    {
+        return NULL;
+    }
+
+    p.length = (size_t)prebuffer;
+    p.offset = 0;
+    p.noalloc = false;
+    p.format = fmt;
+    p.hooks = global_hooks;
+
+    if (!print_value(item, &p))
+    {
+        global_hooks.deallocate(p.buffer);
+        p.buffer = NULL;
+        return NULL;
+    }
+
+    return (char*)p.buffer;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+
+    if ((length < 0) || (buffer == NULL))
+    {
+        return false;
+    }
+
+    p.buffer = (unsigned char*)buffer;
+    p.length = (size_t)length;
+    p.offset = 0;
+    p.noalloc = true;
+    p.format = format;
+    p.hooks = global_hooks;
+
+    return print_value(item, &p);
+}
+
+/* Streaming writer. The values are printed straight into the caller's buffer with the same escaping and number
+ * formatting as cJSON_PrintUnformatted, no cJSON items are created and nothing is allocated. */
+
+/* a printbuffer on top of the writer's buffer, ensure never reallocates it */
+static void writer_output(const cJSON_Writer * const writer, printbuffer * const output)
+{
+    memset(output, 0, sizeof(*output));
+    output->buffer = (unsigned char*)writer->buffer;
+    output->length = writer->length;
+    output->offset = writer->offset;
+    output->noalloc = true;
+    output->hooks = global_hooks;
+}
+
+static cJSON_bool writer_put(cJSON_Writer * const writer, const char character)
+{
+    if ((writer->offset + 1) >= writer->length)
+    {
+        writer->failed = true;
+        return false;
+    }
+
+    writer->buffer[writer->offset++] = character;
+    writer->buffer[writer->offset] = '\0';
+
+    return true;
+}
+
+/* everything but the first value of an object or array is preceded by a comma */
+static cJSON_bool writer_separate(cJSON_Writer * const writer)
+{
+    if ((writer == NULL) || (writer->buffer == NULL) || writer->failed)
+    {
+        return false;
+    }
+
+    if (writer->separate)
+    {
+        return writer_put(writer, ',');
+    }
+
+    return true;
+}
+
+static cJSON_bool writer_string(cJSON_Writer * const writer, const char *string)
+{
+    printbuffer output;
+
+    writer_output(writer, &output);
+    if (!print_string_ptr((const unsigned char*)string, &output))
+    {
+        writer->failed = true;
+        return false;
+    }
+    update_offset(&output);
+    writer->offset = output.offset;
+
+    return true;
+}
+
+CJSON_PUBLIC(void) cJSON_InitWriter(cJSON_Writer * const writer, char *buffer, size_t length)
+{
+    if (writer == NULL)
+    {
+        return;
+    }
+
+    writer->buffer = buffer;
+    writer->length = length;
+    writer->offset = 0;
+    writer->separate = false;
+    writer->failed = (buffer == NULL) || (length == 0);
+    if (!writer->failed)
+    {
+        buffer[0] = '\0';
+    }
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterBeginObject(cJSON_Writer * const writer)
+{
+    if (!writer_separate(writer) || !writer_put(writer, '{'))
+    {
+        return false;
+    }
+    writer->separate = false;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterEndObject(cJSON_Writer * const writer)
+{
+    if ((writer == NULL) || writer->failed || !writer_put(writer, '}'))
+    {
+        return false;
+    }
+    writer->separate = true;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterBeginArray(cJSON_Writer * const writer)
+{
+    if (!writer_separate(writer) || !writer_put(writer, '['))
+    {
+        return false;
+    }
+    writer->separate = false;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterEndArray(cJSON_Writer * const writer)
+{
+    if ((writer == NULL) || writer->failed || !writer_put(writer, ']'))
+    {
+        return false;
+    }
+    writer->separate = true;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterKey(cJSON_Writer * const writer, const char *key)
+{
+    if ((key == NULL) || !writer_separate(writer) || !writer_string(writer, key) || !writer_put(writer, ':'))
+    {
+        return false;
+    }
+    writer->separate = false;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterString(cJSON_Writer * const writer, const char *string)
+{
+    if (!writer_separate(writer) || !writer_string(writer, string))
+    {
+        return false;
+    }
+    writer->separate = true;
+
+    return true;
+}
+
+/* copy a number rendered by format_number_value or format_float_value */
+static cJSON_bool writer_number(cJSON_Writer * const writer, const unsigned char * const number_buffer, const int length)
+{
+    if (!writer_separate(writer))
+    {
+        return false;
+    }
+
+    if ((length < 0) || ((writer->offset + (size_t)length) >= writer->length))
+    {
+        writer->failed = true;
+        return false;
+    }
+
+    memcpy(writer->buffer + writer->offset, number_buffer, (size_t)length);
+    writer->offset += (size_t)length;
+    writer->buffer[writer->offset] = '\0';
+    writer->separate = true;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterNumber(cJSON_Writer * const writer, double number)
+{
+    unsigned char number_buffer[26] = {0};
+    int integer = 0;
+
+    /* same saturation as cJSON_CreateNumber */
+    if (number >= INT_MAX)
+    {
+        integer = INT_MAX;
+    }
+    else if (number <= (double)INT_MIN)
+    {
+        integer = INT_MIN;
+    }
+    else if (!isnan(number))
+    {
+        integer = (int)number;
+    }
+
+    return writer_number(writer, number_buffer, format_number_value(number, integer, number_buffer));
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterBool(cJSON_Writer * const writer, const cJSON_bool boolean)
+{
+    const char *literal = boolean ? "true" : "false";
+
+    if (!writer_separate(writer))
+    {
+        return false;
+    }
+
+    for (; *literal != '\0'; literal++)
+    {
+        if (!writer_put(writer, *literal))
+        {
+            return false;
+        }
+    }
+    writer->separate = true;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterNull(cJSON_Writer * const writer)
+{
+    const char *literal = "null";
+
+    if (!writer_separate(writer))
+    {
+        return false;
+    }
+
+    for (; *literal != '\0'; literal++)
+    {
+        if (!writer_put(writer, *literal))
+        {
+            return false;
+        }
+    }
+    writer->separate = true;
+
+    return true;
+}
+
+CJSON_PUBLIC(size_t) cJSON_WriterLength(const cJSON_Writer * const writer)
+{
+    if ((writer == NULL) || writer->failed)
+    {
+        return 0;
+    }
+
+    return writer->offset;
+}
+
+/* Struct binding. A field table is a flattened tree: an object field is followed by the count fields of the object,
+ * so the fields of a scope are found by walking the table and jumping over nested objects. */
+
+/* index after the field and everything nested in it */
+static size_t binding_next(const cJSON_Field * const fields, const size_t index)
+{
+    if (fields[index].type == cJSON_FieldObject)
+    {
+        return index + 1 + fields[index].count;
+    }
+
+    return index + 1;
+}
+
+static cJSON_bool binding_load_integer(const unsigned char * const member, const size_t size, const cJSON_bool is_signed, double * const number)
+{
+    if (size == sizeof(unsigned char))
+    {
+        unsigned char value = 0;
+        memcpy(&value, member, sizeof(value));
+        *number = is_signed ? (double)(signed char)value : (double)value;
+    }
+    else if (size == sizeof(unsigned short))
+    {
+        unsigned short value = 0;
+        memcpy(&value, member, sizeof(value));
+        *number = is_signed ? (double)(short)value : (double)value;
+    }
+    else if (size == sizeof(unsigned int))
+    {
+        unsigned int value = 0;
+        memcpy(&value, member, sizeof(value));
+        *number = is_signed ? (double)(int)value : (double)value;
+    }
+    else if (size == sizeof(unsigned long))
+    {
+        unsigned long value = 0;
+        memcpy(&value, member, sizeof(value));
+        *number = is_signed ? (double)(long)value : (double)value;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/* numbers are truncated like valueint, but a number the member can't hold is rejected instead of saturated */
+static cJSON_bool binding_store_integer(unsigned char * const member, const size_t size, const cJSON_bool is_signed, const double number)
+{
+    double minimum = 0;
+    double maximum = 0;
+
+    if (size == sizeof(unsigned char))
+    {
+        minimum = is_signed ? SCHAR_MIN : 0;
+        maximum = is_signed ? SCHAR_MAX : UCHAR_MAX;
+    }
+    else if (size == sizeof(unsigned short))
+    {
+        minimum = is_signed ? SHRT_MIN : 0;
+        maximum = is_signed ? SHRT_MAX : USHRT_MAX;
+    }
+    else if (size == sizeof(unsigned int))
+    {
+        minimum = is_signed ? (double)INT_MIN : 0;
+        maximum = is_signed ? (double)INT_MAX : (double)UINT_MAX;
+    }
+    else if (size == sizeof(unsigned long))
+    {
+        minimum = is_signed ? (double)LONG_MIN : 0;
+        maximum = is_signed ? (double)LONG_MAX : (double)ULONG_MAX;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (!(number > (minimum - 1)) || !(number < (maximum + 1)))
+    {
+        /* also rejects NaN */
+        return false;
+    }
+
+    if (size == sizeof(unsigned char))
+    {
+        unsigned char value = 0;
+        if (is_signed)
+        {
+            value = (unsigned char)(signed char)number;
+        }
+        else
+        {
+            value = (unsigned char)number;
+        }
+        memcpy(member, &value, sizeof(value));
+    }
+    else if (size == sizeof(unsigned short))
+    {
+        unsigned short value = 0;
+        if (is_signed)
+        {
+            value = (unsigned short)(short)number;
+        }
+        else
+        {
+            value = (unsigned short)number;
+        }
+        memcpy(member, &value, sizeof(value));
+    }
+    else if (size == sizeof(unsigned int))
+    {
+        unsigned int value = 0;
+        if (is_signed)
+        {
+            value = (unsigned int)(int)number;
+        }
+        else
+        {
+            value = (unsigned int)number;
+        }
+        memcpy(member, &value, sizeof(value));
+    }
+    else
+    {
+        unsigned long value = 0;
+        if (is_signed)
+        {
+            value = (unsigned long)(long)number;
+        }
+        else
+        {
+            value = (unsigned long)number;
+        }
+        memcpy(member, &value, sizeof(value));
+    }
+
+    return true;
+}
+
+static cJSON_bool writer_fields(cJSON_Writer * const writer, const cJSON_Field * const fields, const size_t start, const size_t end, const unsigned char * const structure)
+{
+    size_t index = start;
+
+    for (index = start; index < end; index = binding_next(fields, index))
+    {
+        const cJSON_Field *field = &fields[index];
+        const unsigned char *member = structure + field->offset;
+        double number = 0;
+
+        if (!cJSON_WriterKey(writer, field->key))
+        {
+            return false;
+        }
+
+        switch (field->type)
+        {
+            case cJSON_FieldDouble:
+                memcpy(&number, member, sizeof(number));
+                cJSON_WriterNumber(writer, number);
+                break;
+
+            case cJSON_FieldFloat:
+            {
+                /* printed as a double, 23.1f would come out as 23.100000381469727 */
+                unsigned char number_buffer[26] = {0};
+                float value = 0;
+                memcpy(&value, member, sizeof(value));
+                writer_number(writer, number_buffer, format_float_value(value, number_buffer));
+                break;
+            }
+
+            case cJSON_FieldInt:
+            case cJSON_FieldUnsigned:
+                if (!binding_load_integer(member, field->size, field->type == cJSON_FieldInt, &number))
+                {
+                    writer->failed = true;
+                    return false;
+                }
+                cJSON_WriterNumber(writer, number);
+                break;
+
+            case cJSON_FieldBool:
+                if (!binding_load_integer(member, field->size, false, &number))
+                {
+                    writer->failed = true;
+                    return false;
+                }
+                if (field->names == NULL)
+                {
+                    cJSON_WriterBool(writer, number != 0);
+                }
+                else if (field->count == 2)
+                {
+                    cJSON_WriterString(writer, field->names[(number != 0) ? 1 : 0]);
+                }
+                else
+                {
+                    writer->failed = true;
+                    return false;
+                }
+                break;
+
+            case cJSON_FieldString:
+                /* the array may be full without a terminating zero */
+                if (memchr(member, '\0', field->size) == NULL)
+                {
+                    writer->failed = true;
+                    return false;
+                }
+                cJSON_WriterString(writer, (const char*)member);
+                break;
+
+            case cJSON_FieldEnum:
+                if (!binding_load_integer(member, field->size, false, &number))
+                {
+                    writer->failed = true;
+                    return false;
+                }
+                if (number < (double)field->count)
+                {
+                    cJSON_WriterString(writer, field->names[(size_t)number]);
+                }
+                else
+                {
+                    cJSON_WriterNull(writer);
+                }
+                break;
+
+            case cJSON_FieldObject:
+                cJSON_WriterBeginObject(writer);
+                writer_fields(writer, fields, index + 1, index + 1 + field->count, structure);
+                cJSON_WriterEndObject(writer);
+                break;
+
+            default:
+                writer->failed = true;
+                return false;
+        }
+    }
+
+    return !writer->failed;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterFields(cJSON_Writer * const writer, const cJSON_Field * const fields, const size_t count, const void *structure)
+{
+    if ((writer == NULL) || (fields == NULL) || (structure == NULL) || writer->failed)
+    {
+        return false;
+    }
+
+    return writer_fields(writer, fields, 0, count, (const unsigned char*)structure);
+}
+
+/* length first and the exact bytes before the case insensitive comparison, keys almost always match exactly */
+static cJSON_bool binding_key_equals(const cJSON_Field * const field, const char *key, const size_t length)
+{
+    size_t i = 0;
+
+    if ((field->key_length != length) || (length == 0))
+    {
+        return field->key_length == length;
+    }
+
+    if (memcmp(field->key, key, length) == 0)
+    {
+        return true;
+    }
+
+    for (i = 0; i < length; i++)
+    {
+        if (lowercase[(unsigned char)field->key[i]] != lowercase[(unsigned char)key[i]])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* the object field a field belongs to, count for the top level */
+static size_t binding_parent(const cJSON_Binding * const binding, const size_t index)
+{
+    size_t parent = binding->count;
+    size_t candidate = 0;
+
+    for (candidate = 0; candidate < index; candidate++)
+    {
+        if ((binding->fields[candidate].type == cJSON_FieldObject) && (index <= (candidate + binding->fields[candidate].count)))
+        {
+            parent = candidate;
+        }
+    }
+
+    return parent;
+}
+
+/* the field a value is stored in, NULL if the value is skipped */
+static const cJSON_Field *binding_target(cJSON_Binding * const binding)
+{
+    if ((binding->skip > 0) || (binding->field >= binding->count) || ((binding->found & (1UL << binding->field)) != 0))
+    {
+        return NULL;
+    }
+
+    return &binding->fields[binding->field];
+}
+
+static void binding_stored(cJSON_Binding * const binding)
+{
+    binding->found |= 1UL << binding->field;
+    binding->field = binding->count;
+}
+
+static cJSON_bool binding_start_object(void *user_data)
+{
+    cJSON_Binding *binding = (cJSON_Binding*)user_data;
+    const cJSON_Field *field = NULL;
+
+    if (!binding->started)
+    {
+        binding->started = true;
+        binding->scope = binding->count;
+        binding->field = binding->count;
+        return true;
+    }
+
+    field = binding_target(binding);
+    if (field == NULL)
+    {
+        binding->skip++;
+        return true;
+    }
+
+    if (field->type != cJSON_FieldObject)
+    {
+        return false;
+    }
+
+    binding->scope = binding->field;
+    binding_stored(binding);
+
+    return true;
+}
+
+static cJSON_bool binding_start_array(void *user_data)
+{
+    cJSON_Binding *binding = (cJSON_Binding*)user_data;
+
+    /* there are no array fields */
+    if (!binding->started || (binding_target(binding) != NULL))
+    {
+        return false;
+    }
+    binding->skip++;
+
+    return true;
+}
+
+static cJSON_bool binding_end(void *user_data)
+{
+    cJSON_Binding *binding = (cJSON_Binding*)user_data;
+
+    if (binding->skip > 0)
+    {
+        binding->skip--;
+    }
+    else if (binding->scope < binding->count)
+    {
+        binding->scope = binding_parent(binding, binding->scope);
+    }
+    binding->field = binding->count;
+
+    return true;
+}
+
+static cJSON_bool binding_key(void *user_data, const char *key, size_t length)
+{
+    cJSON_Binding *binding = (cJSON_Binding*)user_data;
+    size_t index = 0;
+    size_t end = binding->count;
+
+    binding->field = binding->count;
+    if (binding->skip > 0)
+    {
+        return true;
+    }
+
+    if (binding->scope < binding->count)
+    {
+        index = binding->scope + 1;
+        end = index + binding->fields[binding->scope].count;
+    }
+
+    for (; index < end; index = binding_next(binding->fields, index))
+    {
+        if (binding_key_equals(&binding->fields[index], key, length))
+        {
+            binding->field = index;
+            break;
+        }
+    }
+
+    return true;
+}
+
+static cJSON_bool binding_string(void *user_data, const char *string, size_t length)
+{
+    cJSON_Binding *binding = (cJSON_Binding*)user_data;
+    const cJSON_Field *field = NULL;
+    unsigned char *member = NULL;
+    size_t index = 0;
+
+    if (!binding->started)
+    {
+        return false;
+    }
+
+    field = binding_target(binding);
+    if (field == NULL)
+    {
+        return true;
+    }
+    member = binding->structure + field->offset;
+
+    if (field->type == cJSON_FieldString)
+    {
+        if (field->size == 0)
+        {
+            return false;
+        }
+        if (length >= field->size)
+        {
+            length = field->size - 1;
+        }
+        memcpy(member, string, length);
+        member[length] = '\0';
+    }
+    else if (field->type == cJSON_FieldEnum)
+    {
+        for (index = 0; index < field->count; index++)
+        {
+            if ((strlen(field->names[index]) == length) && (memcmp(field->names[index], string, length) == 0))
+            {
+                break;
+            }
+        }
+        if (!binding_store_integer(member, field->size, false, (double)index))
+        {
+            return false;
+        }
+    }
+    else if ((field->type == cJSON_FieldBool) && (field->names != NULL) && (field->count == 2))
+    {
+        /* unlike an enum there is no value left for other names, a bool member can only hold 0 and 1 */
+        for (index = 0; index < 2; index++)
+        {
+            if ((strlen(field->names[index]) == length) && (memcmp(field->names[index], string, length) == 0))
+            {
+                break;
+            }
+        }
+        if ((index == 2) || !binding_store_integer(member, field->size, false, (double)index))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    binding_stored(binding);
+
+    return true;
+}
+
+static cJSON_bool binding_number(void *user_data, double number)
+{
+    cJSON_Binding *binding = (cJSON_Binding*)user_data;
+    const cJSON_Field *field = NULL;
+    unsigned char *member = NULL;
+
+    if (!binding->started)
+    {
+        return false;
+    }
+
+    field = binding_target(binding);
+    if (field == NULL)
+    {
+        return true;
+    }
+    member = binding->structure + field->offset;
+
+    if (field->type == cJSON_FieldDouble)
+    {
+        memcpy(member, &number, sizeof(number));
+    }
+    else if (field->type == cJSON_FieldFloat)
+    {
+        float value = (float)number;
+        memcpy(member, &value, sizeof(value));
+    }
+    else if ((field->type != cJSON_FieldInt) && (field->type != cJSON_FieldUnsigned))
+    {
+        return false;
+    }
+    else if (!binding_store_integer(member, field->size, field->type == cJSON_FieldInt, number))
+    {
+        return false;
+    }
+
+    binding_stored(binding);
+
+    return true;
+}
+
+static cJSON_bool binding_boolean(void *user_data, cJSON_bool boolean)
+{
+    cJSON_Binding *binding = (cJSON_Binding*)user_data;
+    const cJSON_Field *field = NULL;
+
+    if (!binding->started)
+    {
+        return false;
+    }
+
+    field = binding_target(binding);
+    if (field == NULL)
+    {
+        return true;
+    }
+
+    if ((field->type != cJSON_FieldBool) || !binding_store_integer(binding->structure + field->offset, field->size, false, boolean ? 1 : 0))
+    {
+        return false;
+    }
+
+    binding_stored(binding);
+
+    return true;
+}
+
+static cJSON_bool binding_null(void *user_data)
+{
+    return ((cJSON_Binding*)user_data)->started;
+}
+
+static const cJSON_SAXHandler binding_handler = {
+    binding_start_object,
+    binding_end,
+    binding_start_array,
+    binding_end,
+    binding_key,
+    binding_string,
+    binding_number,
+    binding_boolean,
+    binding_null
+};
+
+CJSON_PUBLIC(cJSON_bool) cJSON_InitBinding(cJSON_Binding * const binding, const cJSON_Field * const fields, const size_t count, void *structure)
+{
+    if ((binding == NULL) || (fields == NULL) || (structure == NULL) || (count > (sizeof(binding->found) * CHAR_BIT)))
+    {
+        return false;
+    }
+
+    memset(binding, '\0', sizeof(*binding));
+    binding->fields = fields;
+    binding->count = count;
+    binding->structure = (unsigned char*)structure;
+    binding->scope = count;
+    binding->field = count;
+
+    return true;
+}
+
+CJSON_PUBLIC(const cJSON_SAXHandler *) cJSON_GetBindingHandler(void)
+{
+    return &binding_handler;
+}
+
+CJSON_PUBLIC(unsigned long) cJSON_GetBindingFound(const cJSON_Binding * const binding)
+{
+    if (binding == NULL)
+    {
+        return 0;
+    }
+
+    return binding->found;
+}
+
+/* Parser core - when encountering text, process appropriately. */
+static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer)
+{
+    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+    {
+        return false; /* no input */
+    }
+
+    /* parse the different types of values */
+    /* null */
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "null", 4) == 0))
+    {
+        set_parsed_type(item, cJSON_NULL);
+        input_buffer->offset += 4;
+        return true;
+    }
+    /* false */
+    if (can_read(input_buffer, 5) && (strncmp((const char*)buffer_at_offset(input_buffer), "false", 5) == 0))
+    {
+        set_parsed_type(item, cJSON_False);
+        input_buffer->offset += 5;
+        return true;
+    }
+    /* true */
+    if (can_read(input_buffer, 4) && (strncmp((const char*)buffer_at_offset(input_buffer), "true", 4) == 0))
+    {
+        set_parsed_type(item, cJSON_True);
+        item->valueint = 1;
+        input_buffer->offset += 4;
+        return true;
+    }
+    /* string */
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '\"'))
+    {
+        return parse_string(item, input_buffer);
+    }
+    /* number */
+    if (can_access_at_index(input_buffer, 0) && ((buffer_at_offset(input_buffer)[0] == '-') || ((buffer_at_offset(input_buffer)[0] >= '0') && (buffer_at_offset(input_buffer)[0] <= '9'))))
+    {
+        return parse_number(item, input_buffer);
+    }
+    /* array */
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '['))
+    {
+        return parse_array(item, input_buffer);
+    }
+    /* object */
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '{'))
+    {
+        return parse_object(item, input_buffer);
+    }
+
+    return false;
+}
+
+/* Render a value to text. */
+static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output = NULL;
+
+    if ((item == NULL) || (output_buffer == NULL))
+    {
+        return false;
+    }
+
+    switch ((item->type) & 0xFF)
+    {
+        case cJSON_NULL:
+            output = ensure(output_buffer, 4);
+            if (output == NULL)
+            {
+                return false;
+            }
+            strcpy((char*)output, "null");
+            return true;
+
+        case cJSON_False:
+            output = ensure(output_buffer, 5);
+            if (output == NULL)
+            {
+                return false;
+            }
+            strcpy((char*)output, "false");
+            return true;
+
+        case cJSON_True:
+            output = ensure(output_buffer, 4);
+            if (output == NULL)
+            {
+                return false;
+            }
+            strcpy((char*)output, "true");
+            return true;
+
+        case cJSON_Number:
+            return print_number(item, output_buffer);
+
+        case cJSON_Raw:
+        {
+            size_t raw_length = 0;
+            if (item->valuestring == NULL)
+            {
+                return false;
+            }
+
+            raw_length = strlen(item->valuestring);
+            output = ensure(output_buffer, raw_length);
+            if (output == NULL)
+            {
+                return false;
+            }
+            memcpy(output, item->valuestring, raw_length + sizeof(""));
+            return true;
+        }
+
+        case cJSON_String:
+            return print_string(item, output_buffer);
+
+        case cJSON_Array:
+            return print_array(item, output_buffer);
+
+        case cJSON_Object:
+            return print_object(item, output_buffer);
+
+        default:
+            return false;
+    }
+}
+
+/* Build an array from input text. */
+static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer)
+{
+    cJSON *head = NULL; /* head of the linked list */
+    cJSON *current_item = NULL;
+
+    if (input_buffer->depth >= input_buffer->nesting_limit)
+    {
+        return false; /* to deeply nested */
+    }
+    input_buffer->depth++;
+
+    if (buffer_at_offset(input_buffer)[0] != '[')
+    {
+        /* not an array */
+        goto fail;
+    }
+
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ']'))
+    {
+        /* empty array */
+        goto success;
+    }
+
+    /* check if we skipped to the end of the buffer */
+    if (cannot_access_at_index(input_buffer, 0))
+    {
+        input_buffer->offset--;
+        goto fail;
+    }
+
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+    /* loop through the comma separated array elements */
+    do
+    {
+        /* allocate next item */
+        cJSON *new_item = parse_new_item(input_buffer);
+        if (new_item == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+
+        /* attach next item to list */
+        if (head == NULL)
+        {
+            /* start the linked list */
+            current_item = head = new_item;
+        }
+        else
+        {
+            /* add to the end and advance */
+            current_item->next = new_item;
+            new_item->prev = current_item;
+            current_item = new_item;
+        }
+
+        /* parse next value */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!parse_value(current_item, input_buffer))
+        {
+            goto fail; /* failed to parse value */
+        }
+        buffer_skip_whitespace(input_buffer);
+    }
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
+
+    if (cannot_access_at_index(input_buffer, 0) || buffer_at_offset(input_buffer)[0] != ']')
+    {
+        goto fail; /* expected end of array */
+    }
+
+success:
+    input_buffer->depth--;
+
+    if (head != NULL) {
+        head->prev = current_item;
+    }
+
+    set_parsed_type(item, cJSON_Array);
+    item->child = head;
+
+    input_buffer->offset++;
+
+    return true;
+
+fail:
+    if (head != NULL)
+    {
+        cJSON_Delete(head);
+    }
+
+    return false;
+}
+
+/* Render an array to text */
+static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    size_t length = 0;
+    cJSON *current_element = item->child;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* Compose the output array. */
+    /* opening square bracket */
+    output_pointer = ensure(output_buffer, 1);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    *output_pointer = '[';
+    output_buffer->offset++;
+    output_buffer->depth++;
+
+    while (current_element != NULL)
+    {
+        if (!print_value(current_element, output_buffer))
+        {
+            return false;
+        }
+        update_offset(output_buffer);
+        if (current_element->next)
+        {
+            length = (size_t) (output_buffer->format ? 2 : 1);
+            output_pointer = ensure(output_buffer, length);
+            if (output_pointer == NULL)
+            {
+                return false;
+            }
+            *output_pointer++ = ',';
+            if(output_buffer->format)
+            {
+                *output_pointer++ = ' ';
+            }
+            *output_pointer = '\0';
+            output_buffer->offset += length;
+        }
+        current_element = current_element->next;
+    }
+
+    output_pointer = ensure(output_buffer, 1);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+    *output_pointer++ = ']';
+    *output_pointer = '\0';
+    output_buffer->depth--;
+
+    return true;
+}
+
+/* Build an object from the text. */
+static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer)
+{
+    cJSON *head = NULL; /* linked list head */
+    cJSON *current_item = NULL;
+
+    if (input_buffer->depth >= input_buffer->nesting_limit)
+    {
+        return false; /* to deeply nested */
+    }
+    input_buffer->depth++;
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '{'))
+    {
+        goto fail; /* not an object */
+    }
+
+    input_buffer->offset++;
+    buffer_skip_whitespace(input_buffer);
+    if (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '}'))
+    {
+        goto success; /* empty object */
+    }
+
+    /* check if we skipped to the end of the buffer */
+    if (cannot_access_at_index(input_buffer, 0))
+    {
+        input_buffer->offset--;
+        goto fail;
+    }
+
+    /* step back to character in front of the first element */
+    input_buffer->offset--;
+    /* loop through the comma separated array elements */
+    do
+    {
+        /* allocate next item */
+        cJSON *new_item = parse_new_item(input_buffer);
+        if (new_item == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+
+        /* attach next item to list */
+        if (head == NULL)
+        {
+            /* start the linked list */
+            current_item = head = new_item;
+        }
+        else
+        {
+            /* add to the end and advance */
+            current_item->next = new_item;
+            new_item->prev = current_item;
+            current_item = new_item;
+        }
+
+        if (cannot_access_at_index(input_buffer, 1))
+        {
+            goto fail; /* nothing comes after the comma */
+        }
+
+        /* parse the name of the child */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!parse_key(current_item, input_buffer))
+        {
+            goto fail; /* failed to parse name */
+        }
+        buffer_skip_whitespace(input_buffer);
+
+        if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
+        {
+            goto fail; /* invalid object */
+        }
+
+        /* parse the value */
+        input_buffer->offset++;
+        buffer_skip_whitespace(input_buffer);
+        if (!parse_value(current_item, input_buffer))
+        {
+            goto fail; /* failed to parse value */
+        }
+        buffer_skip_whitespace(input_buffer);
+    }
+    while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '}'))
+    {
+        goto fail; /* expected end of object */
+    }
+
+success:
+    input_buffer->depth--;
+
+    if (head != NULL) {
+        head->prev = current_item;
+    }
+
+    set_parsed_type(item, cJSON_Object);
+    item->child = head;
+
+    input_buffer->offset++;
+    return true;
+
+fail:
+    if (head != NULL)
+    {
+        cJSON_Delete(head);
+    }
+
+    return false;
+}
+
+/* Render an object to text. */
+static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    size_t length = 0;
+    cJSON *current_item = item->child;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* Compose the output: */
+    length = (size_t) (output_buffer->format ? 2 : 1); /* fmt: {\n */
+    output_pointer = ensure(output_buffer, length);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    *output_pointer++ = '{';
+    output_buffer->depth++;
+    if (output_buffer->format)
+    {
+        *output_pointer++ = '\n';
+    }
+    output_buffer->offset += length;
+
+    while (current_item)
+    {
+        if (output_buffer->format)
+        {
+            size_t i;
+            output_pointer = ensure(output_buffer, output_buffer->depth);
+            if (output_pointer == NULL)
+            {
+                return false;
+            }
+            for (i = 0; i < output_buffer->depth; i++)
+            {
+                *output_pointer++ = '\t';
+            }
+            output_buffer->offset += output_buffer->depth;
+        }
+
+        /* print key */
+        if (!print_string_ptr((unsigned char*)current_item->string, output_buffer))
+        {
+            return false;
+        }
+        update_offset(output_buffer);
+
+        length = (size_t) (output_buffer->format ? 2 : 1);
+        output_pointer = ensure(output_buffer, length);
+        if (output_pointer == NULL)
+        {
+            return false;
+        }
+        *output_pointer++ = ':';
+        if (output_buffer->format)
+        {
+            *output_pointer++ = '\t';
+        }
+        output_buffer->offset += length;
+
+        /* print value */
+        if (!print_value(current_item, output_buffer))
+        {
+            return false;
+        }
+        update_offset(output_buffer);
+
+        /* print comma if not last */
+        length = ((size_t)(output_buffer->format ? 1 : 0) + (size_t)(current_item->next ? 1 : 0));
+        output_pointer = ensure(output_buffer, length);
+        if (output_pointer == NULL)
+        {
+            return false;
+        }
+        if (current_item->next)
+        {
+            *output_pointer++ = ',';
+        }
+
+        if (output_buffer->format)
+        {
+            *output_pointer++ = '\n';
+        }
+        *output_pointer = '\0';
+        output_buffer->offset += length;
+
+        current_item = current_item->next;
+    }
+
+    output_pointer = ensure(output_buffer, output_buffer->format ? output_buffer->depth : 1);
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+    if (output_buffer->format)
+    {
+        size_t i;
+        for (i = 0; i < (output_buffer->depth - 1); i++)
+        {
+            *output_pointer++ = '\t';
+        }
+    }
+    *output_pointer++ = '}';
+    *output_pointer = '\0';
+    output_buffer->depth--;
+
+    return true;
+}
+
+/* Length of a string printed by print_string_ptr */
+static size_t measure_string(const unsigned char * const input)
+{
+    size_t length = 0;
+
+    if (input == NULL)
+    {
+        return sizeof("\"\"") - 1;
+    }
+
+    length = strlen((const char*)input);
+
+    return length + count_escape_characters(input, input + length) + sizeof("\"\"") - 1;
+}
+
+/* Add the length of item printed by print_value to length, depth is the nesting depth of the item */
+static cJSON_bool measure_value(const cJSON * const item, const cJSON_bool format, const size_t depth, size_t * const length)
+{
+    unsigned char number_buffer[26];
+    const cJSON *child = NULL;
+    int number_length = 0;
+
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    switch ((item->type) & 0xFF)
+    {
+        case cJSON_NULL:
+            *length += sizeof("null") - 1;
+            return true;
+
+        case cJSON_False:
+            *length += sizeof("false") - 1;
+            return true;
+
+        case cJSON_True:
+            *length += sizeof("true") - 1;
+            return true;
+
+        case cJSON_Number:
+            number_length = format_number(item, number_buffer);
+            if (number_length < 0)
+            {
+                return false;
+            }
+            *length += (size_t)number_length;
+            return true;
+
+        case cJSON_Raw:
+            if (item->valuestring == NULL)
+            {
+                return false;
+            }
+            *length += strlen(item->valuestring);
+            return true;
+
+        case cJSON_String:
+            *length += measure_string((const unsigned char*)item->valuestring);
+            return true;
+
+        case cJSON_Array:
+            /* brackets, commas (and spaces after them) */
+            *length += sizeof("[]") - 1;
+            for (child = item->child; child != NULL; child = child->next)
+            {
+                if (!measure_value(child, format, depth + 1, length))
+                {
+                    return false;
+                }
+                if (child->next != NULL)
+                {
+                    *length += format ? 2 : 1;
+                }
+            }
+            return true;
+
+        case cJSON_Object:
+            /* fmt: "{\n" and the closing brace after depth tabs */
+            *length += format ? (2 + depth + 1) : 2;
+            for (child = item->child; child != NULL; child = child->next)
+            {
+                /* fmt: indentation, ":\t" after the key and a newline */
+                *length += format ? (depth + 1 + 2 + 1) : 1;
+                *length += measure_string((const unsigned char*)child->string);
+                if (!measure_value(child, format, depth + 1, length))
+                {
+                    return false;
+                }
+                if (child->next != NULL)
+                {
+                    *length += 1;
+                }
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/* Resumable event parser. The input arrives in chunks, so instead of recursing it keeps where it is in the grammar
+ * in a state and the kind of every open container in a bit stack. Tokens that are cut by the end of a chunk are
+ * collected in scratch, everything else is reported straight out of the chunk. */
+typedef enum
+{
+    incremental_value, /* expecting a value */
+    incremental_first_element, /* after '[', expecting a value or ']' */
+    incremental_first_member, /* after '{', expecting a key or '}' */
+    incremental_key, /* after ',' in an object */
+    incremental_colon,
+    incremental_after_value, /* expecting ',' or the end of the container */
+    incremental_string,
+    incremental_number,
+    incremental_literal,
+    incremental_done, /* only whitespace may follow */
+    incremental_error
+} incremental_state;
+
+struct cJSON_Parser
+{
+    const cJSON_SAXHandler *handler;
+    void *user_data;
+    unsigned char *scratch;
+    size_t scratch_size;
+    size_t token_length; /* bytes of the current token that are in scratch */
+    size_t offset; /* bytes fed so far */
+    size_t depth;
+    unsigned char objects[(CJSON_NESTING_LIMIT + 7) / 8]; /* one bit per level, set if the container is an object */
+    incremental_state state;
+    cJSON_bool is_key; /* the current string is the name of a member */
+    cJSON_bool escaped; /* the current string contains escape sequences */
+    cJSON_bool escape_pending; /* the last chunk ended on a backslash in a string */
+    const char *literal; /* "true", "false" or "null" */
+    size_t literal_matched; /* bytes of the literal seen so far */
+    size_t bom_length; /* bytes of a UTF-8 byte order mark skipped at the start */
+};
+
+#define incremental_in_object(parser) (((parser)->objects[((parser)->depth - 1) / 8] & (1U << (((parser)->depth - 1) % 8))) != 0)
+
+static cJSON_bool is_number_character(const unsigned char character)
+{
+    return ((character >= '0') && (character <= '9')) || (character == '-') || (character == '+') || (character == '.') || (character == 'e') || (character == 'E');
+}
+
+/* append a piece of a token that continues in the next chunk */
+static cJSON_bool incremental_save(cJSON_Parser * const parser, const unsigned char * const start, const size_t length)
+{
+    /* one byte is kept free for the terminator */
+    if ((parser->scratch == NULL) || ((parser->scratch_size - parser->token_length) <= length))
+    {
+        return false; /* token too long for scratch */
+    }
+
+    memcpy(parser->scratch + parser->token_length, start, length);
+    parser->token_length += length;
+
+    return true;
+}
+
+static void incremental_value_done(cJSON_Parser * const parser)
+{
+    parser->state = (parser->depth == 0) ? incremental_done : incremental_after_value;
+}
+
+static cJSON_bool incremental_open(cJSON_Parser * const parser, const cJSON_bool is_object)
+{
+    const size_t level = parser->depth;
+
+    if (level >= CJSON_NESTING_LIMIT)
+    {
+        return false; /* to deeply nested */
+    }
+
+    if (is_object)
+    {
+        parser->objects[level / 8] = (unsigned char)(parser->objects[level / 8] | (1U << (level % 8)));
+        parser->state = incremental_first_member;
+    }
+    else
+    {
+        parser->objects[level / 8] = (unsigned char)(parser->objects[level / 8] & ~(1U << (level % 8)));
+        parser->state = incremental_first_element;
+    }
+    parser->depth++;
+
+    if (is_object)
+    {
+        return (parser->handler->start_object == NULL) || parser->handler->start_object(parser->user_data);
+    }
+    return (parser->handler->start_array == NULL) || parser->handler->start_array(parser->user_data);
+}
+
+static cJSON_bool incremental_close(cJSON_Parser * const parser)
+{
+    const cJSON_bool is_object = incremental_in_object(parser);
+
+    parser->depth--;
+    incremental_value_done(parser);
+
+    if (is_object)
+    {
+        return (parser->handler->end_object == NULL) || parser->handler->end_object(parser->user_data);
+    }
+    return (parser->handler->end_array == NULL) || parser->handler->end_array(parser->user_data);
+}
+
+static cJSON_bool incremental_report_number(cJSON_Parser * const parser, const unsigned char * const number, const size_t length)
+{
+    parse_buffer number_buffer;
+    cJSON item;
+
+    memset(&number_buffer, '\0', sizeof(number_buffer));
+    memset(&item, '\0', sizeof(item));
+    number_buffer.content = number;
+    number_buffer.length = length;
+    number_buffer.hooks = global_hooks;
+
+    /* the number has to be the whole token */
+    if (!parse_number(&item, &number_buffer) || (number_buffer.offset != length))
+    {
+        return false;
+    }
+
+    incremental_value_done(parser);
+
+    return (parser->handler->number == NULL) || parser->handler->number(parser->user_data, item.valuedouble);
+}
+
+/* continue the string at input, returns where parsing goes on or NULL on failure */
+static const unsigned char *incremental_feed_string(cJSON_Parser * const parser, const unsigned char *input, const unsigned char * const input_end)
+{
+    const unsigned char * const start = input;
+    const unsigned char *string = start;
+    size_t string_length = 0;
+    cJSON_bool (*callback)(void *user_data, const char *string, size_t length) = NULL;
+
+    if (parser->escape_pending)
+    {
+        /* the first byte belongs to an escape sequence of the last chunk */
+        parser->escape_pending = false;
+        input++;
+    }
+
+    for (;;)
+    {
+        input += find_string_special(input, (size_t)(input_end - input));
+        if (input >= input_end)
+        {
+            /* the string continues in the next chunk */
+            return incremental_save(parser, start, (size_t)(input_end - start)) ? input_end : NULL;
+        }
+
+        if (*input == '\"')
+        {
+            break;
+        }
+
+        if (*input == '\\')
+        {
+            parser->escaped = true;
+            if ((input + 1) >= input_end)
+            {
+                parser->escape_pending = true;
+                return incremental_save(parser, start, (size_t)(input_end - start)) ? input_end : NULL;
+            }
+            input++;
+        }
+        /* control characters are taken as they are */
+        input++;
+    }
+
+    string_length = (size_t)(input - start);
+    if ((parser->token_length > 0) || parser->escaped)
+    {
+        unsigned char *output_end = NULL;
+
+        if (!incremental_save(parser, start, string_length))
+        {
+            return NULL;
+        }
+
+        /* unescaping never makes a string longer, so scratch can be decoded in place */
+        string = parser->scratch;
+        output_end = unescape_string(&string, parser->scratch + parser->token_length, parser->scratch);
+        if (output_end == NULL)
+        {
+            return NULL; /* invalid escape sequence */
+        }
+        *output_end = '\0';
+
+        string = parser->scratch;
+        string_length = (size_t)(output_end - parser->scratch);
+        parser->token_length = 0;
+    }
+
+    if (parser->is_key)
+    {
+        parser->state = incremental_colon;
+        callback = parser->handler->key;
+    }
+    else
+    {
+        incremental_value_done(parser);
+        callback = parser->handler->string;
+    }
+
+    if ((callback != NULL) && !callback(parser->user_data, (const char*)string, string_length))
+    {
+        return NULL;
+    }
+
+    /* skip the closing quote */
+    return input + 1;
+}
+
+static const unsigned char *incremental_feed_number(cJSON_Parser * const parser, const unsigned char *input, const unsigned char * const input_end)
+{
+    const unsigned char * const start = input;
+    size_t length = 0;
+
+    while ((input < input_end) && is_number_character(*input))
+    {
+        input++;
+    }
+
+    if (input == input_end)
+    {
+        /* the number might continue in the next chunk */
+        return incremental_save(parser, start, (size_t)(input - start)) ? input : NULL;
+    }
+
+    if (parser->token_length == 0)
+    {
+        return incremental_report_number(parser, start, (size_t)(input - start)) ? input : NULL;
+    }
+
+    if (!incremental_save(parser, start, (size_t)(input - start)))
+    {
+        return NULL;
+    }
+    length = parser->token_length;
+    parser->token_length = 0;
+
+    return incremental_report_number(parser, parser->scratch, length) ? input : NULL;
+}
+
+static const unsigned char *incremental_feed_literal(cJSON_Parser * const parser, const unsigned char *input, const unsigned char * const input_end)
+{
+    const size_t literal_length = strlen(parser->literal);
+
+    while ((input < input_end) && (parser->literal_matched < literal_length))
+    {
+        if (*input != (unsigned char)parser->literal[parser->literal_matched])
+        {
+            return NULL;
+        }
+        input++;
+        parser->literal_matched++;
+    }
+
+    if (parser->literal_matched < literal_length)
+    {
+        return input; /* continues in the next chunk */
+    }
+
+    incremental_value_done(parser);
+    if (parser->literal[0] == 'n')
+    {
+        return ((parser->handler->null == NULL) || parser->handler->null(parser->user_data)) ? input : NULL;
+    }
+
+    return ((parser->handler->boolean == NULL) || parser->handler->boolean(parser->user_data, parser->literal[0] == 't')) ? input : NULL;
+}
+
+/* the first character of a value, numbers and literals are then read from it on */
+static cJSON_bool incremental_begin_value(cJSON_Parser * const parser, const unsigned char character)
+{
+    switch (character)
+    {
+        case '{':
+            return incremental_open(parser, true);
+
+        case '[':
+            return incremental_open(parser, false);
+
+        case '\"':
+            parser->state = incremental_string;
+            parser->is_key = false;
+            parser->escaped = false;
+            return true;
+
+        case 't':
+            parser->literal = "true";
+            break;
+
+        case 'f':
+            parser->literal = "false";
+            break;
+
+        case 'n':
+            parser->literal = "null";
+            break;
+
+        default:
+            if ((character == '-') || ((character >= '0') && (character <= '9')))
+            {
+                parser->state = incremental_number;
+                return true;
+            }
+            return false;
+    }
+
+    parser->state = incremental_literal;
+    parser->literal_matched = 0;
+
+    return true;
+}
+
+/* handle a character outside of strings, numbers and literals that isn't whitespace */
+static cJSON_bool incremental_feed_structural(cJSON_Parser * const parser, const unsigned char character)
+{
+    switch (parser->state)
+    {
+        case incremental_value:
+            return incremental_begin_value(parser, character);
+
+        case incremental_first_element:
+            if (character == ']')
+            {
+                return incremental_close(parser); /* empty array */
+            }
+            return incremental_begin_value(parser, character);
+
+        case incremental_first_member:
+            if (character == '}')
+            {
+                return incremental_close(parser); /* empty object */
+            }
+            if (character != '\"')
+            {
+                return false; /* expected the name of a member */
+            }
+            parser->state = incremental_string;
+            parser->is_key = true;
+            parser->escaped = false;
+            return true;
+
+        case incremental_key:
+            if (character != '\"')
+            {
+                return false; /* expected the name of a member */
+            }
+            parser->state = incremental_string;
+            parser->is_key = true;
+            parser->escaped = false;
+            return true;
+
+        case incremental_colon:
+            if (character != ':')
+            {
+                return false; /* invalid object */
+            }
+            parser->state = incremental_value;
+            return true;
+
+        case incremental_after_value:
+            if (character == ',')
+            {
+                parser->state = incremental_in_object(parser) ? incremental_key : incremental_value;
+                return true;
+            }
+            if (character == (incremental_in_object(parser) ? '}' : ']'))
+            {
+                return incremental_close(parser);
+            }
+            return false; /* expected the end of the container */
+
+        case incremental_string:
+        case incremental_number:
+        case incremental_literal:
+        case incremental_done:
+        case incremental_error:
+        default:
+            return false;
+    }
+}
+
+CJSON_PUBLIC(cJSON_Parser *) cJSON_CreateParser(const cJSON_SAXHandler * const handler, void *user_data, char *scratch, size_t scratch_size)
+{
+    cJSON_Parser *parser = NULL;
+
+    if (handler == NULL)
+    {
+        return NULL;
+    }
+
+    parser = (cJSON_Parser*)global_hooks.allocate(sizeof(cJSON_Parser));
+    if (parser == NULL)
+    {
+        return NULL;
+    }
+
+    memset(parser, '\0', sizeof(cJSON_Parser));
+    parser->handler = handler;
+    parser->user_data = user_data;
+    parser->scratch = (unsigned char*)scratch;
+    parser->scratch_size = (scratch != NULL) ? scratch_size : 0;
+    cJSON_ResetParser(parser);
+
+    return parser;
+}
+
+CJSON_PUBLIC(void) cJSON_ResetParser(cJSON_Parser * const parser)
+{
+    if (parser == NULL)
+    {
+        return;
+    }
+
+    parser->token_length = 0;
+    parser->offset = 0;
+    parser->depth = 0;
+    parser->state = incremental_value;
+    parser->is_key = false;
+    parser->escaped = false;
+    parser->escape_pending = false;
+    parser->literal = NULL;
+    parser->literal_matched = 0;
+    parser->bom_length = 0;
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteParser(cJSON_Parser *parser)
+{
+    if (parser != NULL)
+    {
+        global_hooks.deallocate(parser);
+    }
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ParserFeed(cJSON_Parser * const parser, const char *chunk, size_t length)
+{
+    const unsigned char *input = (const unsigned char*)chunk;
+    const unsigned char * const input_end = input + length;
+
+    if ((parser == NULL) || (parser->state == incremental_error) || ((chunk == NULL) && (length > 0)))
+    {
+        return false;
+    }
+
+    while (input < input_end)
+    {
+        const unsigned char *next = NULL;
+
+        switch (parser->state)
+        {
+            case incremental_string:
+                next = incremental_feed_string(parser, input, input_end);
+                break;
+
+            case incremental_number:
+                next = incremental_feed_number(parser, input, input_end);
+                break;
+
+            case incremental_literal:
+                next = incremental_feed_literal(parser, input, input_end);
+                break;
+
+            case incremental_value:
+            case incremental_first_element:
+            case incremental_first_member:
+            case incremental_key:
+            case incremental_colon:
+            case incremental_after_value:
+            case incremental_done:
+            case incremental_error:
+            default:
+                if (*input <= 32)
+                {
+                    next = input + skip_whitespace_bytes(input, (size_t)(input_end - input));
+                }
+                /* skip the UTF-8 BOM (byte order mark) at the beginning of the document */
+                else if ((parser->bom_length < 3) && (parser->bom_length == (parser->offset + (size_t)(input - (const unsigned char*)chunk)))
+                        && (*input == (unsigned char)"\xEF\xBB\xBF"[parser->bom_length]))
+                {
+                    parser->bom_length++;
+                    next = input + 1;
+                }
+                else if (incremental_feed_structural(parser, *input))
+                {
+                    next = ((parser->state == incremental_number) || (parser->state == incremental_literal)) ? input : (input + 1);
+                }
+                break;
+        }
+
+        if (next == NULL)
+        {
+            parser->offset += (size_t)(input - (const unsigned char*)chunk);
+            parser->state = incremental_error;
+            return false;
+        }
+        input = next;
+    }
+
+    parser->offset += length;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ParserFinish(cJSON_Parser * const parser)
+{
+    if (parser == NULL)
+    {
+        return false;
+    }
+
+    /* only the end of the input ends a number at the top level */
+    if ((parser->state == incremental_number) && (parser->depth == 0))
+    {
+        const size_t length = parser->token_length;
+
+        parser->token_length = 0;
+        if (!incremental_report_number(parser, parser->scratch, length))
+        {
+            parser->state = incremental_error;
+            return false;
+        }
+    }
+
+    return parser->state == incremental_done;
+}
+
+CJSON_PUBLIC(size_t) cJSON_GetParserOffset(const cJSON_Parser * const parser)
+{
+    return (parser != NULL) ? parser->offset : 0;
+}
+
+/* Event driven parser for a complete document. The grammar is the state machine of the resumable parser, so it doesn't
+ * recurse and nesting costs one bit per level, but tokens are lexed straight out of the buffer with the tree parser's
+ * lexer, so strings are only ever copied to unescape them. */
+typedef struct
+{
+    parse_buffer buffer;
+    cJSON_Parser events;
+} sax_parser;
+
+/* report the string literal at the current offset, zero copy unless it contains escape sequences */
+static cJSON_bool sax_parse_string(sax_parser * const parser, cJSON_bool is_key)
+{
+    parse_buffer * const input_buffer = &parser->buffer;
+    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
+    const unsigned char *input_end = NULL;
+    const unsigned char *string = input_pointer;
+    size_t string_length = 0;
+    size_t skipped_bytes = 0;
+    cJSON_bool (*callback)(void *user_data, const char *string, size_t length) = NULL;
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '\"'))
+    {
+        return false; /* not a string */
+    }
+
+    if (!find_string_end(input_buffer, &input_end, &skipped_bytes))
+    {
+        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+        return false;
+    }
+
+    if (skipped_bytes == 0)
+    {
+        string_length = (size_t)(input_end - input_pointer);
+    }
+    else
+    {
+        unsigned char *output_end = NULL;
+
+        /* This is at most how much we need for the output */
+        if ((parser->events.scratch == NULL) || (parser->events.scratch_size <= (size_t)(input_end - input_pointer) - skipped_bytes))
+        {
+            input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+            return false; /* scratch buffer too small */
+        }
+
+        output_end = unescape_string(&input_pointer, input_end, parser->events.scratch);
+        if (output_end == NULL)
+        {
+            input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+            return false;
+        }
+        *output_end = '\0';
+
+        string = parser->events.scratch;
+        string_length = (size_t)(output_end - parser->events.scratch);
+    }
+
+    input_buffer->offset = (size_t)(input_end - input_buffer->content);
+    input_buffer->offset++;
+
+    callback = is_key ? parser->events.handler->key : parser->events.handler->string;
+    if (callback != NULL)
+    {
+        return callback(parser->events.user_data, (const char*)string, string_length);
+    }
+
+    return true;
+}
+
+/* lex the string, number or literal that the state machine expects at the current offset */
+static cJSON_bool sax_parse_token(sax_parser * const parser)
+{
+    parse_buffer * const input_buffer = &parser->buffer;
+    cJSON_Parser * const events = &parser->events;
+
+    if (events->state == incremental_string)
+    {
+        if (!sax_parse_string(parser, events->is_key))
+        {
+            return false;
+        }
+        if (events->is_key)
+        {
+            events->state = incremental_colon;
+        }
+        else
+        {
+            incremental_value_done(events);
+        }
+        return true;
+    }
+
+    if (events->state == incremental_number)
+    {
+        cJSON number;
+        memset(&number, '\0', sizeof(number));
+        if (!parse_number(&number, input_buffer))
+        {
+            return false;
+        }
+
+        incremental_value_done(events);
+        return (events->handler->number == NULL) || events->handler->number(events->user_data, number.valuedouble);
+    }
+
+    /* true, false or null */
+    if (!can_read(input_buffer, strlen(events->literal)) || (strncmp((const char*)buffer_at_offset(input_buffer), events->literal, strlen(events->literal)) != 0))
+    {
+        return false;
+    }
+    input_buffer->offset += strlen(events->literal);
+
+    incremental_value_done(events);
+    if (events->literal[0] == 'n')
+    {
+        return (events->handler->null == NULL) || events->handler->null(events->user_data);
+    }
+    return (events->handler->boolean == NULL) || events->handler->boolean(events->user_data, events->literal[0] == 't');
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseSAXWithContext(const char *value, size_t buffer_length, const cJSON_SAXHandler * const handler, void *user_data, char *scratch, size_t scratch_size, cJSON_ParseContext * const context)
+{
+    sax_parser parser;
+    parse_buffer * const input_buffer = &parser.buffer;
+
+    if (context == NULL)
+    {
+        return false;
+    }
+
+    context->end = NULL;
+    context->error = NULL;
+
+    if ((value == NULL) || (buffer_length == 0) || (handler == NULL))
+    {
+        return false;
+    }
+
+    memset(&parser, '\0', sizeof(parser));
+    input_buffer->content = (const unsigned char*)value;
+    input_buffer->length = buffer_length;
+    input_buffer->hooks = global_hooks;
+    parser.events.handler = handler;
+    parser.events.user_data = user_data;
+    parser.events.scratch = (unsigned char*)scratch;
+    parser.events.scratch_size = (scratch != NULL) ? scratch_size : 0;
+    cJSON_ResetParser(&parser.events);
+
+    buffer_skip_whitespace(skip_utf8_bom(input_buffer));
+    /* anything may follow the value */
+    while (parser.events.state != incremental_done)
+    {
+        buffer_skip_whitespace(input_buffer);
+        if (cannot_access_at_index(input_buffer, 0) || !incremental_feed_structural(&parser.events, buffer_at_offset(input_buffer)[0]))
+        {
+            set_context_error(context, input_buffer);
+            return false;
+        }
+
+        if ((parser.events.state == incremental_string) || (parser.events.state == incremental_number) || (parser.events.state == incremental_literal))
+        {
+            if (!sax_parse_token(&parser))
+            {
+                set_context_error(context, input_buffer);
+                return false;
+            }
+        }
+        else
+        {
+            input_buffer->offset++;
+        }
+    }
+    context->end = (const char*)buffer_at_offset(input_buffer);
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseSAX(const char *value, size_t buffer_length, const cJSON_SAXHandler * const handler, void *user_data, char *scratch, size_t scratch_size)
+{
+    cJSON_ParseContext context;
+    cJSON_bool parsed = false;
+
+    cJSON_InitParseContext(&context);
+    parsed = cJSON_ParseSAXWithContext(value, buffer_length, handler, user_data, scratch, scratch_size, &context);
+    set_global_error(&context);
+
+    return parsed;
+}
+
+/* Read-only tape document. Stage one records the offset of every structural character, string and scalar of the
+ * input; stage two checks the grammar on that index and writes one or two 64 bit words per value:
+ *   r  root, the payload of the first word is the position of the last one
+ *   {[ payload is the position after the matching close, with the number of members/elements in bits 32 to 55
+ *   }] payload is the position of the matching open
+ *   "  payload is the offset of the string in the input, the next word its (escaped) length
+ *   d  payload is the offset of the number in the input, the next word its double
+ *   tfn literals, payload is the offset in the input
+ * Keys are string words in front of their value. Strings are not copied, so the input has to outlive the tape. */
+struct cJSON_Tape
+{
+    const unsigned char *json;
+    cjson_uint64 *words;
+    size_t size;
+};
+
+#define tape_word(type, payload) ((((cjson_uint64)(type)) << 56) | (cjson_uint64)(payload))
+#define tape_type(word) ((unsigned char)((word) >> 56))
+#define tape_payload(word) ((word) & cjson_uint64_constant(0x00FFFFFF, 0xFFFFFFFF))
+/* member counts above this are not stored, the container has to be walked instead */
+#define tape_count_limit 0xFFFFFFUL
+/* set in the length word of strings (and in their stage one entry) that contain escape sequences */
+#define tape_escaped cjson_uint64_constant(0x80000000, 0x00000000)
+#define tape_escaped_structural 0x80000000U
+/* keeps offsets in 31 bits and positions on the tape in 32 bits */
+#define tape_max_input_length 0x3FFFFFFFUL
+
+typedef struct
+{
+    size_t open; /* position of the open word */
+    size_t count;
+} tape_scope;
+
+typedef struct
+{
+    parse_buffer buffer;
+    unsigned int *structurals; /* offsets in the input, terminated by the input length */
+    size_t count;
+    size_t capacity;
+    size_t words; /* upper bound of the tape size */
+    unsigned char *scratch; /* for checking escape sequences */
+    size_t scratch_size;
+} tape_parser;
+
+static cJSON_bool tape_add_structural(tape_parser * const parser, const size_t offset)
+{
+    if (parser->count == parser->capacity)
+    {
+        size_t new_capacity = parser->capacity * 2;
+        unsigned int *new_structurals = NULL;
+
+        if (parser->buffer.hooks.reallocate != NULL)
+        {
+            new_structurals = (unsigned int*)parser->buffer.hooks.reallocate(parser->structurals, new_capacity * sizeof(unsigned int));
+        }
+        else
+        {
+            new_structurals = (unsigned int*)parser->buffer.hooks.allocate(new_capacity * sizeof(unsigned int));
+            if (new_structurals != NULL)
+            {
+                memcpy(new_structurals, parser->structurals, parser->count * sizeof(unsigned int));
+                parser->buffer.hooks.deallocate(parser->structurals);
+            }
+        }
+        if (new_structurals == NULL)
+        {
+            return false;
+        }
+
+        parser->structurals = new_structurals;
+        parser->capacity = new_capacity;
+    }
+
+    parser->structurals[parser->count] = (unsigned int)offset;
+    parser->count++;
+
+    return true;
+}
+
+static cJSON_bool is_scalar_end(const unsigned char character)
+{
+    switch (character)
+    {
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',':
+        case '\"':
+            return true;
+
+        default:
+            return character <= 32;
+    }
+}
+
+/* stage one: find where every token starts and how many tape words they need at most */
+static cJSON_bool tape_find_structurals(tape_parser * const parser)
+{
+    parse_buffer * const input_buffer = &parser->buffer;
+    const unsigned char * const content = input_buffer->content;
+    const size_t length = input_buffer->length;
+
+    for (;;)
+    {
+        if ((input_buffer->offset < length) && (content[input_buffer->offset] <= 32))
+        {
+            input_buffer->offset += skip_whitespace_bytes(buffer_at_offset(input_buffer), length - input_buffer->offset);
+        }
+        if (input_buffer->offset >= length)
+        {
+            break;
+        }
+
+        if (!tape_add_structural(parser, input_buffer->offset))
+        {
+            return false;
+        }
+
+        switch (content[input_buffer->offset])
+        {
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+                parser->words++;
+                input_buffer->offset++;
+                break;
+
+            case ':':
+            case ',':
+                input_buffer->offset++;
+                break;
+
+            case '\"':
+            {
+                const unsigned char *string_end = NULL;
+                size_t skipped_bytes = 0;
+
+                if (!find_string_end(input_buffer, &string_end, &skipped_bytes))
+                {
+                    return false;
+                }
+                if (skipped_bytes > 0)
+                {
+                    parser->structurals[parser->count - 1] |= tape_escaped_structural;
+                }
+                parser->words += 2;
+                input_buffer->offset = (size_t)(string_end - content) + 1;
+                break;
+            }
+
+            default:
+                /* numbers and literals are checked by stage two */
+                parser->words += ((content[input_buffer->offset] == '-') || ((content[input_buffer->offset] >= '0') && (content[input_buffer->offset] <= '9'))) ? 2 : 1;
+                while ((input_buffer->offset < length) && !is_scalar_end(content[input_buffer->offset]))
+                {
+                    input_buffer->offset++;
+                }
+                break;
+        }
+    }
+
+    if (parser->count == 0)
+    {
+        return false; /* no value */
+    }
+
+    /* the terminator lets stage two find where the last token ends */
+    if (!tape_add_structural(parser, length))
+    {
+        return false;
+    }
+    parser->count--;
+
+    return true;
+}
+
+#define structural_offset(parser, structural) ((size_t)((parser)->structurals[structural] & ~tape_escaped_structural))
+
+/* end of the token at structural, without the whitespace in front of the next one */
+static size_t tape_token_end(const tape_parser * const parser, const size_t structural)
+{
+    const unsigned char * const content = parser->buffer.content;
+    const size_t start = structural_offset(parser, structural);
+    size_t end = structural_offset(parser, structural + 1);
+
+    while ((end > start) && (content[end - 1] <= 32))
+    {
+        end--;
+    }
+
+    return end;
+}
+
+static cJSON_bool tape_write_string(tape_parser * const parser, cjson_uint64 * const words, const size_t structural)
+{
+    parse_buffer * const input_buffer = &parser->buffer;
+    const size_t start = structural_offset(parser, structural) + 1;
+    /* stage one made sure that the token ends with the closing quote */
+    const size_t end = tape_token_end(parser, structural) - 1;
+    const cJSON_bool escaped = (parser->structurals[structural] & tape_escaped_structural) != 0;
+
+    if (escaped)
+    {
+        const unsigned char *input_pointer = input_buffer->content + start;
+
+        if (parser->scratch_size < (end - start))
+        {
+            input_buffer->hooks.deallocate(parser->scratch);
+            parser->scratch_size = 0;
+            parser->scratch = (unsigned char*)input_buffer->hooks.allocate(end - start);
+            if (parser->scratch == NULL)
+            {
+                return false;
+            }
+            parser->scratch_size = end - start;
+        }
+
+        if (unescape_string(&input_pointer, input_buffer->content + end, parser->scratch) == NULL)
+        {
+            input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+            return false; /* invalid escape sequence */
+        }
+    }
+
+    words[0] = tape_word('\"', start);
+    words[1] = (cjson_uint64)(end - start) | (escaped ? tape_escaped : 0);
+
+    return true;
+}
+
+/* numbers and the literals true, false and null, returns the number of tape words written or 0 */
+static size_t tape_write_scalar(tape_parser * const parser, cjson_uint64 * const words, const size_t structural)
+{
+    const unsigned char * const content = parser->buffer.content;
+    const size_t start = structural_offset(parser, structural);
+    const size_t end = tape_token_end(parser, structural);
+
+    if ((content[start] == '-') || ((content[start] >= '0') && (content[start] <= '9')))
+    {
+        parse_buffer number_buffer = parser->buffer;
+        cJSON number;
+
+        memset(&number, '\0', sizeof(number));
+        number_buffer.offset = start;
+        /* the number has to be the whole token */
+        number_buffer.length = end;
+        if (!parse_number(&number, &number_buffer) || (number_buffer.offset != end))
+        {
+            return 0;
+        }
+
+        words[0] = tape_word('d', start);
+        memcpy(&words[1], &number.valuedouble, sizeof(number.valuedouble));
+        return 2;
+    }
+
+    if (((end - start) == 4) && (strncmp((const char*)content + start, "null", 4) == 0))
+    {
+        words[0] = tape_word('n', start);
+        return 1;
+    }
+    if (((end - start) == 4) && (strncmp((const char*)content + start, "true", 4) == 0))
+    {
+        words[0] = tape_word('t', start);
+        return 1;
+    }
+    if (((end - start) == 5) && (strncmp((const char*)content + start, "false", 5) == 0))
+    {
+        words[0] = tape_word('f', start);
+        return 1;
+    }
+
+    return 0;
+}
+
+/* stage two: check the grammar on the structural index and write the tape.
+ * The containers that are still open are kept in scopes instead of on the call stack. */
+static cJSON_bool tape_build(tape_parser * const parser, cJSON_Tape * const tape, tape_scope * const scopes)
+{
+    parse_buffer * const input_buffer = &parser->buffer;
+    const unsigned char * const content = input_buffer->content;
+    cjson_uint64 * const words = tape->words;
+    size_t position = 1; /* the first word is the root */
+    size_t structural = 0;
+    size_t depth = 0;
+    unsigned char character = '\0';
+    unsigned char open = '\0';
+
+value:
+    input_buffer->offset = structural_offset(parser, structural);
+    if (structural >= parser->count)
+    {
+        return false; /* expected a value */
+    }
+
+    character = content[input_buffer->offset];
+    switch (character)
+    {
+        case '{':
+        case '[':
+            if (depth >= CJSON_NESTING_LIMIT)
+            {
+                return false; /* to deeply nested */
+            }
+            scopes[depth].open = position;
+            scopes[depth].count = 0;
+            depth++;
+            words[position] = tape_word(character, 0);
+            position++;
+            structural++;
+
+            /* '}' and ']' follow their opening character in ASCII */
+            if ((structural < parser->count) && (content[structural_offset(parser, structural)] == (character + 2)))
+            {
+                goto close;
+            }
+            if (character == '{')
+            {
+                goto key;
+            }
+            goto value;
+
+        case '\"':
+            if (!tape_write_string(parser, words + position, structural))
+            {
+                return false;
+            }
+            position += 2;
+            break;
+
+        default:
+        {
+            const size_t written = tape_write_scalar(parser, words + position, structural);
+            if (written == 0)
+            {
+                return false; /* invalid number or literal */
+            }
+            position += written;
+            break;
+        }
+    }
+    structural++;
+    goto next;
+
+key:
+    input_buffer->offset = structural_offset(parser, structural);
+    if ((structural >= parser->count) || (content[input_buffer->offset] != '\"'))
+    {
+        return false; /* expected the name of a member */
+    }
+    if (!tape_write_string(parser, words + position, structural))
+    {
+        return false;
+    }
+    position += 2;
+    structural++;
+
+    input_buffer->offset = structural_offset(parser, structural);
+    if ((structural >= parser->count) || (content[input_buffer->offset] != ':'))
+    {
+        return false; /* invalid object */
+    }
+    structural++;
+    goto value;
+
+next:
+    if (depth == 0)
+    {
+        goto done;
+    }
+    scopes[depth - 1].count++;
+
+    input_buffer->offset = structural_offset(parser, structural);
+    if (structural >= parser->count)
+    {
+        return false; /* container isn't closed */
+    }
+
+    character = content[input_buffer->offset];
+    open = tape_type(words[scopes[depth - 1].open]);
+    if (character == ',')
+    {
+        structural++;
+        if (open == '{')
+        {
+            goto key;
+        }
+        goto value;
+    }
+    if (character != (open + 2))
+    {
+        return false; /* expected the end of the container */
+    }
+
+close:
+    depth--;
+    open = tape_type(words[scopes[depth].open]);
+    words[scopes[depth].open] = tape_word(open, (((cjson_uint64)((scopes[depth].count < tape_count_limit) ? scopes[depth].count : tape_count_limit)) << 32) | (cjson_uint64)(position + 1));
+    words[position] = tape_word(open + 2, scopes[depth].open);
+    position++;
+    structural++;
+    goto next;
+
+done:
+    input_buffer->offset = structural_offset(parser, structural);
+    if (structural != parser->count)
+    {
+        return false; /* more than one value */
+    }
+
+    words[0] = tape_word('r', position);
+    words[position] = tape_word('r', 0);
+    tape->size = position + 1;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_Tape *) cJSON_ParseTapeWithContext(const char *value, size_t buffer_length, cJSON_ParseContext * const context)
+{
+    const size_t header_size = arena_round_up(sizeof(cJSON_Tape));
+    tape_parser parser;
+    tape_scope *scopes = NULL;
+    cJSON_Tape *tape = NULL;
+
+    if (context == NULL)
+    {
+        return NULL;
+    }
+
+    context->end = NULL;
+    context->error = NULL;
+
+    if ((value == NULL) || (buffer_length == 0) || (buffer_length > tape_max_input_length))
+    {
+        return NULL;
+    }
+
+    memset(&parser, '\0', sizeof(parser));
+    parser.buffer.content = (const unsigned char*)value;
+    parser.buffer.length = buffer_length;
+    parser.buffer.hooks = global_hooks;
+
+    /* telemetry and commands have a token every 5 bytes or so, which makes growing the index rare */
+    parser.capacity = (buffer_length / 4) + 16;
+    parser.structurals = (unsigned int*)parser.buffer.hooks.allocate(parser.capacity * sizeof(unsigned int));
+    if (parser.structurals == NULL)
+    {
+        goto fail;
+    }
+
+    skip_utf8_bom(&parser.buffer);
+    if (!tape_find_structurals(&parser))
+    {
+        goto fail;
+    }
+
+    scopes = (tape_scope*)parser.buffer.hooks.allocate(((parser.count < CJSON_NESTING_LIMIT) ? parser.count : CJSON_NESTING_LIMIT) * sizeof(tape_scope));
+    tape = (cJSON_Tape*)parser.buffer.hooks.allocate(header_size + ((parser.words + 2) * sizeof(cjson_uint64)));
+    if ((scopes == NULL) || (tape == NULL))
+    {
+        goto fail;
+    }
+    tape->json = parser.buffer.content;
+    tape->words = (cjson_uint64*)(void*)((unsigned char*)tape + header_size);
+    tape->size = 0;
+
+    if (!tape_build(&parser, tape, scopes))
+    {
+        goto fail;
+    }
+
+    parser.buffer.hooks.deallocate(parser.structurals);
+    parser.buffer.hooks.deallocate(parser.scratch);
+    parser.buffer.hooks.deallocate(scopes);
+    context->end = (const char*)buffer_at_offset(&parser.buffer);
+
+    return tape;
+
+fail:
+    set_context_error(context, &parser.buffer);
+
+    parser.buffer.hooks.deallocate(parser.structurals);
+    parser.buffer.hooks.deallocate(parser.scratch);
+    parser.buffer.hooks.deallocate(scopes);
+    parser.buffer.hooks.deallocate(tape);
+
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON_Tape *) cJSON_ParseTape(const char *value, size_t buffer_length)
+{
+    cJSON_ParseContext context;
+    cJSON_Tape *tape = NULL;
+
+    cJSON_InitParseContext(&context);
+    tape = cJSON_ParseTapeWithContext(value, buffer_length, &context);
+    set_global_error(&context);
+
+    return tape;
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteTape(cJSON_Tape *tape)
+{
+    if (tape != NULL)
+    {
+        global_hooks.deallocate(tape);
+    }
+}
+
+/* position after the value at position */
+static size_t tape_skip(const cJSON_Tape * const tape, const size_t position)
+{
+    const cjson_uint64 word = tape->words[position];
+
+    switch (tape_type(word))
+    {
+        case '{':
+        case '[':
+            return (size_t)(word & 0xFFFFFFFFUL);
+
+        case '\"':
+        case 'd':
+            return position + 2;
+
+        default:
+            return position + 1;
+    }
+}
+
+static cJSON_bool is_tape_value(const cJSON_TapeIterator * const item)
+{
+    return (item != NULL) && (item->tape != NULL) && (item->position > 0) && ((item->position + 1) < item->tape->size);
+}
+
+static cJSON_bool is_tape_container(const cJSON_TapeIterator * const item)
+{
+    return is_tape_value(item)
+        && ((tape_type(item->tape->words[item->position]) == '{') || (tape_type(item->tape->words[item->position]) == '['));
+}
+
+/* span of the string at position in the input, returns NULL if it contains escape sequences */
+static const char *tape_get_string(const cJSON_Tape * const tape, const size_t position, size_t * const length)
+{
+    if (tape_type(tape->words[position]) != '\"')
+    {
+        return NULL;
+    }
+
+    if (length != NULL)
+    {
+        *length = (size_t)(tape->words[position + 1] & ~tape_escaped);
+    }
+
+    if ((tape->words[position + 1] & tape_escaped) != 0)
+    {
+        return NULL;
+    }
+
+    return (const char*)tape->json + tape_payload(tape->words[position]);
+}
+
+/* unescape the string at position into buffer and terminate it */
+static cJSON_bool tape_copy_string(const cJSON_Tape * const tape, const size_t position, unsigned char * const buffer, const size_t buffer_size)
+{
+    const unsigned char *input_pointer = tape->json + tape_payload(tape->words[position]);
+    const size_t length = (size_t)(tape->words[position + 1] & ~tape_escaped);
+    unsigned char *output_end = NULL;
+
+    if ((tape_type(tape->words[position]) != '\"') || (buffer == NULL) || (buffer_size <= length))
+    {
+        return false;
+    }
+
+    if ((tape->words[position + 1] & tape_escaped) == 0)
+    {
+        memcpy(buffer, input_pointer, length);
+        output_end = buffer + length;
+    }
+    else
+    {
+        /* stage two made sure that this succeeds */
+        output_end = unescape_string(&input_pointer, input_pointer + length, buffer);
+        if (output_end == NULL)
+        {
+            return false;
+        }
+    }
+    *output_end = '\0';
+
+    return true;
+}
+
+static unsigned char *tape_duplicate_string(const cJSON_Tape * const tape, const size_t position)
+{
+    const size_t length = (size_t)(tape->words[position + 1] & ~tape_escaped);
+    unsigned char *copy = (unsigned char*)global_hooks.allocate(length + sizeof(""));
+
+    if ((copy != NULL) && !tape_copy_string(tape, position, copy, length + sizeof("")))
+    {
+        global_hooks.deallocate(copy);
+        copy = NULL;
+    }
+
+    return copy;
+}
+
+static cJSON_bool tape_string_equals(const cJSON_Tape * const tape, const size_t position, const char * const string, const size_t string_length)
+{
+    size_t length = 0;
+    const char *span = tape_get_string(tape, position, &length);
+    unsigned char *decoded = NULL;
+    cJSON_bool equal = false;
+
+    if (span != NULL)
+    {
+        return (length == string_length) && (memcmp(span, string, length) == 0);
+    }
+
+    /* unescaping never makes a string longer */
+    if (string_length > length)
+    {
+        return false;
+    }
+
+    decoded = tape_duplicate_string(tape, position);
+    if (decoded != NULL)
+    {
+        equal = strcmp((const char*)decoded, string) == 0;
+        global_hooks.deallocate(decoded);
+    }
+
+    return equal;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_GetTapeRoot(const cJSON_Tape * const tape, cJSON_TapeIterator * const root)
+{
+    if (root == NULL)
+    {
+        return false;
+    }
+
+    /* without a tape, root becomes an invalid iterator */
+    root->tape = tape;
+    root->position = (tape != NULL) ? 1 : 0;
+    root->key = 0;
+
+    return tape != NULL;
+}
+
+CJSON_PUBLIC(int) cJSON_TapeType(const cJSON_TapeIterator * const item)
+{
+    if (!is_tape_value(item))
+    {
+        return cJSON_Invalid;
+    }
+
+    switch (tape_type(item->tape->words[item->position]))
+    {
+        case 'f':
+            return cJSON_False;
+        case 't':
+            return cJSON_True;
+        case 'n':
+            return cJSON_NULL;
+        case 'd':
+            return cJSON_Number;
+        case '\"':
+            return cJSON_String;
+        case '[':
+            return cJSON_Array;
+        case '{':
+            return cJSON_Object;
+        default:
+            return cJSON_Invalid;
+    }
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_TapeChild(const cJSON_TapeIterator * const container, cJSON_TapeIterator * const child)
+{
+    size_t first = 0;
+    unsigned char open = '\0';
+
+    if (!is_tape_container(container) || (child == NULL))
+    {
+        return false;
+    }
+
+    open = tape_type(container->tape->words[container->position]);
+    first = container->position + 1;
+    if (tape_type(container->tape->words[first]) == (open + 2))
+    {
+        return false; /* empty */
+    }
+
+    child->tape = container->tape;
+    if (open == '{')
+    {
+        child->key = first;
+        child->position = first + 2;
+    }
+    else
+    {
+        child->key = 0;
+        child->position = first;
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_TapeNext(cJSON_TapeIterator * const item)
+{
+    size_t next = 0;
+
+    if (!is_tape_value(item))
+    {
+        return false;
+    }
+
+    next = tape_skip(item->tape, item->position);
+    switch (tape_type(item->tape->words[next]))
+    {
+        case '}':
+        case ']':
+        case 'r':
+            return false; /* last one */
+
+        default:
+            break;
+    }
+
+    if (item->key != 0)
+    {
+        item->key = next;
+        item->position = next + 2;
+    }
+    else
+    {
+        item->position = next;
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(int) cJSON_TapeGetArraySize(const cJSON_TapeIterator * const container)
+{
+    cJSON_TapeIterator child;
+    size_t count = 0;
+
+    if (!is_tape_container(container))
+    {
+        return 0;
+    }
+
+    count = (size_t)((container->tape->words[container->position] >> 32) & tape_count_limit);
+    if (count == tape_count_limit)
+    {
+        /* too many to be stored */
+        count = 0;
+        if (cJSON_TapeChild(container, &child))
+        {
+            do
+            {
+                count++;
+            }
+            while (cJSON_TapeNext(&child));
+        }
+    }
+
+    return (int)count;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_TapeGetArrayItem(const cJSON_TapeIterator * const array, int index, cJSON_TapeIterator * const item)
+{
+    if ((index < 0) || !cJSON_TapeChild(array, item))
+    {
+        return false;
+    }
+
+    /* containers are skipped in one step */
+    while (index > 0)
+    {
+        if (!cJSON_TapeNext(item))
+        {
+            return false;
+        }
+        index--;
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_TapeGetObjectItemCaseSensitive(const cJSON_TapeIterator * const object, const char * const string, cJSON_TapeIterator * const item)
+{
+    size_t string_length = 0;
+
+    if ((string == NULL) || !is_tape_container(object) || (tape_type(object->tape->words[object->position]) != '{') || !cJSON_TapeChild(object, item))
+    {
+        return false;
+    }
+
+    string_length = strlen(string);
+    do
+    {
+        if (tape_string_equals(item->tape, item->key, string, string_length))
+        {
+            return true;
+        }
+    }
+    while (cJSON_TapeNext(item));
+
+    return false;
+}
+
+CJSON_PUBLIC(double) cJSON_TapeGetNumber(const cJSON_TapeIterator * const item)
+{
+    double number = 0;
+
+    if (cJSON_TapeType(item) != cJSON_Number)
+    {
+        return (double) NAN;
+    }
+
+    memcpy(&number, &item->tape->words[item->position + 1], sizeof(number));
+
+    return number;
+}
+
+CJSON_PUBLIC(const char *) cJSON_TapeGetString(const cJSON_TapeIterator * const item, size_t * const length)
+{
+    if (!is_tape_value(item))
+    {
+        return NULL;
+    }
+
+    return tape_get_string(item->tape, item->position, length);
+}
+
+CJSON_PUBLIC(const char *) cJSON_TapeGetKey(const cJSON_TapeIterator * const item, size_t * const length)
+{
+    if (!is_tape_value(item) || (item->key == 0))
+    {
+        return NULL;
+    }
+
+    return tape_get_string(item->tape, item->key, length);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_TapeCopyString(const cJSON_TapeIterator * const item, char *buffer, const size_t buffer_size)
+{
+    if (!is_tape_value(item))
+    {
+        return false;
+    }
+
+    return tape_copy_string(item->tape, item->position, (unsigned char*)buffer, buffer_size);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_TapeCopyKey(const cJSON_TapeIterator * const item, char *buffer, const size_t buffer_size)
+{
+    if (!is_tape_value(item) || (item->key == 0))
+    {
+        return false;
+    }
+
+    return tape_copy_string(item->tape, item->key, (unsigned char*)buffer, buffer_size);
+}
+
+static cJSON *tape_to_item(const cJSON_Tape * const tape, const size_t position)
+{
+    const cjson_uint64 word = tape->words[position];
+    cJSON *item = cJSON_New_Item(&global_hooks);
+
+    if (item == NULL)
+    {
+        return NULL;
+    }
+
+    switch (tape_type(word))
+    {
+        case 'f':
+            item->type = cJSON_False;
+            break;
+
+        case 't':
+            item->type = cJSON_True;
+            break;
+
+        case 'n':
+            item->type = cJSON_NULL;
+            break;
+
+        case 'd':
+        {
+            double number = 0;
+            memcpy(&number, &tape->words[position + 1], sizeof(number));
+            item->type = cJSON_Number;
+            cJSON_SetNumberHelper(item, number);
+            break;
+        }
+
+        case '\"':
+            item->type = cJSON_String;
+            item->valuestring = (char*)tape_duplicate_string(tape, position);
+            if (item->valuestring == NULL)
+            {
+                goto fail;
+            }
+            break;
+
+        default:
+        {
+            /* containers, the word in front of the one after them is the close */
+            const size_t end = tape_skip(tape, position) - 1;
+            size_t child_position = position + 1;
+            cJSON *tail = NULL;
+
+            item->type = (tape_type(word) == '{') ? cJSON_Object : cJSON_Array;
+            while (child_position < end)
+            {
+                cJSON *child = NULL;
+                size_t key_position = 0;
+
+                if (item->type == cJSON_Object)
+                {
+                    key_position = child_position;
+                    child_position += 2;
+                }
+
+                child = tape_to_item(tape, child_position);
+                if (child == NULL)
+                {
+                    goto fail;
+                }
+
+                if (tail == NULL)
+                {
+                    item->child = child;
+                }
+                else
+                {
+                    tail->next = child;
+                    child->prev = tail;
+                }
+                tail = child;
+
+                if (key_position != 0)
+                {
+                    child->string = (char*)tape_duplicate_string(tape, key_position);
+                    if (child->string == NULL)
+                    {
+                        goto fail;
+                    }
+                }
+
+                child_position = tape_skip(tape, child_position);
+            }
+
+            if (item->child != NULL)
+            {
+                item->child->prev = tail;
+            }
+            break;
+        }
+    }
+
+    return item;
+
+fail:
+    cJSON_Delete(item);
+
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_TapeToCJSON(const cJSON_TapeIterator * const item)
+{
+    cJSON *copy = NULL;
+
+    if (!is_tape_value(item))
+    {
+        return NULL;
+    }
+
+    copy = tape_to_item(item->tape, item->position);
+    if ((copy != NULL) && (item->key != 0))
+    {
+        copy->string = (char*)tape_duplicate_string(item->tape, item->key);
+        if (copy->string == NULL)
+        {
+            cJSON_Delete(copy);
+            return NULL;
+        }
+    }
+
+    return copy;
+}
+
+/* Lookup index of a large object or array.
+ * Objects use open addressing with linear probing, keyed by the case folded key so that both case sensitive and
+ * insensitive lookups can use it. Members are inserted in list order and removed ones leave a tombstone, so the
+ * first match in probing order is also the first match in the list. No member is more than index_max_probes slots
+ * after its hash slot, an object whose keys collide more than that is marked as collided and looked up in the list.
+ * Arrays keep their items in order, so that slots[i] is the item at position i. */
+typedef struct cJSON_Index
+{
+    size_t count; /* members in the index */
+    size_t used; /* slots taken by members or tombstones */
+    size_t capacity; /* number of slots, a power of two */
+    cJSON_bool is_array;
+    cJSON_bool collided; /* the members didn't fit into the slots, lookups walk the list */
+    cJSON **slots;
+} cJSON_Index;
+
+/* crafted keys with colliding hashes would otherwise make building the index quadratic */
+#define index_max_probes 32
+
+/* marks the slot of a removed member */
+static cJSON index_tombstone;
+
+#ifdef ENABLE_CJSON_INDEX
+#define item_index(item) ((item)->index)
+
+/* members below this many don't get an index, 0 disables indexes */
+static size_t global_index_threshold = 0;
+
+CJSON_PUBLIC(void) cJSON_SetIndexThreshold(size_t minimum_members)
+{
+    global_index_threshold = minimum_members;
+}
+
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON * const item)
+{
+    if ((item != NULL) && (item->index != NULL))
+    {
+        global_hooks.deallocate(item->index);
+        item->index = NULL;
+    }
+}
+#else
+/* struct cJSON has no room for an index (see ENABLE_CJSON_INDEX in cJSON.h), so every lookup walks the list */
+#define item_index(item) ((cJSON_Index*)NULL)
+
+CJSON_PUBLIC(void) cJSON_SetIndexThreshold(size_t minimum_members)
+{
+    (void)minimum_members;
+}
+
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON * const item)
+{
+    (void)item;
+}
+#endif
+
+/* FNV-1a of the lower case key */
+static size_t hash_key(const unsigned char *key)
+{
+    unsigned long hash = 2166136261UL;
+
+    for (; *key != '\0'; key++)
+    {
+        hash ^= (unsigned long)lowercase[*key];
+        hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
+    }
+
+    return (size_t)hash;
+}
+
+#ifdef ENABLE_CJSON_INDEX
+/* returns false if the item would be more than index_max_probes slots after its hash slot */
+static cJSON_bool index_insert(cJSON_Index * const index, cJSON * const item)
+{
+    size_t slot = hash_key((const unsigned char*)item->string) & (index->capacity - 1);
+    size_t probes = 0;
+
+    /* tombstones are not reused, an earlier duplicate key could come after them */
+    while (index->slots[slot] != NULL)
+    {
+        if (++probes == index_max_probes)
+        {
+            return false;
+        }
+        slot = (slot + 1) & (index->capacity - 1);
+    }
+
+    index->slots[slot] = item;
+    index->count++;
+    index->used++;
+
+    return true;
+}
+
+/* the slot that holds item, or capacity if it isn't in the index. position is where it probably is in an array */
+static size_t index_find_slot(const cJSON_Index * const index, const cJSON * const item, const size_t position)
+{
+    size_t slot = 0;
+    size_t probes = 0;
+
+    if (index->is_array)
+    {
+        if ((position < index->count) && (index->slots[position] == item))
+        {
+            return position;
+        }
+        for (slot = 0; slot < index->count; slot++)
+        {
+            if (index->slots[slot] == item)
+            {
+                return slot;
+            }
+        }
+
+        return index->capacity;
+    }
+
+    slot = hash_key((const unsigned char*)item->string) & (index->capacity - 1);
+    for (probes = 0; (probes < index_max_probes) && (index->slots[slot] != NULL); probes++, slot = (slot + 1) & (index->capacity - 1))
+    {
+        if (index->slots[slot] == item)
+        {
+            return slot;
+        }
+    }
+
+    return index->capacity;
+}
+
+#endif /* ENABLE_CJSON_INDEX */
+
+CJSON_PUBLIC(void) cJSON_InitKey(cJSON_Key * const key, const char *string)
+{
+    if (key == NULL)
+    {
+        return;
+    }
+
+    key->string = string;
+    key->length = (string != NULL) ? strlen(string) : 0;
+    key->hash = (string != NULL) ? hash_key((const unsigned char*)string) : 0;
+}
+
+/* Compare the key of a member with a key of known length. The first byte rules out most members, the length is
+ * checked by the member ending where the key does. */
+static cJSON_bool key_equals(const char * const member, const cJSON_Key * const key, const cJSON_bool case_sensitive)
+{
+    const unsigned char *string = (const unsigned char*)member;
+    const unsigned char *name = (const unsigned char*)key->string;
+    size_t i = 0;
+
+    if (lowercase[string[0]] != lowercase[name[0]])
+    {
+        return false;
+    }
+
+    /* a shorter member ends with '\0', which differs from every byte of the key */
+    for (i = 0; i < key->length; i++)
+    {
+        if ((string[i] != name[i]) && (case_sensitive || (lowercase[string[i]] != lowercase[name[i]])))
+        {
+            return false;
+        }
+    }
+
+    return string[key->length] == '\0';
+}
+
+static cJSON *index_find(const cJSON_Index * const index, const cJSON_Key * const key, const cJSON_bool case_sensitive)
+{
+    size_t slot = key->hash & (index->capacity - 1);
+    size_t probes = 0;
+    cJSON *candidate = NULL;
+
+    for (; (probes < index_max_probes) && (index->slots[slot] != NULL); probes++, slot = (slot + 1) & (index->capacity - 1))
+    {
+        candidate = index->slots[slot];
+        if (candidate == &index_tombstone)
+        {
+            continue;
+        }
+
+        if (key_equals(candidate->string, key, case_sensitive))
+        {
+            return candidate;
+        }
+    }
+
+    return NULL;
+}
+
+#ifdef ENABLE_CJSON_INDEX
+/* build the index of an object or array with count members, NULL if out of memory */
+static cJSON_Index *build_index(const cJSON * const parent, const size_t count, const cJSON_bool is_array)
+{
+    cJSON_Index *index = NULL;
+    cJSON *child = NULL;
+    size_t capacity = 16;
+
+    /* keep the load factor of objects at or below 1/2, arrays get room to append */
+    while (capacity < (is_array ? (count + 1) : (count * 2)))
+    {
+        capacity *= 2;
+    }
+
+    index = (cJSON_Index*)global_hooks.allocate(sizeof(cJSON_Index) + capacity * sizeof(cJSON*));
+    if (index == NULL)
+    {
+        return NULL;
+    }
+    index->count = 0;
+    index->used = 0;
+    index->capacity = capacity;
+    index->is_array = is_array;
+    index->collided = false;
+    index->slots = (cJSON**)(void*)(index + 1);
+    memset(index->slots, '\0', capacity * sizeof(cJSON*));
+
+    for (child = parent->child; child != NULL; child = child->next)
+    {
+        if (is_array)
+        {
+            index->slots[index->count++] = child;
+            index->used++;
+        }
+        else if (!index_insert(index, child))
+        {
+            /* kept, so that the next lookup doesn't try again */
+            index->collided = true;
+            index->count = count;
+            break;
+        }
+    }
+
+    return index;
+}
+
+/* the index of an object or array, built on first use once it is large enough */
+static cJSON_Index *get_index(const cJSON * const parent)
+{
+    cJSON *mutable_parent = NULL;
+    const cJSON *child = NULL;
+    cJSON_bool is_array = false;
+    size_t count = 0;
+
+    if (parent->index != NULL)
+    {
+        return parent->index->collided ? NULL : parent->index;
+    }
+
+    /* references and arena items are not owned in a way that would allow keeping an index up to date */
+    if ((global_index_threshold == 0) || (parent->type & (cJSON_IsReference | cJSON_ItemInArena)))
+    {
+        return NULL;
+    }
+    switch (parent->type & 0xFF)
+    {
+        case cJSON_Array:
+            is_array = true;
+            break;
+
+        case cJSON_Object:
+            is_array = false;
+            break;
+
+        default:
+            return NULL;
+    }
+
+    for (child = parent->child; child != NULL; child = child->next)
+    {
+        if (!is_array && (child->string == NULL))
+        {
+            /* a linear lookup stops at members without a key, an index can't do that */
+            return NULL;
+        }
+        count++;
+    }
+    if (count < global_index_threshold)
+    {
+        return NULL;
+    }
+
+    /* the index is a cache, building it doesn't change the item as far as the API is concerned */
+    mutable_parent = (cJSON*)cast_away_const(parent);
+    mutable_parent->index = build_index(parent, count, is_array);
+
+    return ((mutable_parent->index != NULL) && mutable_parent->index->collided) ? NULL : mutable_parent->index;
+}
+
+/* item is about to be inserted into parent at position, which is the size of parent when appending */
+static void index_insert_at(cJSON * const parent, cJSON * const item, const size_t position)
+{
+    cJSON_Index *index = parent->index;
+
+    if (index == NULL)
+    {
+        return;
+    }
+
+    if (index->is_array)
+    {
+        if ((index->count == index->capacity) || (position > index->count))
+        {
+            /* rebuilt with more room on the next lookup */
+            cJSON_InvalidateIndex(parent);
+            return;
+        }
+
+        memmove(index->slots + position + 1, index->slots + position, (index->count - position) * sizeof(cJSON*));
+        index->slots[position] = item;
+        index->count++;
+        index->used++;
+        return;
+    }
+
+    /* members in the middle would end up behind later ones in an object index */
+    if (index->collided || (position != index->count) || (item->string == NULL) || (((index->used + 1) * 4) > (index->capacity * 3))
+            || !index_insert(index, item))
+    {
+        /* rebuilt with more room (and without tombstones) on the next lookup */
+        cJSON_InvalidateIndex(parent);
+    }
+}
+
+/* item is about to be detached from parent, position is where it probably is */
+static void index_remove(cJSON * const parent, const cJSON * const item, const size_t position)
+{
+    cJSON_Index *index = parent->index;
+    size_t slot = 0;
+
+    if (index == NULL)
+    {
+        return;
+    }
+
+    slot = index->collided ? index->capacity : index_find_slot(index, item, position);
+    if (slot == index->capacity)
+    {
+        cJSON_InvalidateIndex(parent);
+        return;
+    }
+
+    if (index->is_array)
+    {
+        memmove(index->slots + slot, index->slots + slot + 1, (index->count - slot - 1) * sizeof(cJSON*));
+        index->slots[index->count - 1] = NULL;
+        index->used--;
+    }
+    else
+    {
+        index->slots[slot] = &index_tombstone;
+    }
+    index->count--;
+}
+
+/* item is about to be replaced with replacement in parent, position is where it probably is */
+static void index_replace(cJSON * const parent, const cJSON * const item, cJSON * const replacement, const size_t position)
+{
+    cJSON_Index *index = parent->index;
+    size_t slot = 0;
+
+    if (index == NULL)
+    {
+        return;
+    }
+
+    slot = index->collided ? index->capacity : index_find_slot(index, item, position);
+    if ((slot == index->capacity)
+            || (!index->is_array
+                && ((replacement->string == NULL)
+                    || (case_insensitive_strcmp((const unsigned char*)item->string, (const unsigned char*)replacement->string) != 0))))
+    {
+        /* the replacement belongs into a different slot */
+        cJSON_InvalidateIndex(parent);
+        return;
+    }
+
+    index->slots[slot] = replacement;
+}
+#else
+static cJSON_Index *get_index(const cJSON * const parent)
+{
+    (void)parent;
+    return NULL;
+}
+
+static void index_insert_at(cJSON * const parent, cJSON * const item, const size_t position)
+{
+    (void)parent;
+    (void)item;
+    (void)position;
+}
+
+static void index_remove(cJSON * const parent, const cJSON * const item, const size_t position)
+{
+    (void)parent;
+    (void)item;
+    (void)position;
+}
+
+static void index_replace(cJSON * const parent, const cJSON * const item, cJSON * const replacement, const size_t position)
+{
+    (void)parent;
+    (void)item;
+    (void)replacement;
+    (void)position;
+}
+#endif /* ENABLE_CJSON_INDEX */
+
+/* Get Array size/item / object item. */
+CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
+{
+    cJSON *child = NULL;
+    size_t size = 0;
+
+    if (array == NULL)
+    {
+        return 0;
+    }
+
+    if (((array->type & 0xFF) == cJSON_Array) ? (get_index(array) != NULL) : (item_index(array) != NULL))
+    {
+        return (int)item_index(array)->count;
+    }
+
+    child = array->child;
+
+    while(child != NULL)
+    {
+        size++;
+        child = child->next;
+    }
+
+    /* FIXME: Can overflow here. Cannot be fixed without breaking the API */
+
+    return (int)size;
+}
+
+static cJSON* get_array_item(const cJSON *array, size_t index)
+{
+    cJSON *current_child = NULL;
+    cJSON_Index *array_index = NULL;
+
+    if (array == NULL)
+    {
+        return NULL;
+    }
+
+    /* objects don't get a positional index, building their key index here wouldn't help */
+    array_index = ((array->type & 0xFF) == cJSON_Array) ? get_index(array) : NULL;
+    if ((array_index != NULL) && array_index->is_array)
+    {
+        return (index < array_index->count) ? array_index->slots[index] : NULL;
+    }
+
+    current_child = array->child;
+    while ((current_child != NULL) && (index > 0))
+    {
+        index--;
+        current_child = current_child->next;
+    }
+
+    return current_child;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index)
+{
+    if (index < 0)
+    {
+        return NULL;
+    }
+
+    return get_array_item(array, (size_t)index);
+}
+
+static cJSON *get_object_item(const cJSON * const object, const char * const name, const cJSON_bool case_sensitive)
+{
+    cJSON *current_element = NULL;
+    cJSON_Index *index = NULL;
+
+    if ((object == NULL) || (name == NULL))
+    {
+        return NULL;
+    }
+
+    index = get_index(object);
+    if ((index != NULL) && !index->is_array)
+    {
+        cJSON_Key key;
+        cJSON_InitKey(&key, name);
+        return index_find(index, &key, case_sensitive);
+    }
+
+    current_element = object->child;
+    if (case_sensitive)
+    {
+        while ((current_element != NULL) && (current_element->string != NULL) && (strcmp(name, current_element->string) != 0))
+        {
+            current_element = current_element->next;
+        }
+    }
+    else
+    {
+        /* the first byte rules out most members before the comparison */
+        const unsigned char first = lowercase[(unsigned char)name[0]];
+        while ((current_element != NULL)
+                && ((current_element->string == NULL) || (lowercase[(unsigned char)current_element->string[0]] != first)
+                    || (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)(current_element->string)) != 0)))
+        {
+            current_element = current_element->next;
+        }
+    }
+
+    if ((current_element == NULL) || (current_element->string == NULL)) {
+        return NULL;
+    }
+
+    return current_element;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string)
+{
+    return get_object_item(object, string, false);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemCaseSensitive(const cJSON * const object, const char * const string)
+{
+    return get_object_item(object, string, true);
+}
+
+static cJSON *get_object_item_key(const cJSON * const object, const cJSON_Key * const key, const cJSON_bool case_sensitive)
+{
+    cJSON *current_element = NULL;
+    cJSON_Index *index = NULL;
+
+    if ((object == NULL) || (key == NULL) || (key->string == NULL))
+    {
+        return NULL;
+    }
+
+    index = get_index(object);
+    if ((index != NULL) && !index->is_array)
+    {
+        return index_find(index, key, case_sensitive);
+    }
+
+    for (current_element = object->child; current_element != NULL; current_element = current_element->next)
+    {
+        if (current_element->string == NULL)
+        {
+            /* the same as get_object_item: case sensitive lookups stop at members without a key */
+            if (case_sensitive)
+            {
+                return NULL;
+            }
+            continue;
+        }
+        if (key_equals(current_element->string, key, case_sensitive))
+        {
+            return current_element;
+        }
+    }
+
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemKey(const cJSON * const object, const cJSON_Key * const key)
+{
+    return get_object_item_key(object, key, false);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemKeyCaseSensitive(const cJSON * const object, const cJSON_Key * const key)
+{
+    return get_object_item_key(object, key, true);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *string)
+{
+    return cJSON_GetObjectItem(object, string) ? 1 : 0;
+}
+
+/* Utility for array list handling. */
+static void suffix_object(cJSON *prev, cJSON *item)
+{
+    prev->next = item;
+    item->prev = prev;
+}
+
+/* Utility for handling references. */
+static cJSON *create_reference(const cJSON *item, const internal_hooks * const hooks)
+{
+    cJSON *reference = NULL;
+    if (item == NULL)
+    {
+        return NULL;
+    }
+
+    reference = cJSON_New_Item(hooks);
+    if (reference == NULL)
+    {
+        return NULL;
+    }
+
+    memcpy(reference, item, sizeof(cJSON));
+    reference->string = NULL;
+#ifdef ENABLE_CJSON_INDEX
+    reference->index = NULL;
+#endif
+    /* the reference is a heap item of its own, whatever memory the item it points to lives in */
+    reference->type &= ~(cJSON_ItemInArena | cJSON_ValuestringIsConst | cJSON_StringIsInterned);
+    reference->type |= cJSON_IsReference;
+    reference->next = reference->prev = NULL;
+    return reference;
+}
+
+static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
+{
+    cJSON *child = NULL;
+
+    if ((item == NULL) || (array == NULL) || (array == item))
+    {
+        return false;
+    }
+
+    child = array->child;
+    /*
+     * To find the last item in array quickly, we use prev in array
+     */
+    if (child == NULL)
+    {
+        /* list is empty, start new one */
+        array->child = item;
+        item->prev = item;
+        item->next = NULL;
+    }
+    else
+    {
+        /* append to the end */
+        if (child->prev)
+        {
+            suffix_object(child->prev, item);
+            array->child->prev = item;
+        }
+    }
+
+    index_insert_at(array, item, (item_index(array) != NULL) ? item_index(array)->count : 0);
+
+    return true;
+}
+
+/* Add item to array/object. */
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToArray(cJSON *array, cJSON *item)
+{
+    return add_item_to_array(array, item);
+}
+
+#if defined(__clang__) || (defined(__GNUC__)  && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 5))))
+    #pragma GCC diagnostic push
+#endif
+#ifdef __GNUC__
+#pragma GCC diagnostic ignored "-Wcast-qual"
+#endif
+/* helper function to cast away const */
+static void* cast_away_const(const void* string)
+{
+    return (void*)string;
+}
+#if defined(__clang__) || (defined(__GNUC__)  && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ > 5))))
+    #pragma GCC diagnostic pop
+#endif
+
+
+static cJSON_bool add_item_to_object(cJSON * const object, const char * const string, cJSON * const item, const internal_hooks * const hooks, const cJSON_bool constant_key)
+{
+    char *new_key = NULL;
+    int new_type = cJSON_Invalid;
+
+    if ((object == NULL) || (string == NULL) || (item == NULL) || (object == item))
+    {
+        return false;
+    }
+
+    if (constant_key)
+    {
+        new_key = (char*)cast_away_const(string);
+        new_type = (item->type & ~cJSON_StringIsInterned) | cJSON_StringIsConst;
+    }
+    else
+    {
+        new_key = (char*)cJSON_strdup((const unsigned char*)string, hooks);
+        if (new_key == NULL)
+        {
+            return false;
+        }
+
+        new_type = item->type & ~(cJSON_StringIsConst | cJSON_StringIsInterned);
+    }
+
+    if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
+    {
+        hooks->deallocate(item->string);
+    }
+
+    item->string = new_key;
+    item->type = new_type;
+
+    return add_item_to_array(object, item);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToObject(cJSON *object, const char *string, cJSON *item)
+{
+    return add_item_to_object(object, string, item, &global_hooks, false);
+}
+
+/* Add an item to an object with constant string as key */
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToObjectCS(cJSON *object, const char *string, cJSON *item)
+{
+    return add_item_to_object(object, string, item, &global_hooks, true);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemReferenceToArray(cJSON *array, cJSON *item)
+{
+    if (array == NULL)
+    {
+        return false;
+    }
+
+    return add_item_to_array(array, create_reference(item, &global_hooks));
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemReferenceToObject(cJSON *object, const char *string, cJSON *item)
+{
+    if ((object == NULL) || (string == NULL))
+    {
+        return false;
+    }
+
+    return add_item_to_object(object, string, create_reference(item, &global_hooks), &global_hooks, false);
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddNullToObject(cJSON * const object, const char * const name)
+{
+    cJSON *null = cJSON_CreateNull();
+    if (add_item_to_object(object, name, null, &global_hooks, false))
+    {
+        return null;
+    }
+
+    cJSON_Delete(null);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddTrueToObject(cJSON * const object, const char * const name)
+{
+    cJSON *true_item = cJSON_CreateTrue();
+    if (add_item_to_object(object, name, true_item, &global_hooks, false))
+    {
+        return true_item;
+    }
+
+    cJSON_Delete(true_item);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddFalseToObject(cJSON * const object, const char * const name)
+{
+    cJSON *false_item = cJSON_CreateFalse();
+    if (add_item_to_object(object, name, false_item, &global_hooks, false))
+    {
+        return false_item;
+    }
+
+    cJSON_Delete(false_item);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddBoolToObject(cJSON * const object, const char * const name, const cJSON_bool boolean)
+{
+    cJSON *bool_item = cJSON_CreateBool(boolean);
+    if (add_item_to_object(object, name, bool_item, &global_hooks, false))
+    {
+        return bool_item;
+    }
+
+    cJSON_Delete(bool_item);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddNumberToObject(cJSON * const object, const char * const name, const double number)
+{
+    cJSON *number_item = cJSON_CreateNumber(number);
+    if (add_item_to_object(object, name, number_item, &global_hooks, false))
+    {
+        return number_item;
+    }
+
+    cJSON_Delete(number_item);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddStringToObject(cJSON * const object, const char * const name, const char * const string)
+{
+    cJSON *string_item = cJSON_CreateString(string);
+    if (add_item_to_object(object, name, string_item, &global_hooks, false))
+    {
+        return string_item;
+    }
+
+    cJSON_Delete(string_item);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddRawToObject(cJSON * const object, const char * const name, const char * const raw)
+{
+    cJSON *raw_item = cJSON_CreateRaw(raw);
+    if (add_item_to_object(object, name, raw_item, &global_hooks, false))
+    {
+        return raw_item;
+    }
+
+    cJSON_Delete(raw_item);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddObjectToObject(cJSON * const object, const char * const name)
+{
+    cJSON *object_item = cJSON_CreateObject();
+    if (add_item_to_object(object, name, object_item, &global_hooks, false))
+    {
+        return object_item;
+    }
+
+    cJSON_Delete(object_item);
+    return NULL;
+}
+
+CJSON_PUBLIC(cJSON*) cJSON_AddArrayToObject(cJSON * const object, const char * const name)
+{
+    cJSON *array = cJSON_CreateArray();
+    if (add_item_to_object(object, name, array, &global_hooks, false))
+    {
+        return array;
+    }
+
+    cJSON_Delete(array);
+    return NULL;
+}
+
+/* position is where item probably is in parent, it only speeds up updating the index */
+static cJSON *detach_item_via_pointer(cJSON *parent, cJSON * const item, const size_t position)
+{
+    if ((parent == NULL) || (item == NULL) || (item != parent->child && item->prev == NULL))
+    {
+        return NULL;
+    }
+
+    index_remove(parent, item, position);
+
+    if (item != parent->child)
+    {
+        /* not the first element */
+        item->prev->next = item->next;
+    }
+    if (item->next != NULL)
+    {
+        /* not the last element */
+        item->next->prev = item->prev;
+    }
+
+    if (item == parent->child)
+    {
+        /* first element */
+        parent->child = item->next;
+    }
+    else if (item->next == NULL)
+    {
+        /* last element */
+        parent->child->prev = item->prev;
+    }
+
+    /* make sure the detached item doesn't point anywhere anymore */
+    item->prev = NULL;
+    item->next = NULL;
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const item)
+{
+    return detach_item_via_pointer(parent, item, 0);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromArray(cJSON *array, int which)
+{
+    if (which < 0)
+    {
+        return NULL;
+    }
+
+    return detach_item_via_pointer(array, get_array_item(array, (size_t)which), (size_t)which);
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteItemFromArray(cJSON *array, int which)
+{
+    cJSON_Delete(cJSON_DetachItemFromArray(array, which));
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromObject(cJSON *object, const char *string)
+{
+    cJSON *to_detach = cJSON_GetObjectItem(object, string);
+
+    return cJSON_DetachItemViaPointer(object, to_detach);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromObjectCaseSensitive(cJSON *object, const char *string)
+{
+    cJSON *to_detach = cJSON_GetObjectItemCaseSensitive(object, string);
+
+    return cJSON_DetachItemViaPointer(object, to_detach);
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteItemFromObject(cJSON *object, const char *string)
+{
+    cJSON_Delete(cJSON_DetachItemFromObject(object, string));
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteItemFromObjectCaseSensitive(cJSON *object, const char *string)
+{
+    cJSON_Delete(cJSON_DetachItemFromObjectCaseSensitive(object, string));
+}
+
+/* Replace array/object items with new ones. */
+CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON *newitem)
+{
+    cJSON *after_inserted = NULL;
+
+    if (which < 0 || newitem == NULL)
+    {
+        return false;
+    }
+
+    after_inserted = get_array_item(array, (size_t)which);
+    if (after_inserted == NULL)
+    {
+        return add_item_to_array(array, newitem);
+    }
+
+    if (after_inserted != array->child && after_inserted->prev == NULL) {
+        /* return false if after_inserted is a corrupted array item */
+        return false;
+    }
+
+    index_insert_at(array, newitem, (size_t)which);
+
+    newitem->next = after_inserted;
+    newitem->prev = after_inserted->prev;
+    after_inserted->prev = newitem;
+    if (after_inserted == array->child)
+    {
+        array->child = newitem;
+    }
+    else
+    {
+        newitem->prev->next = newitem;
+    }
+    return true;
+}
+
+/* position is where item probably is in parent, it only speeds up updating the index */
+static cJSON_bool replace_item_via_pointer(cJSON * const parent, cJSON * const item, cJSON * replacement, const size_t position)
+{
+    if ((parent == NULL) || (parent->child == NULL) || (replacement == NULL) || (item == NULL))
+    {
+        return false;
+    }
+
+    if (replacement == item)
+    {
+        return true;
+    }
+
+    index_replace(parent, item, replacement, position);
+
+    replacement->next = item->next;
+    replacement->prev = item->prev;
+
+    if (replacement->next != NULL)
+    {
+        replacement->next->prev = replacement;
+    }
+    if (parent->child == item)
+    {
+        if (parent->child->prev == parent->child)
+        {
+            replacement->prev = replacement;
+        }
+        parent->child = replacement;
+    }
+    else
+    {   /*
+         * To find the last item in array quickly, we use prev in array.
+         * We can't modify the last item's next pointer where this item was the parent's child
+         */
+        if (replacement->prev != NULL)
+        {
+            replacement->prev->next = replacement;
+        }
+        if (replacement->next == NULL)
+        {
+            parent->child->prev = replacement;
+        }
+    }
+
+    item->next = NULL;
+    item->prev = NULL;
+    cJSON_Delete(item);
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON * const item, cJSON * replacement)
+{
+    return replace_item_via_pointer(parent, item, replacement, 0);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInArray(cJSON *array, int which, cJSON *newitem)
+{
+    if (which < 0)
+    {
+        return false;
+    }
+
+    return replace_item_via_pointer(array, get_array_item(array, (size_t)which), newitem, (size_t)which);
+}
+
+static cJSON_bool replace_item_in_object(cJSON *object, const char *string, cJSON *replacement, cJSON_bool case_sensitive)
+{
+    if ((replacement == NULL) || (string == NULL))
+    {
+        return false;
+    }
+
+    /* replace the name in the replacement */
+    if (!(replacement->type & cJSON_StringIsConst) && (replacement->string != NULL))
+    {
+        cJSON_free(replacement->string);
+    }
+    replacement->string = (char*)cJSON_strdup((const unsigned char*)string, &global_hooks);
+    if (replacement->string == NULL)
+    {
+        return false;
+    }
+
+    replacement->type &= ~(cJSON_StringIsConst | cJSON_StringIsInterned);
+
+    return cJSON_ReplaceItemViaPointer(object, get_object_item(object, string, case_sensitive), replacement);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInObject(cJSON *object, const char *string, cJSON *newitem)
+{
+    return replace_item_in_object(object, string, newitem, false);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInObjectCaseSensitive(cJSON *object, const char *string, cJSON *newitem)
+{
+    return replace_item_in_object(object, string, newitem, true);
+}
+
+/* Create basic types: */
+CJSON_PUBLIC(cJSON *) cJSON_CreateNull(void)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type = cJSON_NULL;
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateTrue(void)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type = cJSON_True;
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateFalse(void)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type = cJSON_False;
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateBool(cJSON_bool boolean)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type = boolean ? cJSON_True : cJSON_False;
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateNumber(double num)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type = cJSON_Number;
+        item->valuedouble = num;
+
+        /* use saturation in case of overflow */
+        if (num >= INT_MAX)
+        {
+            item->valueint = INT_MAX;
+        }
+        else if (num <= (double)INT_MIN)
+        {
+            item->valueint = INT_MIN;
+        }
+        else
+        {
+            item->valueint = (int)num;
+        }
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateString(const char *string)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type = cJSON_String;
+        item->valuestring = (char*)cJSON_strdup((const unsigned char*)string, &global_hooks);
+        if(!item->valuestring)
+        {
+            cJSON_Delete(item);
+            return NULL;
+        }
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateStringReference(const char *string)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if (item != NULL)
+    {
+        item->type = cJSON_String | cJSON_IsReference;
+        item->valuestring = (char*)cast_away_const(string);
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateObjectReference(const cJSON *child)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if (item != NULL) {
+        item->type = cJSON_Object | cJSON_IsReference;
+        item->child = (cJSON*)cast_away_const(child);
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateArrayReference(const cJSON *child) {
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if (item != NULL) {
+        item->type = cJSON_Array | cJSON_IsReference;
+        item->child = (cJSON*)cast_away_const(child);
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateRaw(const char *raw)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type = cJSON_Raw;
+        item->valuestring = (char*)cJSON_strdup((const unsigned char*)raw, &global_hooks);
+        if(!item->valuestring)
+        {
+            cJSON_Delete(item);
+            return NULL;
+        }
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateArray(void)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if(item)
+    {
+        item->type=cJSON_Array;
+    }
+
+    return item;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateObject(void)
+{
+    cJSON *item = cJSON_New_Item(&global_hooks);
+    if (item)
+    {
+        item->type = cJSON_Object;
+    }
+
+    return item;
+}
+
+/* Create Arrays: */
+CJSON_PUBLIC(cJSON *) cJSON_CreateIntArray(const int *numbers, int count)
+{
+    size_t i = 0;
+    cJSON *n = NULL;
+    cJSON *p = NULL;
+    cJSON *a = NULL;
+
+    if ((count < 0) || (numbers == NULL))
+    {
+        return NULL;
+    }
+
+    a = cJSON_CreateArray();
+
+    for(i = 0; a && (i < (size_t)count); i++)
+    {
+        n = cJSON_CreateNumber(numbers[i]);
+        if (!n)
+        {
+            cJSON_Delete(a);
+            return NULL;
+        }
+        if(!i)
+        {
+            a->child = n;
+        }
+        else
+        {
+            suffix_object(p, n);
+        }
+        p = n;
+    }
+
+    if (a && a->child) {
+        a->child->prev = n;
+    }
+
+    return a;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateFloatArray(const float *numbers, int count)
+{
+    size_t i = 0;
+    cJSON *n = NULL;
+    cJSON *p = NULL;
+    cJSON *a = NULL;
+
+    if ((count < 0) || (numbers == NULL))
+    {
+        return NULL;
+    }
+
+    a = cJSON_CreateArray();
+
+    for(i = 0; a && (i < (size_t)count); i++)
+    {
+        n = cJSON_CreateNumber((double)numbers[i]);
+        if(!n)
+        {
+            cJSON_Delete(a);
+            return NULL;
+        }
+        if(!i)
+        {
+            a->child = n;
+        }
+        else
+        {
+            suffix_object(p, n);
+        }
+        p = n;
+    }
+
+    if (a && a->child) {
+        a->child->prev = n;
+    }
+
+    return a;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateDoubleArray(const double *numbers, int count)
+{
+    size_t i = 0;
+    cJSON *n = NULL;
+    cJSON *p = NULL;
+    cJSON *a = NULL;
+
+    if ((count < 0) || (numbers == NULL))
+    {
+        return NULL;
+    }
+
+    a = cJSON_CreateArray();
+
+    for(i = 0; a && (i < (size_t)count); i++)
+    {
+        n = cJSON_CreateNumber(numbers[i]);
+        if(!n)
+        {
+            cJSON_Delete(a);
+            return NULL;
+        }
+        if(!i)
+        {
+            a->child = n;
+        }
+        else
+        {
+            suffix_object(p, n);
+        }
+        p = n;
+    }
+
+    if (a && a->child) {
+        a->child->prev = n;
+    }
+
+    return a;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_CreateStringArray(const char *const *strings, int count)
+{
+    size_t i = 0;
+    cJSON *n = NULL;
+    cJSON *p = NULL;
+    cJSON *a = NULL;
+
+    if ((count < 0) || (strings == NULL))
+    {
+        return NULL;
+    }
+
+    a = cJSON_CreateArray();
+
+    for (i = 0; a && (i < (size_t)count); i++)
+    {
+        n = cJSON_CreateString(strings[i]);
+        if(!n)
+        {
+            cJSON_Delete(a);
+            return NULL;
+        }
+        if(!i)
+        {
+            a->child = n;
+        }
+        else
+        {
+            suffix_object(p,n);
+        }
+        p = n;
+    }
+
+    if (a && a->child) {
+        a->child->prev = n;
+    }
+
+    return a;
+}
+
+/* Duplication */
+cJSON * cJSON_Duplicate_rec(const cJSON *item, size_t depth, cJSON_bool recurse);
+
+CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
+{
+    return cJSON_Duplicate_rec(item, 0, recurse );
+}
+
+cJSON * cJSON_Duplicate_rec(const cJSON *item, size_t depth, cJSON_bool recurse)
+{
+    cJSON *newitem = NULL;
+    cJSON *child = NULL;
+    cJSON *next = NULL;
+    cJSON *newchild = NULL;
+
+    /* Bail on bad ptr */
+    if (!item)
+    {
+        goto fail;
+    }
+    /* Create new item */
+    newitem = cJSON_New_Item(&global_hooks);
+    if (!newitem)
+    {
+        goto fail;
+    }
+    /* Copy over all vars, the copy owns all of its memory */
+    newitem->type = item->type & ~(cJSON_IsReference | cJSON_ValuestringIsConst | cJSON_ItemInArena | cJSON_StringIsInterned);
+    newitem->valueint = item->valueint;
+    newitem->valuedouble = item->valuedouble;
+    if (item->valuestring)
+    {
+        newitem->valuestring = (char*)cJSON_strdup((unsigned char*)item->valuestring, &global_hooks);
+        if (!newitem->valuestring)
+        {
+            goto fail;
+        }
+    }
+    if (item->string)
+    {
+        /* keys of arena, in-situ and interned items die with their memory, so only share real constants */
+        if ((item->type & cJSON_StringIsConst) && !(item->type & (cJSON_ItemInArena | cJSON_ValuestringIsConst | cJSON_StringIsInterned)))
+        {
+            newitem->string = item->string;
+        }
+        else
+        {
+            newitem->string = (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
+            newitem->type &= ~cJSON_StringIsConst;
+        }
+        if (!newitem->string)
+        {
+            goto fail;
+        }
+    }
+    /* If non-recursive, then we're done! */
+    if (!recurse)
+    {
+        return newitem;
+    }
+    /* Walk the ->next chain for the child. */
+    child = item->child;
+    while (child != NULL)
+    {
+        if(depth >= CJSON_CIRCULAR_LIMIT) {
+            goto fail;
+        }
+        newchild = cJSON_Duplicate_rec(child, depth + 1, true); /* Duplicate (with recurse) each item in the ->next chain */
+        if (!newchild)
+        {
+            goto fail;
+        }
+        if (next != NULL)
+        {
+            /* If newitem->child already set, then crosswire ->prev and ->next and move on */
+            next->next = newchild;
+            newchild->prev = next;
+            next = newchild;
+        }
+        else
+        {
+            /* Set newitem->child and move to it */
+            newitem->child = newchild;
+            next = newchild;
+        }
+        child = child->next;
+    }
+    if (newitem && newitem->child)
+    {
+        newitem->child->prev = newchild;
+    }
+
+    return newitem;
+
+fail:
+    if (newitem != NULL)
+    {
+        cJSON_Delete(newitem);
+    }
+
+    return NULL;
+}
+
+/* Compact duplication. A first walk counts the items and string bytes, a second one copies them into one allocation:
+ * the items in preorder, followed by their strings. The walks keep the open containers in a stack of frames instead of
+ * recursing, the first few frames live on the call stack. */
+typedef struct
+{
+    const cJSON *source;
+    cJSON *copy;
+} duplicate_frame;
+
+typedef struct
+{
+    duplicate_frame local[16];
+    duplicate_frame *frames;
+    size_t size;
+    size_t depth;
+} duplicate_stack;
+
+typedef struct
+{
+    cJSON *items; /* NULL while counting */
+    size_t item_count;
+    char *strings;
+    size_t string_length;
+} compact_block;
+
+static cJSON_bool duplicate_push(duplicate_stack * const stack, const cJSON * const source, cJSON * const copy)
+{
+    if (stack->depth >= CJSON_CIRCULAR_LIMIT)
+    {
+        return false;
+    }
+    if (stack->depth == stack->size)
+    {
+        duplicate_frame *frames = NULL;
+
+        frames = (duplicate_frame*)global_hooks.allocate(stack->size * 2 * sizeof(duplicate_frame));
+        if (frames == NULL)
+        {
+            return false;
+        }
+        memcpy(frames, stack->frames, stack->depth * sizeof(duplicate_frame));
+        if (stack->frames != stack->local)
+        {
+            global_hooks.deallocate(stack->frames);
+        }
+        stack->frames = frames;
+        stack->size *= 2;
+    }
+
+    stack->frames[stack->depth].source = source;
+    stack->frames[stack->depth].copy = copy;
+    stack->depth++;
+
+    return true;
+}
+
+static char *compact_string(compact_block * const block, const char * const string)
+{
+    const size_t length = strlen(string) + sizeof("");
+    char *copy = NULL;
+
+    if (block->items != NULL)
+    {
+        copy = block->strings + block->string_length;
+        memcpy(copy, string, length);
+    }
+    block->string_length += length;
+
+    return copy;
+}
+
+/* copy (or only count) item and its children into the block, the copy of item is the first one in it */
+static cJSON_bool compact_walk(const cJSON *item, duplicate_stack * const stack, compact_block * const block)
+{
+    cJSON *copy = NULL;
+    cJSON *previous = NULL; /* the copy of the previous item in the same list */
+    char *string = NULL;
+
+    for (;;)
+    {
+        if (block->items != NULL)
+        {
+            copy = &block->items[block->item_count];
+            memset(copy, '\0', sizeof(cJSON));
+            /* the block owns everything, cJSON_Delete leaves the items alone and cJSON_DeleteCompact frees them */
+            copy->type = (item->type & ~(cJSON_IsReference | cJSON_StringIsConst | cJSON_ValuestringIsConst | cJSON_StringIsInterned)) | cJSON_ItemInArena;
+            copy->valueint = item->valueint;
+            copy->valuedouble = item->valuedouble;
+            if (previous != NULL)
+            {
+                previous->next = copy;
+                copy->prev = previous;
+            }
+            else if (stack->depth > 0)
+            {
+                stack->frames[stack->depth - 1].copy->child = copy;
+            }
+        }
+        block->item_count++;
+
+        if (item->valuestring != NULL)
+        {
+            string = compact_string(block, item->valuestring);
+            if (copy != NULL)
+            {
+                copy->valuestring = string;
+                copy->type |= cJSON_ValuestringIsConst;
+            }
+        }
+        if (item->string != NULL)
+        {
+            string = compact_string(block, item->string);
+            if (copy != NULL)
+            {
+                copy->string = string;
+                copy->type |= cJSON_StringIsConst;
+            }
+        }
+
+        if (item->child != NULL)
+        {
+            if (!duplicate_push(stack, item, copy))
+            {
+                return false;
+            }
+            item = item->child;
+            previous = NULL;
+            continue;
+        }
+
+        /* the next item, or the next one of the innermost container that has one left */
+        previous = copy;
+        while ((stack->depth > 0) && (item->next == NULL))
+        {
+            stack->depth--;
+            if (block->items != NULL)
+            {
+                /* the first item of a list points back at the last one */
+                stack->frames[stack->depth].copy->child->prev = previous;
+            }
+            item = stack->frames[stack->depth].source;
+            previous = stack->frames[stack->depth].copy;
+        }
+        if (stack->depth == 0)
+        {
+            return true;
+        }
+        item = item->next;
+    }
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_DuplicateCompact(const cJSON *item)
+{
+    duplicate_stack stack;
+    compact_block block;
+    cJSON_bool copied = false;
+
+    if (item == NULL)
+    {
+        return NULL;
+    }
+
+    stack.frames = stack.local;
+    stack.size = sizeof(stack.local) / sizeof(stack.local[0]);
+    stack.depth = 0;
+    memset(&block, '\0', sizeof(block));
+
+    if (compact_walk(item, &stack, &block))
+    {
+        const size_t item_count = block.item_count;
+
+        block.items = (cJSON*)global_hooks.allocate(item_count * sizeof(cJSON) + block.string_length);
+        if (block.items != NULL)
+        {
+            block.strings = (char*)(block.items + item_count);
+            block.item_count = 0;
+            block.string_length = 0;
+            stack.depth = 0;
+            copied = compact_walk(item, &stack, &block);
+        }
+    }
+
+    if (stack.frames != stack.local)
+    {
+        global_hooks.deallocate(stack.frames);
+    }
+    if (!copied && (block.items != NULL))
+    {
+        global_hooks.deallocate(block.items);
+        block.items = NULL;
+    }
+
+    return block.items;
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteCompact(cJSON *item)
+{
+    if (item == NULL)
+    {
+        return;
+    }
+
+    /* items that were added to the copy later are deleted as usual, the ones in the block are skipped */
+    cJSON_Delete(item);
+    global_hooks.deallocate(item);
+}
+
+/* length of the comment at the start of input, which starts with '/', or 0 if there is none */
+static size_t comment_length(const unsigned char * const input, const size_t length)
+{
+    const unsigned char *end = NULL;
+    size_t i = 0;
+
+    if ((length < 2) || ((input[1] != '/') && (input[1] != '*')))
+    {
+        return 0;
+    }
+
+    if (input[1] == '/')
+    {
+        /* up to and including the newline */
+        end = (const unsigned char*)memchr(input + static_strlen("//"), '\n', length - static_strlen("//"));
+        return (end == NULL) ? length : (size_t)(end - input) + static_strlen("\n");
+    }
+
+    for (i = static_strlen("/*"); (i + 1) < length; i++)
+    {
+        if ((input[i] == '*') && (input[i + 1] == '/'))
+        {
+            return i + static_strlen("*/");
+        }
+    }
+
+    /* unclosed comments end with the input */
+    return length;
+}
+
+/* copy the bytes of input[0, length) up to the first one that is first, second or below limit, returns how many
+ * were copied. Output never gets ahead of the input, so this works in place. */
+static size_t minify_copy_run(const unsigned char * const input, const size_t length, char * const output, const unsigned char first, const unsigned char second, const unsigned char limit)
+{
+    size_t i = 0;
+
+    /* formatted JSON is mostly short tokens between whitespace, which aren't worth loading a block for */
+    for (; (i < length) && (i < 16); i++)
+    {
+        if ((input[i] == first) || (input[i] == second) || (input[i] < limit))
+        {
+            return i;
+        }
+        output[i] = (char)input[i];
+    }
+
+    if (i < length)
+    {
+        size_t run_length = find_byte_class(input + i, length - i, first, second, limit);
+        memmove(output + i, input + i, run_length);
+        i += run_length;
+    }
+
+    return i;
+}
+
+CJSON_PUBLIC(size_t) cJSON_MinifyWithLength(const char *json, size_t length, char *output)
+{
+    const unsigned char *input = (const unsigned char*)json;
+    size_t input_offset = 0;
+    size_t output_offset = 0;
+    size_t run_length = 0;
+
+    if ((json == NULL) || (output == NULL))
+    {
+        return 0;
+    }
+
+    while (input_offset < length)
+    {
+        switch (input[input_offset])
+        {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                input_offset++;
+                break;
+
+            case '/':
+                run_length = comment_length(input + input_offset, length - input_offset);
+                /* a '/' that doesn't start a comment is dropped too */
+                input_offset += (run_length > 0) ? run_length : 1;
+                break;
+
+            case '\"':
+                output[output_offset++] = '\"';
+                input_offset++;
+                while (input_offset < length)
+                {
+                    run_length = minify_copy_run(input + input_offset, length - input_offset, output + output_offset, '\"', '\\', 32);
+                    input_offset += run_length;
+                    output_offset += run_length;
+                    if (input_offset >= length)
+                    {
+                        break;
+                    }
+                    if (input[input_offset] == '\"')
+                    {
+                        output[output_offset++] = '\"';
+                        input_offset++;
+                        break;
+                    }
+                    /* a backslash keeps the character after it, a control character is copied like any other */
+                    if ((input[input_offset] == '\\') && ((input_offset + 1) < length))
+                    {
+                        output[output_offset++] = (char)input[input_offset++];
+                    }
+                    output[output_offset++] = (char)input[input_offset++];
+                }
+                break;
+
+            default:
+                /* everything up to the next whitespace, string or comment is kept as it is */
+                run_length = minify_copy_run(input + input_offset, length - input_offset, output + output_offset, '\"', '/', 33);
+                if (run_length == 0)
+                {
+                    /* other control characters */
+                    output[output_offset++] = (char)input[input_offset];
+                    run_length = 1;
+                }
+                else
+                {
+                    output_offset += run_length;
+                }
+                input_offset += run_length;
+                break;
+        }
+    }
+
+    return output_offset;
+}
+
+CJSON_PUBLIC(void) cJSON_Minify(char *json)
+{
+    if (json == NULL)
+    {
+        return;
+    }
+
+    json[cJSON_MinifyWithLength(json, strlen(json), json)] = '\0';
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_IsInvalid(const cJSON * const item)
+{
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    return (item->type & 0xFF) == cJSON_Invalid;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_IsFalse(const cJSON * const item)
+{
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    return (item->type & 0xFF) == cJSON_False;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_IsTrue(const cJSON * const item)
+{
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    return (item->type & 0xff) == cJSON_True;
+}
+
+
+CJSON_PUBLIC(cJSON_bool) cJSON_IsBool(const cJSON * const item)
+{
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    return (item->type & (cJSON_True | cJSON_False)) != 0;
+}
+CJSON_PUBLIC(cJSON_bool) cJSON_IsNull(const cJSON * const item)
+{
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    return (item->type & 0xFF) == cJSON_NULL;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_IsNumber(const cJSON * const item)
+{
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    return (item->type & 0xFF) == cJSON_Number;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_IsString(const cJSON * const item)
+{
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    return (item->type & 0xFF) == cJSON_String;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_IsArray(const cJSON * const item)
+{
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    return (item->type & 0xFF) == cJSON_Array;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_IsObject(const cJSON * const item)
+{
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    return (item->type & 0xFF) == cJSON_Object;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_IsRaw(const cJSON * const item)
+{
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    return (item->type & 0xFF) == cJSON_Raw;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_Compare(const cJSON * const a, const cJSON * const b, const cJSON_bool case_sensitive)
+{
+    if ((a == NULL) || (b == NULL) || ((a->type & 0xFF) != (b->type & 0xFF)))
+    {
+        return false;
+    }
+
+    /* check if type is valid */
+    switch (a->type & 0xFF)
+    {
+        case cJSON_False:
+        case cJSON_True:
+        case cJSON_NULL:
+        case cJSON_Number:
+        case cJSON_String:
+        case cJSON_Raw:
+        case cJSON_Array:
+        case cJSON_Object:
+            break;
+
+        default:
+            return false;
+    }
+
+    /* identical objects are equal */
+    if (a == b)
+    {
+        return true;
+    }
+
+    switch (a->type & 0xFF)
+    {
+        /* in these cases and equal type is enough */
+        case cJSON_False:
+        case cJSON_True:
+        case cJSON_NULL:
+            return true;
+
+        case cJSON_Number:
+            if (compare_double(a->valuedouble, b->valuedouble))
+            {
+                return true;
+            }
+            return false;
+
+        case cJSON_String:
+        case cJSON_Raw:
+            if ((a->valuestring == NULL) || (b->valuestring == NULL))
+            {
+                return false;
+            }
+            if (strcmp(a->valuestring, b->valuestring) == 0)
+            {
+                return true;
+            }
+
+            return false;
+
+        case cJSON_Array:
+        {
+            cJSON *a_element = a->child;
+            cJSON *b_element = b->child;
+
+            for (; (a_element != NULL) && (b_element != NULL);)
+            {
+                if (!cJSON_Compare(a_element, b_element, case_sensitive))
+                {
+                    return false;
+                }
+
+                a_element = a_element->next;
+                b_element = b_element->next;
+            }
+
+            /* one of the arrays is longer than the other */
+            if (a_element != b_element) {
+                return false;
+            }
+
+            return true;
+        }
+
+        case cJSON_Object:
+        {
+            cJSON *a_element = NULL;
+            cJSON *b_element = NULL;
+            cJSON_ArrayForEach(a_element, a)
+            {
+                /* TODO This has O(n^2) runtime, which is horrible! */
+                b_element = get_object_item(b, a_element->string, case_sensitive);
+                if (b_element == NULL)
+                {
+                    return false;
+                }
+
+                if (!cJSON_Compare(a_element, b_element, case_sensitive))
+                {
+                    return false;
+                }
+            }
+
+            /* doing this twice, once on a and b to prevent true comparison if a subset of b
+             * TODO: Do this the proper way, this is just a fix for now */
+            cJSON_ArrayForEach(b_element, b)
+            {
+                a_element = get_object_item(a, b_element->string, case_sensitive);
+                if (a_element == NULL)
+                {
+                    return false;
+                }
+
+                if (!cJSON_Compare(b_element, a_element, case_sensitive))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+CJSON_PUBLIC(void *) cJSON_malloc(size_t size)
+{
+    return global_hooks.allocate(size);
+}
+
+CJSON_PUBLIC(void) cJSON_free(void *object)
+{
+    global_hooks.deallocate(object);
+    object = NULL;
+}
@@ -0,0 +1,597 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#ifndef cJSON__h
+#define cJSON__h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if !defined(__WINDOWS__) && (defined(WIN32) || defined(WIN64) || defined(_MSC_VER) || defined(_WIN32))
+#define __WINDOWS__
+#endif
+
+#ifdef __WINDOWS__
+
+/* When compiling for windows, we specify a specific calling convention to avoid issues where we are being called from a project with a different default calling convention.  For windows you have 3 define options:
+
+CJSON_HIDE_SYMBOLS - Define this in the case where you don't want to ever dllexport symbols
+CJSON_EXPORT_SYMBOLS - Define this on library build when you want to dllexport symbols (default)
+CJSON_IMPORT_SYMBOLS - Define this if you want to dllimport symbol
+
+For *nix builds that support visibility attribute, you can define similar behavior by
+
+setting default visibility to hidden by adding
+-fvisibility=hidden (for gcc)
+or
+-xldscope=hidden (for sun cc)
+to CFLAGS
+
+then using the CJSON_API_VISIBILITY flag to "export" the same symbols the way CJSON_EXPORT_SYMBOLS does
+
+*/
+
+#define CJSON_CDECL __cdecl
+#define CJSON_STDCALL __stdcall
+
+/* export symbols by default, this is necessary for copy pasting the C and header file */
+#if !defined(CJSON_HIDE_SYMBOLS) && !defined(CJSON_IMPORT_SYMBOLS) && !defined(CJSON_EXPORT_SYMBOLS)
+#define CJSON_EXPORT_SYMBOLS
+#endif
+
+#if defined(CJSON_HIDE_SYMBOLS)
+#define CJSON_PUBLIC(type)   type CJSON_STDCALL
+#elif defined(CJSON_EXPORT_SYMBOLS)
+#define CJSON_PUBLIC(type)   __declspec(dllexport) type CJSON_STDCALL
+#elif defined(CJSON_IMPORT_SYMBOLS)
+#define CJSON_PUBLIC(type)   __declspec(dllimport) type CJSON_STDCALL
+#endif
+#else /* !__WINDOWS__ */
+#define CJSON_CDECL
+#define CJSON_STDCALL
+
+#if (defined(__GNUC__) || defined(__SUNPRO_CC) || defined (__SUNPRO_C)) && defined(CJSON_API_VISIBILITY)
+#define CJSON_PUBLIC(type)   __attribute__((visibility("default"))) type
+#else
+#define CJSON_PUBLIC(type) type
+#endif
+#endif
+
+/* project version */
+#define CJSON_VERSION_MAJOR 1
+#define CJSON_VERSION_MINOR 7
+#define CJSON_VERSION_PATCH 19
+
+#include <stddef.h>
+
+/* cJSON Types: */
+#define cJSON_Invalid (0)
+#define cJSON_False  (1 << 0)
+#define cJSON_True   (1 << 1)
+#define cJSON_NULL   (1 << 2)
+#define cJSON_Number (1 << 3)
+#define cJSON_String (1 << 4)
+#define cJSON_Array  (1 << 5)
+#define cJSON_Object (1 << 6)
+#define cJSON_Raw    (1 << 7) /* raw json */
+
+#define cJSON_IsReference 256
+#define cJSON_StringIsConst 512
+/* valuestring is not owned by the item (it lives in a cJSON_Arena, a compact duplicate or the input of an in-situ parse) and is not freed by cJSON_Delete */
+#define cJSON_ValuestringIsConst 1024
+/* the item itself lives in a cJSON_Arena or a compact duplicate and is released with cJSON_ResetArena or cJSON_DeleteCompact instead of cJSON_Delete */
+#define cJSON_ItemInArena 2048
+/* string is shared through a cJSON_KeyTable (cJSON_StringIsConst is set as well) and lives as long as the table */
+#define cJSON_StringIsInterned 4096
+
+/* The cJSON structure: */
+typedef struct cJSON
+{
+    /* next/prev allow you to walk array/object chains. Alternatively, use GetArraySize/GetArrayItem/GetObjectItem */
+    struct cJSON *next;
+    struct cJSON *prev;
+    /* An array or object item will have a child pointer pointing to a chain of the items in the array/object. */
+    struct cJSON *child;
+
+    /* The type of the item, as above. */
+    int type;
+
+    /* The item's string, if type==cJSON_String  and type == cJSON_Raw */
+    char *valuestring;
+    /* writing to valueint is DEPRECATED, use cJSON_SetNumberValue instead */
+    int valueint;
+    /* The item's number, if type==cJSON_Number */
+    double valuedouble;
+
+    /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
+    char *string;
+
+#ifdef ENABLE_CJSON_INDEX
+    /* Lookup index of a large object, owned and kept up to date by cJSON. See cJSON_SetIndexThreshold.
+     * Only with ENABLE_CJSON_INDEX, which changes the size of cJSON, so everything including this header and the
+     * library itself have to be built with the same setting. */
+    struct cJSON_Index *index;
+#endif
+} cJSON;
+
+typedef struct cJSON_Hooks
+{
+      /* malloc/free are CDECL on Windows regardless of the default calling convention of the compiler, so ensure the hooks allow passing those functions directly. */
+      void *(CJSON_CDECL *malloc_fn)(size_t sz);
+      void (CJSON_CDECL *free_fn)(void *ptr);
+} cJSON_Hooks;
+
+typedef int cJSON_bool;
+
+/* Node pool for cJSON_InitHooksWithPool: cJSON structs are carved out of slabs of nodes_per_slab nodes and recycled
+ * instead of going through malloc_fn and free_fn one by one. If items are created or deleted by several threads,
+ * lock and unlock have to guard the shared part of the pool (e.g. with a FreeRTOS mutex), otherwise they can be NULL. */
+typedef struct cJSON_PoolConfig
+{
+    size_t nodes_per_slab;
+    void (CJSON_CDECL *lock)(void *context);
+    void (CJSON_CDECL *unlock)(void *context);
+    void *lock_context;
+} cJSON_PoolConfig;
+
+typedef struct cJSON_PoolStats
+{
+    size_t hits; /* nodes handed out again after they were deleted */
+    size_t misses; /* nodes handed out for the first time, from a new slab */
+    size_t in_use; /* nodes handed out and not deleted yet (cached free nodes don't count) */
+    size_t high_water; /* the most nodes in use at once */
+    size_t slabs;
+} cJSON_PoolStats;
+
+/* A caller provided block of memory that cJSON_ParseWithArena places all items and strings in.
+ * Allocation is a pointer bump, everything is released at once with cJSON_ResetArena. */
+typedef struct cJSON_Arena
+{
+    unsigned char *memory;
+    size_t size;
+    size_t used;
+} cJSON_Arena;
+
+/* A key that is looked up again and again, with its length and hash computed once by cJSON_InitKey.
+ * string isn't copied, it has to stay valid as long as the key is used (e.g. a string literal). */
+typedef struct cJSON_Key
+{
+    const char *string;
+    size_t length;
+    size_t hash;
+} cJSON_Key;
+
+/* Writes JSON straight into a caller provided buffer, see cJSON_InitWriter. The fields are private. */
+typedef struct cJSON_Writer
+{
+    char *buffer;
+    size_t length;
+    size_t offset;
+    cJSON_bool separate;
+    cJSON_bool failed;
+} cJSON_Writer;
+
+/* How a struct member is written to and read from JSON, see cJSON_WriterFields and cJSON_InitBinding */
+typedef enum cJSON_FieldType
+{
+    cJSON_FieldDouble,
+    cJSON_FieldFloat, /* written with the shortest digits that read back as the same float */
+    cJSON_FieldInt, /* signed char, short, int or long, depending on the size of the member */
+    cJSON_FieldUnsigned, /* unsigned char, short, int or long */
+    cJSON_FieldBool, /* true or false in an integer member (including bool and cJSON_bool), or the strings names[0] and names[1] */
+    cJSON_FieldString, /* char array, longer strings are cut */
+    cJSON_FieldEnum, /* unsigned member with the index of the string in names, or count for any other string */
+    cJSON_FieldObject /* nested object made of the count fields that follow it */
+} cJSON_FieldType;
+
+/* One entry of a field table. Tables list the fields of nested objects right after the object field, and the offsets
+ * of all of them are relative to the same struct. Use the cJSON_FIELD macros to fill them in. */
+typedef struct cJSON_Field
+{
+    const char *key;
+    size_t key_length;
+    cJSON_FieldType type;
+    size_t offset;
+    size_t size;
+    size_t count;
+    const char * const *names;
+} cJSON_Field;
+
+#define cJSON_FIELD(type, key, structure, member) { (key), sizeof(key) - 1, (type), offsetof(structure, member), sizeof(((structure*)0)->member), 0, NULL }
+#define cJSON_ENUM_FIELD(key, structure, member, names) { (key), sizeof(key) - 1, cJSON_FieldEnum, offsetof(structure, member), sizeof(((structure*)0)->member), sizeof(names) / sizeof((names)[0]), (names) }
+/* a bool written as one of two names (false first) instead of false and true. Any other string is rejected. */
+#define cJSON_NAMED_BOOL_FIELD(key, structure, member, names) { (key), sizeof(key) - 1, cJSON_FieldBool, offsetof(structure, member), sizeof(((structure*)0)->member), sizeof(names) / sizeof((names)[0]), (names) }
+#define cJSON_OBJECT_FIELD(key, count) { (key), sizeof(key) - 1, cJSON_FieldObject, 0, 0, (count), NULL }
+
+/* State of reading a document into a struct, see cJSON_InitBinding. The fields are private. */
+typedef struct cJSON_Binding
+{
+    const cJSON_Field *fields;
+    size_t count;
+    unsigned char *structure;
+    unsigned long found;
+    size_t scope;
+    size_t field;
+    size_t skip;
+    cJSON_bool started;
+} cJSON_Binding;
+
+/* Callbacks for cJSON_ParseSAX, any of them may be NULL. Returning false from a callback stops the parser.
+ * Strings and keys are not null terminated and only valid until the callback returns. */
+typedef struct cJSON_SAXHandler
+{
+    cJSON_bool (*start_object)(void *user_data);
+    cJSON_bool (*end_object)(void *user_data);
+    cJSON_bool (*start_array)(void *user_data);
+    cJSON_bool (*end_array)(void *user_data);
+    cJSON_bool (*key)(void *user_data, const char *key, size_t length);
+    cJSON_bool (*string)(void *user_data, const char *string, size_t length);
+    cJSON_bool (*number)(void *user_data, double number);
+    cJSON_bool (*boolean)(void *user_data, cJSON_bool boolean);
+    cJSON_bool (*null)(void *user_data);
+} cJSON_SAXHandler;
+
+/* Resumable cJSON_ParseSAX, see cJSON_CreateParser */
+typedef struct cJSON_Parser cJSON_Parser;
+
+/* Stores every distinct object key once, see cJSON_ParseWithKeyTable */
+typedef struct cJSON_KeyTable cJSON_KeyTable;
+
+/* Options and results of one cJSON_ParseWithContext. Unlike cJSON_GetErrorPtr, nothing is shared between threads
+ * that parse with their own context. Set it up with cJSON_InitParseContext, which turns all options off.
+ * cJSON_ParseSAXWithContext and cJSON_ParseTapeWithContext ignore the options and only report the results. */
+typedef struct cJSON_ParseContext
+{
+    cJSON_Arena *arena; /* place the tree in the arena, like cJSON_ParseWithArena */
+    cJSON_KeyTable *key_table; /* share the keys through the table, like cJSON_ParseWithKeyTable */
+    size_t nesting_limit; /* reject arrays and objects nested deeper, 0 for CJSON_NESTING_LIMIT, which is also the most */
+    cJSON_bool in_situ; /* unescape strings inside of value, like cJSON_ParseInSitu (value has to be writable) */
+    cJSON_bool require_null_terminated; /* only whitespace and a null terminator may follow the value */
+    /* results */
+    const char *end; /* the end of the parsed value, or where parsing failed */
+    const char *error; /* where parsing failed, NULL after a successful parse */
+} cJSON_ParseContext;
+
+/* Read-only document built by cJSON_ParseTape: a flat array of 64 bit words instead of a tree of cJSON items.
+ * Strings are not copied, they point into the parsed input, which has to be kept until cJSON_DeleteTape. */
+typedef struct cJSON_Tape cJSON_Tape;
+
+/* A value in a cJSON_Tape. Iterators are plain values, they don't need to be freed. */
+typedef struct cJSON_TapeIterator
+{
+    const cJSON_Tape *tape;
+    size_t position;
+    size_t key; /* position of the member name, 0 if the value isn't in an object */
+} cJSON_TapeIterator;
+
+/* Limits how deeply nested arrays/objects can be before cJSON rejects to parse them.
+ * This is to prevent stack overflows. */
+#ifndef CJSON_NESTING_LIMIT
+#define CJSON_NESTING_LIMIT 1000
+#endif
+
+/* Limits the length of circular references can be before cJSON rejects to parse them.
+ * This is to prevent stack overflows. */
+#ifndef CJSON_CIRCULAR_LIMIT
+#define CJSON_CIRCULAR_LIMIT 10000
+#endif
+
+/* returns the version of cJSON as a string */
+CJSON_PUBLIC(const char*) cJSON_Version(void);
+
+/* Supply malloc, realloc and free functions to cJSON */
+CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks);
+/* Like cJSON_InitHooks, but also allocates nodes from a pool (pool NULL or nodes_per_slab 0 turns it off). Slabs come
+ * from malloc_fn and are freed by the next cJSON_InitHooks(WithPool) call, so only switch while no items exist. */
+CJSON_PUBLIC(void) cJSON_InitHooksWithPool(cJSON_Hooks* hooks, const cJSON_PoolConfig * const pool);
+CJSON_PUBLIC(void) cJSON_GetPoolStats(cJSON_PoolStats * const stats);
+/* Give the nodes cached by the calling thread back to the pool, e.g. before the thread exits. */
+CJSON_PUBLIC(void) cJSON_ReleasePoolCache(void);
+
+/* Memory Management: the caller is always responsible to free the results from all variants of cJSON_Parse (with cJSON_Delete) and cJSON_Print (with stdlib free, cJSON_Hooks.free_fn, or cJSON_free as appropriate). The exception is cJSON_PrintPreallocated, where the caller has full responsibility of the buffer. */
+/* Supply a block of JSON, and this returns a cJSON object you can interrogate. */
+CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value);
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length);
+/* ParseWithOpts allows you to require (and check) that the JSON is null terminated, and to retrieve the pointer to the final byte parsed. */
+/* If you supply a ptr in return_parse_end and parsing fails, then return_parse_end will contain a pointer to the error so will match cJSON_GetErrorPtr(). */
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
+
+/* Parse with the options of context and report the end of the value and errors in it. All other parse functions are
+ * shortcuts for this. Items and strings that aren't in an arena are allocated with the hooks of cJSON_InitHooks,
+ * because cJSON_Delete frees them with those. */
+CJSON_PUBLIC(void) cJSON_InitParseContext(cJSON_ParseContext * const context);
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithContext(const char *value, size_t buffer_length, cJSON_ParseContext * const context);
+
+/* Prepare an arena on top of a caller provided memory block (e.g. a static buffer). The arena never allocates on its own. */
+CJSON_PUBLIC(void) cJSON_InitArena(cJSON_Arena * const arena, void *memory, size_t size);
+/* Release everything that was parsed into the arena at once. Items from the arena must not be used afterwards. */
+CJSON_PUBLIC(void) cJSON_ResetArena(cJSON_Arena * const arena);
+/* Parse into the arena instead of allocating with the hooks. Returns NULL if the input is invalid or the arena is too small,
+ * in which case the arena is left as it was before the call. cJSON_Delete leaves items from an arena alone. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithArena(const char *value, size_t buffer_length, cJSON_Arena * const arena);
+
+/* Parse destructively: keys and string values are unescaped inside of value and the items point straight into it,
+ * so value has to stay alive and unmodified for as long as the result is used. Only the items are allocated
+ * (from the arena if one is given). value is modified even if parsing fails. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSitu(char *value, size_t buffer_length);
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSituWithArena(char *value, size_t buffer_length, cJSON_Arena * const arena);
+
+/* Intern the keys of parsed objects: members with the same key (e.g. every record of a batch) share one copy that
+ * belongs to the table, so only the first occurrence of a key is allocated. Shared keys are flagged with
+ * cJSON_StringIsConst | cJSON_StringIsInterned and are not freed by cJSON_Delete, the table has to outlive every tree
+ * parsed with it (cJSON_Duplicate copies them). At most max_keys keys are interned (0 for no limit), further keys,
+ * keys with escape sequences and keys whose hashes collide with too many others are allocated per member as usual.
+ * A table must not be used by two threads at once. */
+CJSON_PUBLIC(cJSON_KeyTable *) cJSON_CreateKeyTable(size_t max_keys);
+CJSON_PUBLIC(void) cJSON_DeleteKeyTable(cJSON_KeyTable *table);
+/* Number of keys in the table. */
+CJSON_PUBLIC(size_t) cJSON_GetKeyTableSize(const cJSON_KeyTable * const table);
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithKeyTable(const char *value, size_t buffer_length, cJSON_KeyTable * const table);
+
+/* Parse without building any items: every value is reported to handler in document order. Strings without escape sequences
+ * point straight into value, the others are unescaped into scratch, which has to be longer than the escaped string.
+ * It doesn't recurse, so the stack it needs doesn't grow with the nesting of the document.
+ * Returns false on invalid input or when a callback stops the parser, cJSON_GetErrorPtr tells where. */
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseSAX(const char *value, size_t buffer_length, const cJSON_SAXHandler * const handler, void *user_data, char *scratch, size_t scratch_size);
+/* The same, but the end of the value and where parsing failed go to context instead of cJSON_GetErrorPtr. */
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseSAXWithContext(const char *value, size_t buffer_length, const cJSON_SAXHandler * const handler, void *user_data, char *scratch, size_t scratch_size, cJSON_ParseContext * const context);
+/* Like cJSON_ParseSAX, but the document can be fed in chunks of any size (e.g. as it arrives from the network) and
+ * every event is reported as soon as it is complete. Bytes are never looked at twice and the parser doesn't allocate
+ * after cJSON_CreateParser. Strings are passed out of the chunk unless they are cut by the end of a chunk or contain
+ * escape sequences, then they are collected in scratch, the same goes for numbers. So scratch has to be longer than
+ * any such string or number. Unlike cJSON_ParseSAX, nothing but whitespace may follow the value. */
+CJSON_PUBLIC(cJSON_Parser *) cJSON_CreateParser(const cJSON_SAXHandler * const handler, void *user_data, char *scratch, size_t scratch_size);
+/* Returns false once the input is invalid or a callback has stopped the parser. */
+CJSON_PUBLIC(cJSON_bool) cJSON_ParserFeed(cJSON_Parser * const parser, const char *chunk, size_t length);
+/* Call after the last chunk, returns true if the input was one complete JSON value. */
+CJSON_PUBLIC(cJSON_bool) cJSON_ParserFinish(cJSON_Parser * const parser);
+/* Number of bytes fed, after a failure roughly where the input became invalid. */
+CJSON_PUBLIC(size_t) cJSON_GetParserOffset(const cJSON_Parser * const parser);
+/* Read an object straight into structure in one pass: run cJSON_ParseSAX or a cJSON_Parser with cJSON_GetBindingHandler
+ * and the binding as user data. Keys are matched like cJSON_GetObjectItem (case insensitive, the first one wins),
+ * unknown keys and null are skipped, and a value that doesn't fit its field (wrong type, a number out of the range
+ * of the member) stops the parser. Members whose key is missing are left alone. */
+CJSON_PUBLIC(cJSON_bool) cJSON_InitBinding(cJSON_Binding * const binding, const cJSON_Field * const fields, const size_t count, void *structure);
+CJSON_PUBLIC(const cJSON_SAXHandler *) cJSON_GetBindingHandler(void);
+/* Bit n is set if a value was stored for fields[n] */
+CJSON_PUBLIC(unsigned long) cJSON_GetBindingFound(const cJSON_Binding * const binding);
+/* Start over with the next document. */
+CJSON_PUBLIC(void) cJSON_ResetParser(cJSON_Parser * const parser);
+CJSON_PUBLIC(void) cJSON_DeleteParser(cJSON_Parser *parser);
+
+/* Parse exactly one JSON value (up to 1 GiB, followed by nothing but whitespace) into a read-only tape.
+ * This takes a fraction of the memory and time of cJSON_Parse. Free the result with cJSON_DeleteTape. */
+CJSON_PUBLIC(cJSON_Tape *) cJSON_ParseTape(const char *value, size_t buffer_length);
+/* The same, but errors are reported in context instead of through cJSON_GetErrorPtr. */
+CJSON_PUBLIC(cJSON_Tape *) cJSON_ParseTapeWithContext(const char *value, size_t buffer_length, cJSON_ParseContext * const context);
+CJSON_PUBLIC(void) cJSON_DeleteTape(cJSON_Tape *tape);
+CJSON_PUBLIC(cJSON_bool) cJSON_GetTapeRoot(const cJSON_Tape * const tape, cJSON_TapeIterator * const root);
+/* The cJSON type (cJSON_False ... cJSON_Object) of the value, cJSON_Invalid for an invalid iterator */
+CJSON_PUBLIC(int) cJSON_TapeType(const cJSON_TapeIterator * const item);
+/* Move to the first element/member of a container or the next one in the same container, false if there is none */
+CJSON_PUBLIC(cJSON_bool) cJSON_TapeChild(const cJSON_TapeIterator * const container, cJSON_TapeIterator * const child);
+CJSON_PUBLIC(cJSON_bool) cJSON_TapeNext(cJSON_TapeIterator * const item);
+CJSON_PUBLIC(int) cJSON_TapeGetArraySize(const cJSON_TapeIterator * const container);
+CJSON_PUBLIC(cJSON_bool) cJSON_TapeGetArrayItem(const cJSON_TapeIterator * const array, int index, cJSON_TapeIterator * const item);
+CJSON_PUBLIC(cJSON_bool) cJSON_TapeGetObjectItemCaseSensitive(const cJSON_TapeIterator * const object, const char * const string, cJSON_TapeIterator * const item);
+CJSON_PUBLIC(double) cJSON_TapeGetNumber(const cJSON_TapeIterator * const item);
+/* The string (or member name) in the input. length receives its length in the input, which bounds the unescaped length.
+ * Returns NULL if the string contains escape sequences, use cJSON_TapeCopyString/cJSON_TapeCopyKey for those. */
+CJSON_PUBLIC(const char *) cJSON_TapeGetString(const cJSON_TapeIterator * const item, size_t * const length);
+CJSON_PUBLIC(const char *) cJSON_TapeGetKey(const cJSON_TapeIterator * const item, size_t * const length);
+/* Copy the unescaped, null terminated string into buffer, which needs to be longer than the length in the input */
+CJSON_PUBLIC(cJSON_bool) cJSON_TapeCopyString(const cJSON_TapeIterator * const item, char *buffer, const size_t buffer_size);
+CJSON_PUBLIC(cJSON_bool) cJSON_TapeCopyKey(const cJSON_TapeIterator * const item, char *buffer, const size_t buffer_size);
+/* Build a regular cJSON tree of the value (named like the member, if it is one), free it with cJSON_Delete */
+CJSON_PUBLIC(cJSON *) cJSON_TapeToCJSON(const cJSON_TapeIterator * const item);
+
+/* Render a cJSON entity to text for transfer/storage. */
+CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
+/* Render a cJSON entity to text for transfer/storage without any formatting. */
+CJSON_PUBLIC(char *) cJSON_PrintUnformatted(const cJSON *item);
+/* Render a cJSON entity to text using a buffered strategy. prebuffer is a guess at the final size. guessing well reduces reallocation. fmt=0 gives unformatted, =1 gives formatted */
+CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON_bool fmt);
+/* Render a cJSON entity to text using a buffer already allocated in memory with given length. Returns 1 on success and 0 on failure. */
+/* Length of the text cJSON_Print (format) or cJSON_PrintUnformatted would render, without the terminating zero. 0 if the item can't be printed. */
+CJSON_PUBLIC(size_t) cJSON_PrintedLength(const cJSON *item, cJSON_bool format);
+/* NOTE: the buffer needs room for the terminating zero as well, cJSON_PrintedLength(item, format) + 1 bytes are enough */
+CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format);
+/* Write unformatted JSON into buffer without building a tree: begin/end objects and arrays, a key before every member
+ * of an object, values in between. The writer doesn't check that the calls form a valid document. The buffer is always
+ * zero terminated; once something doesn't fit every further call returns false and cJSON_WriterLength returns 0. */
+CJSON_PUBLIC(void) cJSON_InitWriter(cJSON_Writer * const writer, char *buffer, size_t length);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterBeginObject(cJSON_Writer * const writer);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterEndObject(cJSON_Writer * const writer);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterBeginArray(cJSON_Writer * const writer);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterEndArray(cJSON_Writer * const writer);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterKey(cJSON_Writer * const writer, const char *key);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterString(cJSON_Writer * const writer, const char *string);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterNumber(cJSON_Writer * const writer, double number);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterBool(cJSON_Writer * const writer, const cJSON_bool boolean);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterNull(cJSON_Writer * const writer);
+/* Length of the text written so far (without the terminating zero), 0 after a failure */
+CJSON_PUBLIC(size_t) cJSON_WriterLength(const cJSON_Writer * const writer);
+/* Write the members of structure described by a field table (at most as many fields as an unsigned long has bits)
+ * into the object that is open in writer. Enum values without a name are written as null. */
+CJSON_PUBLIC(cJSON_bool) cJSON_WriterFields(cJSON_Writer * const writer, const cJSON_Field * const fields, const size_t count, const void *structure);
+/* Delete a cJSON entity and all subentities. */
+CJSON_PUBLIC(void) cJSON_Delete(cJSON *item);
+
+/* Returns the number of items in an array (or object). */
+CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array);
+/* Retrieve item number "index" from array "array". Returns NULL if unsuccessful. */
+CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index);
+/* Get item "string" from object. Case insensitive. */
+CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string);
+CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemCaseSensitive(const cJSON * const object, const char * const string);
+CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *string);
+/* Get an item by a key that was prepared with cJSON_InitKey (e.g. once at startup), which saves hashing and measuring
+ * the name on every lookup. Case insensitive, like cJSON_GetObjectItem. */
+CJSON_PUBLIC(void) cJSON_InitKey(cJSON_Key * const key, const char *string);
+CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemKey(const cJSON * const object, const cJSON_Key * const key);
+CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemKeyCaseSensitive(const cJSON * const object, const cJSON_Key * const key);
+/* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when cJSON_Parse() returns 0. 0 when cJSON_Parse() succeeds. */
+CJSON_PUBLIC(const char *) cJSON_GetErrorPtr(void);
+
+/* Check item type and return its value */
+CJSON_PUBLIC(char *) cJSON_GetStringValue(const cJSON * const item);
+CJSON_PUBLIC(double) cJSON_GetNumberValue(const cJSON * const item);
+
+/* These functions check the type of an item */
+CJSON_PUBLIC(cJSON_bool) cJSON_IsInvalid(const cJSON * const item);
+CJSON_PUBLIC(cJSON_bool) cJSON_IsFalse(const cJSON * const item);
+CJSON_PUBLIC(cJSON_bool) cJSON_IsTrue(const cJSON * const item);
+CJSON_PUBLIC(cJSON_bool) cJSON_IsBool(const cJSON * const item);
+CJSON_PUBLIC(cJSON_bool) cJSON_IsNull(const cJSON * const item);
+CJSON_PUBLIC(cJSON_bool) cJSON_IsNumber(const cJSON * const item);
+CJSON_PUBLIC(cJSON_bool) cJSON_IsString(const cJSON * const item);
+CJSON_PUBLIC(cJSON_bool) cJSON_IsArray(const cJSON * const item);
+CJSON_PUBLIC(cJSON_bool) cJSON_IsObject(const cJSON * const item);
+CJSON_PUBLIC(cJSON_bool) cJSON_IsRaw(const cJSON * const item);
+
+/* These calls create a cJSON item of the appropriate type. */
+CJSON_PUBLIC(cJSON *) cJSON_CreateNull(void);
+CJSON_PUBLIC(cJSON *) cJSON_CreateTrue(void);
+CJSON_PUBLIC(cJSON *) cJSON_CreateFalse(void);
+CJSON_PUBLIC(cJSON *) cJSON_CreateBool(cJSON_bool boolean);
+CJSON_PUBLIC(cJSON *) cJSON_CreateNumber(double num);
+CJSON_PUBLIC(cJSON *) cJSON_CreateString(const char *string);
+/* raw json */
+CJSON_PUBLIC(cJSON *) cJSON_CreateRaw(const char *raw);
+CJSON_PUBLIC(cJSON *) cJSON_CreateArray(void);
+CJSON_PUBLIC(cJSON *) cJSON_CreateObject(void);
+
+/* Create a string where valuestring references a string so
+ * it will not be freed by cJSON_Delete */
+CJSON_PUBLIC(cJSON *) cJSON_CreateStringReference(const char *string);
+/* Create an object/array that only references it's elements so
+ * they will not be freed by cJSON_Delete */
+CJSON_PUBLIC(cJSON *) cJSON_CreateObjectReference(const cJSON *child);
+CJSON_PUBLIC(cJSON *) cJSON_CreateArrayReference(const cJSON *child);
+
+/* These utilities create an Array of count items.
+ * The parameter count cannot be greater than the number of elements in the number array, otherwise array access will be out of bounds.*/
+CJSON_PUBLIC(cJSON *) cJSON_CreateIntArray(const int *numbers, int count);
+CJSON_PUBLIC(cJSON *) cJSON_CreateFloatArray(const float *numbers, int count);
+CJSON_PUBLIC(cJSON *) cJSON_CreateDoubleArray(const double *numbers, int count);
+CJSON_PUBLIC(cJSON *) cJSON_CreateStringArray(const char *const *strings, int count);
+
+/* Append item to the specified array/object. */
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToArray(cJSON *array, cJSON *item);
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToObject(cJSON *object, const char *string, cJSON *item);
+/* Use this when string is definitely const (i.e. a literal, or as good as), and will definitely survive the cJSON object.
+ * WARNING: When this function was used, make sure to always check that (item->type & cJSON_StringIsConst) is zero before
+ * writing to `item->string` */
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemToObjectCS(cJSON *object, const char *string, cJSON *item);
+/* Append reference to item to the specified array/object. Use this when you want to add an existing cJSON to a new cJSON, but don't want to corrupt your existing cJSON. */
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemReferenceToArray(cJSON *array, cJSON *item);
+CJSON_PUBLIC(cJSON_bool) cJSON_AddItemReferenceToObject(cJSON *object, const char *string, cJSON *item);
+
+/* Remove/Detach items from Arrays/Objects. */
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const item);
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromArray(cJSON *array, int which);
+CJSON_PUBLIC(void) cJSON_DeleteItemFromArray(cJSON *array, int which);
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromObject(cJSON *object, const char *string);
+CJSON_PUBLIC(cJSON *) cJSON_DetachItemFromObjectCaseSensitive(cJSON *object, const char *string);
+CJSON_PUBLIC(void) cJSON_DeleteItemFromObject(cJSON *object, const char *string);
+CJSON_PUBLIC(void) cJSON_DeleteItemFromObjectCaseSensitive(cJSON *object, const char *string);
+
+/* Objects with at least minimum_members members get a hash index on their first lookup, arrays get a vector of
+ * their items for constant time cJSON_GetArrayItem and cJSON_GetArraySize. Adding, inserting, detaching and
+ * replacing items keeps them up to date. 0 (the default) disables indexes. Not thread safe, set it up front.
+ * Does nothing unless cJSON is built with ENABLE_CJSON_INDEX. */
+CJSON_PUBLIC(void) cJSON_SetIndexThreshold(size_t minimum_members);
+/* Drop the index of an item. Needed after changing its child list or the keys of its children directly. */
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON * const item);
+
+/* Update array items. */
+CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON *newitem); /* Shifts pre-existing items to the right. */
+CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON * const item, cJSON * replacement);
+CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInArray(cJSON *array, int which, cJSON *newitem);
+CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInObject(cJSON *object,const char *string,cJSON *newitem);
+CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemInObjectCaseSensitive(cJSON *object,const char *string,cJSON *newitem);
+
+/* Duplicate a cJSON item */
+CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse);
+/* Duplicate will create a new, identical cJSON item to the one you pass, in new memory that will
+ * need to be released. With recurse!=0, it will duplicate any children connected to the item.
+ * The item->next and ->prev pointers are always zero on return from Duplicate. */
+/* Duplicate item with all of its children into a single allocation, without recursion. The copy has to be released with
+ * cJSON_DeleteCompact (not cJSON_Delete) and can be modified as usual: items that are added to it later are deleted
+ * with it, items of the copy that are detached or deleted stay in its memory until then. */
+CJSON_PUBLIC(cJSON *) cJSON_DuplicateCompact(const cJSON *item);
+CJSON_PUBLIC(void) cJSON_DeleteCompact(cJSON *item);
+/* Recursively compare two cJSON items for equality. If either a or b is NULL or invalid, they will be considered unequal.
+ * case_sensitive determines if object keys are treated case sensitive (1) or case insensitive (0) */
+CJSON_PUBLIC(cJSON_bool) cJSON_Compare(const cJSON * const a, const cJSON * const b, const cJSON_bool case_sensitive);
+
+/* Minify a strings, remove blank characters(such as ' ', '\t', '\r', '\n') from strings.
+ * The input pointer json cannot point to a read-only address area, such as a string constant, 
+ * but should point to a readable and writable address area. */
+CJSON_PUBLIC(void) cJSON_Minify(char *json);
+/* Minify length bytes of json into output, which needs room for length bytes and may be json itself.
+ * Unlike cJSON_Minify the input doesn't have to be writable or null terminated, and the output isn't null terminated.
+ * Returns the length of the minified JSON. */
+CJSON_PUBLIC(size_t) cJSON_MinifyWithLength(const char *json, size_t length, char *output);
+
+/* Helper functions for creating and adding items to an object at the same time.
+ * They return the added item or NULL on failure. */
+CJSON_PUBLIC(cJSON*) cJSON_AddNullToObject(cJSON * const object, const char * const name);
+CJSON_PUBLIC(cJSON*) cJSON_AddTrueToObject(cJSON * const object, const char * const name);
+CJSON_PUBLIC(cJSON*) cJSON_AddFalseToObject(cJSON * const object, const char * const name);
+CJSON_PUBLIC(cJSON*) cJSON_AddBoolToObject(cJSON * const object, const char * const name, const cJSON_bool boolean);
+CJSON_PUBLIC(cJSON*) cJSON_AddNumberToObject(cJSON * const object, const char * const name, const double number);
+CJSON_PUBLIC(cJSON*) cJSON_AddStringToObject(cJSON * const object, const char * const name, const char * const string);
+CJSON_PUBLIC(cJSON*) cJSON_AddRawToObject(cJSON * const object, const char * const name, const char * const raw);
+CJSON_PUBLIC(cJSON*) cJSON_AddObjectToObject(cJSON * const object, const char * const name);
+CJSON_PUBLIC(cJSON*) cJSON_AddArrayToObject(cJSON * const object, const char * const name);
+
+/* When assigning an integer value, it needs to be propagated to valuedouble too. */
+#define cJSON_SetIntValue(object, number) ((object) ? (object)->valueint = (object)->valuedouble = (number) : (number))
+/* helper for the cJSON_SetNumberValue macro */
+CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number);
+#define cJSON_SetNumberValue(object, number) ((object != NULL) ? cJSON_SetNumberHelper(object, (double)number) : (number))
+/* Change the valuestring of a cJSON_String object, only takes effect when type of object is cJSON_String */
+CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring);
+
+/* If the object is not a boolean type this does nothing and returns cJSON_Invalid else it returns the new type*/
+#define cJSON_SetBoolValue(object, boolValue) ( \
+    (object != NULL && ((object)->type & (cJSON_False|cJSON_True))) ? \
+    (object)->type=((object)->type &(~(cJSON_False|cJSON_True)))|((boolValue)?cJSON_True:cJSON_False) : \
+    cJSON_Invalid\
+)
+
+/* Macro for iterating over an array or object */
+#define cJSON_ArrayForEach(element, array) for(element = (array != NULL) ? (array)->child : NULL; element != NULL; element = element->next)
+
+/* malloc/free objects using the malloc/free functions that have been set with cJSON_InitHooks */
+CJSON_PUBLIC(void *) cJSON_malloc(size_t size);
+CJSON_PUBLIC(void) cJSON_free(void *object);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
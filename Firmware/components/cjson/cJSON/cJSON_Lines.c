@@ -0,0 +1,474 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+/* POSIX threads, mmap and posix_madvise */
+#define _POSIX_C_SOURCE 200112L
+
+#ifdef __GNUCC__
+#pragma GCC visibility push(default)
+#endif
+
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef __GNUCC__
+#pragma GCC visibility pop
+#endif
+
+#include "cJSON_Lines.h"
+
+/* define our own boolean type */
+#ifdef true
+#undef true
+#endif
+#define true ((cJSON_bool)1)
+
+#ifdef false
+#undef false
+#endif
+#define false ((cJSON_bool)0)
+
+#define default_threads 4
+#define default_chunk_size (1024 * 1024)
+
+typedef enum
+{
+    chunk_pending,
+    chunk_parsed,
+    chunk_failed /* out of memory */
+} chunk_state;
+
+/* A run of whole lines, parsed by one thread. */
+typedef struct
+{
+    const char *start;
+    size_t length;
+    size_t line_count; /* including blank lines */
+    cJSON_Line *lines; /* the other lines, numbered from 1 within the chunk */
+    size_t count;
+    chunk_state state;
+} lines_chunk;
+
+typedef struct
+{
+    const char *text;
+    size_t length;
+    size_t chunk_size;
+    /* ring of the chunks in flight, chunk n is in slot n % window until it is passed on */
+    lines_chunk *chunks;
+    size_t window;
+    size_t offset; /* where the next chunk starts */
+    size_t claimed; /* chunks handed out to threads */
+    size_t delivered; /* chunks passed on to the handler */
+    cJSON_bool finished; /* the last chunk is handed out */
+    cJSON_bool stopped;
+    cJSON_LineHandler handler;
+    void *user_data;
+    size_t line_number; /* lines before the next chunk that is passed on */
+    pthread_mutex_t lock;
+    pthread_cond_t chunk_ready;
+    pthread_cond_t slot_free;
+} lines_batch;
+
+/* everything up to and including space is whitespace, like for cJSON_Parse */
+static cJSON_bool is_blank(const char *text, size_t length)
+{
+    for (; length > 0; text++, length--)
+    {
+        if ((unsigned char)*text > 32)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* hand out the next chunk, it ends with the first line break after chunk_size bytes */
+static void claim_chunk(lines_batch * const batch, lines_chunk * const chunk)
+{
+    const char *start = batch->text + batch->offset;
+    size_t remaining = batch->length - batch->offset;
+    const char *line_break = NULL;
+
+    memset(chunk, '\0', sizeof(lines_chunk));
+    chunk->start = start;
+    chunk->length = remaining;
+    if (remaining > batch->chunk_size)
+    {
+        line_break = (const char*)memchr(start + batch->chunk_size - 1, '\n', remaining - batch->chunk_size + 1);
+        if (line_break != NULL)
+        {
+            chunk->length = (size_t)(line_break - start) + 1;
+        }
+    }
+    chunk->state = chunk_pending;
+
+    batch->offset += chunk->length;
+    batch->claimed++;
+    batch->finished = (batch->offset >= batch->length);
+}
+
+static void parse_line(cJSON_Line * const line, cJSON_ParseContext * const context)
+{
+    const char *end = line->text + line->length;
+    const char *position = NULL;
+
+    line->item = cJSON_ParseWithContext(line->text, line->length, context);
+    line->error = context->error;
+    if (line->item == NULL)
+    {
+        return;
+    }
+
+    /* only whitespace may follow the document */
+    for (position = context->end; (position < end) && ((unsigned char)*position <= 32); position++)
+    {
+    }
+    if (position < end)
+    {
+        cJSON_Delete(line->item);
+        line->item = NULL;
+        line->error = position;
+    }
+}
+
+static cJSON_bool parse_chunk(lines_chunk * const chunk)
+{
+    const char *line = chunk->start;
+    const char * const end = chunk->start + chunk->length;
+    const char *line_end = NULL;
+    size_t length = 0;
+    size_t capacity = 0;
+    cJSON_Line *lines = NULL;
+    cJSON_ParseContext context;
+
+    cJSON_InitParseContext(&context);
+    while (line < end)
+    {
+        line_end = (const char*)memchr(line, '\n', (size_t)(end - line));
+        if (line_end == NULL)
+        {
+            line_end = end;
+        }
+        length = (size_t)(line_end - line);
+        if ((length > 0) && (line[length - 1] == '\r'))
+        {
+            length--;
+        }
+        chunk->line_count++;
+
+        if (!is_blank(line, length))
+        {
+            if (chunk->count == capacity)
+            {
+                capacity = (capacity == 0) ? 64 : (2 * capacity);
+                lines = (cJSON_Line*)cJSON_malloc(capacity * sizeof(cJSON_Line));
+                if (lines == NULL)
+                {
+                    return false;
+                }
+                if (chunk->lines != NULL)
+                {
+                    memcpy(lines, chunk->lines, chunk->count * sizeof(cJSON_Line));
+                    cJSON_free(chunk->lines);
+                }
+                chunk->lines = lines;
+            }
+
+            chunk->lines[chunk->count].text = line;
+            chunk->lines[chunk->count].length = length;
+            chunk->lines[chunk->count].number = chunk->line_count;
+            parse_line(&chunk->lines[chunk->count], &context);
+            chunk->count++;
+        }
+
+        if (line_end == end)
+        {
+            break;
+        }
+        line = line_end + 1;
+    }
+
+    return true;
+}
+
+/* delete the documents from the first one on that wasn't passed on */
+static void release_chunk(lines_chunk * const chunk, size_t first)
+{
+    for (; first < chunk->count; first++)
+    {
+        cJSON_Delete(chunk->lines[first].item);
+    }
+    cJSON_free(chunk->lines);
+    chunk->lines = NULL;
+    chunk->count = 0;
+}
+
+/* pass the lines of the chunk on in order, false if the handler stopped */
+static cJSON_bool deliver_chunk(lines_batch * const batch, lines_chunk * const chunk)
+{
+    size_t i = 0;
+
+    for (i = 0; i < chunk->count; i++)
+    {
+        chunk->lines[i].number += batch->line_number;
+        if (!batch->handler(batch->user_data, &chunk->lines[i]))
+        {
+            release_chunk(chunk, i + 1);
+            return false;
+        }
+    }
+    batch->line_number += chunk->line_count;
+    release_chunk(chunk, chunk->count);
+
+    return true;
+}
+
+static cJSON_bool parse_sequentially(lines_batch * const batch)
+{
+    lines_chunk chunk;
+
+    while (!batch->finished)
+    {
+        claim_chunk(batch, &chunk);
+        if (!parse_chunk(&chunk))
+        {
+            release_chunk(&chunk, 0);
+            return false;
+        }
+        if (!deliver_chunk(batch, &chunk))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void *parse_chunks(void *argument)
+{
+    lines_batch *batch = (lines_batch*)argument;
+    lines_chunk *chunk = NULL;
+    chunk_state state = chunk_pending;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&batch->lock);
+        /* don't get further ahead than the window, the handler may be slower than the threads */
+        while (!batch->finished && !batch->stopped && (batch->claimed >= (batch->delivered + batch->window)))
+        {
+            pthread_cond_wait(&batch->slot_free, &batch->lock);
+        }
+        if (batch->finished || batch->stopped)
+        {
+            pthread_mutex_unlock(&batch->lock);
+            /* the nodes this thread has cached would be stranded once it exits */
+            cJSON_ReleasePoolCache();
+            return NULL;
+        }
+        chunk = &batch->chunks[batch->claimed % batch->window];
+        claim_chunk(batch, chunk);
+        pthread_mutex_unlock(&batch->lock);
+
+        state = parse_chunk(chunk) ? chunk_parsed : chunk_failed;
+
+        pthread_mutex_lock(&batch->lock);
+        chunk->state = state;
+        pthread_cond_broadcast(&batch->chunk_ready);
+        pthread_mutex_unlock(&batch->lock);
+    }
+}
+
+/* the calling thread passes the chunks on in order while the threads parse the ones after them */
+static cJSON_bool deliver_in_order(lines_batch * const batch)
+{
+    lines_chunk *chunk = NULL;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&batch->lock);
+        while ((batch->delivered < batch->claimed) ? (batch->chunks[batch->delivered % batch->window].state == chunk_pending) : !batch->finished)
+        {
+            pthread_cond_wait(&batch->chunk_ready, &batch->lock);
+        }
+        if (batch->delivered >= batch->claimed)
+        {
+            pthread_mutex_unlock(&batch->lock);
+            return true;
+        }
+        chunk = &batch->chunks[batch->delivered % batch->window];
+        pthread_mutex_unlock(&batch->lock);
+
+        if ((chunk->state == chunk_failed) || !deliver_chunk(batch, chunk))
+        {
+            return false;
+        }
+
+        pthread_mutex_lock(&batch->lock);
+        batch->delivered++;
+        pthread_cond_broadcast(&batch->slot_free);
+        pthread_mutex_unlock(&batch->lock);
+    }
+}
+
+static cJSON_bool parse_in_parallel(lines_batch * const batch, const size_t thread_count)
+{
+    pthread_t *threads = NULL;
+    size_t started = 0;
+    size_t i = 0;
+    cJSON_bool result = false;
+
+    /* two chunks per thread, so that they have another one to work on while theirs waits to be passed on */
+    batch->window = 2 * thread_count;
+    batch->chunks = (lines_chunk*)cJSON_malloc(batch->window * sizeof(lines_chunk));
+    threads = (pthread_t*)cJSON_malloc(thread_count * sizeof(pthread_t));
+    if ((batch->chunks == NULL) || (threads == NULL))
+    {
+        cJSON_free(batch->chunks);
+        cJSON_free(threads);
+        return false;
+    }
+    pthread_mutex_init(&batch->lock, NULL);
+    pthread_cond_init(&batch->chunk_ready, NULL);
+    pthread_cond_init(&batch->slot_free, NULL);
+
+    for (started = 0; started < thread_count; started++)
+    {
+        if (pthread_create(&threads[started], NULL, parse_chunks, batch) != 0)
+        {
+            break;
+        }
+    }
+    result = (started == thread_count) && deliver_in_order(batch);
+
+    pthread_mutex_lock(&batch->lock);
+    batch->stopped = true;
+    pthread_cond_broadcast(&batch->slot_free);
+    pthread_mutex_unlock(&batch->lock);
+    for (i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    /* the chunks that weren't passed on after stopping early */
+    for (i = batch->delivered; i < batch->claimed; i++)
+    {
+        release_chunk(&batch->chunks[i % batch->window], 0);
+    }
+
+    pthread_cond_destroy(&batch->slot_free);
+    pthread_cond_destroy(&batch->chunk_ready);
+    pthread_mutex_destroy(&batch->lock);
+    cJSON_free(threads);
+    cJSON_free(batch->chunks);
+
+    return result;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseLinesWithLength(const char *text, size_t length, const cJSON_LinesOptions * const options, cJSON_LineHandler handler, void *user_data)
+{
+    lines_batch batch;
+    size_t thread_count = default_threads;
+
+    if (((text == NULL) && (length > 0)) || (handler == NULL))
+    {
+        return false;
+    }
+    if (length == 0)
+    {
+        return true;
+    }
+
+    memset(&batch, '\0', sizeof(batch));
+    batch.text = text;
+    batch.length = length;
+    batch.chunk_size = default_chunk_size;
+    batch.handler = handler;
+    batch.user_data = user_data;
+    if (options != NULL)
+    {
+        thread_count = options->threads;
+        if (options->chunk_size > 0)
+        {
+            batch.chunk_size = options->chunk_size;
+        }
+    }
+
+    if (thread_count == 0)
+    {
+        return parse_sequentially(&batch);
+    }
+
+    return parse_in_parallel(&batch, thread_count);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseLines(const char *path, const cJSON_LinesOptions * const options, cJSON_LineHandler handler, void *user_data)
+{
+    struct stat status;
+    void *mapping = NULL;
+    size_t length = 0;
+    cJSON_bool result = false;
+    int file = -1;
+
+    if ((path == NULL) || (handler == NULL))
+    {
+        return false;
+    }
+
+    file = open(path, O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+    if ((fstat(file, &status) != 0) || (status.st_size < 0) || ((off_t)(size_t)status.st_size != status.st_size))
+    {
+        close(file);
+        return false;
+    }
+    length = (size_t)status.st_size;
+    if (length == 0)
+    {
+        close(file);
+        return true;
+    }
+
+    /* the mapping stays valid after the file is closed */
+    mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+    posix_madvise(mapping, length, POSIX_MADV_SEQUENTIAL);
+
+    result = cJSON_ParseLinesWithLength((const char*)mapping, length, options, handler, user_data);
+    munmap(mapping, length);
+
+    return result;
+}
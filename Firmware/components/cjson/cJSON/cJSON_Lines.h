@@ -0,0 +1,66 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#ifndef cJSON_Lines__h
+#define cJSON_Lines__h
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "cJSON.h"
+
+/* Parse newline delimited JSON (NDJSON, JSON Lines): one document per line. The input is cut into chunks at line
+ * boundaries that are parsed on a pool of threads, the results are passed to a handler in the order of the lines.
+ * Needs POSIX threads (and mmap for files). If the node pool is enabled, it has to have lock and unlock functions. */
+
+/* One line of the input, as it is passed to the handler. */
+typedef struct cJSON_Line
+{
+    cJSON *item; /* the document, NULL if the line isn't valid JSON. It belongs to the handler, which has to delete it */
+    const char *text; /* the line in the input without the line break, not null terminated. Files are unmapped after parsing */
+    size_t length;
+    size_t number; /* starting with 1, blank lines count but aren't passed to the handler */
+    const char *error; /* where in text parsing failed, NULL if item isn't NULL */
+} cJSON_Line;
+
+/* Return false to stop, lines that are already parsed are deleted without passing them on. */
+typedef cJSON_bool (*cJSON_LineHandler)(void *user_data, cJSON_Line * const line);
+
+typedef struct cJSON_LinesOptions
+{
+    size_t threads; /* parsing threads next to the calling one, which passes the results on. 0 parses on the calling thread */
+    size_t chunk_size; /* bytes of input per chunk (rounded up to the next line break), 0 for 1 MB */
+} cJSON_LinesOptions;
+
+/* Both return false if the handler stopped, or if a file can't be read or memory runs out. Invalid lines don't
+ * stop parsing, they are passed on with item set to NULL. options can be NULL for 4 threads and 1 MB chunks. */
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseLines(const char *path, const cJSON_LinesOptions * const options, cJSON_LineHandler handler, void *user_data);
+/* Parse lines from memory. text has to stay valid until the function returns. */
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseLinesWithLength(const char *text, size_t length, const cJSON_LinesOptions * const options, cJSON_LineHandler handler, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,2482 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+/* disable warnings about old C89 functions in MSVC */
+#if !defined(_CRT_SECURE_NO_DEPRECATE) && defined(_MSC_VER)
+#define _CRT_SECURE_NO_DEPRECATE
+#endif
+
+#ifdef __GNUCC__
+#pragma GCC visibility push(default)
+#endif
+#if defined(_MSC_VER)
+#pragma warning (push)
+/* disable warning about single line comments in system headers */
+#pragma warning (disable : 4001)
+#endif
+
+#include <ctype.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <limits.h>
+#include <math.h>
+#include <float.h>
+#include <math.h>
+
+#if defined(_MSC_VER)
+#pragma warning (pop)
+#endif
+#ifdef __GNUCC__
+#pragma GCC visibility pop
+#endif
+
+#include "cJSON_Utils.h"
+
+/* define our own boolean type */
+#ifdef true
+#undef true
+#endif
+#define true ((cJSON_bool)1)
+
+#ifdef false
+#undef false
+#endif
+#define false ((cJSON_bool)0)
+
+static unsigned char* cJSONUtils_strdup(const unsigned char* const string)
+{
+    size_t length = 0;
+    unsigned char *copy = NULL;
+
+    length = strlen((const char*)string) + sizeof("");
+    copy = (unsigned char*) cJSON_malloc(length);
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+    memcpy(copy, string, length);
+
+    return copy;
+}
+
+/* string comparison which doesn't consider NULL pointers equal */
+static int compare_strings(const unsigned char *string1, const unsigned char *string2, const cJSON_bool case_sensitive)
+{
+    if ((string1 == NULL) || (string2 == NULL))
+    {
+        return 1;
+    }
+
+    if (string1 == string2)
+    {
+        return 0;
+    }
+
+    if (case_sensitive)
+    {
+        return strcmp((const char*)string1, (const char*)string2);
+    }
+
+    for(; tolower(*string1) == tolower(*string2); (void)string1++, string2++)
+    {
+        if (*string1 == '\0')
+        {
+            return 0;
+        }
+    }
+
+    return tolower(*string1) - tolower(*string2);
+}
+
+/* securely comparison of floating-point variables */
+static cJSON_bool compare_double(double a, double b)
+{
+    double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
+    return (fabs(a - b) <= maxVal * DBL_EPSILON);
+}
+
+
+/* Compare the next path element of two JSON pointers, two NULL pointers are considered unequal: */
+static cJSON_bool compare_pointers(const unsigned char *name, const unsigned char *pointer, const cJSON_bool case_sensitive)
+{
+    if ((name == NULL) || (pointer == NULL))
+    {
+        return false;
+    }
+
+    for (; (*name != '\0') && (*pointer != '\0') && (*pointer != '/'); (void)name++, pointer++) /* compare until next '/' */
+    {
+        if (*pointer == '~')
+        {
+            /* check for escaped '~' (~0) and '/' (~1) */
+            if (((pointer[1] != '0') || (*name != '~')) && ((pointer[1] != '1') || (*name != '/')))
+            {
+                /* invalid escape sequence or wrong character in *name */
+                return false;
+            }
+            else
+            {
+                pointer++;
+            }
+        }
+        else if ((!case_sensitive && (tolower(*name) != tolower(*pointer))) || (case_sensitive && (*name != *pointer)))
+        {
+            return false;
+        }
+    }
+    if (((*pointer != 0) && (*pointer != '/')) != (*name != 0))
+    {
+        /* one string has ended, the other not */
+        return false;;
+    }
+
+    return true;
+}
+
+/* calculate the length of a string if encoded as JSON pointer with ~0 and ~1 escape sequences */
+static size_t pointer_encoded_length(const unsigned char *string)
+{
+    size_t length;
+    for (length = 0; *string != '\0'; (void)string++, length++)
+    {
+        /* character needs to be escaped? */
+        if ((*string == '~') || (*string == '/'))
+        {
+            length++;
+        }
+    }
+
+    return length;
+}
+
+/* copy a string while escaping '~' and '/' with ~0 and ~1 JSON pointer escape codes */
+static void encode_string_as_pointer(unsigned char *destination, const unsigned char *source)
+{
+    for (; source[0] != '\0'; (void)source++, destination++)
+    {
+        if (source[0] == '/')
+        {
+            destination[0] = '~';
+            destination[1] = '1';
+            destination++;
+        }
+        else if (source[0] == '~')
+        {
+            destination[0] = '~';
+            destination[1] = '0';
+            destination++;
+        }
+        else
+        {
+            destination[0] = source[0];
+        }
+    }
+
+    destination[0] = '\0';
+}
+
+CJSON_PUBLIC(char *) cJSONUtils_FindPointerFromObjectTo(const cJSON * const object, const cJSON * const target)
+{
+    size_t child_index = 0;
+    cJSON *current_child = 0;
+
+    if ((object == NULL) || (target == NULL))
+    {
+        return NULL;
+    }
+
+    if (object == target)
+    {
+        /* found */
+        return (char*)cJSONUtils_strdup((const unsigned char*)"");
+    }
+
+    /* recursively search all children of the object or array */
+    for (current_child = object->child; current_child != NULL; (void)(current_child = current_child->next), child_index++)
+    {
+        unsigned char *target_pointer = (unsigned char*)cJSONUtils_FindPointerFromObjectTo(current_child, target);
+        /* found the target? */
+        if (target_pointer != NULL)
+        {
+            if (cJSON_IsArray(object))
+            {
+                /* reserve enough memory for a 64 bit integer + '/' and '\0' */
+                unsigned char *full_pointer = (unsigned char*)cJSON_malloc(strlen((char*)target_pointer) + 20 + sizeof("/"));
+                /* check if conversion to unsigned long is valid
+                 * This should be eliminated at compile time by dead code elimination
+                 * if size_t is an alias of unsigned long, or if it is bigger */
+                if (child_index > ULONG_MAX)
+                {
+                    cJSON_free(target_pointer);
+                    cJSON_free(full_pointer);
+                    return NULL;
+                }
+                sprintf((char*)full_pointer, "/%lu%s", (unsigned long)child_index, target_pointer); /* /<array_index><path> */
+                cJSON_free(target_pointer);
+
+                return (char*)full_pointer;
+            }
+
+            if (cJSON_IsObject(object))
+            {
+                unsigned char *full_pointer = (unsigned char*)cJSON_malloc(strlen((char*)target_pointer) + pointer_encoded_length((unsigned char*)current_child->string) + 2);
+                full_pointer[0] = '/';
+                encode_string_as_pointer(full_pointer + 1, (unsigned char*)current_child->string);
+                strcat((char*)full_pointer, (char*)target_pointer);
+                cJSON_free(target_pointer);
+
+                return (char*)full_pointer;
+            }
+
+            /* reached leaf of the tree, found nothing */
+            cJSON_free(target_pointer);
+            return NULL;
+        }
+    }
+
+    /* not found */
+    return NULL;
+}
+
+/* non broken version of cJSON_GetArrayItem */
+static cJSON *get_array_item(const cJSON *array, size_t item)
+{
+    cJSON *child = array ? array->child : NULL;
+    while ((child != NULL) && (item > 0))
+    {
+        item--;
+        child = child->next;
+    }
+
+    return child;
+}
+
+static cJSON_bool decode_array_index_from_pointer(const unsigned char * const pointer, size_t * const index)
+{
+    size_t parsed_index = 0;
+    size_t position = 0;
+
+    if ((pointer[0] == '0') && ((pointer[1] != '\0') && (pointer[1] != '/')))
+    {
+        /* leading zeroes are not permitted */
+        return 0;
+    }
+
+    for (position = 0; (pointer[position] >= '0') && (pointer[position] <= '9'); position++)
+    {
+        parsed_index = (10 * parsed_index) + (size_t)(pointer[position] - '0');
+
+    }
+
+    if ((pointer[position] != '\0') && (pointer[position] != '/'))
+    {
+        return 0;
+    }
+
+    *index = parsed_index;
+
+    return 1;
+}
+
+static cJSON *get_item_from_pointer(cJSON * const object, const char * pointer, const cJSON_bool case_sensitive)
+{
+    cJSON *current_element = object;
+
+    if (pointer == NULL)
+    {
+        return NULL;
+    }
+
+    /* follow path of the pointer */
+    while ((pointer[0] == '/') && (current_element != NULL))
+    {
+        pointer++;
+        if (cJSON_IsArray(current_element))
+        {
+            size_t index = 0;
+            if (!decode_array_index_from_pointer((const unsigned char*)pointer, &index))
+            {
+                return NULL;
+            }
+
+            current_element = get_array_item(current_element, index);
+        }
+        else if (cJSON_IsObject(current_element))
+        {
+            current_element = current_element->child;
+            /* GetObjectItem. */
+            while ((current_element != NULL) && !compare_pointers((unsigned char*)current_element->string, (const unsigned char*)pointer, case_sensitive))
+            {
+                current_element = current_element->next;
+            }
+        }
+        else
+        {
+            return NULL;
+        }
+
+        /* skip to the next path token or end of string */
+        while ((pointer[0] != '\0') && (pointer[0] != '/'))
+        {
+            pointer++;
+        }
+    }
+
+    return current_element;
+}
+
+CJSON_PUBLIC(cJSON *) cJSONUtils_GetPointer(cJSON * const object, const char *pointer)
+{
+    return get_item_from_pointer(object, pointer, false);
+}
+
+CJSON_PUBLIC(cJSON *) cJSONUtils_GetPointerCaseSensitive(cJSON * const object, const char *pointer)
+{
+    return get_item_from_pointer(object, pointer, true);
+}
+
+/* one token of a compiled pointer: unescaped and hashed for object members, parsed for array elements */
+typedef struct
+{
+    cJSON_Key key;
+    size_t index;
+    cJSON_bool is_index;
+    /* the token has an invalid escape sequence and key keeps it as written: it matches no member, like in
+     * cJSONUtils_GetPointer, but JSON patches still add and remove the member with exactly that name */
+    cJSON_bool invalid_escape;
+} pointer_token;
+
+struct cJSONUtils_Pointer
+{
+    pointer_token *tokens;
+    size_t count;
+};
+
+CJSON_PUBLIC(cJSONUtils_Pointer *) cJSONUtils_CompilePointer(const char *pointer)
+{
+    cJSONUtils_Pointer *compiled = NULL;
+    const unsigned char *position = (const unsigned char*)pointer;
+    unsigned char *strings = NULL;
+    size_t length = 0;
+    size_t count = 0;
+    size_t token = 0;
+
+    if (pointer == NULL)
+    {
+        return NULL;
+    }
+
+    /* like cJSONUtils_GetPointer, a pointer without a leading '/' has no tokens and resolves to the object itself */
+    for (length = 0; pointer[length] != '\0'; length++)
+    {
+        if ((pointer[length] == '/') && (pointer[0] == '/'))
+        {
+            count++;
+        }
+    }
+
+    /* the tokens and their unescaped strings live in the same allocation, the strings are never longer than the pointer */
+    compiled = (cJSONUtils_Pointer*)cJSON_malloc(sizeof(cJSONUtils_Pointer) + (count * sizeof(pointer_token)) + length + sizeof(""));
+    if (compiled == NULL)
+    {
+        return NULL;
+    }
+    compiled->tokens = (pointer_token*)(compiled + 1);
+    compiled->count = count;
+    strings = (unsigned char*)(compiled->tokens + count);
+
+    for (token = 0; token < count; token++)
+    {
+        const unsigned char *decoded = strings;
+        const unsigned char *end = NULL;
+
+        position++; /* skip the '/' */
+        compiled->tokens[token].index = 0;
+        compiled->tokens[token].is_index = decode_array_index_from_pointer(position, &compiled->tokens[token].index);
+        compiled->tokens[token].invalid_escape = false;
+        for (end = position; (*end != '\0') && (*end != '/'); end++)
+        {
+            /* check for escaped '~' (~0) and '/' (~1) */
+            if ((end[0] == '~') && (end[1] != '0') && (end[1] != '1'))
+            {
+                compiled->tokens[token].invalid_escape = true;
+            }
+        }
+
+        for (; position < end; position++)
+        {
+            if ((*position == '~') && !compiled->tokens[token].invalid_escape)
+            {
+                position++;
+                *strings++ = (*position == '0') ? '~' : '/';
+            }
+            else
+            {
+                *strings++ = *position;
+            }
+        }
+        *strings++ = '\0';
+
+        cJSON_InitKey(&compiled->tokens[token].key, (const char*)decoded);
+    }
+
+    return compiled;
+}
+
+CJSON_PUBLIC(void) cJSONUtils_DeletePointer(cJSONUtils_Pointer *pointer)
+{
+    if (pointer != NULL)
+    {
+        cJSON_free(pointer);
+    }
+}
+
+static cJSON *get_item_from_tokens(cJSON * const object, const pointer_token * const tokens, const size_t count, const cJSON_bool case_sensitive)
+{
+    cJSON *current_element = object;
+    size_t token = 0;
+
+    for (token = 0; (token < count) && (current_element != NULL); token++)
+    {
+        if (cJSON_IsArray(current_element))
+        {
+            if (!tokens[token].is_index)
+            {
+                return NULL;
+            }
+            /* cJSON_GetArrayItem can use the index of a large array */
+            if (tokens[token].index <= INT_MAX)
+            {
+                current_element = cJSON_GetArrayItem(current_element, (int)tokens[token].index);
+            }
+            else
+            {
+                current_element = get_array_item(current_element, tokens[token].index);
+            }
+        }
+        else if (cJSON_IsObject(current_element))
+        {
+            if (tokens[token].invalid_escape)
+            {
+                return NULL;
+            }
+            if (case_sensitive)
+            {
+                current_element = cJSON_GetObjectItemKeyCaseSensitive(current_element, &tokens[token].key);
+            }
+            else
+            {
+                current_element = cJSON_GetObjectItemKey(current_element, &tokens[token].key);
+            }
+        }
+        else
+        {
+            return NULL;
+        }
+    }
+
+    return current_element;
+}
+
+CJSON_PUBLIC(cJSON *) cJSONUtils_GetCompiledPointer(cJSON * const object, const cJSONUtils_Pointer * const pointer)
+{
+    if (pointer == NULL)
+    {
+        return NULL;
+    }
+
+    return get_item_from_tokens(object, pointer->tokens, pointer->count, false);
+}
+
+CJSON_PUBLIC(cJSON *) cJSONUtils_GetCompiledPointerCaseSensitive(cJSON * const object, const cJSONUtils_Pointer * const pointer)
+{
+    if (pointer == NULL)
+    {
+        return NULL;
+    }
+
+    return get_item_from_tokens(object, pointer->tokens, pointer->count, true);
+}
+
+/* JSON Patch implementation. */
+
+typedef enum
+{
+    undo_insert,
+    undo_detach,
+    undo_root
+} undo_kind;
+
+/* one change to the document, recorded so that it can be taken back */
+typedef struct
+{
+    undo_kind kind;
+    cJSON *parent;
+    cJSON *item; /* inserted or detached item, the old contents for undo_root */
+    cJSON *previous; /* sibling a detached item followed, NULL if it was the first child */
+    char *string; /* key an inserted item had before */
+    int type;
+    cJSON_bool owned; /* detached items are deleted on commit, inserted ones on rollback */
+} undo_entry;
+
+/* Changes of a transactional apply, items removed from the document stay alive here until the transaction ends */
+typedef struct
+{
+    undo_entry *entries;
+    size_t count;
+    size_t size;
+} undo_log;
+
+/* make room for a patch operation's changes up front, so that recording them can't fail halfway through */
+static cJSON_bool reserve_undo_entries(undo_log * const log, const size_t count)
+{
+    undo_entry *entries = NULL;
+    size_t size = 0;
+
+    if ((log->count + count) <= log->size)
+    {
+        return true;
+    }
+
+    size = (log->size == 0) ? 16 : (2 * log->size);
+    if (size < (log->count + count))
+    {
+        size = log->count + count;
+    }
+    entries = (undo_entry*)cJSON_malloc(size * sizeof(undo_entry));
+    if (entries == NULL)
+    {
+        return false;
+    }
+    if (log->entries != NULL)
+    {
+        memcpy(entries, log->entries, log->count * sizeof(undo_entry));
+        cJSON_free(log->entries);
+    }
+    log->entries = entries;
+    log->size = size;
+
+    return true;
+}
+
+static undo_entry *add_undo_entry(undo_log * const log, const undo_kind kind, cJSON * const parent, cJSON * const item, const cJSON_bool owned)
+{
+    undo_entry *entry = &log->entries[log->count++];
+
+    memset(entry, '\0', sizeof(undo_entry));
+    entry->kind = kind;
+    entry->parent = parent;
+    entry->item = item;
+    entry->owned = owned;
+
+    return entry;
+}
+
+/* Record an item that is about to be inserted. Its key is marked constant so that cJSON_AddItemToObject
+ * replaces it without freeing it, the log puts it back on rollback and frees it on commit. */
+static void log_insertion(undo_log * const log, cJSON * const parent, cJSON * const item, const cJSON_bool owned)
+{
+    undo_entry *entry = NULL;
+
+    if (log == NULL)
+    {
+        return;
+    }
+
+    entry = add_undo_entry(log, undo_insert, parent, item, owned);
+    entry->string = item->string;
+    entry->type = item->type;
+    if (cJSON_IsObject(parent))
+    {
+        item->type |= cJSON_StringIsConst;
+    }
+}
+
+/* Detach an item from its parent. With an undo log the item isn't deleted by the caller,
+ * the log keeps it together with the sibling it followed. */
+static cJSON *detach_item(cJSON * const parent, cJSON * const item, undo_log * const log, const cJSON_bool owned)
+{
+    if (item == NULL)
+    {
+        return NULL;
+    }
+
+    if (log != NULL)
+    {
+        add_undo_entry(log, undo_detach, parent, item, owned)->previous = (item == parent->child) ? NULL : item->prev;
+    }
+
+    return cJSON_DetachItemViaPointer(parent, item);
+}
+
+/* put a detached item back after 'previous' */
+static void reattach_item(cJSON * const parent, cJSON * const previous, cJSON * const item)
+{
+    cJSON_InvalidateIndex(parent);
+    if (previous == NULL)
+    {
+        /* the first child's prev points to the last one */
+        item->prev = (parent->child != NULL) ? parent->child->prev : item;
+        item->next = parent->child;
+        if (parent->child != NULL)
+        {
+            parent->child->prev = item;
+        }
+        parent->child = item;
+        return;
+    }
+
+    item->prev = previous;
+    item->next = previous->next;
+    if (previous->next != NULL)
+    {
+        previous->next->prev = item;
+    }
+    else
+    {
+        parent->child->prev = item;
+    }
+    previous->next = item;
+}
+
+/* keep the old contents of the root in the log before it is overwritten */
+static cJSON_bool save_root(cJSON * const root, undo_log * const log)
+{
+    cJSON *saved = (cJSON*)cJSON_malloc(sizeof(cJSON));
+    if (saved == NULL)
+    {
+        return false;
+    }
+
+    cJSON_InvalidateIndex(root);
+    memcpy(saved, root, sizeof(cJSON));
+    /* the contents belong to the log now */
+    root->string = NULL;
+    root->valuestring = NULL;
+    root->child = NULL;
+    add_undo_entry(log, undo_root, root, saved, true);
+
+    return true;
+}
+
+static void overwrite_item(cJSON * const root, const cJSON replacement);
+
+/* take back all changes in reverse order, which leaves the document exactly as it was */
+static void rollback_undo_log(undo_log * const log)
+{
+    while (log->count > 0)
+    {
+        undo_entry *entry = &log->entries[--log->count];
+        switch (entry->kind)
+        {
+            case undo_insert:
+                cJSON_DetachItemViaPointer(entry->parent, entry->item);
+                if (entry->item->string != entry->string)
+                {
+                    if (!(entry->item->type & cJSON_StringIsConst) && (entry->item->string != NULL))
+                    {
+                        cJSON_free(entry->item->string);
+                    }
+                    entry->item->string = entry->string;
+                }
+                entry->item->type = entry->type;
+                if (entry->owned)
+                {
+                    cJSON_Delete(entry->item);
+                }
+                break;
+
+            case undo_detach:
+                reattach_item(entry->parent, entry->previous, entry->item);
+                break;
+
+            case undo_root:
+                overwrite_item(entry->parent, *entry->item);
+                cJSON_free(entry->item);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+/* free what the changes removed from the document, in the order they were made */
+static void commit_undo_log(undo_log * const log)
+{
+    size_t index = 0;
+
+    for (index = 0; index < log->count; index++)
+    {
+        undo_entry *entry = &log->entries[index];
+        switch (entry->kind)
+        {
+            case undo_insert:
+                if (entry->item->string == entry->string)
+                {
+                    /* still the same key, drop the constant mark of log_insertion */
+                    entry->item->type = (entry->item->type & ~cJSON_StringIsConst) | (entry->type & cJSON_StringIsConst);
+                }
+                else if ((entry->string != NULL) && !(entry->type & cJSON_StringIsConst))
+                {
+                    cJSON_free(entry->string);
+                }
+                break;
+
+            case undo_detach:
+                if (entry->owned)
+                {
+                    cJSON_Delete(entry->item);
+                }
+                break;
+
+            case undo_root:
+            {
+                cJSON *saved = entry->item;
+                if (saved->string != NULL)
+                {
+                    cJSON_free(saved->string);
+                }
+                if (saved->valuestring != NULL)
+                {
+                    cJSON_free(saved->valuestring);
+                }
+                if (saved->child != NULL)
+                {
+                    cJSON_Delete(saved->child);
+                }
+                cJSON_free(saved);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+    log->count = 0;
+}
+
+/* Paths that a patch adds to or detaches from are split at the last '/'. The parent is resolved like
+ * cJSONUtils_GetPointer does, so without a leading '/' it is the root and only the last token is left. */
+static cJSONUtils_Pointer *compile_patch_path(const char *path)
+{
+    const char *last_token = strrchr(path, '/');
+
+    if ((path[0] != '/') && (last_token != NULL))
+    {
+        return cJSONUtils_CompilePointer(last_token);
+    }
+
+    return cJSONUtils_CompilePointer(path);
+}
+
+/* detach the item at the given path */
+static cJSON *detach_path(cJSON *object, const cJSONUtils_Pointer * const path, const cJSON_bool case_sensitive, undo_log * const log, const cJSON_bool owned)
+{
+    const pointer_token *child = NULL;
+    cJSON *parent = NULL;
+
+    if ((path == NULL) || (path->count == 0))
+    {
+        return NULL;
+    }
+
+    child = &path->tokens[path->count - 1];
+    parent = get_item_from_tokens(object, path->tokens, path->count - 1, case_sensitive);
+    if (cJSON_IsArray(parent))
+    {
+        return child->is_index ? detach_item(parent, get_array_item(parent, child->index), log, owned) : NULL;
+    }
+    if (cJSON_IsObject(parent))
+    {
+        /* case insensitive in either mode, like cJSON_DetachItemFromObject */
+        return detach_item(parent, cJSON_GetObjectItemKey(parent, &child->key), log, owned);
+    }
+
+    /* Couldn't find object to remove child from. */
+    return NULL;
+}
+
+/* sort lists using mergesort */
+static cJSON *sort_list(cJSON *list, const cJSON_bool case_sensitive)
+{
+    cJSON *first = list;
+    cJSON *second = list;
+    cJSON *current_item = list;
+    cJSON *result = list;
+    cJSON *result_tail = NULL;
+
+    if ((list == NULL) || (list->next == NULL))
+    {
+        /* One entry is sorted already. */
+        return result;
+    }
+
+    while ((current_item != NULL) && (current_item->next != NULL) && (compare_strings((unsigned char*)current_item->string, (unsigned char*)current_item->next->string, case_sensitive) < 0))
+    {
+        /* Test for list sorted. */
+        current_item = current_item->next;
+    }
+    if ((current_item == NULL) || (current_item->next == NULL))
+    {
+        /* Leave sorted lists unmodified. */
+        return result;
+    }
+
+    /* reset pointer to the beginning */
+    current_item = list;
+    while (current_item != NULL)
+    {
+        /* Walk two pointers to find the middle. */
+        second = second->next;
+        current_item = current_item->next;
+        /* advances current_item two steps at a time */
+        if (current_item != NULL)
+        {
+            current_item = current_item->next;
+        }
+    }
+    if ((second != NULL) && (second->prev != NULL))
+    {
+        /* Split the lists */
+        second->prev->next = NULL;
+        second->prev = NULL;
+    }
+
+    /* Recursively sort the sub-lists. */
+    first = sort_list(first, case_sensitive);
+    second = sort_list(second, case_sensitive);
+    result = NULL;
+
+    /* Merge the sub-lists */
+    while ((first != NULL) && (second != NULL))
+    {
+        cJSON *smaller = NULL;
+        if (compare_strings((unsigned char*)first->string, (unsigned char*)second->string, case_sensitive) < 0)
+        {
+            smaller = first;
+        }
+        else
+        {
+            smaller = second;
+        }
+
+        if (result == NULL)
+        {
+            /* start merged list with the smaller element */
+            result_tail = smaller;
+            result = smaller;
+        }
+        else
+        {
+            /* add smaller element to the list */
+            result_tail->next = smaller;
+            smaller->prev = result_tail;
+            result_tail = smaller;
+        }
+
+        if (first == smaller)
+        {
+            first = first->next;
+        }
+        else
+        {
+            second = second->next;
+        }
+    }
+
+    if (first != NULL)
+    {
+        /* Append rest of first list. */
+        if (result == NULL)
+        {
+            return first;
+        }
+        result_tail->next = first;
+        first->prev = result_tail;
+    }
+    if (second != NULL)
+    {
+        /* Append rest of second list */
+        if (result == NULL)
+        {
+            return second;
+        }
+        result_tail->next = second;
+        second->prev = result_tail;
+    }
+
+    return result;
+}
+
+static void sort_object(cJSON * const object, const cJSON_bool case_sensitive)
+{
+    if (object == NULL)
+    {
+        return;
+    }
+    cJSON_InvalidateIndex(object);
+    object->child = sort_list(object->child, case_sensitive);
+}
+
+static cJSON_bool compare_json(cJSON *a, cJSON *b, const cJSON_bool case_sensitive)
+{
+    if ((a == NULL) || (b == NULL) || ((a->type & 0xFF) != (b->type & 0xFF)))
+    {
+        /* mismatched type. */
+        return false;
+    }
+    switch (a->type & 0xFF)
+    {
+        case cJSON_Number:
+            /* numeric mismatch. */
+            if ((a->valueint != b->valueint) || (!compare_double(a->valuedouble, b->valuedouble)))
+            {
+                return false;
+            }
+            else
+            {
+                return true;
+            }
+
+        case cJSON_String:
+            /* string mismatch. */
+            if (strcmp(a->valuestring, b->valuestring) != 0)
+            {
+                return false;
+            }
+            else
+            {
+                return true;
+            }
+
+        case cJSON_Array:
+            for ((void)(a = a->child), b = b->child; (a != NULL) && (b != NULL); (void)(a = a->next), b = b->next)
+            {
+                cJSON_bool identical = compare_json(a, b, case_sensitive);
+                if (!identical)
+                {
+                    return false;
+                }
+            }
+
+            /* array size mismatch? (one of both children is not NULL) */
+            if ((a != NULL) || (b != NULL))
+            {
+                return false;
+            }
+            else
+            {
+                return true;
+            }
+
+        case cJSON_Object:
+            sort_object(a, case_sensitive);
+            sort_object(b, case_sensitive);
+            for ((void)(a = a->child), b = b->child; (a != NULL) && (b != NULL); (void)(a = a->next), b = b->next)
+            {
+                cJSON_bool identical = false;
+                /* compare object keys */
+                if (compare_strings((unsigned char*)a->string, (unsigned char*)b->string, case_sensitive))
+                {
+                    /* missing member */
+                    return false;
+                }
+                identical = compare_json(a, b, case_sensitive);
+                if (!identical)
+                {
+                    return false;
+                }
+            }
+
+            /* object length mismatch (one of both children is not null) */
+            if ((a != NULL) || (b != NULL))
+            {
+                return false;
+            }
+            else
+            {
+                return true;
+            }
+
+        default:
+            break;
+    }
+
+    /* null, true or false */
+    return true;
+}
+
+/* non broken version of cJSON_InsertItemInArray */
+static cJSON_bool insert_item_in_array(cJSON *array, size_t which, cJSON *newitem)
+{
+    cJSON *child = array->child;
+    while (child && (which > 0))
+    {
+        child = child->next;
+        which--;
+    }
+    if (which > 0)
+    {
+        /* item is after the end of the array */
+        return 0;
+    }
+    if (child == NULL)
+    {
+        cJSON_AddItemToArray(array, newitem);
+        return 1;
+    }
+
+    /* insert into the linked list */
+    cJSON_InvalidateIndex(array);
+    newitem->next = child;
+    newitem->prev = child->prev;
+    child->prev = newitem;
+
+    /* was it at the beginning */
+    if (child == array->child)
+    {
+        array->child = newitem;
+    }
+    else
+    {
+        newitem->prev->next = newitem;
+    }
+
+    return 1;
+}
+
+static cJSON *get_object_item(const cJSON * const object, const char* name, const cJSON_bool case_sensitive)
+{
+    if (case_sensitive)
+    {
+        return cJSON_GetObjectItemCaseSensitive(object, name);
+    }
+
+    return cJSON_GetObjectItem(object, name);
+}
+
+enum patch_operation { INVALID, ADD, REMOVE, REPLACE, MOVE, COPY, TEST };
+
+static enum patch_operation decode_patch_operation(const cJSON * const patch, const cJSON_bool case_sensitive)
+{
+    cJSON *operation = get_object_item(patch, "op", case_sensitive);
+    if (!cJSON_IsString(operation))
+    {
+        return INVALID;
+    }
+
+    if (strcmp(operation->valuestring, "add") == 0)
+    {
+        return ADD;
+    }
+
+    if (strcmp(operation->valuestring, "remove") == 0)
+    {
+        return REMOVE;
+    }
+
+    if (strcmp(operation->valuestring, "replace") == 0)
+    {
+        return REPLACE;
+    }
+
+    if (strcmp(operation->valuestring, "move") == 0)
+    {
+        return MOVE;
+    }
+
+    if (strcmp(operation->valuestring, "copy") == 0)
+    {
+        return COPY;
+    }
+
+    if (strcmp(operation->valuestring, "test") == 0)
+    {
+        return TEST;
+    }
+
+    return INVALID;
+}
+
+/* overwrite and existing item with another one and free resources on the way */
+static void overwrite_item(cJSON * const root, const cJSON replacement)
+{
+    if (root == NULL)
+    {
+        return;
+    }
+
+    if (root->string != NULL)
+    {
+        cJSON_free(root->string);
+    }
+    if (root->valuestring != NULL)
+    {
+        cJSON_free(root->valuestring);
+    }
+    if (root->child != NULL)
+    {
+        cJSON_Delete(root->child);
+    }
+    cJSON_InvalidateIndex(root);
+
+    memcpy(root, &replacement, sizeof(cJSON));
+}
+
+/* Apply one operation. With an undo log every change is recorded and nothing is freed until the log is committed. */
+static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_sensitive, undo_log * const log)
+{
+    cJSON *path = NULL;
+    cJSON *value = NULL;
+    cJSON *parent = NULL;
+    cJSONUtils_Pointer *compiled_path = NULL;
+    cJSONUtils_Pointer *compiled_from = NULL;
+    const pointer_token *child = NULL;
+    enum patch_operation opcode = INVALID;
+    int status = 0;
+
+    path = get_object_item(patch, "path", case_sensitive);
+    if (!cJSON_IsString(path))
+    {
+        /* malformed patch. */
+        status = 2;
+        goto cleanup;
+    }
+
+    opcode = decode_patch_operation(patch, case_sensitive);
+    if (opcode == INVALID)
+    {
+        status = 3;
+        goto cleanup;
+    }
+
+    /* decode the path once for all the lookups below, NULL if out of memory */
+    compiled_path = (opcode == TEST) ? cJSONUtils_CompilePointer(path->valuestring) : compile_patch_path(path->valuestring);
+    if (opcode == TEST)
+    {
+        /* compare value: {...} with the given path */
+        cJSON *item = (compiled_path != NULL) ? get_item_from_tokens(object, compiled_path->tokens, compiled_path->count, case_sensitive) : NULL;
+        if (log != NULL)
+        {
+            /* compare_json sorts objects, which a rollback couldn't take back */
+            status = !cJSON_Compare(item, get_object_item(patch, "value", case_sensitive), case_sensitive);
+        }
+        else
+        {
+            status = !compare_json(item, get_object_item(patch, "value", case_sensitive), case_sensitive);
+        }
+        goto cleanup;
+    }
+
+    /* an operation makes at most three changes: detach, detach a member with the same key and insert */
+    if ((log != NULL) && !reserve_undo_entries(log, 3))
+    {
+        /* out of memory for the undo log. */
+        status = 14;
+        goto cleanup;
+    }
+
+    /* special case for replacing the root */
+    if (path->valuestring[0] == '\0')
+    {
+        if (opcode == REMOVE)
+        {
+            cJSON invalid;
+
+            /* struct cJSON has one more member with ENABLE_CJSON_INDEX, so no initializer list */
+            memset(&invalid, '\0', sizeof(invalid));
+            invalid.type = cJSON_Invalid;
+
+            if ((log != NULL) && !save_root(object, log))
+            {
+                status = 14;
+                goto cleanup;
+            }
+            overwrite_item(object, invalid);
+
+            status = 0;
+            goto cleanup;
+        }
+
+        if ((opcode == REPLACE) || (opcode == ADD))
+        {
+            value = get_object_item(patch, "value", case_sensitive);
+            if (value == NULL)
+            {
+                /* missing "value" for add/replace. */
+                status = 7;
+                goto cleanup;
+            }
+
+            value = cJSON_Duplicate(value, 1);
+            if (value == NULL)
+            {
+                /* out of memory for add/replace. */
+                status = 8;
+                goto cleanup;
+            }
+
+            if ((log != NULL) && !save_root(object, log))
+            {
+                status = 14;
+                goto cleanup;
+            }
+            overwrite_item(object, *value);
+
+            /* delete the duplicated value, its contents belong to object now */
+            memset(value, '\0', sizeof(cJSON));
+            cJSON_Delete(value);
+            value = NULL;
+
+            /* the string "value" isn't needed */
+            if (object->string != NULL)
+            {
+                cJSON_free(object->string);
+                object->string = NULL;
+            }
+
+            status = 0;
+            goto cleanup;
+        }
+    }
+
+    if ((opcode == REMOVE) || (opcode == REPLACE))
+    {
+        /* Get rid of old. */
+        cJSON *old_item = detach_path(object, compiled_path, case_sensitive, log, true);
+        if (old_item == NULL)
+        {
+            status = 13;
+            goto cleanup;
+        }
+        if (log == NULL)
+        {
+            cJSON_Delete(old_item);
+        }
+        if (opcode == REMOVE)
+        {
+            /* For Remove, this job is done. */
+            status = 0;
+            goto cleanup;
+        }
+    }
+
+    /* Copy/Move uses "from". */
+    if ((opcode == MOVE) || (opcode == COPY))
+    {
+        cJSON *from = get_object_item(patch, "from", case_sensitive);
+        if (from == NULL)
+        {
+            /* missing "from" for copy/move. */
+            status = 4;
+            goto cleanup;
+        }
+
+        /* move detaches "from" like remove, copy looks it up like test */
+        compiled_from = (opcode == MOVE) ? compile_patch_path(from->valuestring) : cJSONUtils_CompilePointer(from->valuestring);
+        if ((opcode == MOVE) && (compiled_from != NULL))
+        {
+            value = detach_path(object, compiled_from, case_sensitive, log, false);
+        }
+        if ((opcode == COPY) && (compiled_from != NULL))
+        {
+            value = get_item_from_tokens(object, compiled_from->tokens, compiled_from->count, case_sensitive);
+        }
+        if (value == NULL)
+        {
+            /* missing "from" for copy/move. */
+            status = 5;
+            goto cleanup;
+        }
+        if (opcode == COPY)
+        {
+            value = cJSON_Duplicate(value, 1);
+        }
+        if (value == NULL)
+        {
+            /* out of memory for copy/move. */
+            status = 6;
+            goto cleanup;
+        }
+    }
+    else /* Add/Replace uses "value". */
+    {
+        value = get_object_item(patch, "value", case_sensitive);
+        if (value == NULL)
+        {
+            /* missing "value" for add/replace. */
+            status = 7;
+            goto cleanup;
+        }
+        value = cJSON_Duplicate(value, 1);
+        if (value == NULL)
+        {
+            /* out of memory for add/replace. */
+            status = 8;
+            goto cleanup;
+        }
+    }
+
+    /* Now, just add "value" to "path". */
+
+    /* split pointer in parent and child */
+    if ((compiled_path != NULL) && (compiled_path->count > 0))
+    {
+        child = &compiled_path->tokens[compiled_path->count - 1];
+        parent = get_item_from_tokens(object, compiled_path->tokens, compiled_path->count - 1, case_sensitive);
+    }
+
+    /* add, remove, replace, move, copy, test. */
+    if ((parent == NULL) || (child == NULL))
+    {
+        /* Couldn't find object to add to. */
+        status = 9;
+        goto cleanup;
+    }
+    else if (cJSON_IsArray(parent))
+    {
+        if (strcmp(child->key.string, "-") == 0)
+        {
+            log_insertion(log, parent, value, opcode != MOVE);
+            cJSON_AddItemToArray(parent, value);
+            value = NULL;
+        }
+        else
+        {
+            if (!child->is_index)
+            {
+                status = 11;
+                goto cleanup;
+            }
+
+            if (!insert_item_in_array(parent, child->index, value))
+            {
+                status = 10;
+                goto cleanup;
+            }
+            log_insertion(log, parent, value, opcode != MOVE);
+            value = NULL;
+        }
+    }
+    else if (cJSON_IsObject(parent))
+    {
+        if (log != NULL)
+        {
+            detach_item(parent, get_object_item(parent, child->key.string, case_sensitive), log, true);
+        }
+        else if (case_sensitive)
+        {
+            cJSON_DeleteItemFromObjectCaseSensitive(parent, child->key.string);
+        }
+        else
+        {
+            cJSON_DeleteItemFromObject(parent, child->key.string);
+        }
+        log_insertion(log, parent, value, opcode != MOVE);
+        cJSON_AddItemToObject(parent, child->key.string, value);
+        value = NULL;
+    }
+    else /* parent is not an object */
+    {
+        /* Couldn't find object to add to. */
+        status = 9;
+        goto cleanup;
+    }
+
+cleanup:
+    /* a moved item is still in the undo log, the rollback puts it back */
+    if ((value != NULL) && !((log != NULL) && (opcode == MOVE)))
+    {
+        cJSON_Delete(value);
+    }
+    cJSONUtils_DeletePointer(compiled_path);
+    cJSONUtils_DeletePointer(compiled_from);
+
+    return status;
+}
+
+CJSON_PUBLIC(int) cJSONUtils_ApplyPatches(cJSON * const object, const cJSON * const patches)
+{
+    const cJSON *current_patch = NULL;
+    int status = 0;
+
+    if (!cJSON_IsArray(patches))
+    {
+        /* malformed patches. */
+        return 1;
+    }
+
+    if (patches != NULL)
+    {
+        current_patch = patches->child;
+    }
+
+    while (current_patch != NULL)
+    {
+        status = apply_patch(object, current_patch, false, NULL);
+        if (status != 0)
+        {
+            return status;
+        }
+        current_patch = current_patch->next;
+    }
+
+    return 0;
+}
+
+CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesCaseSensitive(cJSON * const object, const cJSON * const patches)
+{
+    const cJSON *current_patch = NULL;
+    int status = 0;
+
+    if (!cJSON_IsArray(patches))
+    {
+        /* malformed patches. */
+        return 1;
+    }
+
+    if (patches != NULL)
+    {
+        current_patch = patches->child;
+    }
+
+    while (current_patch != NULL)
+    {
+        status = apply_patch(object, current_patch, true, NULL);
+        if (status != 0)
+        {
+            return status;
+        }
+        current_patch = current_patch->next;
+    }
+
+    return 0;
+}
+
+static int apply_patches_transactional(cJSON * const object, const cJSON * const patches, const cJSON_bool case_sensitive)
+{
+    const cJSON *current_patch = NULL;
+    undo_log log = { NULL, 0, 0 };
+    int status = 0;
+
+    if (!cJSON_IsArray(patches))
+    {
+        /* malformed patches. */
+        return 1;
+    }
+
+    for (current_patch = patches->child; (current_patch != NULL) && (status == 0); current_patch = current_patch->next)
+    {
+        status = apply_patch(object, current_patch, case_sensitive, &log);
+    }
+
+    if (status == 0)
+    {
+        commit_undo_log(&log);
+    }
+    else
+    {
+        rollback_undo_log(&log);
+    }
+    if (log.entries != NULL)
+    {
+        cJSON_free(log.entries);
+    }
+
+    return status;
+}
+
+CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesTransactional(cJSON * const object, const cJSON * const patches)
+{
+    return apply_patches_transactional(object, patches, false);
+}
+
+CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesTransactionalCaseSensitive(cJSON * const object, const cJSON * const patches)
+{
+    return apply_patches_transactional(object, patches, true);
+}
+
+static void compose_patch(cJSON * const patches, const unsigned char * const operation, const unsigned char * const path, const unsigned char *suffix, const cJSON * const value)
+{
+    cJSON *patch = NULL;
+
+    if ((patches == NULL) || (operation == NULL) || (path == NULL))
+    {
+        return;
+    }
+
+    patch = cJSON_CreateObject();
+    if (patch == NULL)
+    {
+        return;
+    }
+    cJSON_AddItemToObject(patch, "op", cJSON_CreateString((const char*)operation));
+
+    if (suffix == NULL)
+    {
+        cJSON_AddItemToObject(patch, "path", cJSON_CreateString((const char*)path));
+    }
+    else
+    {
+        size_t suffix_length = pointer_encoded_length(suffix);
+        size_t path_length = strlen((const char*)path);
+        unsigned char *full_path = (unsigned char*)cJSON_malloc(path_length + suffix_length + sizeof("/"));
+
+        sprintf((char*)full_path, "%s/", (const char*)path);
+        encode_string_as_pointer(full_path + path_length + 1, suffix);
+
+        cJSON_AddItemToObject(patch, "path", cJSON_CreateString((const char*)full_path));
+        cJSON_free(full_path);
+    }
+
+    if (value != NULL)
+    {
+        cJSON_AddItemToObject(patch, "value", cJSON_Duplicate(value, 1));
+    }
+    cJSON_AddItemToArray(patches, patch);
+}
+
+CJSON_PUBLIC(void) cJSONUtils_AddPatchToArray(cJSON * const array, const char * const operation, const char * const path, const cJSON * const value)
+{
+    compose_patch(array, (const unsigned char*)operation, (const unsigned char*)path, NULL, value);
+}
+
+/* Largest edit distance for which create_array_patches searches a minimal edit script, the search needs memory
+ * quadratic in it. Arrays that differ by more are diffed element by element in the middle instead. */
+#ifndef CJSON_UTILS_ARRAY_EDIT_LIMIT
+#define CJSON_UTILS_ARRAY_EDIT_LIMIT 128
+#endif
+
+/* Structural hash and item count of a subtree. The summaries of a document are stored in preorder, so the first
+ * child of the item summarized at summary[0] is at summary[1] and every sibling follows 'size' entries later. */
+typedef struct
+{
+    size_t hash;
+    size_t size;
+} subtree_summary;
+
+typedef struct
+{
+    const cJSON *item;
+    const subtree_summary *summary;
+} summarized_item;
+
+typedef enum
+{
+    edit_keep,
+    edit_remove,
+    edit_insert
+} array_edit;
+
+static size_t hash_bytes(size_t hash, const unsigned char *bytes, size_t length, const cJSON_bool case_sensitive)
+{
+    for (; length > 0; (void)bytes++, length--)
+    {
+        hash = (hash ^ (case_sensitive ? *bytes : (unsigned char)tolower(*bytes))) * 16777619U;
+    }
+
+    return hash;
+}
+
+static size_t count_items(const cJSON *item)
+{
+    size_t count = 1;
+    for (item = item->child; item != NULL; item = item->next)
+    {
+        count += count_items(item);
+    }
+
+    return count;
+}
+
+/* Fill in the summaries of an item and all its descendants, returns the number of items in the subtree.
+ * Equal subtrees hash equal, except for numbers that only compare equal within the epsilon of compare_double. */
+static size_t summarize(const cJSON * const item, subtree_summary * const summary, const cJSON_bool case_sensitive)
+{
+    const cJSON *child = NULL;
+    size_t size = 1;
+    size_t hash = 2166136261U ^ (size_t)(item->type & 0xFF);
+
+    switch (item->type & 0xFF)
+    {
+        case cJSON_Number:
+        {
+            /* 0 and -0 are equal, so make them hash equal */
+            double number = (fabs(item->valuedouble) < DBL_MIN) ? 0.0 : item->valuedouble;
+            hash = hash_bytes(hash, (const unsigned char*)&number, sizeof(number), true);
+            break;
+        }
+
+        case cJSON_String:
+            if (item->valuestring != NULL)
+            {
+                hash = hash_bytes(hash, (const unsigned char*)item->valuestring, strlen(item->valuestring), true);
+            }
+            break;
+
+        case cJSON_Array:
+            for (child = item->child; child != NULL; child = child->next)
+            {
+                subtree_summary *child_summary = summary + size;
+                size += summarize(child, child_summary, case_sensitive);
+                hash = (hash ^ child_summary->hash) * 16777619U;
+            }
+            break;
+
+        case cJSON_Object:
+            /* members are unordered, so combine them with a commutative sum */
+            for (child = item->child; child != NULL; child = child->next)
+            {
+                subtree_summary *child_summary = summary + size;
+                size_t member_hash = 0;
+                size += summarize(child, child_summary, case_sensitive);
+                member_hash = child_summary->hash;
+                if (child->string != NULL)
+                {
+                    member_hash = hash_bytes(member_hash, (const unsigned char*)child->string, strlen(child->string), case_sensitive);
+                }
+                hash += member_hash * 2654435761U;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    summary->hash = hash;
+    summary->size = size;
+
+    return size;
+}
+
+/* order object members by key and keep members with equal keys in document order */
+static int compare_members(const summarized_item * const a, const summarized_item * const b, const cJSON_bool case_sensitive)
+{
+    int diff = compare_strings((const unsigned char*)a->item->string, (const unsigned char*)b->item->string, case_sensitive);
+    if (diff != 0)
+    {
+        return diff;
+    }
+
+    return (a->summary < b->summary) ? -1 : ((a->summary > b->summary) ? 1 : 0);
+}
+
+static int compare_members_case_insensitive(const void *a, const void *b)
+{
+    return compare_members((const summarized_item*)a, (const summarized_item*)b, false);
+}
+
+static int compare_members_case_sensitive(const void *a, const void *b)
+{
+    return compare_members((const summarized_item*)a, (const summarized_item*)b, true);
+}
+
+/* Collect the children of an item together with their summaries, members of objects are sorted by key.
+ * Returns NULL for items without children and if allocation fails, in which case 'count' is not 0. */
+static summarized_item *collect_children(const cJSON * const item, const subtree_summary * const summary, size_t * const count, const cJSON_bool case_sensitive)
+{
+    summarized_item *children = NULL;
+    const subtree_summary *child_summary = summary + 1;
+    const cJSON *child = NULL;
+    size_t index = 0;
+
+    *count = 0;
+    for (child = item->child; child != NULL; child = child->next)
+    {
+        (*count)++;
+    }
+    if (*count == 0)
+    {
+        return NULL;
+    }
+
+    children = (summarized_item*)cJSON_malloc(*count * sizeof(summarized_item));
+    if (children == NULL)
+    {
+        return NULL;
+    }
+
+    for (child = item->child; child != NULL; (void)(child = child->next), index++)
+    {
+        children[index].item = child;
+        children[index].summary = child_summary;
+        child_summary += child_summary->size;
+    }
+
+    if (cJSON_IsObject(item))
+    {
+        qsort(children, *count, sizeof(summarized_item), case_sensitive ? compare_members_case_sensitive : compare_members_case_insensitive);
+    }
+
+    return children;
+}
+
+static cJSON_bool equal_subtrees(const cJSON * const a, const subtree_summary * const a_summary, const cJSON * const b, const subtree_summary * const b_summary, const cJSON_bool case_sensitive);
+
+/* compare object members matched up by key, for objects whose members aren't in the same order */
+static cJSON_bool equal_sorted_members(const cJSON * const a, const subtree_summary * const a_summary, const cJSON * const b, const subtree_summary * const b_summary, const cJSON_bool case_sensitive)
+{
+    summarized_item *a_members = NULL;
+    summarized_item *b_members = NULL;
+    size_t a_count = 0;
+    size_t b_count = 0;
+    size_t index = 0;
+    cJSON_bool equal = true;
+
+    a_members = collect_children(a, a_summary, &a_count, case_sensitive);
+    b_members = collect_children(b, b_summary, &b_count, case_sensitive);
+    if ((a_count != b_count) || ((a_members == NULL) && (a_count != 0)) || ((b_members == NULL) && (b_count != 0)))
+    {
+        equal = false;
+    }
+
+    for (index = 0; equal && (index < a_count); index++)
+    {
+        equal = (compare_strings((unsigned char*)a_members[index].item->string, (unsigned char*)b_members[index].item->string, case_sensitive) == 0)
+            && equal_subtrees(a_members[index].item, a_members[index].summary, b_members[index].item, b_members[index].summary, case_sensitive);
+    }
+
+    if (a_members != NULL)
+    {
+        cJSON_free(a_members);
+    }
+    if (b_members != NULL)
+    {
+        cJSON_free(b_members);
+    }
+
+    return equal;
+}
+
+/* Compare two subtrees without modifying them. May return false for equal subtrees if their hashes differ
+ * or memory runs out, callers then diff them in full, which never produces patches for equal values. */
+static cJSON_bool equal_subtrees(const cJSON * const a, const subtree_summary * const a_summary, const cJSON * const b, const subtree_summary * const b_summary, const cJSON_bool case_sensitive)
+{
+    const cJSON *a_child = NULL;
+    const cJSON *b_child = NULL;
+    const subtree_summary *a_child_summary = a_summary + 1;
+    const subtree_summary *b_child_summary = b_summary + 1;
+
+    if ((a->type & 0xFF) != (b->type & 0xFF))
+    {
+        return false;
+    }
+
+    switch (a->type & 0xFF)
+    {
+        case cJSON_Number:
+            return (a->valueint == b->valueint) && compare_double(a->valuedouble, b->valuedouble);
+
+        case cJSON_String:
+            return strcmp(a->valuestring, b->valuestring) == 0;
+
+        case cJSON_Array:
+        case cJSON_Object:
+            break;
+
+        default:
+            return true;
+    }
+
+    if ((a_summary->hash != b_summary->hash) || (a_summary->size != b_summary->size))
+    {
+        return false;
+    }
+
+    /* members usually come in the same order, only sort them when they don't */
+    for (a_child = a->child, b_child = b->child; (a_child != NULL) && (b_child != NULL); (void)(a_child = a_child->next), b_child = b_child->next)
+    {
+        if (cJSON_IsObject(a) && (compare_strings((unsigned char*)a_child->string, (unsigned char*)b_child->string, case_sensitive) != 0))
+        {
+            return equal_sorted_members(a, a_summary, b, b_summary, case_sensitive);
+        }
+        if (!equal_subtrees(a_child, a_child_summary, b_child, b_child_summary, case_sensitive))
+        {
+            return false;
+        }
+        a_child_summary += a_child_summary->size;
+        b_child_summary += b_child_summary->size;
+    }
+
+    return (a_child == NULL) && (b_child == NULL);
+}
+
+/* Where the furthest reaching path with 'step' edits on 'diagonal' (x - y) starts its run of kept elements, or -1
+ * if the diagonal can't be reached. 'previous' holds the furthest x of step - 1 for its diagonals -step + 1, -step + 3,
+ * ..., step - 1. Prefers inserting over removing on ties, like Myers' original formulation. */
+static long edit_start(const long * const previous, const long step, const long diagonal, const long from_count, const long to_count, cJSON_bool * const insertion)
+{
+    long down = -1;
+    long right = -1;
+
+    *insertion = false;
+    if (step == 0)
+    {
+        return 0;
+    }
+
+    /* insert to[y] after the path on diagonal + 1 */
+    if ((diagonal < step) && (previous[(diagonal + step) / 2] >= 0) && ((previous[(diagonal + step) / 2] - diagonal) <= to_count))
+    {
+        down = previous[(diagonal + step) / 2];
+    }
+    /* remove from[x] after the path on diagonal - 1 */
+    if ((diagonal > -step) && (previous[(diagonal + step) / 2 - 1] >= 0) && (previous[(diagonal + step) / 2 - 1] < from_count))
+    {
+        right = previous[(diagonal + step) / 2 - 1] + 1;
+    }
+
+    if ((down >= 0) && (down >= right))
+    {
+        *insertion = true;
+        return down;
+    }
+
+    return right;
+}
+
+/* Myers' O(ND) difference algorithm on the element hashes. Writes the shortest edit script that turns 'from' into 'to'
+ * to 'edits' and returns its length, or 0 if it takes more than CJSON_UTILS_ARRAY_EDIT_LIMIT removals and insertions
+ * or memory runs out. Both arrays must be non-empty. */
+static size_t find_array_edits(const summarized_item * const from, const size_t from_length, const summarized_item * const to, const size_t to_length, unsigned char *edits)
+{
+    long *furthest = NULL;
+    long limit = CJSON_UTILS_ARRAY_EDIT_LIMIT;
+    long from_count = 0;
+    long to_count = 0;
+    long step = 0;
+    long diagonal = 0;
+    long x = 0;
+    long y = 0;
+    cJSON_bool insertion = false;
+    size_t length = 0;
+
+    if ((from_length > (size_t)LONG_MAX / 2) || (to_length > (size_t)LONG_MAX / 2))
+    {
+        return 0;
+    }
+    from_count = (long)from_length;
+    to_count = (long)to_length;
+    if ((from_count + to_count) < limit)
+    {
+        limit = from_count + to_count;
+    }
+
+    /* the furthest x of step d for diagonals -d, -d + 2, ..., d starts at index d * (d + 1) / 2 */
+    furthest = (long*)cJSON_malloc((size_t)((limit + 1) * (limit + 2) / 2) * sizeof(long));
+    if (furthest == NULL)
+    {
+        return 0;
+    }
+
+    for (step = 0; step <= limit; step++)
+    {
+        long *current = furthest + step * (step + 1) / 2;
+        const long *previous = furthest + (step - 1) * step / 2;
+        for (diagonal = -step; diagonal <= step; diagonal += 2)
+        {
+            x = edit_start(previous, step, diagonal, from_count, to_count, &insertion);
+            if (x < 0)
+            {
+                current[(diagonal + step) / 2] = -1;
+                continue;
+            }
+            y = x - diagonal;
+            while ((x < from_count) && (y < to_count) && (from[x].summary->hash == to[y].summary->hash))
+            {
+                x++;
+                y++;
+            }
+            current[(diagonal + step) / 2] = x;
+
+            if ((x == from_count) && (y == to_count))
+            {
+                goto found;
+            }
+        }
+    }
+
+    cJSON_free(furthest);
+    return 0;
+
+found:
+    /* walk back from the end, every step is a removal or insertion followed by kept elements */
+    length = (size_t)((from_count + to_count + step) / 2);
+    edits += length;
+    for (; step > 0; step--)
+    {
+        long start = edit_start(furthest + (step - 1) * step / 2, step, x - y, from_count, to_count, &insertion);
+        for (; x > start; x--, y--)
+        {
+            *--edits = (unsigned char)edit_keep;
+        }
+        if (insertion)
+        {
+            *--edits = (unsigned char)edit_insert;
+            y--;
+        }
+        else
+        {
+            *--edits = (unsigned char)edit_remove;
+            x--;
+        }
+    }
+    for (; x > 0; x--)
+    {
+        *--edits = (unsigned char)edit_keep;
+    }
+
+    cJSON_free(furthest);
+    return length;
+}
+
+/* Number of operations an edit script turns into, the removals and insertions of a run pair up into changed elements */
+static size_t count_array_operations(const unsigned char * const edits, const size_t edit_count)
+{
+    size_t operations = 0;
+    size_t removals = 0;
+    size_t insertions = 0;
+    size_t position = 0;
+
+    for (position = 0; position <= edit_count; position++)
+    {
+        if ((position == edit_count) || (edits[position] == (unsigned char)edit_keep))
+        {
+            operations += (removals > insertions) ? removals : insertions;
+            removals = 0;
+            insertions = 0;
+        }
+        else if (edits[position] == (unsigned char)edit_remove)
+        {
+            removals++;
+        }
+        else
+        {
+            insertions++;
+        }
+    }
+
+    return operations;
+}
+
+static void create_patches(cJSON * const patches, const unsigned char * const path, const cJSON * const from, const subtree_summary * const from_summary, const cJSON * const to, const subtree_summary * const to_summary, const cJSON_bool case_sensitive);
+
+static void create_array_patches(cJSON * const patches, const unsigned char * const path, const cJSON * const from, const subtree_summary * const from_summary, const cJSON * const to, const subtree_summary * const to_summary, const cJSON_bool case_sensitive)
+{
+    summarized_item *from_items = NULL;
+    summarized_item *to_items = NULL;
+    unsigned char *edits = NULL;
+    unsigned char *new_path = NULL;
+    unsigned char index_string[21]; /* Allow space for 64bit int. log10(2^64) = 20 */
+    size_t from_count = 0;
+    size_t to_count = 0;
+    size_t prefix = 0;
+    size_t suffix = 0;
+    size_t edit_count = 0;
+    size_t position = 0;
+    size_t from_index = 0;
+    size_t to_index = 0;
+    size_t index = 0; /* position in the array as the patches are applied one after another */
+    size_t length = 0; /* length of the array as the patches are applied one after another */
+
+    from_items = collect_children(from, from_summary, &from_count, case_sensitive);
+    to_items = collect_children(to, to_summary, &to_count, case_sensitive);
+    /* check if conversion to unsigned long is valid
+     * This should be eliminated at compile time by dead code elimination
+     * if size_t is an alias of unsigned long, or if it is bigger */
+    if (((from_items == NULL) && (from_count != 0)) || ((to_items == NULL) && (to_count != 0)) || ((from_count + to_count) > ULONG_MAX))
+    {
+        goto cleanup;
+    }
+
+    edits = (unsigned char*)cJSON_malloc(from_count + to_count + 1);
+    new_path = (unsigned char*)cJSON_malloc(strlen((const char*)path) + 20 + sizeof("/"));
+    if ((edits == NULL) || (new_path == NULL))
+    {
+        goto cleanup;
+    }
+
+    /* elements that didn't change at the start and end don't need to go through the search */
+    while ((prefix < from_count) && (prefix < to_count) && (from_items[prefix].summary->hash == to_items[prefix].summary->hash))
+    {
+        edits[edit_count++] = (unsigned char)edit_keep;
+        prefix++;
+    }
+    while (((prefix + suffix) < from_count) && ((prefix + suffix) < to_count) && (from_items[from_count - suffix - 1].summary->hash == to_items[to_count - suffix - 1].summary->hash))
+    {
+        suffix++;
+    }
+
+    if ((from_count > (prefix + suffix)) && (to_count > (prefix + suffix)))
+    {
+        size_t middle = 0;
+        size_t changed = 0;
+
+        position = find_array_edits(from_items + prefix, from_count - prefix - suffix, to_items + prefix, to_count - prefix - suffix, edits + edit_count);
+
+        /* the shortest edit script can still take more operations than changing the elements in place,
+         * as with a reversed array, so fall back to that if it isn't worse */
+        for (middle = prefix; (middle < (from_count - suffix)) && (middle < (to_count - suffix)); middle++)
+        {
+            if (from_items[middle].summary->hash != to_items[middle].summary->hash)
+            {
+                changed++;
+            }
+        }
+        changed += (from_count > to_count) ? (from_count - to_count) : (to_count - from_count);
+        if ((position != 0) && (count_array_operations(edits + edit_count, position) < changed))
+        {
+            edit_count += position;
+        }
+        else
+        {
+            position = 0;
+        }
+    }
+    if (position == 0)
+    {
+        /* too many differences or no gain, pair the remaining elements up by index */
+        for (index = prefix; index < (from_count - suffix); index++)
+        {
+            edits[edit_count++] = (unsigned char)edit_remove;
+        }
+        for (index = prefix; index < (to_count - suffix); index++)
+        {
+            edits[edit_count++] = (unsigned char)edit_insert;
+        }
+    }
+    for (index = 0; index < suffix; index++)
+    {
+        edits[edit_count++] = (unsigned char)edit_keep;
+    }
+
+    index = 0;
+    length = from_count;
+    for (position = 0; position < edit_count;)
+    {
+        size_t removals = 0;
+        size_t insertions = 0;
+        size_t edit = 0;
+
+        if (edits[position] == (unsigned char)edit_keep)
+        {
+            removals = 1;
+            insertions = 1;
+            position++;
+        }
+        else
+        {
+            /* a run of removals and insertions, the elements they pair up are diffed against each other */
+            for (; (position < edit_count) && (edits[position] != (unsigned char)edit_keep); position++)
+            {
+                if (edits[position] == (unsigned char)edit_remove)
+                {
+                    removals++;
+                }
+                else
+                {
+                    insertions++;
+                }
+            }
+        }
+
+        for (edit = 0; (edit < removals) && (edit < insertions); edit++)
+        {
+            sprintf((char*)new_path, "%s/%lu", path, (unsigned long)index); /* path of the current array element */
+            create_patches(patches, new_path, from_items[from_index].item, from_items[from_index].summary, to_items[to_index].item, to_items[to_index].summary, case_sensitive);
+            from_index++;
+            to_index++;
+            index++;
+        }
+        for (; edit < removals; edit++)
+        {
+            sprintf((char*)index_string, "%lu", (unsigned long)index);
+            compose_patch(patches, (const unsigned char*)"remove", path, index_string, NULL);
+            from_index++;
+            length--;
+        }
+        for (; edit < insertions; edit++)
+        {
+            sprintf((char*)index_string, "%lu", (unsigned long)index);
+            compose_patch(patches, (const unsigned char*)"add", path, (index == length) ? (const unsigned char*)"-" : index_string, to_items[to_index].item);
+            to_index++;
+            index++;
+            length++;
+        }
+    }
+
+cleanup:
+    if (from_items != NULL)
+    {
+        cJSON_free(from_items);
+    }
+    if (to_items != NULL)
+    {
+        cJSON_free(to_items);
+    }
+    if (edits != NULL)
+    {
+        cJSON_free(edits);
+    }
+    if (new_path != NULL)
+    {
+        cJSON_free(new_path);
+    }
+}
+
+static void create_object_patches(cJSON * const patches, const unsigned char * const path, const cJSON * const from, const subtree_summary * const from_summary, const cJSON * const to, const subtree_summary * const to_summary, const cJSON_bool case_sensitive)
+{
+    summarized_item *from_members = NULL;
+    summarized_item *to_members = NULL;
+    size_t from_count = 0;
+    size_t to_count = 0;
+    size_t from_index = 0;
+    size_t to_index = 0;
+
+    /* match the members up by key on sorted copies of the member lists, the objects themselves stay as they are */
+    from_members = collect_children(from, from_summary, &from_count, case_sensitive);
+    to_members = collect_children(to, to_summary, &to_count, case_sensitive);
+    if (((from_members == NULL) && (from_count != 0)) || ((to_members == NULL) && (to_count != 0)))
+    {
+        from_count = 0;
+        to_count = 0;
+    }
+
+    /* for all object values in the object with more of them */
+    while ((from_index < from_count) || (to_index < to_count))
+    {
+        int diff;
+        if (from_index == from_count)
+        {
+            diff = 1;
+        }
+        else if (to_index == to_count)
+        {
+            diff = -1;
+        }
+        else
+        {
+            diff = compare_strings((unsigned char*)from_members[from_index].item->string, (unsigned char*)to_members[to_index].item->string, case_sensitive);
+        }
+
+        if (diff == 0)
+        {
+            /* both object keys are the same */
+            const summarized_item *from_child = &from_members[from_index];
+            const summarized_item *to_child = &to_members[to_index];
+            size_t path_length = strlen((const char*)path);
+            size_t from_child_name_length = pointer_encoded_length((unsigned char*)from_child->item->string);
+            unsigned char *new_path = (unsigned char*)cJSON_malloc(path_length + from_child_name_length + sizeof("/"));
+
+            sprintf((char*)new_path, "%s/", path);
+            encode_string_as_pointer(new_path + path_length + 1, (unsigned char*)from_child->item->string);
+
+            /* create a patch for the element */
+            create_patches(patches, new_path, from_child->item, from_child->summary, to_child->item, to_child->summary, case_sensitive);
+            cJSON_free(new_path);
+
+            from_index++;
+            to_index++;
+        }
+        else if (diff < 0)
+        {
+            /* object element doesn't exist in 'to' --> remove it */
+            compose_patch(patches, (const unsigned char*)"remove", path, (unsigned char*)from_members[from_index].item->string, NULL);
+
+            from_index++;
+        }
+        else
+        {
+            /* object element doesn't exist in 'from' --> add it */
+            compose_patch(patches, (const unsigned char*)"add", path, (unsigned char*)to_members[to_index].item->string, to_members[to_index].item);
+
+            to_index++;
+        }
+    }
+
+    if (from_members != NULL)
+    {
+        cJSON_free(from_members);
+    }
+    if (to_members != NULL)
+    {
+        cJSON_free(to_members);
+    }
+}
+
+static void create_patches(cJSON * const patches, const unsigned char * const path, const cJSON * const from, const subtree_summary * const from_summary, const cJSON * const to, const subtree_summary * const to_summary, const cJSON_bool case_sensitive)
+{
+    if ((from->type & 0xFF) != (to->type & 0xFF))
+    {
+        compose_patch(patches, (const unsigned char*)"replace", path, 0, to);
+        return;
+    }
+
+    switch (from->type & 0xFF)
+    {
+        case cJSON_Number:
+            if ((from->valueint != to->valueint) || !compare_double(from->valuedouble, to->valuedouble))
+            {
+                compose_patch(patches, (const unsigned char*)"replace", path, NULL, to);
+            }
+            return;
+
+        case cJSON_String:
+            if (strcmp(from->valuestring, to->valuestring) != 0)
+            {
+                compose_patch(patches, (const unsigned char*)"replace", path, NULL, to);
+            }
+            return;
+
+        case cJSON_Array:
+            /* identical subtrees need no patches, the hashes rule most differing ones out right away */
+            if (!equal_subtrees(from, from_summary, to, to_summary, case_sensitive))
+            {
+                create_array_patches(patches, path, from, from_summary, to, to_summary, case_sensitive);
+            }
+            return;
+
+        case cJSON_Object:
+            if (!equal_subtrees(from, from_summary, to, to_summary, case_sensitive))
+            {
+                create_object_patches(patches, path, from, from_summary, to, to_summary, case_sensitive);
+            }
+            return;
+
+        default:
+            break;
+    }
+}
+
+static cJSON *generate_patches(const cJSON * const from, const cJSON * const to, const cJSON_bool case_sensitive)
+{
+    cJSON *patches = NULL;
+    subtree_summary *summaries = NULL;
+    size_t from_size = 0;
+
+    if ((from == NULL) || (to == NULL))
+    {
+        return NULL;
+    }
+
+    from_size = count_items(from);
+    summaries = (subtree_summary*)cJSON_malloc((from_size + count_items(to)) * sizeof(subtree_summary));
+    if (summaries == NULL)
+    {
+        return NULL;
+    }
+    summarize(from, summaries, case_sensitive);
+    summarize(to, summaries + from_size, case_sensitive);
+
+    patches = cJSON_CreateArray();
+    if (patches != NULL)
+    {
+        create_patches(patches, (const unsigned char*)"", from, summaries, to, summaries + from_size, case_sensitive);
+    }
+    cJSON_free(summaries);
+
+    return patches;
+}
+
+CJSON_PUBLIC(cJSON *) cJSONUtils_GeneratePatches(cJSON * const from, cJSON * const to)
+{
+    return generate_patches(from, to, false);
+}
+
+CJSON_PUBLIC(cJSON *) cJSONUtils_GeneratePatchesCaseSensitive(cJSON * const from, cJSON * const to)
+{
+    return generate_patches(from, to, true);
+}
+
+CJSON_PUBLIC(void) cJSONUtils_SortObject(cJSON * const object)
+{
+    sort_object(object, false);
+}
+
+CJSON_PUBLIC(void) cJSONUtils_SortObjectCaseSensitive(cJSON * const object)
+{
+    sort_object(object, true);
+}
+
+static cJSON *merge_patch(cJSON *target, const cJSON * const patch, const cJSON_bool case_sensitive)
+{
+    cJSON *patch_child = NULL;
+
+    if (!cJSON_IsObject(patch))
+    {
+        /* scalar value, array or NULL, just duplicate */
+        cJSON_Delete(target);
+        return cJSON_Duplicate(patch, 1);
+    }
+
+    if (!cJSON_IsObject(target))
+    {
+        cJSON_Delete(target);
+        target = cJSON_CreateObject();
+    }
+
+    patch_child = patch->child;
+    while (patch_child != NULL)
+    {
+        if (cJSON_IsNull(patch_child))
+        {
+            /* NULL is the indicator to remove a value, see RFC7396 */
+            if (case_sensitive)
+            {
+                cJSON_DeleteItemFromObjectCaseSensitive(target, patch_child->string);
+            }
+            else
+            {
+                cJSON_DeleteItemFromObject(target, patch_child->string);
+            }
+        }
+        else
+        {
+            cJSON *replace_me = NULL;
+            cJSON *replacement = NULL;
+
+            if (case_sensitive)
+            {
+                replace_me = cJSON_DetachItemFromObjectCaseSensitive(target, patch_child->string);
+            }
+            else
+            {
+                replace_me = cJSON_DetachItemFromObject(target, patch_child->string);
+            }
+
+            replacement = merge_patch(replace_me, patch_child, case_sensitive);
+            if (replacement == NULL)
+            {
+                cJSON_Delete(target);
+                return NULL;
+            }
+
+            cJSON_AddItemToObject(target, patch_child->string, replacement);
+        }
+        patch_child = patch_child->next;
+    }
+    return target;
+}
+
+CJSON_PUBLIC(cJSON *) cJSONUtils_MergePatch(cJSON *target, const cJSON * const patch)
+{
+    return merge_patch(target, patch, false);
+}
+
+CJSON_PUBLIC(cJSON *) cJSONUtils_MergePatchCaseSensitive(cJSON *target, const cJSON * const patch)
+{
+    return merge_patch(target, patch, true);
+}
+
+static cJSON *generate_merge_patch(cJSON * const from, cJSON * const to, const cJSON_bool case_sensitive)
+{
+    cJSON *from_child = NULL;
+    cJSON *to_child = NULL;
+    cJSON *patch = NULL;
+    if (to == NULL)
+    {
+        /* patch to delete everything */
+        return cJSON_CreateNull();
+    }
+    if (!cJSON_IsObject(to) || !cJSON_IsObject(from))
+    {
+        return cJSON_Duplicate(to, 1);
+    }
+
+    sort_object(from, case_sensitive);
+    sort_object(to, case_sensitive);
+
+    from_child = from->child;
+    to_child = to->child;
+    patch = cJSON_CreateObject();
+    if (patch == NULL)
+    {
+        return NULL;
+    }
+    while (from_child || to_child)
+    {
+        int diff;
+        if (from_child != NULL)
+        {
+            if (to_child != NULL)
+            {
+                diff = strcmp(from_child->string, to_child->string);
+            }
+            else
+            {
+                diff = -1;
+            }
+        }
+        else
+        {
+            diff = 1;
+        }
+
+        if (diff < 0)
+        {
+            /* from has a value that to doesn't have -> remove */
+            cJSON_AddItemToObject(patch, from_child->string, cJSON_CreateNull());
+
+            from_child = from_child->next;
+        }
+        else if (diff > 0)
+        {
+            /* to has a value that from doesn't have -> add to patch */
+            cJSON_AddItemToObject(patch, to_child->string, cJSON_Duplicate(to_child, 1));
+
+            to_child = to_child->next;
+        }
+        else
+        {
+            /* object key exists in both objects */
+            if (!compare_json(from_child, to_child, case_sensitive))
+            {
+                /* not identical --> generate a patch */
+                cJSON_AddItemToObject(patch, to_child->string, cJSONUtils_GenerateMergePatch(from_child, to_child));
+            }
+
+            /* next key in the object */
+            from_child = from_child->next;
+            to_child = to_child->next;
+        }
+    }
+    if (patch->child == NULL)
+    {
+        /* no patch generated */
+        cJSON_Delete(patch);
+        return NULL;
+    }
+
+    return patch;
+}
+
+CJSON_PUBLIC(cJSON *) cJSONUtils_GenerateMergePatch(cJSON * const from, cJSON * const to)
+{
+    return generate_merge_patch(from, to, false);
+}
+
+CJSON_PUBLIC(cJSON *) cJSONUtils_GenerateMergePatchCaseSensitive(cJSON * const from, cJSON * const to)
+{
+    return generate_merge_patch(from, to, true);
+}
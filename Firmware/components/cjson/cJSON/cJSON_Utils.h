@@ -33,9 +33,19 @@ extern "C"
 /* Implement RFC6901 (https://tools.ietf.org/html/rfc6901) JSON Pointer spec. */
 CJSON_PUBLIC(cJSON *) cJSONUtils_GetPointer(cJSON * const object, const char *pointer);
 CJSON_PUBLIC(cJSON *) cJSONUtils_GetPointerCaseSensitive(cJSON * const object, const char *pointer);
+/* A pointer decoded once by cJSONUtils_CompilePointer: its tokens are unescaped, array indices parsed and member
+ * names hashed, so resolving the same path again and again skips all of that. It resolves exactly like
+ * cJSONUtils_GetPointer, also for pointers that aren't valid RFC6901: without a leading '/' it is the object itself
+ * and a token with an invalid escape sequence matches nothing. Returns NULL if pointer is NULL or out of memory. */
+typedef struct cJSONUtils_Pointer cJSONUtils_Pointer;
+CJSON_PUBLIC(cJSONUtils_Pointer *) cJSONUtils_CompilePointer(const char *pointer);
+CJSON_PUBLIC(cJSON *) cJSONUtils_GetCompiledPointer(cJSON * const object, const cJSONUtils_Pointer * const pointer);
+CJSON_PUBLIC(cJSON *) cJSONUtils_GetCompiledPointerCaseSensitive(cJSON * const object, const cJSONUtils_Pointer * const pointer);
+CJSON_PUBLIC(void) cJSONUtils_DeletePointer(cJSONUtils_Pointer *pointer);
 
 /* Implement RFC6902 (https://tools.ietf.org/html/rfc6902) JSON Patch spec. */
-/* NOTE: This modifies objects in 'from' and 'to' by sorting the elements by their key */
+/* 'from' and 'to' are left as they are. Identical subtrees are skipped by their structural hash and arrays get
+ * a shortest edit script of removals and insertions, so an element added to the front is a single "add". */
 CJSON_PUBLIC(cJSON *) cJSONUtils_GeneratePatches(cJSON * const from, cJSON * const to);
 CJSON_PUBLIC(cJSON *) cJSONUtils_GeneratePatchesCaseSensitive(cJSON * const from, cJSON * const to);
 /* Utility for generating patch array entries. */
@@ -43,6 +53,10 @@ CJSON_PUBLIC(void) cJSONUtils_AddPatchToArray(cJSON * const array, const char *
 /* Returns 0 for success. */
 CJSON_PUBLIC(int) cJSONUtils_ApplyPatches(cJSON * const object, const cJSON * const patches);
 CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesCaseSensitive(cJSON * const object, const cJSON * const patches);
+/* All or nothing: if an operation fails, the ones before it are rolled back and 'object' is left as it was. The changes
+ * are recorded in an undo log, so this costs about as much as the operations themselves instead of a copy of 'object'. */
+CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesTransactional(cJSON * const object, const cJSON * const patches);
+CJSON_PUBLIC(int) cJSONUtils_ApplyPatchesTransactionalCaseSensitive(cJSON * const object, const cJSON * const patches);
 
 /*
 // Note that ApplyPatches is NOT atomic on failure. To implement an atomic ApplyPatches, use:
@@ -0,0 +1,987 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <math.h>
+
+#include "../benchmarks/common.h"
+
+#ifdef CJSON_COMPLEXITY_UTILS
+#include "../cJSON_Utils.h"
+#endif
+
+/* Worst case complexity harness: the fuzzers only find crashes, this finds latency and memory cliffs.
+ *
+ * usage: complexity [--corpus directory] [--filter text]
+ *
+ * Every case generates an adversarial input at four sizes, each twice as large as the one before, and measures
+ * the time and the peak heap of one operation on it per input byte. From the smallest to the largest input the
+ * cost of a linear operation grows like the input, the growth exponent is about 1. A case that grows faster than
+ * MAX_EXPONENT is super-linear: an untrusted peer can stall the ingest path with a few kilobytes.
+ *
+ * Cases that are known to be super-linear are reported but don't fail, the harness only fails when a case that
+ * should be linear isn't. */
+
+#define MAX_EXPONENT 1.5
+#define SIZE_STEPS 4
+
+typedef enum
+{
+    complexity_linear,
+    complexity_known_superlinear
+} complexity_expectation;
+
+/* the input of one measurement, tree is json already parsed for the operations that don't parse */
+typedef struct
+{
+    char *json;
+    size_t length;
+    cJSON *tree;
+    cJSON *other; /* a second tree, for comparing and diffing */
+    char *scratch;
+} complexity_input;
+
+/* writes an input of about size bytes */
+typedef char *(*complexity_generator)(size_t size);
+/* returns 0 when the operation failed */
+typedef cJSON_bool (*complexity_operation)(complexity_input *input);
+
+typedef struct
+{
+    const char *name;
+    complexity_generator generate;
+    complexity_operation run;
+    size_t max_size;
+    complexity_expectation expectation;
+} complexity_case;
+
+typedef struct
+{
+    size_t length;
+    double seconds;
+    size_t peak;
+} complexity_sample;
+
+static const char *corpus = CJSON_COMPLEXITY_CORPUS;
+
+/* text builder for the generators, plain malloc so that inputs don't count as heap usage */
+typedef struct
+{
+    char *buffer;
+    size_t length;
+    size_t size;
+} text;
+
+static cJSON_bool text_init(text *output, size_t size)
+{
+    output->size = size + 64;
+    output->length = 0;
+    output->buffer = (char*)malloc(output->size);
+
+    return output->buffer != NULL;
+}
+
+static void text_append(text *output, const char *string, size_t length)
+{
+    if ((output->buffer == NULL) || ((output->length + length + 1) > output->size))
+    {
+        char *grown = NULL;
+
+        output->size = (output->size + length) * 2;
+        grown = (char*)realloc(output->buffer, output->size);
+        if (grown == NULL)
+        {
+            free(output->buffer);
+            output->buffer = NULL;
+            return;
+        }
+        output->buffer = grown;
+    }
+
+    memcpy(output->buffer + output->length, string, length);
+    output->length += length;
+    output->buffer[output->length] = '\0';
+}
+
+static void text_put(text *output, const char *string)
+{
+    text_append(output, string, strlen(string));
+}
+
+/* [[[...]]], as deep as the size allows */
+static char *generate_nested_arrays(size_t size)
+{
+    text output;
+    size_t depth = size / 2;
+    size_t i = 0;
+
+    if (!text_init(&output, size))
+    {
+        return NULL;
+    }
+    for (i = 0; i < depth; i++)
+    {
+        text_put(&output, "[");
+    }
+    for (i = 0; i < depth; i++)
+    {
+        text_put(&output, "]");
+    }
+
+    return output.buffer;
+}
+
+/* {"a":{"a":...{}}}, the innermost object is the last level the parser allows */
+static char *generate_nested_objects(size_t size)
+{
+    text output;
+    size_t depth = size / 6;
+    size_t i = 0;
+
+    if (depth >= CJSON_NESTING_LIMIT)
+    {
+        depth = CJSON_NESTING_LIMIT - 1;
+    }
+    if (!text_init(&output, size))
+    {
+        return NULL;
+    }
+    for (i = 0; i < depth; i++)
+    {
+        text_put(&output, "{\"a\":");
+    }
+    text_put(&output, "{}");
+    for (i = 0; i < depth; i++)
+    {
+        text_put(&output, "}");
+    }
+
+    return output.buffer;
+}
+
+static char *generate_repeated_string(size_t size, const char *run)
+{
+    text output;
+    size_t run_length = strlen(run);
+
+    if (!text_init(&output, size))
+    {
+        return NULL;
+    }
+    text_put(&output, "\"");
+    while (output.length < size)
+    {
+        text_append(&output, run, run_length);
+    }
+    text_put(&output, "\"");
+
+    return output.buffer;
+}
+
+static char *generate_long_string(size_t size)
+{
+    return generate_repeated_string(size, "abcdefghijklmnopqrstuvwxyz012345");
+}
+
+/* the closing quote is missing, the parser only finds out at the end */
+static char *generate_unterminated_string(size_t size)
+{
+    char *json = generate_long_string(size);
+
+    if (json != NULL)
+    {
+        json[strlen(json) - 1] = '\0';
+    }
+
+    return json;
+}
+
+static char *generate_escapes(size_t size)
+{
+    return generate_repeated_string(size, "\\n\\t\\\"\\\\\\/\\b\\f\\r\\u0001");
+}
+
+/* surrogate pairs, and lone high surrogates that have to be rejected once the whole run is decoded */
+static char *generate_surrogates(size_t size)
+{
+    return generate_repeated_string(size, "\\ud83d\\ude00\\uD834\\uDD1E");
+}
+
+/* one number with size digits */
+static char *generate_huge_number(size_t size)
+{
+    text output;
+
+    if (!text_init(&output, size))
+    {
+        return NULL;
+    }
+    text_put(&output, "-1");
+    while (output.length < size)
+    {
+        text_put(&output, "2345678901");
+    }
+    text_put(&output, ".5e-3");
+
+    return output.buffer;
+}
+
+/* an array of numbers that are too long for the fast path */
+static char *generate_long_numbers(size_t size)
+{
+    text output;
+
+    if (!text_init(&output, size))
+    {
+        return NULL;
+    }
+    text_put(&output, "[");
+    while (output.length < size)
+    {
+        if (output.length > 1)
+        {
+            text_put(&output, ",");
+        }
+        text_put(&output, "3.14159265358979323846264338327950288419716939937510582097494459230781640628e-300");
+    }
+    text_put(&output, "]");
+
+    return output.buffer;
+}
+
+static char *generate_wide_array(size_t size)
+{
+    text output;
+    char number[32];
+    size_t i = 0;
+
+    if (!text_init(&output, size))
+    {
+        return NULL;
+    }
+    text_put(&output, "[");
+    for (i = 0; output.length < size; i++)
+    {
+        sprintf(number, (i == 0) ? "%lu" : ",%lu", (unsigned long)i);
+        text_put(&output, number);
+    }
+    text_put(&output, "]");
+
+    return output.buffer;
+}
+
+/* thousands of members with the same key */
+static char *generate_duplicate_keys(size_t size)
+{
+    text output;
+    size_t i = 0;
+
+    if (!text_init(&output, size))
+    {
+        return NULL;
+    }
+    text_put(&output, "{");
+    for (i = 0; output.length < size; i++)
+    {
+        text_put(&output, (i == 0) ? "\"key\":0" : ",\"key\":0");
+    }
+    text_put(&output, "}");
+
+    return output.buffer;
+}
+
+/* distinct keys in descending order, the worst order for sorting */
+static char *generate_distinct_keys(size_t size)
+{
+    text output;
+    char member[48];
+    size_t count = size / 16;
+    size_t i = 0;
+
+    if (!text_init(&output, size))
+    {
+        return NULL;
+    }
+    text_put(&output, "{");
+    for (i = count; i > 0; i--)
+    {
+        sprintf(member, (i == count) ? "\"key%08lu\":%lu" : ",\"key%08lu\":%lu", (unsigned long)i, (unsigned long)i);
+        text_put(&output, member);
+    }
+    text_put(&output, "}");
+
+    return output.buffer;
+}
+
+/* Keys whose hashes agree in the low colliding_bits bits, so that they all want the same slot of any table up to
+ * that size. The key table and the object index hash with FNV-1a, the keys only use lower case letters and digits
+ * so that case folding doesn't change it. The low bits of FNV-1a only depend on the low bits of its state, so two
+ * blocks that take one state to the same one can stand in for each other: a key of colliding_blocks positions with
+ * two such blocks each is one of 2^colliding_blocks keys with the same low bits. */
+#define colliding_bits 20
+#define colliding_blocks 16
+#define block_length 3
+
+static char collision_blocks[colliding_blocks][2][block_length + 1];
+static cJSON_bool collision_blocks_found = 0;
+
+static unsigned long fnv1a(unsigned long hash, const char *bytes, size_t length)
+{
+    for (; length > 0; bytes++, length--)
+    {
+        hash ^= (unsigned long)(unsigned char)*bytes;
+        hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
+    }
+
+    return hash;
+}
+
+/* a birthday search over the blocks of every position, about a thousand blocks each */
+static cJSON_bool find_collision_blocks(void)
+{
+    static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+    const unsigned long mask = (1UL << colliding_bits) - 1;
+    const size_t letters = sizeof(alphabet) - 1;
+    const size_t candidates = letters * letters * letters;
+    unsigned long *hashes = NULL;
+    unsigned long state = 2166136261UL;
+    size_t position = 0;
+
+    hashes = (unsigned long*)malloc(candidates * sizeof(unsigned long));
+    if (hashes == NULL)
+    {
+        return 0;
+    }
+
+    for (position = 0; position < colliding_blocks; position++)
+    {
+        char block[block_length + 1];
+        size_t candidate = 0;
+        size_t other = 0;
+        cJSON_bool found = 0;
+
+        block[block_length] = '\0';
+        for (candidate = 0; (candidate < candidates) && !found; candidate++)
+        {
+            block[0] = alphabet[candidate % letters];
+            block[1] = alphabet[(candidate / letters) % letters];
+            block[2] = alphabet[candidate / (letters * letters)];
+            hashes[candidate] = fnv1a(state, block, block_length) & mask;
+            for (other = 0; other < candidate; other++)
+            {
+                if (hashes[other] == hashes[candidate])
+                {
+                    found = 1;
+                    break;
+                }
+            }
+        }
+        if (!found)
+        {
+            free(hashes);
+            return 0;
+        }
+
+        candidate--;
+        memcpy(collision_blocks[position][0], block, sizeof(block));
+        collision_blocks[position][1][0] = alphabet[other % letters];
+        collision_blocks[position][1][1] = alphabet[(other / letters) % letters];
+        collision_blocks[position][1][2] = alphabet[other / (letters * letters)];
+        collision_blocks[position][1][block_length] = '\0';
+        state = fnv1a(state, block, block_length);
+    }
+
+    free(hashes);
+    collision_blocks_found = 1;
+
+    return 1;
+}
+
+static char *generate_colliding_keys(size_t size)
+{
+    text output;
+    unsigned long i = 0;
+    size_t position = 0;
+
+    if ((!collision_blocks_found && !find_collision_blocks()) || !text_init(&output, size))
+    {
+        return NULL;
+    }
+    text_put(&output, "{");
+    for (i = 0; (output.length < size) && (i < (1UL << colliding_blocks)); i++)
+    {
+        text_put(&output, (i == 0) ? "\"" : ",\"");
+        for (position = 0; position < colliding_blocks; position++)
+        {
+            text_put(&output, collision_blocks[position][(i >> position) & 1]);
+        }
+        text_put(&output, "\":0");
+    }
+    text_put(&output, "}");
+
+    return output.buffer;
+}
+
+/* the seeds of the fuzzing corpus in one array, repeated until it has the size */
+static char *generate_fuzzing_corpus(size_t size)
+{
+    text output;
+    char path[1024];
+    char *seeds[16];
+    size_t seed_lengths[16];
+    size_t seed_count = 0;
+    size_t i = 0;
+
+    if ((strlen(corpus) > (sizeof(path) - 16)) || !text_init(&output, size))
+    {
+        return NULL;
+    }
+
+    for (i = 1; i <= 16; i++)
+    {
+        FILE *file = NULL;
+        char buffer[8192];
+        size_t length = 0;
+        cJSON *seed = NULL;
+
+        sprintf(path, "%s/test%lu", corpus, (unsigned long)i);
+        file = fopen(path, "rb");
+        if (file == NULL)
+        {
+            continue;
+        }
+        length = fread(buffer, 1, sizeof(buffer) - 1, file);
+        fclose(file);
+        /* afl inputs start with two option characters, and not all of them are valid JSON */
+        if (length <= 2)
+        {
+            continue;
+        }
+        buffer[length] = '\0';
+        seed = cJSON_Parse(buffer + 2);
+        if (seed == NULL)
+        {
+            continue;
+        }
+        seeds[seed_count] = cJSON_PrintUnformatted(seed);
+        cJSON_Delete(seed);
+        if (seeds[seed_count] != NULL)
+        {
+            seed_lengths[seed_count] = strlen(seeds[seed_count]);
+            seed_count++;
+        }
+    }
+
+    text_put(&output, "[");
+    for (i = 0; (seed_count > 0) && (output.length < size); i++)
+    {
+        if (i > 0)
+        {
+            text_put(&output, ",");
+        }
+        text_append(&output, seeds[i % seed_count], seed_lengths[i % seed_count]);
+    }
+    text_put(&output, "]");
+
+    for (i = 0; i < seed_count; i++)
+    {
+        cJSON_free(seeds[i]);
+    }
+    if (seed_count == 0)
+    {
+        free(output.buffer);
+        return NULL;
+    }
+
+    return output.buffer;
+}
+
+static cJSON_bool run_parse(complexity_input *input)
+{
+    cJSON *tree = cJSON_ParseWithLength(input->json, input->length);
+
+    if (tree == NULL)
+    {
+        return 0;
+    }
+    cJSON_Delete(tree);
+
+    return 1;
+}
+
+/* a new table for every run, so that every distinct key is interned */
+static cJSON_bool run_parse_with_key_table(complexity_input *input)
+{
+    cJSON_KeyTable *table = cJSON_CreateKeyTable(0);
+    cJSON *tree = NULL;
+    cJSON_bool parsed = 0;
+
+    if (table == NULL)
+    {
+        return 0;
+    }
+    tree = cJSON_ParseWithKeyTable(input->json, input->length, table);
+    parsed = (tree != NULL) ? 1 : 0;
+    cJSON_Delete(tree);
+    cJSON_DeleteKeyTable(table);
+
+    return parsed;
+}
+
+/* the input has to be rejected, but only after it was read completely */
+static cJSON_bool run_parse_rejected(complexity_input *input)
+{
+    cJSON *tree = cJSON_ParseWithLength(input->json, input->length);
+
+    if (tree != NULL)
+    {
+        cJSON_Delete(tree);
+        return 0;
+    }
+
+    return 1;
+}
+
+static cJSON_bool run_print(complexity_input *input)
+{
+    char *printed = cJSON_PrintUnformatted(input->tree);
+
+    if (printed == NULL)
+    {
+        return 0;
+    }
+    cJSON_free(printed);
+
+    return 1;
+}
+
+static cJSON_bool run_print_formatted(complexity_input *input)
+{
+    char *printed = cJSON_Print(input->tree);
+
+    if (printed == NULL)
+    {
+        return 0;
+    }
+    cJSON_free(printed);
+
+    return 1;
+}
+
+static cJSON_bool run_minify(complexity_input *input)
+{
+    memcpy(input->scratch, input->json, input->length + 1);
+    cJSON_Minify(input->scratch);
+
+    return 1;
+}
+
+static cJSON_bool run_duplicate(complexity_input *input)
+{
+    cJSON *copy = cJSON_Duplicate(input->tree, 1);
+
+    if (copy == NULL)
+    {
+        return 0;
+    }
+    cJSON_Delete(copy);
+
+    return 1;
+}
+
+static cJSON_bool run_duplicate_compact(complexity_input *input)
+{
+    cJSON *copy = cJSON_DuplicateCompact(input->tree);
+
+    if (copy == NULL)
+    {
+        return 0;
+    }
+    cJSON_DeleteCompact(copy);
+
+    return 1;
+}
+
+static cJSON_bool run_compare(complexity_input *input)
+{
+    return cJSON_Compare(input->tree, input->other, 1);
+}
+
+/* a consumer that reads every member by name */
+static cJSON_bool run_get_every_item(complexity_input *input)
+{
+    const cJSON *member = NULL;
+
+    cJSON_ArrayForEach(member, input->tree)
+    {
+        if (cJSON_GetObjectItem(input->tree, member->string) == NULL)
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/* the last of the duplicates, case insensitive, is as far away as it gets */
+static cJSON_bool run_get_missing_item(complexity_input *input)
+{
+    return cJSON_GetObjectItem(input->tree, "KEY_") == NULL;
+}
+
+/* builds the index of the object again, a no-op without ENABLE_CJSON_INDEX */
+static cJSON_bool run_index_lookup(complexity_input *input)
+{
+    cJSON_bool missing = 0;
+
+    cJSON_InvalidateIndex(input->tree);
+    cJSON_SetIndexThreshold(16);
+    missing = (cJSON_GetObjectItemCaseSensitive(input->tree, "missing") == NULL);
+    cJSON_SetIndexThreshold(0);
+
+    return missing;
+}
+
+#ifdef CJSON_COMPLEXITY_UTILS
+static cJSON_bool run_sort_object(complexity_input *input)
+{
+    cJSON *copy = cJSON_Duplicate(input->tree, 1);
+
+    if (copy == NULL)
+    {
+        return 0;
+    }
+    cJSONUtils_SortObjectCaseSensitive(copy);
+    cJSON_Delete(copy);
+
+    return 1;
+}
+
+static cJSON_bool run_generate_patches(complexity_input *input)
+{
+    cJSON *patches = cJSONUtils_GeneratePatchesCaseSensitive(input->tree, input->other);
+    cJSON_bool success = (patches != NULL);
+
+    cJSON_Delete(patches);
+
+    return success;
+}
+
+/* one replace operation per member */
+static cJSON_bool run_apply_patches(complexity_input *input)
+{
+    cJSON *target = cJSON_Duplicate(input->tree, 1);
+    cJSON_bool success = 0;
+
+    if (target != NULL)
+    {
+        success = (cJSONUtils_ApplyPatchesCaseSensitive(target, input->other) == 0);
+    }
+    cJSON_Delete(target);
+
+    return success;
+}
+#endif
+
+static const complexity_case cases[] =
+{
+    { "parse nested arrays", generate_nested_arrays, run_parse, 2 * CJSON_NESTING_LIMIT, complexity_linear },
+    { "parse nested objects", generate_nested_objects, run_parse, 6 * CJSON_NESTING_LIMIT, complexity_linear },
+    { "print nested objects", generate_nested_objects, run_print, 6 * CJSON_NESTING_LIMIT, complexity_linear },
+    /* one tab per level on every line, bounded by the nesting limit */
+    { "print formatted nested objects", generate_nested_objects, run_print_formatted, 6 * CJSON_NESTING_LIMIT, complexity_known_superlinear },
+    { "duplicate compact nested objects", generate_nested_objects, run_duplicate_compact, 6 * CJSON_NESTING_LIMIT, complexity_linear },
+    { "parse long string", generate_long_string, run_parse, 1 << 20, complexity_linear },
+    { "print long string", generate_long_string, run_print, 1 << 20, complexity_linear },
+    { "reject unterminated string", generate_unterminated_string, run_parse_rejected, 1 << 20, complexity_linear },
+    { "parse escapes", generate_escapes, run_parse, 1 << 20, complexity_linear },
+    { "print escapes", generate_escapes, run_print, 1 << 20, complexity_linear },
+    { "print formatted escapes", generate_escapes, run_print_formatted, 1 << 20, complexity_linear },
+    { "minify escapes", generate_escapes, run_minify, 1 << 20, complexity_linear },
+    { "parse surrogates", generate_surrogates, run_parse, 1 << 20, complexity_linear },
+    { "print surrogates", generate_surrogates, run_print, 1 << 20, complexity_linear },
+    { "parse huge number", generate_huge_number, run_parse, 1 << 18, complexity_linear },
+    { "parse long numbers", generate_long_numbers, run_parse, 1 << 20, complexity_linear },
+    { "parse wide array", generate_wide_array, run_parse, 1 << 20, complexity_linear },
+    { "print wide array", generate_wide_array, run_print, 1 << 20, complexity_linear },
+    { "duplicate wide array", generate_wide_array, run_duplicate, 1 << 20, complexity_linear },
+    { "duplicate compact wide array", generate_wide_array, run_duplicate_compact, 1 << 20, complexity_linear },
+    { "compare wide array", generate_wide_array, run_compare, 1 << 20, complexity_linear },
+    { "parse duplicate keys", generate_duplicate_keys, run_parse, 1 << 20, complexity_linear },
+    { "get missing item of duplicate keys", generate_duplicate_keys, run_get_missing_item, 1 << 20, complexity_linear },
+    { "parse duplicate keys with key table", generate_duplicate_keys, run_parse_with_key_table, 1 << 20, complexity_linear },
+    { "parse distinct keys", generate_distinct_keys, run_parse, 1 << 20, complexity_linear },
+    { "parse distinct keys with key table", generate_distinct_keys, run_parse_with_key_table, 1 << 20, complexity_linear },
+    { "duplicate distinct keys", generate_distinct_keys, run_duplicate, 1 << 20, complexity_linear },
+    { "parse colliding keys", generate_colliding_keys, run_parse, 1 << 20, complexity_linear },
+    { "parse colliding keys with key table", generate_colliding_keys, run_parse_with_key_table, 1 << 20, complexity_linear },
+    { "index lookup in distinct keys", generate_distinct_keys, run_index_lookup, 1 << 20, complexity_linear },
+    { "index lookup in colliding keys", generate_colliding_keys, run_index_lookup, 1 << 20, complexity_linear },
+    /* every lookup walks the members */
+    { "get every item of distinct keys", generate_distinct_keys, run_get_every_item, 1 << 15, complexity_known_superlinear },
+    { "compare distinct keys", generate_distinct_keys, run_compare, 1 << 15, complexity_known_superlinear },
+    { "parse fuzzing corpus", generate_fuzzing_corpus, run_parse, 1 << 20, complexity_linear },
+    { "print fuzzing corpus", generate_fuzzing_corpus, run_print, 1 << 20, complexity_linear },
+#ifdef CJSON_COMPLEXITY_UTILS
+    { "sort distinct keys", generate_distinct_keys, run_sort_object, 1 << 20, complexity_linear },
+    { "generate patches of distinct keys", generate_distinct_keys, run_generate_patches, 1 << 18, complexity_linear },
+    { "generate patches of wide array", generate_wide_array, run_generate_patches, 1 << 20, complexity_linear },
+    /* every operation resolves its path from the root */
+    { "apply patches to distinct keys", generate_distinct_keys, run_apply_patches, 1 << 15, complexity_known_superlinear },
+#endif
+    { NULL, NULL, NULL, 0, complexity_linear }
+};
+
+/* the second tree of compare, generate_patches and apply_patches */
+static cJSON *create_other(const complexity_case *test, cJSON *tree)
+{
+#ifdef CJSON_COMPLEXITY_UTILS
+    if (test->run == run_apply_patches)
+    {
+        cJSON *patches = cJSON_CreateArray();
+        const cJSON *member = NULL;
+        char path[64];
+
+        cJSON_ArrayForEach(member, tree)
+        {
+            cJSON *patch = cJSON_CreateObject();
+
+            sprintf(path, "/%s", member->string);
+            cJSON_AddStringToObject(patch, "op", "replace");
+            cJSON_AddStringToObject(patch, "path", path);
+            cJSON_AddNumberToObject(patch, "value", 0);
+            cJSON_AddItemToArray(patches, patch);
+        }
+
+        return patches;
+    }
+    if (test->run == run_generate_patches)
+    {
+        cJSON *other = cJSON_Duplicate(tree, 1);
+        cJSON *member = NULL;
+        size_t i = 0;
+
+        /* arrays shift by one element, which has to stay two operations however long they are */
+        if (cJSON_IsArray(other))
+        {
+            cJSON_InsertItemInArray(other, 0, cJSON_CreateString("first"));
+            cJSON_DeleteItemFromArray(other, cJSON_GetArraySize(other) - 1);
+
+            return other;
+        }
+
+        /* every 16th member changes */
+        cJSON_ArrayForEach(member, other)
+        {
+            if ((i++ % 16) == 0)
+            {
+                cJSON_SetNumberValue(member, -1);
+            }
+        }
+
+        return other;
+    }
+#endif
+    if (test->run == run_compare)
+    {
+        return cJSON_Duplicate(tree, 1);
+    }
+
+    return NULL;
+}
+
+static cJSON_bool measure(const complexity_case *test, size_t size, complexity_sample *sample)
+{
+    complexity_input input;
+    cJSON_bool success = 0;
+    unsigned long iterations = 1;
+    unsigned long i = 0;
+    int trial = 0;
+    size_t baseline = 0;
+    double best = -1;
+    clock_t start;
+
+    memset(&input, '\0', sizeof(input));
+    memset(sample, '\0', sizeof(*sample));
+    input.json = test->generate(size);
+    if (input.json == NULL)
+    {
+        return 0;
+    }
+    input.length = strlen(input.json);
+    input.scratch = (char*)malloc(input.length + 1);
+    input.tree = cJSON_ParseWithLength(input.json, input.length);
+    if (input.tree != NULL)
+    {
+        input.other = create_other(test, input.tree);
+    }
+    if ((input.scratch == NULL) || ((input.tree == NULL) && (test->run != run_parse_rejected)))
+    {
+        goto cleanup;
+    }
+
+    /* the peak heap of one run */
+    baseline = benchmark_live_bytes;
+    reset_peak_bytes();
+    if (!test->run(&input))
+    {
+        goto cleanup;
+    }
+    sample->peak = benchmark_peak_bytes - baseline;
+
+    /* best of three, every one at least 10ms, so that a busy machine doesn't produce a cliff */
+    for (trial = 0; trial < 3; trial++)
+    {
+        double seconds = 0;
+
+        for (;;)
+        {
+            start = clock();
+            for (i = 0; i < iterations; i++)
+            {
+                test->run(&input);
+            }
+            seconds = seconds_since(start);
+            if ((seconds >= 0.01) || (iterations >= 0x40000000UL))
+            {
+                break;
+            }
+            iterations *= 2;
+        }
+        seconds /= (double)iterations;
+        if ((best < 0) || (seconds < best))
+        {
+            best = seconds;
+        }
+    }
+
+    sample->length = input.length;
+    sample->seconds = best;
+    success = 1;
+
+cleanup:
+    cJSON_Delete(input.tree);
+    cJSON_Delete(input.other);
+    free(input.scratch);
+    free(input.json);
+
+    return success;
+}
+
+/* how cost grows with the input: 1 is linear, 2 quadratic */
+static double growth_exponent(double first_cost, double last_cost, const complexity_sample *first, const complexity_sample *last)
+{
+    if ((first_cost <= 0) || (last_cost <= 0) || (last->length <= first->length))
+    {
+        return 0;
+    }
+
+    return log(last_cost / first_cost) / log((double)last->length / (double)first->length);
+}
+
+int CJSON_CDECL main(int argc, char **argv)
+{
+    const char *filter = NULL;
+    const complexity_case *test = NULL;
+    int failures = 0;
+    int i = 0;
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--corpus") == 0) && ((i + 1) < argc))
+        {
+            corpus = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--filter") == 0) && ((i + 1) < argc))
+        {
+            filter = argv[++i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--corpus directory] [--filter text]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    use_tracking_hooks();
+
+    printf("%-40s %10s %12s %12s %8s %8s\n", "case", "bytes", "ns/byte", "heap/byte", "time^", "heap^");
+    for (test = cases; test->name != NULL; test++)
+    {
+        complexity_sample samples[SIZE_STEPS];
+        const complexity_sample *first = &samples[0];
+        const complexity_sample *last = &samples[SIZE_STEPS - 1];
+        double time_exponent = 0;
+        double heap_exponent = 0;
+        const char *verdict = "linear";
+        size_t step = 0;
+
+        if ((filter != NULL) && (strstr(test->name, filter) == NULL))
+        {
+            continue;
+        }
+
+        for (step = 0; step < SIZE_STEPS; step++)
+        {
+            if (!measure(test, test->max_size >> (SIZE_STEPS - 1 - step), &samples[step]))
+            {
+                break;
+            }
+            printf("%-40s %10lu %12.3f %12.3f\n", test->name, (unsigned long)samples[step].length,
+                samples[step].seconds * 1e9 / (double)samples[step].length,
+                (double)samples[step].peak / (double)samples[step].length);
+        }
+        if (step < SIZE_STEPS)
+        {
+            printf("%-40s failed\n", test->name);
+            failures++;
+            continue;
+        }
+
+        time_exponent = growth_exponent(first->seconds, last->seconds, first, last);
+        heap_exponent = growth_exponent((double)first->peak, (double)last->peak, first, last);
+        if ((time_exponent > MAX_EXPONENT) || (heap_exponent > MAX_EXPONENT))
+        {
+            if (test->expectation == complexity_known_superlinear)
+            {
+                verdict = "super-linear (known)";
+            }
+            else
+            {
+                verdict = "SUPER-LINEAR";
+                failures++;
+            }
+        }
+        else if (test->expectation == complexity_known_superlinear)
+        {
+            verdict = "linear (was super-linear)";
+        }
+        printf("%-40s %10s %12s %12s %8.2f %8.2f  %s\n", test->name, "", "", "", time_exponent, heap_exponent, verdict);
+    }
+
+    if (failures > 0)
+    {
+        printf("%d case(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,249 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+/* an array of the numbers 0 to count - 1 */
+static cJSON *create_numbered_array(int count)
+{
+    cJSON *array = cJSON_CreateArray();
+    int i = 0;
+
+    TEST_ASSERT_NOT_NULL(array);
+    for (i = 0; i < count; i++)
+    {
+        TEST_ASSERT_TRUE(cJSON_AddItemToArray(array, cJSON_CreateNumber(i)));
+    }
+
+    return array;
+}
+
+/* indexed access has to agree with the linked list */
+static void assert_index_matches_list(const cJSON * const array)
+{
+    cJSON *child = NULL;
+    int position = 0;
+
+    cJSON_ArrayForEach(child, array)
+    {
+        TEST_ASSERT_TRUE(cJSON_GetArrayItem(array, position) == child);
+        position++;
+    }
+    TEST_ASSERT_EQUAL_INT(position, cJSON_GetArraySize(array));
+    TEST_ASSERT_NULL(cJSON_GetArrayItem(array, position));
+    TEST_ASSERT_NULL(cJSON_GetArrayItem(array, -1));
+}
+
+static void array_index_should_be_built_on_first_access_of_large_arrays(void)
+{
+    cJSON *small = create_numbered_array(15);
+    cJSON *large = create_numbered_array(16);
+
+    cJSON_SetIndexThreshold(16);
+    TEST_ASSERT_EQUAL_INT(15, cJSON_GetArraySize(small));
+    TEST_ASSERT_NULL(small->index);
+
+    TEST_ASSERT_EQUAL_INT(16, cJSON_GetArraySize(large));
+    TEST_ASSERT_NOT_NULL(large->index);
+    assert_index_matches_list(small);
+    assert_index_matches_list(large);
+    TEST_ASSERT_EQUAL_DOUBLE(7, cJSON_GetArrayItem(large, 7)->valuedouble);
+
+    cJSON_Delete(small);
+    cJSON_Delete(large);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void array_index_should_be_kept_up_to_date_when_appending(void)
+{
+    cJSON *array = create_numbered_array(16);
+    int i = 0;
+
+    cJSON_SetIndexThreshold(16);
+    assert_index_matches_list(array);
+
+    for (i = 16; i < 1000; i++)
+    {
+        TEST_ASSERT_TRUE(cJSON_AddItemToArray(array, cJSON_CreateNumber(i)));
+        TEST_ASSERT_EQUAL_INT(i + 1, cJSON_GetArraySize(array));
+        TEST_ASSERT_EQUAL_DOUBLE(i, cJSON_GetArrayItem(array, i)->valuedouble);
+    }
+    assert_index_matches_list(array);
+
+    cJSON_Delete(array);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void array_index_should_be_kept_up_to_date_when_inserting(void)
+{
+    cJSON *array = create_numbered_array(16);
+    cJSON_Index *index = NULL;
+
+    cJSON_SetIndexThreshold(16);
+    assert_index_matches_list(array);
+    index = array->index;
+
+    TEST_ASSERT_TRUE(cJSON_InsertItemInArray(array, 0, cJSON_CreateString("first")));
+    TEST_ASSERT_TRUE(cJSON_InsertItemInArray(array, 8, cJSON_CreateString("middle")));
+    TEST_ASSERT_TRUE(cJSON_InsertItemInArray(array, 18, cJSON_CreateString("last")));
+    TEST_ASSERT_TRUE(array->index == index);
+
+    TEST_ASSERT_EQUAL_STRING("first", cJSON_GetArrayItem(array, 0)->valuestring);
+    TEST_ASSERT_EQUAL_STRING("middle", cJSON_GetArrayItem(array, 8)->valuestring);
+    TEST_ASSERT_EQUAL_STRING("last", cJSON_GetArrayItem(array, 18)->valuestring);
+    assert_index_matches_list(array);
+
+    cJSON_Delete(array);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void array_index_should_be_kept_up_to_date_when_deleting(void)
+{
+    cJSON *array = create_numbered_array(32);
+    cJSON *detached = NULL;
+
+    cJSON_SetIndexThreshold(16);
+    assert_index_matches_list(array);
+
+    cJSON_DeleteItemFromArray(array, 0);
+    cJSON_DeleteItemFromArray(array, 10);
+    cJSON_DeleteItemFromArray(array, 29);
+    TEST_ASSERT_NOT_NULL(array->index);
+    TEST_ASSERT_EQUAL_INT(29, cJSON_GetArraySize(array));
+    TEST_ASSERT_EQUAL_DOUBLE(1, cJSON_GetArrayItem(array, 0)->valuedouble);
+    TEST_ASSERT_EQUAL_DOUBLE(12, cJSON_GetArrayItem(array, 10)->valuedouble);
+    TEST_ASSERT_EQUAL_DOUBLE(30, cJSON_GetArrayItem(array, 28)->valuedouble);
+    assert_index_matches_list(array);
+
+    detached = cJSON_DetachItemViaPointer(array, cJSON_GetArrayItem(array, 5));
+    TEST_ASSERT_EQUAL_DOUBLE(6, detached->valuedouble);
+    cJSON_Delete(detached);
+    assert_index_matches_list(array);
+
+    while (cJSON_GetArraySize(array) > 0)
+    {
+        cJSON_DeleteItemFromArray(array, cJSON_GetArraySize(array) / 2);
+        assert_index_matches_list(array);
+    }
+    TEST_ASSERT_NULL(array->child);
+
+    cJSON_Delete(array);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void array_index_should_be_kept_up_to_date_when_replacing(void)
+{
+    cJSON *array = create_numbered_array(16);
+    cJSON_Index *index = NULL;
+
+    cJSON_SetIndexThreshold(16);
+    assert_index_matches_list(array);
+    index = array->index;
+
+    TEST_ASSERT_TRUE(cJSON_ReplaceItemInArray(array, 0, cJSON_CreateString("first")));
+    TEST_ASSERT_TRUE(cJSON_ReplaceItemInArray(array, 15, cJSON_CreateString("last")));
+    TEST_ASSERT_TRUE(cJSON_ReplaceItemViaPointer(array, cJSON_GetArrayItem(array, 7), cJSON_CreateString("middle")));
+    TEST_ASSERT_TRUE(array->index == index);
+
+    TEST_ASSERT_EQUAL_STRING("first", cJSON_GetArrayItem(array, 0)->valuestring);
+    TEST_ASSERT_EQUAL_STRING("middle", cJSON_GetArrayItem(array, 7)->valuestring);
+    TEST_ASSERT_EQUAL_STRING("last", cJSON_GetArrayItem(array, 15)->valuestring);
+    assert_index_matches_list(array);
+
+    cJSON_Delete(array);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void array_index_should_not_be_built_for_references(void)
+{
+    cJSON *array = create_numbered_array(16);
+    cJSON *reference = cJSON_CreateArrayReference(array->child);
+
+    cJSON_SetIndexThreshold(4);
+    TEST_ASSERT_EQUAL_INT(16, cJSON_GetArraySize(reference));
+    TEST_ASSERT_NOT_NULL(cJSON_GetArrayItem(reference, 3));
+    TEST_ASSERT_NULL(reference->index);
+
+    cJSON_Delete(reference);
+    cJSON_Delete(array);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void array_index_should_not_be_built_for_objects(void)
+{
+    cJSON *object = cJSON_Parse("{\"a\": 1, \"b\": 2, \"c\": 3, \"d\": 4}");
+
+    cJSON_SetIndexThreshold(2);
+    TEST_ASSERT_NOT_NULL(object);
+    TEST_ASSERT_EQUAL_INT(4, cJSON_GetArraySize(object));
+    TEST_ASSERT_EQUAL_STRING("c", cJSON_GetArrayItem(object, 2)->string);
+    TEST_ASSERT_NULL(object->index);
+
+    /* the key index knows the size too */
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItem(object, "a"));
+    TEST_ASSERT_NOT_NULL(object->index);
+    cJSON_DeleteItemFromObject(object, "b");
+    TEST_ASSERT_EQUAL_INT(3, cJSON_GetArraySize(object));
+    TEST_ASSERT_EQUAL_STRING("d", cJSON_GetArrayItem(object, 2)->string);
+
+    cJSON_Delete(object);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void array_index_should_work_with_parsed_arrays(void)
+{
+    cJSON *array = NULL;
+
+    cJSON_SetIndexThreshold(2);
+    array = cJSON_Parse("[1, [2, 3], {\"x\": [4, 5, 6]}]");
+    TEST_ASSERT_NOT_NULL(array);
+
+    TEST_ASSERT_EQUAL_INT(2, cJSON_GetArraySize(cJSON_GetArrayItem(array, 1)));
+    TEST_ASSERT_EQUAL_INT(6, cJSON_GetArrayItem(cJSON_GetObjectItem(cJSON_GetArrayItem(array, 2), "x"), 2)->valueint);
+    TEST_ASSERT_NOT_NULL(array->index);
+    assert_index_matches_list(array);
+
+    cJSON_Delete(array);
+    cJSON_SetIndexThreshold(0);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(array_index_should_be_built_on_first_access_of_large_arrays);
+    RUN_TEST(array_index_should_be_kept_up_to_date_when_appending);
+    RUN_TEST(array_index_should_be_kept_up_to_date_when_inserting);
+    RUN_TEST(array_index_should_be_kept_up_to_date_when_deleting);
+    RUN_TEST(array_index_should_be_kept_up_to_date_when_replacing);
+    RUN_TEST(array_index_should_not_be_built_for_references);
+    RUN_TEST(array_index_should_not_be_built_for_objects);
+    RUN_TEST(array_index_should_work_with_parsed_arrays);
+
+    return UNITY_END();
+}
@@ -31,7 +31,7 @@ void reset(cJSON *item) {
     {
         cJSON_Delete(item->child);
     }
-    if ((item->valuestring != NULL) && !(item->type & cJSON_IsReference))
+    if ((item->valuestring != NULL) && !(item->type & (cJSON_IsReference | cJSON_ValuestringIsConst)))
     {
         global_hooks.deallocate(item->valuestring);
     }
@@ -39,6 +39,7 @@ void reset(cJSON *item) {
     {
         global_hooks.deallocate(item->string);
     }
+    cJSON_InvalidateIndex(item);
 
     memset(item, 0, sizeof(cJSON));
 }
@@ -0,0 +1,229 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+#include "../cJSON_Utils.h"
+
+/* the example document of RFC 6901 */
+static const char rfc6901[] = "{\"foo\":[\"bar\",\"baz\"],\"\":0,\"a/b\":1,\"c%d\":2,\"e^f\":3,\"g|h\":4,\"i\\\\j\":5,\"k\\\"l\":6,\" \":7,\"m~n\":8}";
+
+static void assert_same_as_get_pointer(cJSON *document, const char *pointer)
+{
+    cJSONUtils_Pointer *compiled = cJSONUtils_CompilePointer(pointer);
+
+    TEST_ASSERT_NOT_NULL(compiled);
+    TEST_ASSERT_TRUE(cJSONUtils_GetPointerCaseSensitive(document, pointer) == cJSONUtils_GetCompiledPointerCaseSensitive(document, compiled));
+    TEST_ASSERT_TRUE(cJSONUtils_GetPointer(document, pointer) == cJSONUtils_GetCompiledPointer(document, compiled));
+
+    cJSONUtils_DeletePointer(compiled);
+}
+
+static void compiled_pointers_should_resolve_like_get_pointer(void)
+{
+    cJSON *document = cJSON_Parse(rfc6901);
+    const char *pointers[] = { "", "/foo", "/foo/0", "/foo/1", "/foo/2", "/foo/01", "/foo/-", "/foo/x", "/", "/a~1b", "/c%d", "/e^f",
+        "/g|h", "/i\\j", "/k\"l", "/ ", "/m~0n", "/FOO/0", "/missing", "/foo/0/deeper", NULL };
+    size_t i = 0;
+
+    TEST_ASSERT_NOT_NULL(document);
+    for (i = 0; pointers[i] != NULL; i++)
+    {
+        assert_same_as_get_pointer(document, pointers[i]);
+    }
+
+    cJSON_Delete(document);
+}
+
+static void compiled_pointers_should_unescape_tokens(void)
+{
+    cJSON *document = cJSON_Parse("{\"a/b\":{\"m~n\":{\"~/\":1}},\"~1\":2}");
+    cJSONUtils_Pointer *compiled = cJSONUtils_CompilePointer("/a~1b/m~0n/~0~1");
+
+    TEST_ASSERT_NOT_NULL(compiled);
+    TEST_ASSERT_EQUAL_INT(1, cJSONUtils_GetCompiledPointerCaseSensitive(document, compiled)->valueint);
+    cJSONUtils_DeletePointer(compiled);
+
+    /* "~01" is "~1" and not "~/" */
+    compiled = cJSONUtils_CompilePointer("/~01");
+    TEST_ASSERT_NOT_NULL(compiled);
+    TEST_ASSERT_EQUAL_INT(2, cJSONUtils_GetCompiledPointerCaseSensitive(document, compiled)->valueint);
+    cJSONUtils_DeletePointer(compiled);
+
+    cJSON_Delete(document);
+}
+
+static void compiled_pointers_should_respect_case_sensitivity(void)
+{
+    cJSON *document = cJSON_Parse("{\"Fan\":{\"Speed\":3}}");
+    cJSONUtils_Pointer *compiled = cJSONUtils_CompilePointer("/fan/speed");
+
+    TEST_ASSERT_NOT_NULL(compiled);
+    TEST_ASSERT_EQUAL_INT(3, cJSONUtils_GetCompiledPointer(document, compiled)->valueint);
+    TEST_ASSERT_NULL(cJSONUtils_GetCompiledPointerCaseSensitive(document, compiled));
+
+    cJSONUtils_DeletePointer(compiled);
+    cJSON_Delete(document);
+}
+
+static void compiled_pointers_should_use_array_indices(void)
+{
+    cJSON *array = cJSON_CreateArray();
+    cJSONUtils_Pointer *compiled = cJSONUtils_CompilePointer("/999");
+    int i = 0;
+
+    /* large enough for cJSON to index it */
+    for (i = 0; i < 1000; i++)
+    {
+        cJSON_AddItemToArray(array, cJSON_CreateNumber(i));
+    }
+
+    TEST_ASSERT_NOT_NULL(compiled);
+    TEST_ASSERT_EQUAL_INT(999, cJSONUtils_GetCompiledPointer(array, compiled)->valueint);
+    cJSON_DeleteItemFromArray(array, 0);
+    TEST_ASSERT_NULL(cJSONUtils_GetCompiledPointer(array, compiled));
+
+    cJSONUtils_DeletePointer(compiled);
+    cJSON_Delete(array);
+}
+
+static void compiled_pointers_should_resolve_invalid_pointers_like_get_pointer(void)
+{
+    cJSON *document = cJSON_Parse("{\"foo\":{\"~2\":1,\"~\":2},\"a\":[3]}");
+    const char *pointers[] = { "foo", "x/y", "a/0", "foo/", "/foo/~2", "/foo/~", "/foo~2", "/a/~2", "/~2/foo", NULL };
+    size_t i = 0;
+
+    /* without a leading '/' that's the document itself, tokens with invalid escape sequences match nothing */
+    TEST_ASSERT_NOT_NULL(document);
+    for (i = 0; pointers[i] != NULL; i++)
+    {
+        assert_same_as_get_pointer(document, pointers[i]);
+    }
+    TEST_ASSERT_TRUE(cJSONUtils_GetPointer(document, "x/y") == document);
+    TEST_ASSERT_NULL(cJSONUtils_GetPointer(document, "/foo/~2"));
+    cJSON_Delete(document);
+
+    TEST_ASSERT_NULL(cJSONUtils_CompilePointer(NULL));
+    TEST_ASSERT_NULL(cJSONUtils_GetCompiledPointer(NULL, NULL));
+    cJSONUtils_DeletePointer(NULL);
+}
+
+static void apply_patches_should_unescape_the_last_token(void)
+{
+    cJSON *document = cJSON_Parse("{\"a/b\":1,\"m~n\":2}");
+    cJSON *patches = cJSON_Parse("[{\"op\":\"replace\",\"path\":\"/a~1b\",\"value\":3},{\"op\":\"remove\",\"path\":\"/m~0n\"},{\"op\":\"add\",\"path\":\"/x~1y~0z\",\"value\":4}]");
+    cJSON *expected = cJSON_Parse("{\"a/b\":3,\"x/y~z\":4}");
+
+    TEST_ASSERT_EQUAL_INT(0, cJSONUtils_ApplyPatchesCaseSensitive(document, patches));
+    TEST_ASSERT_TRUE(cJSON_Compare(document, expected, true));
+
+    cJSON_Delete(expected);
+    cJSON_Delete(patches);
+    cJSON_Delete(document);
+}
+
+static void apply_patches_should_keep_status_codes_for_bad_paths(void)
+{
+    cJSON *document = cJSON_Parse("{\"list\":[1,2]}");
+    cJSON *patches = NULL;
+
+    patches = cJSON_Parse("[{\"op\":\"add\",\"path\":\"list\",\"value\":1}]");
+    TEST_ASSERT_EQUAL_INT(9, cJSONUtils_ApplyPatches(document, patches));
+    cJSON_Delete(patches);
+
+    patches = cJSON_Parse("[{\"op\":\"remove\",\"path\":\"/missing/0\"}]");
+    TEST_ASSERT_EQUAL_INT(13, cJSONUtils_ApplyPatches(document, patches));
+    cJSON_Delete(patches);
+
+    patches = cJSON_Parse("[{\"op\":\"add\",\"path\":\"/list/01\",\"value\":1}]");
+    TEST_ASSERT_EQUAL_INT(11, cJSONUtils_ApplyPatches(document, patches));
+    cJSON_Delete(patches);
+
+    patches = cJSON_Parse("[{\"op\":\"add\",\"path\":\"/list/3\",\"value\":1}]");
+    TEST_ASSERT_EQUAL_INT(10, cJSONUtils_ApplyPatches(document, patches));
+    cJSON_Delete(patches);
+
+    patches = cJSON_Parse("[{\"op\":\"move\",\"from\":\"/list/~2\",\"path\":\"/x\"}]");
+    TEST_ASSERT_EQUAL_INT(5, cJSONUtils_ApplyPatches(document, patches));
+    cJSON_Delete(patches);
+
+    patches = cJSON_Parse("[{\"op\":\"add\",\"path\":\"/list/~2\",\"value\":1}]");
+    TEST_ASSERT_EQUAL_INT(11, cJSONUtils_ApplyPatches(document, patches));
+    cJSON_Delete(patches);
+
+    patches = cJSON_Parse("[{\"op\":\"copy\",\"from\":\"/list/~2\",\"path\":\"/x\"}]");
+    TEST_ASSERT_EQUAL_INT(5, cJSONUtils_ApplyPatches(document, patches));
+    cJSON_Delete(patches);
+
+    cJSON_Delete(document);
+}
+
+static void apply_patches_should_keep_handling_paths_that_are_not_rfc6901(void)
+{
+    cJSON *document = cJSON_Parse("{\"a\":{\"b\":1,\"~2\":2}}");
+    /* add and remove split the path at the last '/' and resolve the rest like cJSONUtils_GetPointer, which is the
+     * root without a leading '/', and a last token with an invalid escape sequence is taken as written */
+    cJSON *patches = cJSON_Parse("[{\"op\":\"add\",\"path\":\"x/y\",\"value\":3},"
+        "{\"op\":\"add\",\"path\":\"/a/~2\",\"value\":4},"
+        "{\"op\":\"add\",\"path\":\"/a/~\",\"value\":5},"
+        "{\"op\":\"remove\",\"path\":\"a/y\"},"
+        "{\"op\":\"move\",\"from\":\"/a/~\",\"path\":\"/c\"},"
+        "{\"op\":\"copy\",\"from\":\"/a/b\",\"path\":\"a/d\"},"
+        "{\"op\":\"test\",\"path\":\"x\",\"value\":{\"a\":{\"b\":1,\"~2\":4},\"c\":5,\"d\":1}}]");
+    cJSON *expected = cJSON_Parse("{\"a\":{\"b\":1,\"~2\":4},\"c\":5,\"d\":1}");
+
+    TEST_ASSERT_EQUAL_INT(0, cJSONUtils_ApplyPatchesCaseSensitive(document, patches));
+    TEST_ASSERT_TRUE(cJSON_Compare(document, expected, true));
+
+    /* but a token with an invalid escape sequence doesn't match anything on the way to the parent */
+    cJSON_Delete(patches);
+    patches = cJSON_Parse("[{\"op\":\"add\",\"path\":\"/~2/b\",\"value\":1}]");
+    TEST_ASSERT_EQUAL_INT(9, cJSONUtils_ApplyPatches(document, patches));
+    cJSON_Delete(patches);
+    patches = cJSON_Parse("[{\"op\":\"copy\",\"from\":\"/a/~2\",\"path\":\"/e\"}]");
+    TEST_ASSERT_EQUAL_INT(5, cJSONUtils_ApplyPatches(document, patches));
+
+    cJSON_Delete(expected);
+    cJSON_Delete(patches);
+    cJSON_Delete(document);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(compiled_pointers_should_resolve_like_get_pointer);
+    RUN_TEST(compiled_pointers_should_unescape_tokens);
+    RUN_TEST(compiled_pointers_should_respect_case_sensitivity);
+    RUN_TEST(compiled_pointers_should_use_array_indices);
+    RUN_TEST(compiled_pointers_should_resolve_invalid_pointers_like_get_pointer);
+    RUN_TEST(apply_patches_should_unescape_the_last_token);
+    RUN_TEST(apply_patches_should_keep_status_codes_for_bad_paths);
+    RUN_TEST(apply_patches_should_keep_handling_paths_that_are_not_rfc6901);
+
+    return UNITY_END();
+}
@@ -0,0 +1,232 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static size_t allocations = 0;
+
+static void * CJSON_CDECL counting_malloc(size_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+/* work around MSVC error C2322: '...' address of dllimport '...' is not static */
+static void CJSON_CDECL normal_free(void *pointer)
+{
+    free(pointer);
+}
+
+static cJSON_Hooks counting_hooks = {
+    counting_malloc,
+    normal_free
+};
+
+static const char shadow[] = "{\"state\":{\"reported\":{\"fanSpeed\":75,\"mode\":\"auto\",\"filters\":[\"pre\",\"hepa\",{\"age\":120}],"
+    "\"raw\":null,\"on\":true}},\"version\":42,\"empty\":{},\"list\":[]}";
+
+static void duplicate_compact_should_copy_in_one_allocation(void)
+{
+    cJSON *original = cJSON_Parse(shadow);
+    cJSON *copy = NULL;
+
+    TEST_ASSERT_NOT_NULL(original);
+
+    cJSON_InitHooks(&counting_hooks);
+    allocations = 0;
+    copy = cJSON_DuplicateCompact(original);
+    cJSON_InitHooks(NULL);
+
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT_EQUAL_INT(1, allocations);
+    TEST_ASSERT_TRUE(cJSON_Compare(original, copy, true));
+    /* the lists are linked like in any other tree */
+    TEST_ASSERT_EQUAL_INT(cJSON_GetArraySize(cJSON_GetObjectItem(original, "list")), cJSON_GetArraySize(cJSON_GetObjectItem(copy, "list")));
+    TEST_ASSERT_TRUE(copy->child->prev == cJSON_GetObjectItem(copy, "list"));
+    TEST_ASSERT_NULL(copy->next);
+    TEST_ASSERT_NULL(copy->prev);
+
+    cJSON_DeleteCompact(copy);
+    cJSON_Delete(original);
+}
+
+static void duplicate_compact_should_not_share_memory_with_the_original(void)
+{
+    cJSON *original = cJSON_Parse(shadow);
+    cJSON *copy = cJSON_DuplicateCompact(original);
+    char *printed = NULL;
+    char *expected = cJSON_PrintUnformatted(original);
+
+    TEST_ASSERT_NOT_NULL(copy);
+    cJSON_Delete(original);
+
+    printed = cJSON_PrintUnformatted(copy);
+    TEST_ASSERT_EQUAL_STRING(expected, printed);
+
+    cJSON_free(printed);
+    cJSON_free(expected);
+    cJSON_DeleteCompact(copy);
+}
+
+static void duplicate_compact_should_copy_references_and_constant_strings(void)
+{
+    cJSON *shared = cJSON_CreateString("shared");
+    cJSON *original = cJSON_CreateObject();
+    cJSON *copy = NULL;
+
+    cJSON_AddItemToObjectCS(original, "constant", cJSON_CreateNumber(1));
+    cJSON_AddItemReferenceToObject(original, "reference", shared);
+    cJSON_AddItemToObject(original, "raw", cJSON_CreateRaw("[1,2]"));
+
+    copy = cJSON_DuplicateCompact(original);
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT_TRUE(cJSON_Compare(original, copy, true));
+    TEST_ASSERT_FALSE(cJSON_GetObjectItem(copy, "reference")->type & cJSON_IsReference);
+    TEST_ASSERT_TRUE(cJSON_GetObjectItem(copy, "constant")->string != cJSON_GetObjectItem(original, "constant")->string);
+
+    cJSON_DeleteCompact(copy);
+    cJSON_Delete(original);
+    cJSON_Delete(shared);
+}
+
+static void duplicate_compact_should_allow_modifications(void)
+{
+    cJSON *original = cJSON_Parse(shadow);
+    cJSON *copy = cJSON_DuplicateCompact(original);
+    cJSON *reported = NULL;
+    char *printed = NULL;
+    const int numbers[] = { 1, 2 };
+
+    TEST_ASSERT_NOT_NULL(copy);
+    reported = cJSON_GetObjectItem(cJSON_GetObjectItem(copy, "state"), "reported");
+
+    /* items of the copy stay in its memory, new items are freed with it */
+    cJSON_DeleteItemFromObject(reported, "filters");
+    cJSON_Delete(cJSON_DetachItemFromObject(copy, "empty"));
+    cJSON_AddStringToObject(reported, "added", "new");
+    cJSON_AddItemToArray(cJSON_GetObjectItem(copy, "list"), cJSON_CreateIntArray(numbers, 2));
+    TEST_ASSERT_NOT_NULL(cJSON_SetValuestring(cJSON_GetObjectItem(reported, "mode"), "a much longer mode than before"));
+    cJSON_SetNumberValue(cJSON_GetObjectItem(copy, "version"), 43);
+
+    printed = cJSON_PrintUnformatted(copy);
+    TEST_ASSERT_EQUAL_STRING("{\"state\":{\"reported\":{\"fanSpeed\":75,\"mode\":\"a much longer mode than before\",\"raw\":null,\"on\":true,\"added\":\"new\"}},"
+        "\"version\":43,\"list\":[[1,2]]}", printed);
+
+    cJSON_free(printed);
+    cJSON_DeleteCompact(copy);
+    cJSON_Delete(original);
+}
+
+static void duplicate_compact_should_be_referenced_from_heap_items(void)
+{
+    cJSON *original = cJSON_Parse(shadow);
+    cJSON *copy = cJSON_DuplicateCompact(original);
+    cJSON *references = cJSON_CreateObject();
+    cJSON *list = cJSON_CreateArray();
+
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT_TRUE(cJSON_AddItemReferenceToObject(references, "version", cJSON_GetObjectItem(copy, "version")));
+    TEST_ASSERT_TRUE(cJSON_AddItemReferenceToArray(list, cJSON_GetObjectItem(copy, "state")));
+    TEST_ASSERT_BITS(cJSON_ItemInArena | cJSON_ValuestringIsConst, 0, cJSON_GetObjectItem(references, "version")->type);
+    TEST_ASSERT_BITS(cJSON_ItemInArena, 0, cJSON_GetArrayItem(list, 0)->type);
+    TEST_ASSERT_TRUE(cJSON_Compare(cJSON_GetObjectItem(original, "state"), cJSON_GetArrayItem(list, 0), true));
+
+    /* the references are heap items and freed here, the copy keeps its items */
+    cJSON_Delete(references);
+    cJSON_Delete(list);
+    TEST_ASSERT_TRUE(cJSON_Compare(original, copy, true));
+
+    cJSON_DeleteCompact(copy);
+    cJSON_Delete(original);
+}
+
+static void duplicate_compact_should_not_recurse(void)
+{
+    cJSON *original = cJSON_CreateArray();
+    cJSON *innermost = original;
+    cJSON *copy = NULL;
+    size_t depth = 0;
+    int i = 0;
+
+    /* far deeper than the 16 frames on the call stack */
+    for (i = 0; i < 5000; i++)
+    {
+        cJSON *nested = cJSON_CreateArray();
+        cJSON_AddItemToArray(innermost, nested);
+        innermost = nested;
+    }
+    cJSON_AddItemToArray(innermost, cJSON_CreateString("bottom"));
+
+    copy = cJSON_DuplicateCompact(original);
+    TEST_ASSERT_NOT_NULL(copy);
+    for (innermost = copy; cJSON_IsArray(innermost); innermost = innermost->child)
+    {
+        depth++;
+    }
+    TEST_ASSERT_EQUAL_INT(5001, depth);
+    TEST_ASSERT_EQUAL_STRING("bottom", cJSON_GetStringValue(innermost));
+
+    cJSON_DeleteCompact(copy);
+    cJSON_Delete(original);
+}
+
+static void duplicate_compact_should_fail_on_circular_references(void)
+{
+    cJSON *original = cJSON_CreateArray();
+    cJSON *loop = cJSON_CreateArray();
+
+    cJSON_AddItemToArray(original, loop);
+    cJSON_AddItemReferenceToArray(loop, original);
+
+    TEST_ASSERT_NULL(cJSON_DuplicateCompact(original));
+
+    /* the reference doesn't own what it points at */
+    cJSON_Delete(original);
+}
+
+static void duplicate_compact_should_handle_null(void)
+{
+    TEST_ASSERT_NULL(cJSON_DuplicateCompact(NULL));
+    cJSON_DeleteCompact(NULL);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(duplicate_compact_should_copy_in_one_allocation);
+    RUN_TEST(duplicate_compact_should_not_share_memory_with_the_original);
+    RUN_TEST(duplicate_compact_should_copy_references_and_constant_strings);
+    RUN_TEST(duplicate_compact_should_allow_modifications);
+    RUN_TEST(duplicate_compact_should_be_referenced_from_heap_items);
+    RUN_TEST(duplicate_compact_should_not_recurse);
+    RUN_TEST(duplicate_compact_should_fail_on_circular_references);
+    RUN_TEST(duplicate_compact_should_handle_null);
+
+    return UNITY_END();
+}
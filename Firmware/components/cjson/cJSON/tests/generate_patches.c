@@ -0,0 +1,257 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+#include "../cJSON_Utils.h"
+
+static const char shadow[] = "{\"state\":{\"reported\":{\"pm25\":12,\"fan\":{\"speed\":3,\"mode\":\"auto\"},\"filters\":[{\"id\":1,\"life\":80},{\"id\":2,\"life\":60}]}},\"version\":7}";
+
+/* generate patches, check that applying them to a copy of 'from' gives 'to' and return them */
+static cJSON *generate_and_apply(const char *from_json, const char *to_json)
+{
+    cJSON *from = cJSON_Parse(from_json);
+    cJSON *to = cJSON_Parse(to_json);
+    cJSON *patched = NULL;
+    cJSON *patches = NULL;
+
+    TEST_ASSERT_NOT_NULL(from);
+    TEST_ASSERT_NOT_NULL(to);
+    patches = cJSONUtils_GeneratePatchesCaseSensitive(from, to);
+    TEST_ASSERT_NOT_NULL(patches);
+
+    patched = cJSON_Duplicate(from, true);
+    TEST_ASSERT_EQUAL_INT(0, cJSONUtils_ApplyPatchesCaseSensitive(patched, patches));
+    TEST_ASSERT_TRUE(cJSON_Compare(patched, to, true));
+
+    cJSON_Delete(patched);
+    cJSON_Delete(from);
+    cJSON_Delete(to);
+
+    return patches;
+}
+
+static void assert_single_patch(cJSON *patches, const char *expected)
+{
+    char *printed = NULL;
+
+    TEST_ASSERT_EQUAL_INT(1, cJSON_GetArraySize(patches));
+    printed = cJSON_PrintUnformatted(cJSON_GetArrayItem(patches, 0));
+    TEST_ASSERT_EQUAL_STRING(expected, printed);
+
+    cJSON_free(printed);
+    cJSON_Delete(patches);
+}
+
+static void generate_patches_should_not_modify_inputs(void)
+{
+    const char from_json[] = "{\"z\":1,\"a\":{\"y\":[3,2,1],\"b\":true},\"m\":\"x\"}";
+    const char to_json[] = "{\"m\":\"y\",\"z\":2,\"a\":{\"b\":false,\"y\":[1,2,3]},\"n\":null}";
+    cJSON *from = cJSON_Parse(from_json);
+    cJSON *to = cJSON_Parse(to_json);
+    cJSON *patches = NULL;
+    char *printed = NULL;
+
+    patches = cJSONUtils_GeneratePatches(from, to);
+    TEST_ASSERT_NOT_NULL(patches);
+
+    printed = cJSON_PrintUnformatted(from);
+    TEST_ASSERT_EQUAL_STRING(from_json, printed);
+    cJSON_free(printed);
+    printed = cJSON_PrintUnformatted(to);
+    TEST_ASSERT_EQUAL_STRING(to_json, printed);
+    cJSON_free(printed);
+
+    cJSON_Delete(patches);
+    cJSON_Delete(from);
+    cJSON_Delete(to);
+}
+
+static void generate_patches_should_return_no_patches_for_equal_documents(void)
+{
+    cJSON *patches = generate_and_apply(shadow, "{\"version\":7,\"state\":{\"reported\":{\"fan\":{\"mode\":\"auto\",\"speed\":3},\"pm25\":12,\"filters\":[{\"life\":80,\"id\":1},{\"id\":2,\"life\":60}]}}}");
+
+    TEST_ASSERT_EQUAL_INT(0, cJSON_GetArraySize(patches));
+    cJSON_Delete(patches);
+}
+
+static void generate_patches_should_only_touch_changed_values(void)
+{
+    assert_single_patch(generate_and_apply(shadow, "{\"state\":{\"reported\":{\"pm25\":12,\"fan\":{\"speed\":4,\"mode\":\"auto\"},\"filters\":[{\"id\":1,\"life\":80},{\"id\":2,\"life\":60}]}},\"version\":7}"),
+            "{\"op\":\"replace\",\"path\":\"/state/reported/fan/speed\",\"value\":4}");
+    assert_single_patch(generate_and_apply(shadow, "{\"state\":{\"reported\":{\"pm25\":12,\"fan\":{\"speed\":3,\"mode\":\"auto\"},\"filters\":[{\"id\":1,\"life\":80},{\"id\":2,\"life\":59}]}},\"version\":7}"),
+            "{\"op\":\"replace\",\"path\":\"/state/reported/filters/1/life\",\"value\":59}");
+}
+
+static void generate_patches_should_insert_into_arrays(void)
+{
+    assert_single_patch(generate_and_apply("[1,2,3,4,5,6,7,8]", "[0,1,2,3,4,5,6,7,8]"), "{\"op\":\"add\",\"path\":\"/0\",\"value\":0}");
+    assert_single_patch(generate_and_apply("[1,2,3,4,5,6,7,8]", "[1,2,3,4,0,5,6,7,8]"), "{\"op\":\"add\",\"path\":\"/4\",\"value\":0}");
+    assert_single_patch(generate_and_apply("[1,2,3,4,5,6,7,8]", "[1,2,3,4,5,6,7,8,0]"), "{\"op\":\"add\",\"path\":\"/-\",\"value\":0}");
+    assert_single_patch(generate_and_apply("[{\"id\":1},{\"id\":2}]", "[{\"id\":0},{\"id\":1},{\"id\":2}]"), "{\"op\":\"add\",\"path\":\"/0\",\"value\":{\"id\":0}}");
+}
+
+static void generate_patches_should_remove_from_arrays(void)
+{
+    assert_single_patch(generate_and_apply("[1,2,3,4,5,6,7,8]", "[2,3,4,5,6,7,8]"), "{\"op\":\"remove\",\"path\":\"/0\"}");
+    assert_single_patch(generate_and_apply("[1,2,3,4,5,6,7,8]", "[1,2,3,5,6,7,8]"), "{\"op\":\"remove\",\"path\":\"/3\"}");
+}
+
+static void generate_patches_should_find_shortest_edit_scripts(void)
+{
+    cJSON *patches = NULL;
+
+    /* the example from Myers' paper, 5 edits */
+    patches = generate_and_apply("[\"a\",\"b\",\"c\",\"a\",\"b\",\"b\",\"a\"]", "[\"c\",\"b\",\"a\",\"b\",\"a\",\"c\"]");
+    TEST_ASSERT_EQUAL_INT(5, cJSON_GetArraySize(patches));
+    cJSON_Delete(patches);
+
+    patches = generate_and_apply("[1,2,3,4,5,6]", "[6,5,4,3,2,1]");
+    TEST_ASSERT_EQUAL_INT(6, cJSON_GetArraySize(patches));
+    cJSON_Delete(patches);
+
+    patches = generate_and_apply("[]", "[1,[2],{\"3\":3}]");
+    TEST_ASSERT_EQUAL_INT(3, cJSON_GetArraySize(patches));
+    cJSON_Delete(patches);
+
+    patches = generate_and_apply("[1,[2],{\"3\":3}]", "[]");
+    TEST_ASSERT_EQUAL_INT(3, cJSON_GetArraySize(patches));
+    cJSON_Delete(patches);
+}
+
+static void generate_patches_should_handle_arrays_beyond_the_edit_limit(void)
+{
+    cJSON *from = cJSON_CreateArray();
+    cJSON *to = cJSON_CreateArray();
+    cJSON *patches = NULL;
+    char *from_json = NULL;
+    char *to_json = NULL;
+    int index = 0;
+
+    /* every other element differs, which takes more edits than CJSON_UTILS_ARRAY_EDIT_LIMIT */
+    for (index = 0; index < 1000; index++)
+    {
+        cJSON_AddItemToArray(from, cJSON_CreateNumber(index));
+        cJSON_AddItemToArray(to, cJSON_CreateNumber(((index % 2) == 0) ? index : -index));
+    }
+    cJSON_AddItemToArray(to, cJSON_CreateNumber(1000));
+    from_json = cJSON_PrintUnformatted(from);
+    to_json = cJSON_PrintUnformatted(to);
+
+    patches = generate_and_apply(from_json, to_json);
+    TEST_ASSERT_EQUAL_INT(501, cJSON_GetArraySize(patches));
+
+    cJSON_Delete(patches);
+    cJSON_free(from_json);
+    cJSON_free(to_json);
+    cJSON_Delete(from);
+    cJSON_Delete(to);
+}
+
+static void generate_patches_should_round_trip_random_array_edits(void)
+{
+    unsigned long state = 12345;
+    int round = 0;
+
+    for (round = 0; round < 200; round++)
+    {
+        cJSON *from = cJSON_CreateArray();
+        cJSON *to = cJSON_CreateArray();
+        cJSON *patches = NULL;
+        char *from_json = NULL;
+        char *to_json = NULL;
+        int length = 0;
+        int index = 0;
+
+        /* small alphabets make for many equal elements, edits are insertions, removals and changes */
+        state = state * 1103515245UL + 12345UL;
+        length = (int)((state >> 16) % 40);
+        for (index = 0; index < length; index++)
+        {
+            state = state * 1103515245UL + 12345UL;
+            cJSON_AddItemToArray(from, cJSON_CreateNumber((double)((state >> 16) % 5)));
+            switch ((state >> 20) % 6)
+            {
+                case 0:
+                    break;
+                case 1:
+                    cJSON_AddItemToArray(to, cJSON_CreateNumber(7));
+                    cJSON_AddItemToArray(to, cJSON_CreateNumber((double)((state >> 16) % 5)));
+                    break;
+                case 2:
+                    cJSON_AddItemToArray(to, cJSON_CreateNumber((double)((state >> 24) % 5)));
+                    break;
+                default:
+                    cJSON_AddItemToArray(to, cJSON_CreateNumber((double)((state >> 16) % 5)));
+                    break;
+            }
+        }
+        from_json = cJSON_PrintUnformatted(from);
+        to_json = cJSON_PrintUnformatted(to);
+
+        patches = generate_and_apply(from_json, to_json);
+        TEST_ASSERT_TRUE(cJSON_GetArraySize(patches) <= ((length > cJSON_GetArraySize(to)) ? length : cJSON_GetArraySize(to)));
+
+        cJSON_Delete(patches);
+        cJSON_free(from_json);
+        cJSON_free(to_json);
+        cJSON_Delete(from);
+        cJSON_Delete(to);
+    }
+}
+
+static void generate_patches_should_compare_keys_case_insensitively(void)
+{
+    cJSON *from = cJSON_Parse("{\"Mode\":\"auto\",\"speed\":1}");
+    cJSON *to = cJSON_Parse("{\"mode\":\"auto\",\"SPEED\":2}");
+    cJSON *patches = cJSONUtils_GeneratePatches(from, to);
+
+    TEST_ASSERT_EQUAL_INT(0, cJSONUtils_ApplyPatches(from, patches));
+    TEST_ASSERT_EQUAL_INT(1, cJSON_GetArraySize(patches));
+    TEST_ASSERT_EQUAL_INT(2, cJSON_GetObjectItem(from, "speed")->valueint);
+
+    cJSON_Delete(patches);
+    cJSON_Delete(from);
+    cJSON_Delete(to);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(generate_patches_should_not_modify_inputs);
+    RUN_TEST(generate_patches_should_return_no_patches_for_equal_documents);
+    RUN_TEST(generate_patches_should_only_touch_changed_values);
+    RUN_TEST(generate_patches_should_insert_into_arrays);
+    RUN_TEST(generate_patches_should_remove_from_arrays);
+    RUN_TEST(generate_patches_should_find_shortest_edit_scripts);
+    RUN_TEST(generate_patches_should_handle_arrays_beyond_the_edit_limit);
+    RUN_TEST(generate_patches_should_round_trip_random_array_edits);
+    RUN_TEST(generate_patches_should_compare_keys_case_insensitively);
+
+    return UNITY_END();
+}
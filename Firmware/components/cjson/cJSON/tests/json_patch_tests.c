@@ -119,6 +119,64 @@ static cJSON_bool test_apply_patch(const cJSON * const test)
     return successful;
 }
 
+/* Apply the patch all or nothing and once more followed by an operation that always fails, which has to roll
+ * every operation of the patch back and leave the document exactly as it was. */
+static cJSON_bool test_apply_patch_transactional(const cJSON * const test)
+{
+    cJSON *doc = NULL;
+    cJSON *patch = NULL;
+    cJSON *failing_patch = NULL;
+    cJSON *expected = NULL;
+    cJSON *object = NULL;
+    char *printed_doc = NULL;
+    char *printed_object = NULL;
+    cJSON_bool successful = true;
+
+    if (cJSON_IsTrue(cJSON_GetObjectItemCaseSensitive(test, "disabled")))
+    {
+        return true;
+    }
+
+    doc = cJSON_GetObjectItemCaseSensitive(test, "doc");
+    patch = cJSON_GetObjectItemCaseSensitive(test, "patch");
+    expected = cJSON_GetObjectItemCaseSensitive(test, "expected");
+    printed_doc = cJSON_PrintUnformatted(doc);
+    TEST_ASSERT_NOT_NULL(printed_doc);
+
+    if (cJSON_GetObjectItemCaseSensitive(test, "error") == NULL)
+    {
+        object = cJSON_Duplicate(doc, true);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, cJSONUtils_ApplyPatchesTransactionalCaseSensitive(object, patch), "Failed to apply patches transactionally.");
+        if (expected != NULL)
+        {
+            successful = cJSON_Compare(object, expected, true);
+        }
+        cJSON_Delete(object);
+    }
+
+    failing_patch = cJSON_Duplicate(patch, true);
+    TEST_ASSERT_NOT_NULL(failing_patch);
+    cJSONUtils_AddPatchToArray(failing_patch, "remove", "/~2", NULL);
+
+    object = cJSON_Duplicate(doc, true);
+    TEST_ASSERT_TRUE_MESSAGE(0 != cJSONUtils_ApplyPatchesTransactionalCaseSensitive(object, failing_patch), "Test didn't fail as it's supposed to.");
+    printed_object = cJSON_PrintUnformatted(object);
+    TEST_ASSERT_NOT_NULL(printed_object);
+    if (strcmp(printed_doc, printed_object) != 0)
+    {
+        successful = false;
+    }
+
+    printf("transactional: %s\n", successful ? "OK" : "FAILED");
+
+    free(printed_object);
+    free(printed_doc);
+    cJSON_Delete(object);
+    cJSON_Delete(failing_patch);
+
+    return successful;
+}
+
 static cJSON_bool test_generate_test(cJSON *test)
 {
     cJSON *doc = NULL;
@@ -189,6 +247,7 @@ static void cjson_utils_should_pass_json_patch_test_tests(void)
     cJSON_ArrayForEach(test, tests)
     {
         failed |= !test_apply_patch(test);
+        failed |= !test_apply_patch_transactional(test);
         failed |= !test_generate_test(test);
     }
 
@@ -206,6 +265,7 @@ static void cjson_utils_should_pass_json_patch_test_spec_tests(void)
     cJSON_ArrayForEach(test, tests)
     {
         failed |= !test_apply_patch(test);
+        failed |= !test_apply_patch_transactional(test);
         failed |= !test_generate_test(test);
     }
 
@@ -223,6 +283,7 @@ static void cjson_utils_should_pass_json_patch_test_cjson_utils_tests(void)
     cJSON_ArrayForEach(test, tests)
     {
         failed |= !test_apply_patch(test);
+        failed |= !test_apply_patch_transactional(test);
         failed |= !test_generate_test(test);
     }
 
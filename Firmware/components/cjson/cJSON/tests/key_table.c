@@ -0,0 +1,210 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static const char batch[] = "[{\"deviceId\":\"a\",\"pm25\":1},{\"deviceId\":\"b\",\"pm25\":2},{\"pm25\":3,\"deviceId\":\"c\"}]";
+
+static cJSON *parse_with_table(const char *json, cJSON_KeyTable *table)
+{
+    return cJSON_ParseWithKeyTable(json, strlen(json) + sizeof(""), table);
+}
+
+static void key_table_should_share_keys_between_records(void)
+{
+    cJSON_KeyTable *table = cJSON_CreateKeyTable(0);
+    cJSON *interned = parse_with_table(batch, table);
+    cJSON *plain = cJSON_Parse(batch);
+    cJSON *first = NULL;
+    cJSON *second = NULL;
+    cJSON *third = NULL;
+
+    TEST_ASSERT_NOT_NULL(interned);
+    TEST_ASSERT_EQUAL_INT(2, cJSON_GetKeyTableSize(table));
+    TEST_ASSERT_TRUE(cJSON_Compare(interned, plain, true));
+
+    first = cJSON_GetArrayItem(interned, 0)->child;
+    second = cJSON_GetArrayItem(interned, 1)->child;
+    third = cJSON_GetArrayItem(interned, 2)->child;
+    TEST_ASSERT_TRUE(first->string == second->string);
+    TEST_ASSERT_TRUE(first->next->string == third->string);
+    TEST_ASSERT_TRUE(first->string == third->next->string);
+    TEST_ASSERT_TRUE(first->type & cJSON_StringIsConst);
+    TEST_ASSERT_TRUE(first->type & cJSON_StringIsInterned);
+    TEST_ASSERT_TRUE(cJSON_IsString(first));
+    TEST_ASSERT_FALSE(first->type & cJSON_ValuestringIsConst);
+
+    cJSON_Delete(interned);
+    cJSON_Delete(plain);
+    cJSON_DeleteKeyTable(table);
+}
+
+static void key_table_should_outlive_the_trees(void)
+{
+    cJSON_KeyTable *table = cJSON_CreateKeyTable(0);
+    cJSON *first = parse_with_table("{\"temperature\":24.5,\"humidity\":48}", table);
+    cJSON *second = NULL;
+
+    TEST_ASSERT_NOT_NULL(first);
+    cJSON_Delete(first);
+
+    /* the keys are still there for the next document */
+    second = parse_with_table("{\"humidity\":50,\"temperature\":25}", table);
+    TEST_ASSERT_NOT_NULL(second);
+    TEST_ASSERT_EQUAL_INT(2, cJSON_GetKeyTableSize(table));
+    TEST_ASSERT_EQUAL_STRING("humidity", second->child->string);
+    TEST_ASSERT_EQUAL_DOUBLE(25, cJSON_GetObjectItemCaseSensitive(second, "temperature")->valuedouble);
+
+    cJSON_Delete(second);
+    cJSON_DeleteKeyTable(table);
+}
+
+static void key_table_should_copy_escaped_keys(void)
+{
+    cJSON_KeyTable *table = cJSON_CreateKeyTable(0);
+    cJSON *object = parse_with_table("{\"a\\u0062\":1,\"ab\":2}", table);
+
+    TEST_ASSERT_NOT_NULL(object);
+    TEST_ASSERT_EQUAL_STRING("ab", object->child->string);
+    TEST_ASSERT_FALSE(object->child->type & cJSON_StringIsConst);
+    TEST_ASSERT_TRUE(object->child->next->type & cJSON_StringIsInterned);
+    TEST_ASSERT_EQUAL_INT(1, cJSON_GetKeyTableSize(table));
+
+    cJSON_Delete(object);
+    cJSON_DeleteKeyTable(table);
+}
+
+static void key_table_should_stop_at_max_keys(void)
+{
+    cJSON_KeyTable *table = cJSON_CreateKeyTable(1);
+    cJSON *object = parse_with_table("{\"a\":1,\"b\":2,\"a\":3}", table);
+
+    TEST_ASSERT_NOT_NULL(object);
+    TEST_ASSERT_EQUAL_INT(1, cJSON_GetKeyTableSize(table));
+    TEST_ASSERT_TRUE(object->child->type & cJSON_StringIsInterned);
+    TEST_ASSERT_FALSE(object->child->next->type & cJSON_StringIsConst);
+    TEST_ASSERT_EQUAL_STRING("b", object->child->next->string);
+    TEST_ASSERT_TRUE(object->child->string == object->child->next->next->string);
+
+    cJSON_Delete(object);
+    cJSON_DeleteKeyTable(table);
+}
+
+static void key_table_should_grow(void)
+{
+    char json[2048];
+    char name[16];
+    char *position = json;
+    cJSON_KeyTable *table = cJSON_CreateKeyTable(0);
+    cJSON *object = NULL;
+    int i = 0;
+
+    *position++ = '{';
+    for (i = 0; i < 100; i++)
+    {
+        position += sprintf(position, "%s\"key%d\":%d", (i > 0) ? "," : "", i, i);
+    }
+    *position++ = '}';
+    *position = '\0';
+
+    object = parse_with_table(json, table);
+    TEST_ASSERT_NOT_NULL(object);
+    TEST_ASSERT_EQUAL_INT(100, cJSON_GetKeyTableSize(table));
+    for (i = 0; i < 100; i++)
+    {
+        sprintf(name, "key%d", i);
+        TEST_ASSERT_EQUAL_DOUBLE(i, cJSON_GetObjectItemCaseSensitive(object, name)->valuedouble);
+    }
+    cJSON_Delete(object);
+
+    /* parsing it again finds every key */
+    object = parse_with_table(json, table);
+    TEST_ASSERT_NOT_NULL(object);
+    TEST_ASSERT_EQUAL_INT(100, cJSON_GetKeyTableSize(table));
+
+    cJSON_Delete(object);
+    cJSON_DeleteKeyTable(table);
+}
+
+static void key_table_should_not_leak_into_copies(void)
+{
+    cJSON_KeyTable *table = cJSON_CreateKeyTable(0);
+    cJSON *object = parse_with_table("{\"mode\":\"auto\",\"fanSpeed\":75}", table);
+    cJSON *copy = NULL;
+    cJSON *moved = NULL;
+    cJSON *target = cJSON_CreateObject();
+
+    TEST_ASSERT_NOT_NULL(object);
+
+    copy = cJSON_Duplicate(object, true);
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT_FALSE(copy->child->type & (cJSON_StringIsConst | cJSON_StringIsInterned));
+    TEST_ASSERT_TRUE(copy->child->string != object->child->string);
+
+    /* a member that is added under a new key owns that key */
+    moved = cJSON_DetachItemFromObjectCaseSensitive(object, "fanSpeed");
+    TEST_ASSERT_TRUE(cJSON_AddItemToObject(target, "speed", moved));
+    TEST_ASSERT_FALSE(moved->type & (cJSON_StringIsConst | cJSON_StringIsInterned));
+
+    cJSON_Delete(object);
+    cJSON_DeleteKeyTable(table);
+
+    TEST_ASSERT_EQUAL_STRING("mode", copy->child->string);
+    TEST_ASSERT_EQUAL_STRING("speed", target->child->string);
+    cJSON_Delete(copy);
+    cJSON_Delete(target);
+}
+
+static void key_table_should_handle_invalid_input(void)
+{
+    cJSON_KeyTable *table = cJSON_CreateKeyTable(0);
+
+    TEST_ASSERT_NULL(parse_with_table("{\"a\":1,\"b\":}", table));
+    TEST_ASSERT_NULL(parse_with_table("{\"unterminated", table));
+    TEST_ASSERT_NULL(cJSON_ParseWithKeyTable(NULL, 0, table));
+    TEST_ASSERT_NULL(cJSON_ParseWithKeyTable("{}", 3, NULL));
+    TEST_ASSERT_EQUAL_INT(0, cJSON_GetKeyTableSize(NULL));
+    cJSON_DeleteKeyTable(NULL);
+
+    cJSON_DeleteKeyTable(table);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(key_table_should_share_keys_between_records);
+    RUN_TEST(key_table_should_outlive_the_trees);
+    RUN_TEST(key_table_should_copy_escaped_keys);
+    RUN_TEST(key_table_should_stop_at_max_keys);
+    RUN_TEST(key_table_should_grow);
+    RUN_TEST(key_table_should_not_leak_into_copies);
+    RUN_TEST(key_table_should_handle_invalid_input);
+
+    return UNITY_END();
+}
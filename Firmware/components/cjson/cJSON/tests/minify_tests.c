@@ -158,6 +158,85 @@ static void cjson_minify_should_not_loop_infinitely(void) {
     cJSON_Minify(string);
 }
 
+static void cjson_minify_with_length_should_write_to_another_buffer(void)
+{
+    /* read only, and the length ends the input before the last member */
+    const char *to_minify = "{ \"key\" : [ 1, 2 ] /* comment */ ,\n\t\"other\": null }";
+    char minified[64];
+    size_t length = 0;
+
+    memset(minified, 'x', sizeof(minified));
+    length = cJSON_MinifyWithLength(to_minify, 34, minified);
+
+    TEST_ASSERT_EQUAL_INT(strlen("{\"key\":[1,2],"), length);
+    TEST_ASSERT_EQUAL_MEMORY("{\"key\":[1,2],", minified, length);
+    TEST_ASSERT_EQUAL_INT('x', minified[length]);
+}
+
+static void cjson_minify_with_length_should_work_in_place(void)
+{
+    char to_minify[] = "[ \"a b\" , // comment\n true ]";
+    size_t length = cJSON_MinifyWithLength(to_minify, strlen(to_minify), to_minify);
+
+    TEST_ASSERT_EQUAL_INT(strlen("[\"a b\",true]"), length);
+    TEST_ASSERT_EQUAL_MEMORY("[\"a b\",true]", to_minify, length);
+}
+
+static void cjson_minify_with_length_should_handle_null_pointers(void)
+{
+    char output[4];
+
+    TEST_ASSERT_EQUAL_INT(0, cJSON_MinifyWithLength(NULL, 4, output));
+    TEST_ASSERT_EQUAL_INT(0, cJSON_MinifyWithLength("[ ]", 3, NULL));
+}
+
+static void cjson_minify_should_keep_escaped_backslashes(void)
+{
+    char to_minify[] = "[ \"a\\\\\" , \" \\\" \" ]";
+
+    cJSON_Minify(to_minify);
+    TEST_ASSERT_EQUAL_STRING("[\"a\\\\\",\" \\\" \"]", to_minify);
+}
+
+static void cjson_minify_with_length_should_match_unformatted_print(void)
+{
+    /* long runs of indentation and long strings, so that whole blocks are copied */
+    cJSON *root = cJSON_CreateObject();
+    cJSON *items = cJSON_AddArrayToObject(root, "items");
+    char *formatted = NULL;
+    char *unformatted = NULL;
+    char *minified = NULL;
+    size_t length = 0;
+    int i = 0;
+
+    TEST_ASSERT_NOT_NULL(items);
+    for (i = 0; i < 20; i++)
+    {
+        cJSON *item = cJSON_CreateObject();
+        cJSON *nested = cJSON_AddObjectToObject(item, "nested");
+
+        cJSON_AddNumberToObject(item, "index", i);
+        cJSON_AddStringToObject(item, "text", "a string with spaces, // no comment /* at all */ and a \"quote\" \\ \t in it");
+        cJSON_AddObjectToObject(cJSON_AddObjectToObject(nested, "deeper"), "deepest");
+        cJSON_AddItemToArray(items, item);
+    }
+    formatted = cJSON_Print(root);
+    unformatted = cJSON_PrintUnformatted(root);
+    TEST_ASSERT_NOT_NULL(formatted);
+    TEST_ASSERT_NOT_NULL(unformatted);
+    minified = (char*)malloc(strlen(formatted));
+    TEST_ASSERT_NOT_NULL(minified);
+
+    length = cJSON_MinifyWithLength(formatted, strlen(formatted), minified);
+    TEST_ASSERT_EQUAL_INT(strlen(unformatted), length);
+    TEST_ASSERT_EQUAL_MEMORY(unformatted, minified, length);
+
+    free(minified);
+    cJSON_free(unformatted);
+    cJSON_free(formatted);
+    cJSON_Delete(root);
+}
+
 int CJSON_CDECL main(void)
 {
     UNITY_BEGIN();
@@ -169,6 +248,11 @@ int CJSON_CDECL main(void)
     RUN_TEST(cjson_minify_should_remove_spaces);
     RUN_TEST(cjson_minify_should_not_modify_strings);
     RUN_TEST(cjson_minify_should_not_loop_infinitely);
+    RUN_TEST(cjson_minify_should_keep_escaped_backslashes);
+    RUN_TEST(cjson_minify_with_length_should_write_to_another_buffer);
+    RUN_TEST(cjson_minify_with_length_should_work_in_place);
+    RUN_TEST(cjson_minify_with_length_should_handle_null_pointers);
+    RUN_TEST(cjson_minify_with_length_should_match_unformatted_print);
 
     return UNITY_END();
 }
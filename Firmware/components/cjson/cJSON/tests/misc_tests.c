@@ -238,7 +238,10 @@ static void cjson_should_not_follow_too_deep_circular_references(void)
 
 static void cjson_set_number_value_should_set_numbers(void)
 {
-    cJSON number[1] = {{NULL, NULL, NULL, cJSON_Number, NULL, 0, 0, NULL}};
+    cJSON number[1];
+
+    memset(number, '\0', sizeof(number));
+    number->type = cJSON_Number;
 
     cJSON_SetNumberValue(number, 1.5);
     TEST_ASSERT_EQUAL(1, number->valueint);
@@ -263,6 +266,7 @@ static void cjson_detach_item_via_pointer_should_detach_items(void)
     cJSON parent[1];
 
     memset(list, '\0', sizeof(list));
+    memset(parent, '\0', sizeof(parent));
 
     /* link the list */
     list[0].next = &(list[1]);
@@ -303,6 +307,7 @@ static void cjson_detach_item_via_pointer_should_return_null_if_item_prev_is_nul
     cJSON parent[1];
 
     memset(list, '\0', sizeof(list));
+    memset(parent, '\0', sizeof(parent));
 
     /* link the list */
     list[0].next = &(list[1]);
@@ -360,11 +365,13 @@ static void cjson_replace_item_via_pointer_should_replace_items(void)
 
 static void cjson_replace_item_in_object_should_preserve_name(void)
 {
-    cJSON root[1] = {{NULL, NULL, NULL, 0, NULL, 0, 0, NULL}};
+    cJSON root[1];
     cJSON *child = NULL;
     cJSON *replacement = NULL;
     cJSON_bool flag = false;
 
+    memset(root, '\0', sizeof(root));
+
     child = cJSON_CreateNumber(1);
     TEST_ASSERT_NOT_NULL(child);
     replacement = cJSON_CreateNumber(2);
@@ -525,7 +532,9 @@ static void ensure_should_fail_on_failed_realloc(void)
 static void skip_utf8_bom_should_skip_bom(void)
 {
     const unsigned char string[] = "\xEF\xBB\xBF{}";
-    parse_buffer buffer = {0, 0, 0, 0, {0, 0, 0}};
+    parse_buffer buffer;
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.nesting_limit = CJSON_NESTING_LIMIT;
     buffer.content = string;
     buffer.length = sizeof(string);
     buffer.hooks = global_hooks;
@@ -537,7 +546,9 @@ static void skip_utf8_bom_should_skip_bom(void)
 static void skip_utf8_bom_should_not_skip_bom_if_not_at_beginning(void)
 {
     const unsigned char string[] = " \xEF\xBB\xBF{}";
-    parse_buffer buffer = {0, 0, 0, 0, {0, 0, 0}};
+    parse_buffer buffer;
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.nesting_limit = CJSON_NESTING_LIMIT;
     buffer.content = string;
     buffer.length = sizeof(string);
     buffer.hooks = global_hooks;
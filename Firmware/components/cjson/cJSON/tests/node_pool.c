@@ -0,0 +1,260 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static size_t allocations = 0;
+static size_t frees = 0;
+static size_t locks = 0;
+static size_t unlocks = 0;
+static cJSON_bool fail_allocations = 0;
+
+static void * CJSON_CDECL counting_malloc(size_t size)
+{
+    if (fail_allocations)
+    {
+        return NULL;
+    }
+    allocations++;
+    return malloc(size);
+}
+
+static void CJSON_CDECL counting_free(void *pointer)
+{
+    if (pointer != NULL)
+    {
+        frees++;
+    }
+    free(pointer);
+}
+
+static void CJSON_CDECL counting_lock(void *context)
+{
+    TEST_ASSERT_TRUE(context == &locks);
+    TEST_ASSERT_TRUE(locks == unlocks);
+    locks++;
+}
+
+static void CJSON_CDECL counting_unlock(void *context)
+{
+    TEST_ASSERT_TRUE(context == &locks);
+    unlocks++;
+    TEST_ASSERT_TRUE(locks == unlocks);
+}
+
+static cJSON_Hooks counting_hooks = {
+    counting_malloc,
+    counting_free
+};
+
+static void use_pool(size_t nodes_per_slab)
+{
+    cJSON_PoolConfig pool;
+
+    pool.nodes_per_slab = nodes_per_slab;
+    pool.lock = counting_lock;
+    pool.unlock = counting_unlock;
+    pool.lock_context = &locks;
+
+    allocations = 0;
+    frees = 0;
+    locks = 0;
+    unlocks = 0;
+    fail_allocations = 0;
+    cJSON_InitHooksWithPool(&counting_hooks, &pool);
+}
+
+/* the shape of a command as the firmware receives it */
+static cJSON *create_command(void)
+{
+    cJSON *command = cJSON_CreateObject();
+    cJSON *payload = NULL;
+
+    if (command == NULL)
+    {
+        return NULL;
+    }
+    cJSON_AddStringToObject(command, "commandId", "6f1c2a9e");
+    cJSON_AddStringToObject(command, "commandType", "SET_FAN_SPEED");
+    payload = cJSON_AddObjectToObject(command, "payload");
+    cJSON_AddNumberToObject(payload, "fanSpeed", 75);
+    cJSON_AddStringToObject(command, "timestamp", "2025-01-15T10:30:00.000Z");
+
+    return command;
+}
+
+static void node_pool_should_be_off_by_default(void)
+{
+    cJSON_PoolStats stats;
+    cJSON *command = NULL;
+
+    cJSON_InitHooks(&counting_hooks);
+    allocations = 0;
+    command = create_command();
+    TEST_ASSERT_NOT_NULL(command);
+    /* 6 nodes, 5 keys and 3 strings */
+    TEST_ASSERT_EQUAL_UINT(14, (unsigned int)allocations);
+    cJSON_Delete(command);
+
+    cJSON_GetPoolStats(&stats);
+    TEST_ASSERT_TRUE(stats.hits == 0);
+    TEST_ASSERT_TRUE(stats.slabs == 0);
+
+    cJSON_InitHooks(NULL);
+}
+
+static void node_pool_should_recycle_nodes(void)
+{
+    cJSON_PoolStats stats;
+    cJSON *command = NULL;
+    size_t i = 0;
+
+    use_pool(64);
+    for (i = 0; i < 100; i++)
+    {
+        command = create_command();
+        TEST_ASSERT_NOT_NULL(command);
+        cJSON_Delete(command);
+    }
+
+    /* one slab, and only keys and strings come from malloc_fn */
+    TEST_ASSERT_EQUAL_UINT(1 + (100 * 8), (unsigned int)allocations);
+    cJSON_GetPoolStats(&stats);
+    TEST_ASSERT_TRUE(stats.slabs == 1);
+    /* the first command takes 6 new nodes, all later ones reuse them */
+    TEST_ASSERT_TRUE(stats.misses == 6);
+    TEST_ASSERT_TRUE(stats.hits == ((100 * 6) - 6));
+    TEST_ASSERT_TRUE(stats.in_use == 0);
+    TEST_ASSERT_TRUE(stats.high_water == 6);
+
+    cJSON_ReleasePoolCache();
+    cJSON_GetPoolStats(&stats);
+    TEST_ASSERT_TRUE(stats.in_use == 0);
+    TEST_ASSERT_TRUE(locks > 0);
+
+    cJSON_InitHooks(NULL);
+    TEST_ASSERT_TRUE(frees == allocations);
+}
+
+static void node_pool_should_add_slabs_when_running_out(void)
+{
+    cJSON_PoolStats stats;
+    cJSON *array = NULL;
+    size_t i = 0;
+
+    use_pool(4);
+    array = cJSON_CreateArray();
+    for (i = 0; i < 99; i++)
+    {
+        TEST_ASSERT_TRUE(cJSON_AddItemToArray(array, cJSON_CreateNull()));
+    }
+
+    cJSON_GetPoolStats(&stats);
+    TEST_ASSERT_TRUE(stats.slabs == 25);
+    TEST_ASSERT_TRUE(stats.misses == 100);
+    TEST_ASSERT_TRUE(stats.in_use == 100);
+    TEST_ASSERT_TRUE(stats.high_water == 100);
+    TEST_ASSERT_EQUAL_UINT(25, (unsigned int)allocations);
+
+    cJSON_Delete(array);
+    cJSON_ReleasePoolCache();
+    cJSON_GetPoolStats(&stats);
+    TEST_ASSERT_TRUE(stats.in_use == 0);
+    TEST_ASSERT_TRUE(stats.high_water == 100);
+
+    cJSON_InitHooks(NULL);
+    TEST_ASSERT_EQUAL_UINT(25, (unsigned int)frees);
+}
+
+static void node_pool_should_work_with_parsing_and_printing(void)
+{
+    const char json[] = "{\"a\":[1,2,{\"b\":null}],\"c\":\"d\",\"e\":{\"f\":true}}";
+    cJSON *parsed = NULL;
+    cJSON *duplicate = NULL;
+    char *printed = NULL;
+
+    use_pool(8);
+    parsed = cJSON_Parse(json);
+    TEST_ASSERT_NOT_NULL(parsed);
+    duplicate = cJSON_Duplicate(parsed, 1);
+    TEST_ASSERT_TRUE(cJSON_Compare(parsed, duplicate, 1));
+    cJSON_Delete(parsed);
+
+    printed = cJSON_PrintUnformatted(duplicate);
+    TEST_ASSERT_EQUAL_STRING(json, printed);
+    cJSON_free(printed);
+    cJSON_Delete(duplicate);
+
+    cJSON_InitHooks(NULL);
+    TEST_ASSERT_TRUE(frees == allocations);
+}
+
+static void node_pool_should_fail_if_slabs_cant_be_allocated(void)
+{
+    use_pool(16);
+    fail_allocations = 1;
+    TEST_ASSERT_NULL(cJSON_CreateNull());
+    TEST_ASSERT_NULL(cJSON_Parse("[1, 2, 3]"));
+    fail_allocations = 0;
+
+    cJSON_InitHooks(NULL);
+}
+
+static void node_pool_should_be_turned_off_by_init_hooks(void)
+{
+    cJSON_PoolStats stats;
+    cJSON *item = NULL;
+
+    use_pool(16);
+    cJSON_Delete(cJSON_CreateNull());
+    cJSON_InitHooks(&counting_hooks);
+    TEST_ASSERT_TRUE(frees == allocations);
+
+    allocations = 0;
+    item = cJSON_CreateNull();
+    TEST_ASSERT_TRUE(allocations == 1);
+    cJSON_Delete(item);
+    cJSON_GetPoolStats(&stats);
+    TEST_ASSERT_TRUE(stats.slabs == 0);
+
+    cJSON_InitHooks(NULL);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(node_pool_should_be_off_by_default);
+    RUN_TEST(node_pool_should_recycle_nodes);
+    RUN_TEST(node_pool_should_add_slabs_when_running_out);
+    RUN_TEST(node_pool_should_work_with_parsing_and_printing);
+    RUN_TEST(node_pool_should_fail_if_slabs_cant_be_allocated);
+    RUN_TEST(node_pool_should_be_turned_off_by_init_hooks);
+
+    return UNITY_END();
+}
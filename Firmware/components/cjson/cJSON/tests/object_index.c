@@ -0,0 +1,339 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+/* an object with the members "key0" = 0 to "key<count - 1>" = count - 1 */
+static cJSON *create_numbered_object(size_t count)
+{
+    cJSON *object = cJSON_CreateObject();
+    char key[32];
+    size_t i = 0;
+
+    TEST_ASSERT_NOT_NULL(object);
+    for (i = 0; i < count; i++)
+    {
+        sprintf(key, "key%u", (unsigned int)i);
+        TEST_ASSERT_NOT_NULL(cJSON_AddNumberToObject(object, key, (double)i));
+    }
+
+    return object;
+}
+
+static void assert_numbered_members(const cJSON * const object, size_t count)
+{
+    char key[32];
+    size_t i = 0;
+    cJSON *item = NULL;
+
+    for (i = 0; i < count; i++)
+    {
+        sprintf(key, "key%u", (unsigned int)i);
+        item = cJSON_GetObjectItemCaseSensitive(object, key);
+        TEST_ASSERT_NOT_NULL(item);
+        TEST_ASSERT_EQUAL_DOUBLE((double)i, item->valuedouble);
+
+        sprintf(key, "KEY%u", (unsigned int)i);
+        TEST_ASSERT_NULL(cJSON_GetObjectItemCaseSensitive(object, key));
+        TEST_ASSERT_TRUE(cJSON_GetObjectItem(object, key) == item);
+    }
+
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(object, "missing"));
+    sprintf(key, "key%u", (unsigned int)count);
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(object, key));
+}
+
+static void object_index_should_not_be_built_when_disabled(void)
+{
+    cJSON *object = create_numbered_object(64);
+
+    cJSON_SetIndexThreshold(0);
+    assert_numbered_members(object, 64);
+    TEST_ASSERT_NULL(object->index);
+
+    cJSON_Delete(object);
+}
+
+static void object_index_should_be_built_on_first_lookup_of_large_objects(void)
+{
+    cJSON *small = create_numbered_object(7);
+    cJSON *large = create_numbered_object(8);
+
+    cJSON_SetIndexThreshold(8);
+    TEST_ASSERT_NULL(large->index);
+
+    assert_numbered_members(small, 7);
+    assert_numbered_members(large, 8);
+    TEST_ASSERT_NULL(small->index);
+    TEST_ASSERT_NOT_NULL(large->index);
+
+    cJSON_Delete(small);
+    cJSON_Delete(large);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void object_index_should_find_the_first_of_duplicate_keys(void)
+{
+    cJSON *object = create_numbered_object(16);
+    cJSON *first = cJSON_CreateString("first");
+    cJSON *second = cJSON_CreateString("second");
+    cJSON *third = cJSON_CreateString("third");
+
+    cJSON_SetIndexThreshold(4);
+    TEST_ASSERT_TRUE(cJSON_AddItemToObject(object, "Duplicate", first));
+    TEST_ASSERT_TRUE(cJSON_AddItemToObject(object, "duplicate", second));
+    TEST_ASSERT_TRUE(cJSON_AddItemToObject(object, "duplicate", third));
+
+    TEST_ASSERT_TRUE(cJSON_GetObjectItem(object, "DUPLICATE") == first);
+    TEST_ASSERT_TRUE(cJSON_GetObjectItemCaseSensitive(object, "duplicate") == second);
+    TEST_ASSERT_NOT_NULL(object->index);
+
+    cJSON_DeleteItemFromObject(object, "duplicate");
+    TEST_ASSERT_NOT_NULL(object->index);
+    TEST_ASSERT_TRUE(cJSON_GetObjectItem(object, "DUPLICATE") == second);
+    cJSON_DeleteItemFromObjectCaseSensitive(object, "duplicate");
+    TEST_ASSERT_TRUE(cJSON_GetObjectItem(object, "DUPLICATE") == third);
+    assert_numbered_members(object, 16);
+
+    cJSON_Delete(object);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void object_index_should_be_kept_up_to_date_when_adding(void)
+{
+    cJSON *object = create_numbered_object(16);
+    cJSON_Index *index = NULL;
+    char key[32];
+    size_t i = 0;
+
+    cJSON_SetIndexThreshold(16);
+    assert_numbered_members(object, 16);
+    index = object->index;
+    TEST_ASSERT_NOT_NULL(index);
+
+    /* fits without growing */
+    TEST_ASSERT_NOT_NULL(cJSON_AddNumberToObject(object, "key16", 16));
+    TEST_ASSERT_TRUE(object->index == index);
+    assert_numbered_members(object, 17);
+
+    /* grows */
+    for (i = 17; i < 1000; i++)
+    {
+        sprintf(key, "key%u", (unsigned int)i);
+        TEST_ASSERT_NOT_NULL(cJSON_AddNumberToObject(object, key, (double)i));
+        TEST_ASSERT_NOT_NULL(cJSON_GetObjectItem(object, key));
+    }
+    assert_numbered_members(object, 1000);
+
+    cJSON_Delete(object);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void object_index_should_be_kept_up_to_date_when_detaching(void)
+{
+    cJSON *object = create_numbered_object(32);
+    cJSON *detached = NULL;
+
+    cJSON_SetIndexThreshold(16);
+    assert_numbered_members(object, 32);
+
+    detached = cJSON_DetachItemFromObject(object, "key31");
+    TEST_ASSERT_NOT_NULL(detached);
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(object, "key31"));
+    TEST_ASSERT_NOT_NULL(object->index);
+    assert_numbered_members(object, 31);
+
+    /* it can be added again after being removed */
+    TEST_ASSERT_TRUE(cJSON_AddItemToObject(object, "key31", detached));
+    assert_numbered_members(object, 32);
+
+    cJSON_DeleteItemFromArray(object, 0);
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(object, "key0"));
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItem(object, "key1"));
+
+    cJSON_Delete(object);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void object_index_should_be_kept_up_to_date_when_replacing(void)
+{
+    cJSON *object = create_numbered_object(32);
+    cJSON *replacement = cJSON_CreateString("replaced");
+    cJSON_Index *index = NULL;
+
+    cJSON_SetIndexThreshold(16);
+    assert_numbered_members(object, 32);
+    index = object->index;
+
+    TEST_ASSERT_TRUE(cJSON_ReplaceItemInObject(object, "KEY5", replacement));
+    TEST_ASSERT_TRUE(object->index == index);
+    TEST_ASSERT_TRUE(cJSON_GetObjectItemCaseSensitive(object, "KEY5") == replacement);
+    TEST_ASSERT_NULL(cJSON_GetObjectItemCaseSensitive(object, "key5"));
+
+    /* a replacement with a different key */
+    replacement = cJSON_CreateString("renamed");
+    replacement->string = (char*)cJSON_strdup((const unsigned char*)"renamed", &global_hooks);
+    TEST_ASSERT_TRUE(cJSON_ReplaceItemViaPointer(object, cJSON_GetObjectItem(object, "key6"), replacement));
+    TEST_ASSERT_TRUE(cJSON_GetObjectItem(object, "renamed") == replacement);
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(object, "key6"));
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItem(object, "key7"));
+
+    cJSON_Delete(object);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void object_index_should_be_kept_up_to_date_when_inserting(void)
+{
+    cJSON *object = create_numbered_object(16);
+    cJSON *inserted = cJSON_CreateString("inserted");
+
+    cJSON_SetIndexThreshold(16);
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItem(object, "key15"));
+
+    /* keys are not set by cJSON_InsertItemInArray */
+    inserted->string = (char*)cJSON_strdup((const unsigned char*)"key15", &global_hooks);
+    TEST_ASSERT_TRUE(cJSON_InsertItemInArray(object, 0, inserted));
+    TEST_ASSERT_TRUE(cJSON_GetObjectItem(object, "key15") == inserted);
+
+    cJSON_Delete(object);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void object_index_should_not_change_lookups_with_missing_keys(void)
+{
+    cJSON *object = create_numbered_object(16);
+
+    cJSON_SetIndexThreshold(4);
+    /* arrays members added to an object have no key, linear lookups stop there case sensitively */
+    TEST_ASSERT_TRUE(cJSON_AddItemToArray(object, cJSON_CreateNull()));
+    TEST_ASSERT_TRUE(cJSON_AddItemToObject(object, "after", cJSON_CreateTrue()));
+
+    TEST_ASSERT_NULL(cJSON_GetObjectItemCaseSensitive(object, "after"));
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItem(object, "after"));
+    TEST_ASSERT_NULL(object->index);
+
+    cJSON_Delete(object);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void object_index_should_not_be_built_for_references(void)
+{
+    cJSON *object = create_numbered_object(16);
+    cJSON *reference = cJSON_CreateObjectReference(object->child);
+    cJSON *container = cJSON_CreateObject();
+
+    cJSON_SetIndexThreshold(4);
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItem(reference, "key3"));
+    TEST_ASSERT_NULL(reference->index);
+
+    assert_numbered_members(object, 16);
+    TEST_ASSERT_TRUE(cJSON_AddItemReferenceToObject(container, "reference", object));
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(container, "reference")->index);
+
+    cJSON_Delete(container);
+    cJSON_Delete(reference);
+    cJSON_Delete(object);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void object_index_should_fall_back_to_the_list_for_colliding_keys(void)
+{
+    /* the hashes of these keys agree in their low 8 bits, more of them than a lookup probes want the same slot */
+    static const char *colliding[] =
+    {
+        "c714", "c1069", "c1375", "c1692", "c1726", "c1753", "c1872", "c1986", "c2042", "c2248", "c2550", "c2712",
+        "c2859", "c2925", "c2998", "c3193", "c3665", "c3719", "c4057", "c4251", "c4408", "c4501", "c4952", "c5050",
+        "c5212", "c5542", "c5748", "c5883", "c6244", "c6613", "c6666", "c6882", "c6929", "c7504", "c8026", "c8053",
+        "c8192", "c8475", "c8769", "c9018"
+    };
+    const size_t count = sizeof(colliding) / sizeof(colliding[0]);
+    cJSON *object = cJSON_CreateObject();
+    cJSON *item = NULL;
+    size_t i = 0;
+
+    cJSON_SetIndexThreshold(8);
+    for (i = 0; i < count; i++)
+    {
+        TEST_ASSERT_NOT_NULL(cJSON_AddNumberToObject(object, colliding[i], (double)i));
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        item = cJSON_GetObjectItemCaseSensitive(object, colliding[i]);
+        TEST_ASSERT_NOT_NULL(item);
+        TEST_ASSERT_EQUAL_DOUBLE((double)i, item->valuedouble);
+    }
+    TEST_ASSERT_NOT_NULL(object->index);
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(object, "missing"));
+    TEST_ASSERT_EQUAL_INT((int)count, cJSON_GetArraySize(object));
+
+    cJSON_DeleteItemFromObjectCaseSensitive(object, colliding[0]);
+    TEST_ASSERT_NOT_NULL(cJSON_AddNumberToObject(object, colliding[0], -1));
+    TEST_ASSERT_EQUAL_INT((int)count, cJSON_GetArraySize(object));
+    TEST_ASSERT_EQUAL_DOUBLE(-1, cJSON_GetObjectItemCaseSensitive(object, colliding[0])->valuedouble);
+    TEST_ASSERT_EQUAL_DOUBLE((double)(count - 1), cJSON_GetObjectItem(object, colliding[count - 1])->valuedouble);
+
+    cJSON_Delete(object);
+    cJSON_SetIndexThreshold(0);
+}
+
+static void object_index_should_work_with_parsed_objects(void)
+{
+    cJSON *object = NULL;
+
+    cJSON_SetIndexThreshold(2);
+    object = cJSON_Parse("{\"a\": 1, \"b\": {\"c\": 2, \"d\": 3}, \"e\": 4}");
+    TEST_ASSERT_NOT_NULL(object);
+
+    TEST_ASSERT_EQUAL_INT(2, cJSON_GetObjectItem(cJSON_GetObjectItem(object, "b"), "c")->valueint);
+    TEST_ASSERT_EQUAL_INT(4, cJSON_GetObjectItem(object, "E")->valueint);
+    TEST_ASSERT_NOT_NULL(object->index);
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItem(object, "b")->index);
+
+    cJSON_Delete(object);
+    cJSON_SetIndexThreshold(0);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(object_index_should_not_be_built_when_disabled);
+    RUN_TEST(object_index_should_be_built_on_first_lookup_of_large_objects);
+    RUN_TEST(object_index_should_find_the_first_of_duplicate_keys);
+    RUN_TEST(object_index_should_be_kept_up_to_date_when_adding);
+    RUN_TEST(object_index_should_be_kept_up_to_date_when_detaching);
+    RUN_TEST(object_index_should_be_kept_up_to_date_when_replacing);
+    RUN_TEST(object_index_should_be_kept_up_to_date_when_inserting);
+    RUN_TEST(object_index_should_not_change_lookups_with_missing_keys);
+    RUN_TEST(object_index_should_not_be_built_for_references);
+    RUN_TEST(object_index_should_fall_back_to_the_list_for_colliding_keys);
+    RUN_TEST(object_index_should_work_with_parsed_objects);
+
+    return UNITY_END();
+}
@@ -0,0 +1,164 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static const char document[] = "{\"fanSpeed\":75,\"FANSPEED\":1,\"mode\":\"auto\",\"key1\":1,\"key10\":10,\"key\":0,\"\":\"empty\"}";
+
+static void object_key_should_find_members_like_get_object_item(void)
+{
+    static const char * const names[] = { "fanSpeed", "FANSPEED", "fanspeed", "Mode", "mode", "key1", "KEY10", "key", "", "missing", "ke", "key100" };
+    cJSON *object = cJSON_Parse(document);
+    cJSON_Key key;
+    size_t i = 0;
+
+    TEST_ASSERT_NOT_NULL(object);
+    for (i = 0; i < (sizeof(names) / sizeof(names[0])); i++)
+    {
+        cJSON_InitKey(&key, names[i]);
+        TEST_ASSERT_EQUAL_INT(strlen(names[i]), key.length);
+        TEST_ASSERT_TRUE(cJSON_GetObjectItemKey(object, &key) == cJSON_GetObjectItem(object, names[i]));
+        TEST_ASSERT_TRUE(cJSON_GetObjectItemKeyCaseSensitive(object, &key) == cJSON_GetObjectItemCaseSensitive(object, names[i]));
+    }
+
+    cJSON_Delete(object);
+}
+
+static void object_key_should_compare_whole_keys(void)
+{
+    cJSON *object = cJSON_Parse(document);
+    cJSON_Key key;
+
+    TEST_ASSERT_NOT_NULL(object);
+
+    cJSON_InitKey(&key, "KEY1");
+    TEST_ASSERT_EQUAL_DOUBLE(1, cJSON_GetObjectItemKey(object, &key)->valuedouble);
+    TEST_ASSERT_NULL(cJSON_GetObjectItemKeyCaseSensitive(object, &key));
+
+    cJSON_InitKey(&key, "FanSpeed");
+    TEST_ASSERT_EQUAL_DOUBLE(75, cJSON_GetObjectItemKey(object, &key)->valuedouble);
+    cJSON_InitKey(&key, "FANSPEED");
+    TEST_ASSERT_EQUAL_DOUBLE(1, cJSON_GetObjectItemKeyCaseSensitive(object, &key)->valuedouble);
+
+    cJSON_InitKey(&key, "");
+    TEST_ASSERT_EQUAL_STRING("empty", cJSON_GetStringValue(cJSON_GetObjectItemKey(object, &key)));
+
+    cJSON_Delete(object);
+}
+
+static void object_key_should_use_the_index(void)
+{
+    cJSON *object = cJSON_Parse(document);
+    cJSON_Key key;
+
+    TEST_ASSERT_NOT_NULL(object);
+    cJSON_SetIndexThreshold(4);
+
+    cJSON_InitKey(&key, "MODE");
+    TEST_ASSERT_EQUAL_STRING("auto", cJSON_GetStringValue(cJSON_GetObjectItemKey(object, &key)));
+#ifdef ENABLE_CJSON_INDEX
+    TEST_ASSERT_NOT_NULL(object->index);
+#endif
+    TEST_ASSERT_NULL(cJSON_GetObjectItemKeyCaseSensitive(object, &key));
+    cJSON_InitKey(&key, "fanspeed");
+    TEST_ASSERT_EQUAL_DOUBLE(75, cJSON_GetObjectItemKey(object, &key)->valuedouble);
+    cJSON_InitKey(&key, "key10");
+    TEST_ASSERT_EQUAL_DOUBLE(10, cJSON_GetObjectItemKeyCaseSensitive(object, &key)->valuedouble);
+    cJSON_InitKey(&key, "key100");
+    TEST_ASSERT_NULL(cJSON_GetObjectItemKey(object, &key));
+
+    cJSON_SetIndexThreshold(0);
+    cJSON_Delete(object);
+}
+
+static void object_key_should_only_fold_ascii(void)
+{
+    cJSON *object = cJSON_Parse("{\"\xC3\x84rger\":1,\"[\":2}");
+    cJSON_Key key;
+
+    TEST_ASSERT_NOT_NULL(object);
+
+    /* 'A' + 32 is 'a', but '[' + 32 is '{' and UTF-8 isn't folded at all */
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(object, "\xC3\xA4rger"));
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItem(object, "\xC3\x84RGER"));
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(object, "{"));
+    cJSON_InitKey(&key, "\xC3\xA4rger");
+    TEST_ASSERT_NULL(cJSON_GetObjectItemKey(object, &key));
+    cJSON_InitKey(&key, "{");
+    TEST_ASSERT_NULL(cJSON_GetObjectItemKey(object, &key));
+
+    cJSON_Delete(object);
+}
+
+static void object_key_should_skip_members_without_a_key(void)
+{
+    cJSON *object = cJSON_CreateObject();
+    cJSON_Key key;
+
+    /* a member without a key ends case sensitive lookups, like it always did */
+    cJSON_AddItemToArray(object, cJSON_CreateNull());
+    cJSON_AddNumberToObject(object, "after", 1);
+
+    cJSON_InitKey(&key, "after");
+    TEST_ASSERT_TRUE(cJSON_GetObjectItemKey(object, &key) == cJSON_GetObjectItem(object, "after"));
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItemKey(object, &key));
+    TEST_ASSERT_NULL(cJSON_GetObjectItemKeyCaseSensitive(object, &key));
+    TEST_ASSERT_NULL(cJSON_GetObjectItemCaseSensitive(object, "after"));
+
+    cJSON_Delete(object);
+}
+
+static void object_key_should_handle_null(void)
+{
+    cJSON *object = cJSON_CreateObject();
+    cJSON_Key key;
+
+    cJSON_InitKey(NULL, "key");
+    cJSON_InitKey(&key, NULL);
+    TEST_ASSERT_NULL(key.string);
+    TEST_ASSERT_NULL(cJSON_GetObjectItemKey(object, &key));
+    TEST_ASSERT_NULL(cJSON_GetObjectItemKey(object, NULL));
+    cJSON_InitKey(&key, "key");
+    TEST_ASSERT_NULL(cJSON_GetObjectItemKey(NULL, &key));
+
+    cJSON_Delete(object);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(object_key_should_find_members_like_get_object_item);
+    RUN_TEST(object_key_should_compare_whole_keys);
+    RUN_TEST(object_key_should_use_the_index);
+    RUN_TEST(object_key_should_only_fold_ascii);
+    RUN_TEST(object_key_should_skip_members_without_a_key);
+    RUN_TEST(object_key_should_handle_null);
+
+    return UNITY_END();
+}
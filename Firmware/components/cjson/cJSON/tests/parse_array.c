@@ -44,7 +44,9 @@ static void assert_is_array(cJSON *array_item)
 
 static void assert_not_array(const char *json)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer buffer;
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.nesting_limit = CJSON_NESTING_LIMIT;
     buffer.content = (const unsigned char*)json;
     buffer.length = strlen(json) + sizeof("");
     buffer.hooks = global_hooks;
@@ -55,7 +57,9 @@ static void assert_not_array(const char *json)
 
 static void assert_parse_array(const char *json)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer buffer;
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.nesting_limit = CJSON_NESTING_LIMIT;
     buffer.content = (const unsigned char*)json;
     buffer.length = strlen(json) + sizeof("");
     buffer.hooks = global_hooks;
@@ -142,6 +146,31 @@ static void parse_array_should_parse_arrays_with_multiple_elements(void)
     }
 }
 
+static void parse_array_should_skip_whitespace_runs_of_any_length(void)
+{
+    char json[256];
+    size_t length = 0;
+
+    for (length = 0; length < 70; length++)
+    {
+        /* "[" whitespace "1," whitespace "2" whitespace "]" */
+        json[0] = '[';
+        memset(json + 1, (length % 2) ? ' ' : '\t', length);
+        memcpy(json + 1 + length, "1,", 2);
+        memset(json + 3 + length, '\n', length);
+        json[3 + 2 * length] = '2';
+        memset(json + 4 + 2 * length, '\r', length / 2);
+        json[4 + 2 * length + length / 2] = ']';
+        json[5 + 2 * length + length / 2] = '\0';
+
+        assert_parse_array(json);
+        TEST_ASSERT_NOT_NULL(item->child);
+        TEST_ASSERT_NOT_NULL(item->child->next);
+        TEST_ASSERT_EQUAL_INT(2, item->child->next->valueint);
+        reset(item);
+    }
+}
+
 static void parse_array_should_not_parse_non_arrays(void)
 {
     assert_not_array("");
@@ -162,6 +191,7 @@ int CJSON_CDECL main(void)
     RUN_TEST(parse_array_should_parse_empty_arrays);
     RUN_TEST(parse_array_should_parse_arrays_with_one_element);
     RUN_TEST(parse_array_should_parse_arrays_with_multiple_elements);
+    RUN_TEST(parse_array_should_skip_whitespace_runs_of_any_length);
     RUN_TEST(parse_array_should_not_parse_non_arrays);
     return UNITY_END();
 }
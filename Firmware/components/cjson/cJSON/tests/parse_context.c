@@ -0,0 +1,330 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef CJSON_TEST_THREADS
+#include <pthread.h>
+#endif
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static cJSON *parse_with_context(const char *json, cJSON_ParseContext *context)
+{
+    return cJSON_ParseWithContext(json, strlen(json) + sizeof(""), context);
+}
+
+static void parse_context_should_report_like_the_global_error(void)
+{
+    static const char * const inputs[] = { "{\"a\":1} trailing", "[1,2,}", "{\"a\" 1}", "\"unterminated", "", "  ", "nul", "[[]]" };
+    cJSON_ParseContext context;
+    const char *end = NULL;
+    cJSON *expected = NULL;
+    cJSON *actual = NULL;
+    size_t i = 0;
+
+    for (i = 0; i < (sizeof(inputs) / sizeof(inputs[0])); i++)
+    {
+        end = NULL;
+        expected = cJSON_ParseWithOpts(inputs[i], &end, false);
+        cJSON_InitParseContext(&context);
+        actual = parse_with_context(inputs[i], &context);
+
+        TEST_ASSERT_TRUE(context.end == end);
+        if (expected == NULL)
+        {
+            TEST_ASSERT_NULL(actual);
+            TEST_ASSERT_TRUE(context.error == cJSON_GetErrorPtr());
+            TEST_ASSERT_NOT_NULL(context.error);
+        }
+        else
+        {
+            TEST_ASSERT_NULL(context.error);
+            TEST_ASSERT_TRUE(cJSON_Compare(expected, actual, true));
+        }
+
+        cJSON_Delete(expected);
+        cJSON_Delete(actual);
+    }
+}
+
+static void parse_context_should_leave_the_global_error_alone(void)
+{
+    static const char legacy[] = "[1,}";
+    static const char json[] = "{\"a\":}";
+    cJSON_ParseContext context;
+
+    TEST_ASSERT_NULL(cJSON_Parse(legacy));
+    TEST_ASSERT_TRUE(cJSON_GetErrorPtr() == legacy + 3);
+
+    cJSON_InitParseContext(&context);
+    TEST_ASSERT_NULL(parse_with_context(json, &context));
+    TEST_ASSERT_TRUE(context.error == json + 5);
+    TEST_ASSERT_TRUE(cJSON_GetErrorPtr() == legacy + 3);
+}
+
+static void parse_context_should_require_null_termination(void)
+{
+    static const char json[] = "{\"a\":1} \n";
+    static const char garbage[] = "{\"a\":1} x";
+    cJSON_ParseContext context;
+    cJSON *item = NULL;
+
+    cJSON_InitParseContext(&context);
+    context.require_null_terminated = true;
+
+    item = parse_with_context(json, &context);
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_TRUE(context.end == json + strlen(json));
+    cJSON_Delete(item);
+
+    TEST_ASSERT_NULL(parse_with_context(garbage, &context));
+    TEST_ASSERT_TRUE(context.error == garbage + 8);
+}
+
+static void parse_context_should_limit_nesting(void)
+{
+    char deep[CJSON_NESTING_LIMIT + 3];
+    cJSON_ParseContext context;
+    cJSON *item = NULL;
+
+    cJSON_InitParseContext(&context);
+    context.nesting_limit = 2;
+
+    item = parse_with_context("[{\"a\":1}]", &context);
+    TEST_ASSERT_NOT_NULL(item);
+    cJSON_Delete(item);
+    TEST_ASSERT_NULL(parse_with_context("[{\"a\":[]}]", &context));
+    TEST_ASSERT_NULL(parse_with_context("{\"a\":{\"b\":{}}}", &context));
+
+    /* the limit can't be raised above CJSON_NESTING_LIMIT */
+    memset(deep, '[', CJSON_NESTING_LIMIT + 1);
+    deep[CJSON_NESTING_LIMIT + 1] = '\0';
+    context.nesting_limit = CJSON_NESTING_LIMIT + 10;
+    TEST_ASSERT_NULL(parse_with_context(deep, &context));
+    TEST_ASSERT_TRUE(context.error == deep + CJSON_NESTING_LIMIT);
+    context.nesting_limit = 0;
+    TEST_ASSERT_NULL(parse_with_context(deep, &context));
+    TEST_ASSERT_TRUE(context.error == deep + CJSON_NESTING_LIMIT);
+}
+
+static void parse_context_should_combine_options(void)
+{
+    static const char json[] = "[{\"mode\":\"auto\"},{\"mode\":\"manual\"}]";
+    char in_situ[sizeof(json)];
+    union
+    {
+        double alignment;
+        unsigned char memory[2048];
+    } block;
+    cJSON_ParseContext context;
+    cJSON_Arena arena;
+    cJSON *item = NULL;
+
+    cJSON_InitArena(&arena, block.memory, sizeof(block.memory));
+    cJSON_InitParseContext(&context);
+    context.arena = &arena;
+    context.key_table = cJSON_CreateKeyTable(0);
+    TEST_ASSERT_NOT_NULL(context.key_table);
+
+    item = parse_with_context(json, &context);
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_TRUE(item->type & cJSON_ItemInArena);
+    TEST_ASSERT_TRUE(item->child->child->string == item->child->next->child->string);
+    TEST_ASSERT_EQUAL_INT(1, cJSON_GetKeyTableSize(context.key_table));
+    cJSON_Delete(item);
+    cJSON_ResetArena(&arena);
+
+    /* a failed parse doesn't use up the arena */
+    TEST_ASSERT_NULL(parse_with_context("[{\"mode\":\"auto\"},", &context));
+    TEST_ASSERT_EQUAL_INT(0, arena.used);
+    cJSON_DeleteKeyTable(context.key_table);
+
+    memcpy(in_situ, json, sizeof(json));
+    cJSON_InitParseContext(&context);
+    context.in_situ = true;
+    item = parse_with_context(in_situ, &context);
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_TRUE((item->child->child->valuestring > in_situ) && (item->child->child->valuestring < (in_situ + sizeof(in_situ))));
+    cJSON_Delete(item);
+}
+
+static void parse_context_should_handle_null(void)
+{
+    cJSON_ParseContext context;
+
+    cJSON_InitParseContext(NULL);
+    TEST_ASSERT_NULL(cJSON_ParseWithContext("{}", 3, NULL));
+
+    cJSON_InitParseContext(&context);
+    TEST_ASSERT_NULL(cJSON_ParseWithContext(NULL, 0, &context));
+    TEST_ASSERT_NULL(context.error);
+    TEST_ASSERT_NULL(context.end);
+}
+
+/* the SAX and tape parsers report the positions of their shortcuts, but leave the global error alone */
+static void parse_context_should_report_sax_and_tape_errors(void)
+{
+    static const char legacy[] = "[1,}";
+    static const char * const inputs[] = { "{\"a\":1} trailing", "[1,2,}", "{\"a\" 1}", "\"unterminated", "nul", "[[]]" };
+    cJSON_SAXHandler handler;
+    cJSON_ParseContext context;
+    cJSON_Tape *tape = NULL;
+    const char *expected_error = NULL;
+    cJSON_bool expected = false;
+    char scratch[16];
+    size_t i = 0;
+
+    memset(&handler, '\0', sizeof(handler));
+    for (i = 0; i < (sizeof(inputs) / sizeof(inputs[0])); i++)
+    {
+        const size_t length = strlen(inputs[i]);
+
+        expected = cJSON_ParseSAX(inputs[i], length, &handler, NULL, scratch, sizeof(scratch));
+        expected_error = expected ? NULL : cJSON_GetErrorPtr();
+        TEST_ASSERT_NULL(cJSON_Parse(legacy));
+
+        cJSON_InitParseContext(&context);
+        TEST_ASSERT_EQUAL_INT(expected, cJSON_ParseSAXWithContext(inputs[i], length, &handler, NULL, scratch, sizeof(scratch), &context));
+        TEST_ASSERT_TRUE(context.error == expected_error);
+        TEST_ASSERT_TRUE(cJSON_GetErrorPtr() == legacy + 3);
+
+        tape = cJSON_ParseTape(inputs[i], length);
+        expected_error = (tape != NULL) ? NULL : cJSON_GetErrorPtr();
+        cJSON_DeleteTape(tape);
+        TEST_ASSERT_NULL(cJSON_Parse(legacy));
+
+        tape = cJSON_ParseTapeWithContext(inputs[i], length, &context);
+        TEST_ASSERT_TRUE((tape != NULL) == (expected_error == NULL));
+        TEST_ASSERT_TRUE(context.error == expected_error);
+        TEST_ASSERT_TRUE(cJSON_GetErrorPtr() == legacy + 3);
+        cJSON_DeleteTape(tape);
+    }
+
+    /* anything may follow a SAX document */
+    TEST_ASSERT_TRUE(cJSON_ParseSAXWithContext(inputs[0], strlen(inputs[0]), &handler, NULL, scratch, sizeof(scratch), &context));
+    TEST_ASSERT_TRUE(context.end == inputs[0] + 7);
+    TEST_ASSERT_FALSE(cJSON_ParseSAXWithContext(inputs[0], strlen(inputs[0]), &handler, NULL, scratch, sizeof(scratch), NULL));
+    TEST_ASSERT_NULL(cJSON_ParseTapeWithContext(inputs[5], strlen(inputs[5]), NULL));
+}
+
+#ifdef CJSON_TEST_THREADS
+#define stress_threads 8
+#define stress_iterations 2000
+
+typedef struct
+{
+    char invalid[64];
+    size_t error_offset;
+    unsigned long failures;
+} stress_worker;
+
+static const char stress_document[] = "{\"deviceId\":\"device_esp32_001\",\"temperature\":24.5,\"pm25\":12.75,\"fanSpeed\":75,\"powerState\":\"ON\"}";
+
+static const cJSON_SAXHandler stress_handler = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+
+static void *stress_parse(void *argument)
+{
+    stress_worker *worker = (stress_worker*)argument;
+    cJSON_ParseContext context;
+    cJSON *item = NULL;
+    int i = 0;
+
+    for (i = 0; i < stress_iterations; i++)
+    {
+        cJSON_InitParseContext(&context);
+        item = parse_with_context(stress_document, &context);
+        if ((item == NULL) || (context.error != NULL) || (cJSON_GetNumberValue(cJSON_GetObjectItemCaseSensitive(item, "fanSpeed")) != 75))
+        {
+            worker->failures++;
+        }
+        cJSON_Delete(item);
+
+        /* every thread fails at its own position, a context that was shared would mix them up */
+        item = parse_with_context(worker->invalid, &context);
+        if ((item != NULL) || (context.error != (worker->invalid + worker->error_offset)))
+        {
+            worker->failures++;
+        }
+        cJSON_Delete(item);
+
+        if (cJSON_ParseSAXWithContext(worker->invalid, sizeof(worker->invalid), &stress_handler, NULL, NULL, 0, &context)
+                || (context.error != (worker->invalid + worker->error_offset)))
+        {
+            worker->failures++;
+        }
+    }
+
+    return NULL;
+}
+
+static void parse_context_should_be_reentrant(void)
+{
+    stress_worker workers[stress_threads];
+    pthread_t threads[stress_threads];
+    size_t i = 0;
+
+    for (i = 0; i < stress_threads; i++)
+    {
+        memset(&workers[i], '\0', sizeof(workers[i]));
+        /* [1,1,...,} with i + 1 elements fails on the brace */
+        memset(workers[i].invalid, '\0', sizeof(workers[i].invalid));
+        workers[i].invalid[0] = '[';
+        workers[i].error_offset = 1;
+        while (workers[i].error_offset < (2 * (i + 1)))
+        {
+            workers[i].invalid[workers[i].error_offset++] = '1';
+            workers[i].invalid[workers[i].error_offset++] = ',';
+        }
+        workers[i].invalid[workers[i].error_offset] = '}';
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, stress_parse, &workers[i]));
+    }
+
+    for (i = 0; i < stress_threads; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(threads[i], NULL));
+        TEST_ASSERT_EQUAL_INT(0, workers[i].failures);
+    }
+}
+#endif
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(parse_context_should_report_like_the_global_error);
+    RUN_TEST(parse_context_should_leave_the_global_error_alone);
+    RUN_TEST(parse_context_should_require_null_termination);
+    RUN_TEST(parse_context_should_limit_nesting);
+    RUN_TEST(parse_context_should_combine_options);
+    RUN_TEST(parse_context_should_handle_null);
+    RUN_TEST(parse_context_should_report_sax_and_tape_errors);
+#ifdef CJSON_TEST_THREADS
+    RUN_TEST(parse_context_should_be_reentrant);
+#endif
+
+    return UNITY_END();
+}
@@ -0,0 +1,210 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static size_t allocations = 0;
+
+static void * CJSON_CDECL counting_malloc(size_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+/* work around MSVC error C2322: '...' address of dllimport '...' is not static */
+static void CJSON_CDECL normal_free(void *pointer)
+{
+    free(pointer);
+}
+
+static cJSON_Hooks counting_hooks = {
+    counting_malloc,
+    normal_free
+};
+
+static cJSON *parse_in_situ(char *json)
+{
+    return cJSON_ParseInSitu(json, strlen(json) + sizeof(""));
+}
+
+static void assert_in_buffer(const char *pointer, const char *buffer, size_t length)
+{
+    TEST_ASSERT_TRUE_MESSAGE((pointer >= buffer) && (pointer < (buffer + length)), "String is not inside of the input buffer.");
+}
+
+static void parse_in_situ_should_point_into_the_input(void)
+{
+    char json[] = "{\"commandId\":\"cmd-1\",\"commandType\":\"POWER_ON\",\"payload\":{\"fanSpeed\":40}}";
+    cJSON *root = NULL;
+    cJSON *id = NULL;
+
+    allocations = 0;
+    cJSON_InitHooks(&counting_hooks);
+    root = parse_in_situ(json);
+    cJSON_InitHooks(NULL);
+    TEST_ASSERT_NOT_NULL(root);
+
+    /* only the 5 items are allocated, no strings */
+    TEST_ASSERT_EQUAL_INT(5, allocations);
+
+    id = cJSON_GetObjectItem(root, "commandId");
+    TEST_ASSERT_EQUAL_STRING("cmd-1", id->valuestring);
+    TEST_ASSERT_EQUAL_STRING("commandId", id->string);
+    assert_in_buffer(id->valuestring, json, sizeof(json));
+    assert_in_buffer(id->string, json, sizeof(json));
+    TEST_ASSERT_BITS(cJSON_StringIsConst | cJSON_ValuestringIsConst, cJSON_StringIsConst | cJSON_ValuestringIsConst, id->type);
+
+    TEST_ASSERT_EQUAL_STRING("POWER_ON", cJSON_GetObjectItem(root, "commandType")->valuestring);
+    TEST_ASSERT_EQUAL_INT(40, cJSON_GetObjectItem(cJSON_GetObjectItem(root, "payload"), "fanSpeed")->valueint);
+
+    cJSON_Delete(root);
+}
+
+static void parse_in_situ_should_unescape_in_place(void)
+{
+    char json[] = "[\"\\\"quoted\\\"\",\"back\\\\slash\",\"\\/\\b\\f\\n\\r\\t\",\"\\u0041\\u00e4\\u20ac\",\"\"]";
+    cJSON *root = parse_in_situ(json);
+    cJSON *element = NULL;
+
+    TEST_ASSERT_NOT_NULL(root);
+    TEST_ASSERT_EQUAL_INT(5, cJSON_GetArraySize(root));
+
+    cJSON_ArrayForEach(element, root)
+    {
+        assert_in_buffer(element->valuestring, json, sizeof(json));
+    }
+
+    TEST_ASSERT_EQUAL_STRING("\"quoted\"", cJSON_GetArrayItem(root, 0)->valuestring);
+    TEST_ASSERT_EQUAL_STRING("back\\slash", cJSON_GetArrayItem(root, 1)->valuestring);
+    TEST_ASSERT_EQUAL_STRING("/\b\f\n\r\t", cJSON_GetArrayItem(root, 2)->valuestring);
+    TEST_ASSERT_EQUAL_STRING("A\xC3\xA4\xE2\x82\xAC", cJSON_GetArrayItem(root, 3)->valuestring);
+    TEST_ASSERT_EQUAL_STRING("", cJSON_GetArrayItem(root, 4)->valuestring);
+
+    cJSON_Delete(root);
+}
+
+static void parse_in_situ_should_decode_surrogate_pairs(void)
+{
+    char json[] = "{\"\\ud83d\\ude00 key\":\"\\uD834\\uDD1E clef\",\"next\":\"\\ud83d\\ude00\"}";
+    cJSON *root = parse_in_situ(json);
+    cJSON *first = NULL;
+
+    TEST_ASSERT_NOT_NULL(root);
+    first = root->child;
+    TEST_ASSERT_EQUAL_STRING("\xF0\x9F\x98\x80 key", first->string);
+    TEST_ASSERT_EQUAL_STRING("\xF0\x9D\x84\x9E clef", first->valuestring);
+    TEST_ASSERT_EQUAL_STRING("\xF0\x9F\x98\x80", cJSON_GetObjectItem(root, "next")->valuestring);
+
+    cJSON_Delete(root);
+}
+
+static void parse_in_situ_should_match_regular_parse(void)
+{
+    const char original[] = "{\"a\\tb\":[1,2.5,\"x\\u00fcy\",{\"n\":null,\"t\":true,\"f\":false}],\"\\\\\":\"\\\"\"}";
+    char json[sizeof(original)];
+    cJSON *in_situ = NULL;
+    cJSON *regular = NULL;
+
+    memcpy(json, original, sizeof(original));
+    in_situ = parse_in_situ(json);
+    regular = cJSON_Parse(original);
+    TEST_ASSERT_NOT_NULL(in_situ);
+    TEST_ASSERT_NOT_NULL(regular);
+    TEST_ASSERT_TRUE(cJSON_Compare(in_situ, regular, true));
+
+    cJSON_Delete(in_situ);
+    cJSON_Delete(regular);
+}
+
+static void parse_in_situ_should_fail_on_invalid_escapes(void)
+{
+    char invalid_escape[] = "[\"abc\\x\"]";
+    char lone_surrogate[] = "[\"\\ud83d\"]";
+    char invalid_second_half[] = "[\"\\ud83d\\u0041\"]";
+    char unterminated[] = "{\"key\":\"value";
+
+    TEST_ASSERT_NULL(parse_in_situ(invalid_escape));
+    TEST_ASSERT_NULL(parse_in_situ(lone_surrogate));
+    TEST_ASSERT_NULL(parse_in_situ(invalid_second_half));
+    TEST_ASSERT_NULL(parse_in_situ(unterminated));
+}
+
+static void parse_in_situ_should_work_with_an_arena(void)
+{
+    char json[] = "{\"commandId\":\"c\\u0031\",\"payload\":{\"fanSpeed\":99}}";
+    double memory[64];
+    cJSON_Arena arena;
+    cJSON *root = NULL;
+
+    cJSON_InitArena(&arena, memory, sizeof(memory));
+    cJSON_InitHooks(&counting_hooks);
+    allocations = 0;
+    root = cJSON_ParseInSituWithArena(json, sizeof(json), &arena);
+    cJSON_InitHooks(NULL);
+
+    TEST_ASSERT_NOT_NULL(root);
+    TEST_ASSERT_EQUAL_INT(0, allocations);
+    /* only items in the arena, the strings stay in the input */
+    TEST_ASSERT_TRUE(arena.used <= (4 * arena_round_up(sizeof(cJSON))) + arena_round_up(sizeof("99")));
+    TEST_ASSERT_EQUAL_STRING("c1", cJSON_GetObjectItem(root, "commandId")->valuestring);
+    TEST_ASSERT_EQUAL_INT(99, cJSON_GetObjectItem(cJSON_GetObjectItem(root, "payload"), "fanSpeed")->valueint);
+
+    cJSON_ResetArena(&arena);
+}
+
+static void in_situ_items_should_be_duplicated_into_owned_memory(void)
+{
+    char json[] = "{\"key\":\"value\"}";
+    cJSON *root = parse_in_situ(json);
+    cJSON *copy = NULL;
+
+    TEST_ASSERT_NOT_NULL(root);
+    copy = cJSON_Duplicate(root, true);
+    cJSON_Delete(root);
+    memset(json, 'x', sizeof(json) - 1);
+
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT_EQUAL_STRING("key", copy->child->string);
+    TEST_ASSERT_EQUAL_STRING("value", copy->child->valuestring);
+    cJSON_Delete(copy);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(parse_in_situ_should_point_into_the_input);
+    RUN_TEST(parse_in_situ_should_unescape_in_place);
+    RUN_TEST(parse_in_situ_should_decode_surrogate_pairs);
+    RUN_TEST(parse_in_situ_should_match_regular_parse);
+    RUN_TEST(parse_in_situ_should_fail_on_invalid_escapes);
+    RUN_TEST(parse_in_situ_should_work_with_an_arena);
+    RUN_TEST(in_situ_items_should_be_duplicated_into_owned_memory);
+
+    return UNITY_END();
+}
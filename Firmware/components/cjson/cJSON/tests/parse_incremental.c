@@ -0,0 +1,365 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+/* every event is appended to the log in a compact text form */
+typedef struct
+{
+    char log[512];
+    size_t events;
+    size_t stop_after;
+    const char *last_string;
+} event_log;
+
+static size_t allocations = 0;
+
+static void * CJSON_CDECL counting_malloc(size_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+/* work around MSVC error C2322: '...' address of dllimport '...' is not static */
+static void CJSON_CDECL normal_free(void *pointer)
+{
+    free(pointer);
+}
+
+static cJSON_Hooks counting_hooks = {
+    counting_malloc,
+    normal_free
+};
+
+static cJSON_bool log_event(event_log *events, const char *text, size_t length)
+{
+    size_t used = strlen(events->log);
+
+    TEST_ASSERT_TRUE_MESSAGE((used + length + 2) < sizeof(events->log), "Event log overflow.");
+    memcpy(events->log + used, text, length);
+    events->log[used + length] = ' ';
+    events->log[used + length + 1] = '\0';
+
+    events->events++;
+    return (events->stop_after == 0) || (events->events < events->stop_after);
+}
+
+static cJSON_bool on_start_object(void *user_data)
+{
+    return log_event((event_log*)user_data, "{", 1);
+}
+
+static cJSON_bool on_end_object(void *user_data)
+{
+    return log_event((event_log*)user_data, "}", 1);
+}
+
+static cJSON_bool on_start_array(void *user_data)
+{
+    return log_event((event_log*)user_data, "[", 1);
+}
+
+static cJSON_bool on_end_array(void *user_data)
+{
+    return log_event((event_log*)user_data, "]", 1);
+}
+
+static cJSON_bool on_key(void *user_data, const char *key, size_t length)
+{
+    event_log *events = (event_log*)user_data;
+    char text[64];
+
+    TEST_ASSERT_TRUE(length < (sizeof(text) - 1));
+    text[0] = ':';
+    memcpy(text + 1, key, length);
+    return log_event(events, text, length + 1);
+}
+
+static cJSON_bool on_string(void *user_data, const char *string, size_t length)
+{
+    event_log *events = (event_log*)user_data;
+
+    events->last_string = string;
+    return log_event(events, string, length);
+}
+
+static cJSON_bool on_number(void *user_data, double number)
+{
+    char text[32];
+
+    sprintf(text, "%g", number);
+    return log_event((event_log*)user_data, text, strlen(text));
+}
+
+static cJSON_bool on_boolean(void *user_data, cJSON_bool boolean)
+{
+    return boolean ? log_event((event_log*)user_data, "true", 4) : log_event((event_log*)user_data, "false", 5);
+}
+
+static cJSON_bool on_null(void *user_data)
+{
+    return log_event((event_log*)user_data, "null", 4);
+}
+
+static const cJSON_SAXHandler logging_handler = {
+    on_start_object,
+    on_end_object,
+    on_start_array,
+    on_end_array,
+    on_key,
+    on_string,
+    on_number,
+    on_boolean,
+    on_null
+};
+
+/* feed json in two chunks split at split, or byte by byte if split is 0 */
+static cJSON_bool parse_in_chunks(cJSON_Parser *parser, const char *json, size_t split, event_log *events)
+{
+    const size_t length = strlen(json);
+    size_t i = 0;
+
+    memset(events, '\0', sizeof(*events));
+    cJSON_ResetParser(parser);
+
+    if (split > 0)
+    {
+        if (!cJSON_ParserFeed(parser, json, split) || !cJSON_ParserFeed(parser, json + split, length - split))
+        {
+            return false;
+        }
+        return cJSON_ParserFinish(parser);
+    }
+
+    for (i = 0; i < length; i++)
+    {
+        if (!cJSON_ParserFeed(parser, json + i, 1))
+        {
+            return false;
+        }
+    }
+
+    return cJSON_ParserFinish(parser);
+}
+
+static const char *documents[] = {
+    "{\"a\": [1, 2.5, -3e2], \"b\": {\"c\": null, \"d\": true}, \"e\": false, \"f\": \"text\", \"g\": [], \"h\": {}}",
+    "[\"a\\tb\\u00e4\", \"\\ud83d\\ude00\", \"\\\\\", \"\\\"quoted\\\"\", \"\"]",
+    "{\"commandId\":\"6f1c2a9e-8d4b-4a57-9e2f-3b1d7c0a5e11\",\"commandType\":\"SET_FAN_SPEED\",\"payload\":{\"fanSpeed\":75}}",
+    "  [ [ [ ] , { } ] , -0.5E-3 , 123456789012 , true ]  ",
+    "\"single\"",
+    "null"
+};
+
+static void parser_should_report_the_events_of_parse_sax_at_any_split(void)
+{
+    cJSON_Parser *parser = NULL;
+    event_log expected;
+    event_log events;
+    char scratch[64];
+    size_t i = 0;
+    size_t split = 0;
+
+    for (i = 0; i < (sizeof(documents) / sizeof(documents[0])); i++)
+    {
+        memset(&expected, '\0', sizeof(expected));
+        TEST_ASSERT_TRUE(cJSON_ParseSAX(documents[i], strlen(documents[i]), &logging_handler, &expected, scratch, sizeof(scratch)));
+
+        parser = cJSON_CreateParser(&logging_handler, &events, scratch, sizeof(scratch));
+        TEST_ASSERT_NOT_NULL(parser);
+        for (split = 0; split < strlen(documents[i]); split++)
+        {
+            TEST_ASSERT_TRUE_MESSAGE(parse_in_chunks(parser, documents[i], split, &events), documents[i]);
+            TEST_ASSERT_EQUAL_STRING(expected.log, events.log);
+        }
+        TEST_ASSERT_TRUE(cJSON_GetParserOffset(parser) == strlen(documents[i]));
+        cJSON_DeleteParser(parser);
+    }
+}
+
+static void parser_should_pass_strings_out_of_the_chunk(void)
+{
+    const char json[] = "[\"plain\", \"cut\"]";
+    cJSON_Parser *parser = NULL;
+    event_log events;
+    char scratch[8];
+
+    allocations = 0;
+    cJSON_InitHooks(&counting_hooks);
+    parser = cJSON_CreateParser(&logging_handler, &events, scratch, sizeof(scratch));
+    TEST_ASSERT_NOT_NULL(parser);
+    TEST_ASSERT_EQUAL_INT(1, allocations);
+
+    memset(&events, '\0', sizeof(events));
+    TEST_ASSERT_TRUE(cJSON_ParserFeed(parser, json, 12));
+    TEST_ASSERT_TRUE(events.last_string == (json + 2));
+    TEST_ASSERT_TRUE(cJSON_ParserFeed(parser, json + 12, sizeof(json) - 13));
+    TEST_ASSERT_TRUE(events.last_string == scratch);
+    TEST_ASSERT_TRUE(cJSON_ParserFinish(parser));
+    TEST_ASSERT_EQUAL_STRING("[ plain cut ] ", events.log);
+    TEST_ASSERT_EQUAL_INT(1, allocations);
+
+    cJSON_DeleteParser(parser);
+    cJSON_InitHooks(NULL);
+}
+
+static void parser_should_fail_if_cut_tokens_do_not_fit_into_scratch(void)
+{
+    cJSON_Parser *parser = NULL;
+    event_log events;
+    char scratch[4];
+
+    parser = cJSON_CreateParser(&logging_handler, &events, scratch, sizeof(scratch));
+    TEST_ASSERT_NOT_NULL(parser);
+
+    TEST_ASSERT_TRUE(parse_in_chunks(parser, "[\"abc\", 123]", 0, &events));
+    TEST_ASSERT_FALSE(parse_in_chunks(parser, "[\"abcd\"]", 0, &events));
+    TEST_ASSERT_FALSE(parse_in_chunks(parser, "[1234]", 0, &events));
+    /* in one piece without escape sequences, strings don't need scratch */
+    TEST_ASSERT_TRUE(parse_in_chunks(parser, "[\"abcdefgh\", 12345678]", 1, &events));
+    TEST_ASSERT_EQUAL_STRING("[ abcdefgh 1.23457e+07 ] ", events.log);
+    TEST_ASSERT_FALSE(parse_in_chunks(parser, "[\"abcd\\n\"]", 1, &events));
+    cJSON_DeleteParser(parser);
+
+    parser = cJSON_CreateParser(&logging_handler, &events, NULL, 0);
+    TEST_ASSERT_NOT_NULL(parser);
+    /* a chunk may end right after the opening quote */
+    TEST_ASSERT_TRUE(parse_in_chunks(parser, "{\"a\": \"b\"}", 2, &events));
+    TEST_ASSERT_FALSE(parse_in_chunks(parser, "{\"a\": \"b\"}", 3, &events));
+    cJSON_DeleteParser(parser);
+}
+
+static void parser_should_fail_on_invalid_input(void)
+{
+    const char *invalid[] = {
+        "{\"a\": [1, 2}", "{\"a\" 1}", "[1,]", "[,1]", "[1 2]", "{\"a\":}", "{1:2}", "[\"\\x\"]", "[\"\\u12\"]",
+        "nul", "truex", "[-]", "[1a]", "[1] 2", "{} {}", "[}", "{]", "]", ":"
+    };
+    cJSON_Parser *parser = NULL;
+    event_log events;
+    char scratch[16];
+    size_t i = 0;
+    size_t split = 0;
+
+    parser = cJSON_CreateParser(&logging_handler, &events, scratch, sizeof(scratch));
+    TEST_ASSERT_NOT_NULL(parser);
+    for (i = 0; i < (sizeof(invalid) / sizeof(invalid[0])); i++)
+    {
+        for (split = 0; split < strlen(invalid[i]); split++)
+        {
+            TEST_ASSERT_FALSE_MESSAGE(parse_in_chunks(parser, invalid[i], split, &events), invalid[i]);
+        }
+    }
+
+    /* invalid input stays invalid */
+    cJSON_ResetParser(parser);
+    TEST_ASSERT_FALSE(cJSON_ParserFeed(parser, "[1}", 3));
+    TEST_ASSERT_TRUE(cJSON_GetParserOffset(parser) == 2);
+    TEST_ASSERT_FALSE(cJSON_ParserFeed(parser, "]", 1));
+    TEST_ASSERT_FALSE(cJSON_ParserFinish(parser));
+
+    cJSON_DeleteParser(parser);
+
+    TEST_ASSERT_NULL(cJSON_CreateParser(NULL, NULL, NULL, 0));
+    TEST_ASSERT_FALSE(cJSON_ParserFeed(NULL, "[]", 2));
+    TEST_ASSERT_FALSE(cJSON_ParserFinish(NULL));
+}
+
+static void parser_should_only_finish_complete_documents(void)
+{
+    const char *incomplete[] = { "", "   ", "{", "{\"a\"", "{\"a\":", "{\"a\":1", "[1,", "\"abc", "tru", "-" };
+    cJSON_Parser *parser = NULL;
+    event_log events;
+    char scratch[16];
+    size_t i = 0;
+
+    parser = cJSON_CreateParser(&logging_handler, &events, scratch, sizeof(scratch));
+    TEST_ASSERT_NOT_NULL(parser);
+    for (i = 0; i < (sizeof(incomplete) / sizeof(incomplete[0])); i++)
+    {
+        memset(&events, '\0', sizeof(events));
+        cJSON_ResetParser(parser);
+        TEST_ASSERT_TRUE(cJSON_ParserFeed(parser, incomplete[i], strlen(incomplete[i])));
+        TEST_ASSERT_FALSE_MESSAGE(cJSON_ParserFinish(parser), incomplete[i]);
+    }
+
+    /* numbers at the top level end with the input */
+    TEST_ASSERT_TRUE(parse_in_chunks(parser, "\xEF\xBB\xBF" "12", 0, &events));
+    TEST_ASSERT_EQUAL_STRING("12 ", events.log);
+    TEST_ASSERT_TRUE(parse_in_chunks(parser, "1", 0, &events));
+    TEST_ASSERT_TRUE(parse_in_chunks(parser, "-1.5e3 ", 2, &events));
+    TEST_ASSERT_EQUAL_STRING("-1500 ", events.log);
+    TEST_ASSERT_FALSE(parse_in_chunks(parser, " \xBB\xBF" "12", 0, &events));
+
+    cJSON_DeleteParser(parser);
+}
+
+static void parser_should_respect_the_nesting_limit(void)
+{
+    char json[CJSON_NESTING_LIMIT + 1];
+    const cJSON_SAXHandler empty_handler = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+    cJSON_Parser *parser = cJSON_CreateParser(&empty_handler, NULL, NULL, 0);
+
+    TEST_ASSERT_NOT_NULL(parser);
+    memset(json, '[', sizeof(json));
+    TEST_ASSERT_TRUE(cJSON_ParserFeed(parser, json, CJSON_NESTING_LIMIT));
+    TEST_ASSERT_FALSE(cJSON_ParserFeed(parser, json, 1));
+
+    cJSON_DeleteParser(parser);
+}
+
+static void parser_should_stop_when_a_callback_fails(void)
+{
+    const char json[] = "{\"a\": 1, \"b\": 2}";
+    cJSON_Parser *parser = NULL;
+    event_log events;
+
+    parser = cJSON_CreateParser(&logging_handler, &events, NULL, 0);
+    TEST_ASSERT_NOT_NULL(parser);
+    memset(&events, '\0', sizeof(events));
+    events.stop_after = 3;
+    TEST_ASSERT_FALSE(cJSON_ParserFeed(parser, json, sizeof(json) - 1));
+    TEST_ASSERT_EQUAL_STRING("{ :a 1 ", events.log);
+
+    cJSON_DeleteParser(parser);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(parser_should_report_the_events_of_parse_sax_at_any_split);
+    RUN_TEST(parser_should_pass_strings_out_of_the_chunk);
+    RUN_TEST(parser_should_fail_if_cut_tokens_do_not_fit_into_scratch);
+    RUN_TEST(parser_should_fail_on_invalid_input);
+    RUN_TEST(parser_should_only_finish_complete_documents);
+    RUN_TEST(parser_should_respect_the_nesting_limit);
+    RUN_TEST(parser_should_stop_when_a_callback_fails);
+
+    return UNITY_END();
+}
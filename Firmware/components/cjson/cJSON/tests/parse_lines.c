@@ -0,0 +1,341 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+#include "../cJSON_Lines.h"
+
+#define line_count 3000
+
+/* what the handler saw, in order */
+typedef struct
+{
+    size_t count;
+    size_t numbers[line_count];
+    char *printed[line_count]; /* NULL for invalid lines */
+    size_t error_offsets[line_count];
+    size_t stop_after; /* 0 to take every line */
+} collected_lines;
+
+static char *input = NULL;
+static size_t input_length = 0;
+
+static cJSON_bool collect_line(void *user_data, cJSON_Line * const line)
+{
+    collected_lines *collected = (collected_lines*)user_data;
+
+    if (collected->count >= line_count)
+    {
+        cJSON_Delete(line->item);
+        return 0;
+    }
+
+    collected->numbers[collected->count] = line->number;
+    collected->printed[collected->count] = NULL;
+    collected->error_offsets[collected->count] = 0;
+    if (line->item != NULL)
+    {
+        collected->printed[collected->count] = cJSON_PrintUnformatted(line->item);
+        cJSON_Delete(line->item);
+    }
+    else
+    {
+        collected->error_offsets[collected->count] = (size_t)(line->error - line->text);
+    }
+    collected->count++;
+
+    return (collected->stop_after == 0) || (collected->count < collected->stop_after);
+}
+
+static void free_lines(collected_lines *collected)
+{
+    size_t i = 0;
+
+    for (i = 0; i < collected->count; i++)
+    {
+        if (collected->printed[i] != NULL)
+        {
+            cJSON_free(collected->printed[i]);
+        }
+    }
+    free(collected);
+}
+
+static collected_lines *new_lines(size_t stop_after)
+{
+    collected_lines *collected = (collected_lines*)calloc(1, sizeof(collected_lines));
+
+    TEST_ASSERT_NOT_NULL(collected);
+    collected->stop_after = stop_after;
+
+    return collected;
+}
+
+/* telemetry records with blank lines, CRLF line breaks and invalid lines in between */
+static void create_input(void)
+{
+    size_t capacity = line_count * 96;
+    size_t i = 0;
+
+    input = (char*)malloc(capacity);
+    TEST_ASSERT_NOT_NULL(input);
+    input_length = 0;
+    for (i = 0; i < line_count; i++)
+    {
+        switch (i % 7)
+        {
+            case 3:
+                input_length += (size_t)sprintf(input + input_length, "\n");
+                break;
+            case 4:
+                input_length += (size_t)sprintf(input + input_length, "{\"record\":%lu,\"pm25\":}\n", (unsigned long)i);
+                break;
+            case 5:
+                input_length += (size_t)sprintf(input + input_length, "  {\"record\":%lu} x\r\n", (unsigned long)i);
+                break;
+            default:
+                input_length += (size_t)sprintf(input + input_length, "{\"record\":%lu,\"pm25\":12.75,\"mode\":\"auto\"}\r\n", (unsigned long)i);
+                break;
+        }
+    }
+    /* the last line doesn't need a line break */
+    input_length += (size_t)sprintf(input + input_length, "[%lu]", (unsigned long)line_count);
+}
+
+static collected_lines *parse_input(size_t threads, size_t chunk_size, size_t stop_after, cJSON_bool expected_result)
+{
+    cJSON_LinesOptions options;
+    collected_lines *collected = new_lines(stop_after);
+
+    options.threads = threads;
+    options.chunk_size = chunk_size;
+    TEST_ASSERT_TRUE(cJSON_ParseLinesWithLength(input, input_length, &options, collect_line, collected) == expected_result);
+
+    return collected;
+}
+
+static void assert_same_lines(const collected_lines *expected, const collected_lines *actual)
+{
+    size_t i = 0;
+
+    TEST_ASSERT_EQUAL_INT(expected->count, actual->count);
+    for (i = 0; i < expected->count; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(expected->numbers[i], actual->numbers[i]);
+        TEST_ASSERT_EQUAL_INT(expected->error_offsets[i], actual->error_offsets[i]);
+        if (expected->printed[i] == NULL)
+        {
+            TEST_ASSERT_NULL(actual->printed[i]);
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL_STRING(expected->printed[i], actual->printed[i]);
+        }
+    }
+}
+
+static void parse_lines_should_parse_every_line(void)
+{
+    collected_lines *lines = parse_input(0, 0, 0, 1);
+
+    /* blank lines (429 of them) are counted, but not passed on */
+    TEST_ASSERT_EQUAL_INT(line_count - 429 + 1, lines->count);
+    TEST_ASSERT_EQUAL_INT(1, lines->numbers[0]);
+    TEST_ASSERT_EQUAL_STRING("{\"record\":0,\"pm25\":12.75,\"mode\":\"auto\"}", lines->printed[0]);
+    TEST_ASSERT_EQUAL_INT(5, lines->numbers[3]);
+    TEST_ASSERT_NULL(lines->printed[3]);
+    TEST_ASSERT_EQUAL_INT(19, lines->error_offsets[3]);
+    TEST_ASSERT_EQUAL_INT(6, lines->numbers[4]);
+    TEST_ASSERT_NULL(lines->printed[4]);
+    TEST_ASSERT_EQUAL_INT(15, lines->error_offsets[4]);
+    TEST_ASSERT_EQUAL_INT(line_count + 1, lines->numbers[lines->count - 1]);
+    TEST_ASSERT_EQUAL_STRING("[3000]", lines->printed[lines->count - 1]);
+
+    free_lines(lines);
+}
+
+static void parse_lines_should_keep_the_order_of_a_sequential_parse(void)
+{
+    static const size_t threads[] = { 1, 2, 4, 7 };
+    static const size_t chunk_sizes[] = { 1, 100, 4096, 0 };
+    collected_lines *expected = parse_input(0, 0, 0, 1);
+    collected_lines *actual = NULL;
+    size_t i = 0;
+    size_t j = 0;
+
+    for (i = 0; i < (sizeof(threads) / sizeof(threads[0])); i++)
+    {
+        for (j = 0; j < (sizeof(chunk_sizes) / sizeof(chunk_sizes[0])); j++)
+        {
+            actual = parse_input(threads[i], chunk_sizes[j], 0, 1);
+            assert_same_lines(expected, actual);
+            free_lines(actual);
+        }
+    }
+
+    free_lines(expected);
+}
+
+static void parse_lines_should_stop_when_the_handler_says_so(void)
+{
+    collected_lines *expected = parse_input(0, 0, 0, 1);
+    collected_lines *lines = NULL;
+
+    lines = parse_input(0, 100, 10, 0);
+    TEST_ASSERT_EQUAL_INT(10, lines->count);
+    TEST_ASSERT_EQUAL_INT(expected->numbers[9], lines->numbers[9]);
+    free_lines(lines);
+
+    /* the chunks that are parsed ahead are deleted */
+    lines = parse_input(4, 100, 500, 0);
+    TEST_ASSERT_EQUAL_INT(500, lines->count);
+    TEST_ASSERT_EQUAL_STRING(expected->printed[499], lines->printed[499]);
+    free_lines(lines);
+
+    free_lines(expected);
+}
+
+static void parse_lines_should_read_files(void)
+{
+    static const char path[] = "parse_lines.ndjson";
+    collected_lines *expected = parse_input(0, 0, 0, 1);
+    collected_lines *lines = new_lines(0);
+    cJSON_LinesOptions options;
+    FILE *file = fopen(path, "wb");
+
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_EQUAL_INT(input_length, fwrite(input, 1, input_length, file));
+    fclose(file);
+
+    options.threads = 3;
+    options.chunk_size = 512;
+    TEST_ASSERT_TRUE(cJSON_ParseLines(path, &options, collect_line, lines));
+    assert_same_lines(expected, lines);
+    free_lines(lines);
+
+    /* empty files have no lines */
+    file = fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(file);
+    fclose(file);
+    lines = new_lines(0);
+    TEST_ASSERT_TRUE(cJSON_ParseLines(path, NULL, collect_line, lines));
+    TEST_ASSERT_EQUAL_INT(0, lines->count);
+    remove(path);
+
+    TEST_ASSERT_FALSE(cJSON_ParseLines("does/not/exist.ndjson", NULL, collect_line, lines));
+    free_lines(lines);
+    free_lines(expected);
+}
+
+static void CJSON_CDECL lock_pool(void *context)
+{
+    pthread_mutex_lock((pthread_mutex_t*)context);
+}
+
+static void CJSON_CDECL unlock_pool(void *context)
+{
+    pthread_mutex_unlock((pthread_mutex_t*)context);
+}
+
+static void parse_lines_should_leave_no_nodes_in_thread_caches(void)
+{
+    static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+    cJSON_PoolConfig pool;
+    cJSON_PoolStats stats;
+    collected_lines *lines = NULL;
+    cJSON *nodes = NULL;
+    size_t slabs = 0;
+    size_t i = 0;
+
+    pool.nodes_per_slab = 64;
+    pool.lock = lock_pool;
+    pool.unlock = unlock_pool;
+    pool.lock_context = &pool_mutex;
+    cJSON_InitHooksWithPool(NULL, &pool);
+
+    for (i = 0; i < 20; i++)
+    {
+        lines = parse_input(4, 4096, 0, 1);
+        free_lines(lines);
+        /* the handler ran on this thread, so its cache holds the nodes of the deleted documents */
+        cJSON_ReleasePoolCache();
+
+        cJSON_GetPoolStats(&stats);
+        TEST_ASSERT_EQUAL_INT(0, stats.in_use);
+    }
+
+    /* every node is back on the shared free list: taking all of them doesn't need another slab */
+    slabs = stats.slabs;
+    nodes = cJSON_CreateArray();
+    for (i = 1; i < (slabs * pool.nodes_per_slab); i++)
+    {
+        cJSON_AddItemToArray(nodes, cJSON_CreateNull());
+    }
+    cJSON_GetPoolStats(&stats);
+    TEST_ASSERT_EQUAL_INT(slabs, stats.slabs);
+    TEST_ASSERT_EQUAL_INT((slabs * pool.nodes_per_slab) - 1, cJSON_GetArraySize(nodes));
+
+    cJSON_Delete(nodes);
+    cJSON_InitHooks(NULL);
+}
+
+static void parse_lines_should_handle_null(void)
+{
+    collected_lines *lines = new_lines(0);
+
+    TEST_ASSERT_FALSE(cJSON_ParseLines(NULL, NULL, collect_line, lines));
+    TEST_ASSERT_FALSE(cJSON_ParseLines("parse_lines.ndjson", NULL, NULL, lines));
+    TEST_ASSERT_FALSE(cJSON_ParseLinesWithLength(NULL, 1, NULL, collect_line, lines));
+    TEST_ASSERT_FALSE(cJSON_ParseLinesWithLength("[]", 2, NULL, NULL, lines));
+    TEST_ASSERT_TRUE(cJSON_ParseLinesWithLength(NULL, 0, NULL, collect_line, lines));
+    TEST_ASSERT_TRUE(cJSON_ParseLinesWithLength(" \n\r\n", 4, NULL, collect_line, lines));
+    TEST_ASSERT_EQUAL_INT(0, lines->count);
+
+    free_lines(lines);
+}
+
+int CJSON_CDECL main(void)
+{
+    int result = 0;
+
+    create_input();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(parse_lines_should_parse_every_line);
+    RUN_TEST(parse_lines_should_keep_the_order_of_a_sequential_parse);
+    RUN_TEST(parse_lines_should_stop_when_the_handler_says_so);
+    RUN_TEST(parse_lines_should_read_files);
+    RUN_TEST(parse_lines_should_leave_no_nodes_in_thread_caches);
+    RUN_TEST(parse_lines_should_handle_null);
+
+    result = UNITY_END();
+    free(input);
+
+    return result;
+}
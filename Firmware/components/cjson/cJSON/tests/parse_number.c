@@ -0,0 +1,315 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static cJSON item[1];
+
+static void assert_is_number(cJSON *number_item)
+{
+    TEST_ASSERT_NOT_NULL_MESSAGE(number_item, "Item is NULL.");
+
+    assert_not_in_list(number_item);
+    assert_has_no_child(number_item);
+    assert_has_type(number_item, cJSON_Number);
+    assert_has_no_reference(number_item);
+    assert_has_no_const_string(number_item);
+    assert_has_no_valuestring(number_item);
+    assert_has_no_string(number_item);
+}
+
+static void assert_parse_number(const char *string, int integer, double real)
+{
+    parse_buffer buffer;
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.nesting_limit = CJSON_NESTING_LIMIT;
+    buffer.content = (const unsigned char*)string;
+    buffer.length = strlen(string) + sizeof("");
+    buffer.hooks = global_hooks;
+
+    TEST_ASSERT_TRUE(parse_number(item, &buffer));
+    assert_is_number(item);
+    TEST_ASSERT_EQUAL_INT(integer, item->valueint);
+    TEST_ASSERT_EQUAL_DOUBLE(real, item->valuedouble);
+}
+
+static void assert_parse_big_number(const char *string)
+{
+    parse_buffer buffer;
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.nesting_limit = CJSON_NESTING_LIMIT;
+    buffer.content = (const unsigned char*)string;
+    buffer.length = strlen(string) + sizeof("");
+    buffer.hooks = global_hooks;
+
+    TEST_ASSERT_TRUE(parse_number(item, &buffer));
+    assert_is_number(item);
+}
+
+static void parse_number_should_parse_zero(void)
+{
+    assert_parse_number("0", 0, 0);
+    assert_parse_number("0.0", 0, 0.0);
+    assert_parse_number("-0", 0, -0.0);
+}
+
+static void parse_number_should_parse_negative_integers(void)
+{
+    assert_parse_number("-1", -1, -1);
+    assert_parse_number("-32768", -32768, -32768.0);
+    assert_parse_number("-2147483648", (int)-2147483648.0, -2147483648.0);
+}
+
+static void parse_number_should_parse_positive_integers(void)
+{
+    assert_parse_number("1", 1, 1);
+    assert_parse_number("32767", 32767, 32767.0);
+    assert_parse_number("2147483647", (int)2147483647.0, 2147483647.0);
+}
+
+static void parse_number_should_parse_positive_reals(void)
+{
+    assert_parse_number("0.001", 0, 0.001);
+    assert_parse_number("10e-10", 0, 10e-10);
+    assert_parse_number("10E-10", 0, 10e-10);
+    assert_parse_number("10e10", INT_MAX, 10e10);
+    assert_parse_number("123e+127", INT_MAX, 123e127);
+    assert_parse_number("123e-128", 0, 123e-128);
+}
+
+static void parse_number_should_parse_negative_reals(void)
+{
+    assert_parse_number("-0.001", 0, -0.001);
+    assert_parse_number("-10e-10", 0, -10e-10);
+    assert_parse_number("-10E-10", 0, -10e-10);
+    assert_parse_number("-10e20", INT_MIN, -10e20);
+    assert_parse_number("-123e+127", INT_MIN, -123e127);
+    assert_parse_number("-123e-128", 0, -123e-128);
+}
+
+static void parse_number_should_parse_big_numbers(void)
+{
+    assert_parse_big_number("9999999999999999999999999999999999999999999999912345678901234567");
+    assert_parse_big_number("9999999999999999999999999999999999999999999999912345678901234567E10");
+    assert_parse_big_number("999999999999999999999999999999999999999999999991234567890.1234567");
+}
+
+static size_t allocations = 0;
+
+static void * CJSON_CDECL counting_allocate(size_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+static void CJSON_CDECL normal_deallocate(void *pointer)
+{
+    free(pointer);
+}
+
+static void assert_parse_number_length(const char *string, size_t length)
+{
+    parse_buffer buffer;
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.nesting_limit = CJSON_NESTING_LIMIT;
+    buffer.content = (const unsigned char*)string;
+    buffer.length = strlen(string) + sizeof("");
+    buffer.hooks = global_hooks;
+
+    TEST_ASSERT_TRUE(parse_number(item, &buffer));
+    TEST_ASSERT_TRUE(buffer.offset == length);
+}
+
+static void assert_not_a_number(const char *string)
+{
+    parse_buffer buffer;
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.nesting_limit = CJSON_NESTING_LIMIT;
+    buffer.content = (const unsigned char*)string;
+    buffer.length = strlen(string) + sizeof("");
+    buffer.hooks = global_hooks;
+
+    TEST_ASSERT_FALSE(parse_number(item, &buffer));
+}
+
+static void parse_number_should_fill_valueint_of_integer_literals(void)
+{
+    assert_parse_number("2147483646", 2147483646, 2147483646.0);
+    assert_parse_number("2147483648", INT_MAX, 2147483648.0);
+    assert_parse_number("-2147483647", -2147483647, -2147483647.0);
+    assert_parse_number("-2147483649", INT_MIN, -2147483649.0);
+    assert_parse_number("12345678901234567890123", INT_MAX, 12345678901234567890123.0);
+    assert_parse_number("-12345678901234567890123", INT_MIN, -12345678901234567890123.0);
+    assert_parse_number("000000000000000000000000042", 42, 42.0);
+    assert_parse_number("1.9", 1, 1.9);
+    assert_parse_number("-1.9", -1, -1.9);
+}
+
+static void parse_number_should_stop_where_strtod_stops(void)
+{
+    assert_parse_number_length("1e", 1);
+    assert_parse_number_length("1e+", 1);
+    assert_parse_number_length("1.", 2);
+    assert_parse_number_length("1.5e+3x", 6);
+    assert_parse_number_length("-.5", 3);
+    assert_parse_number_length("12-3", 2);
+    assert_parse_number_length("1.2.3", 3);
+    assert_not_a_number("-");
+    assert_not_a_number("-.");
+    assert_not_a_number("-e5");
+}
+
+static void parse_number_should_not_allocate(void)
+{
+    const char *numbers[] = { "42", "-0.001", "24.5", "0.3499999940395355", "1.7976931348623157e308", "5e-324", "0.34999999403953552" };
+    size_t i = 0;
+
+    for (i = 0; i < (sizeof(numbers) / sizeof(numbers[0])); i++)
+    {
+        parse_buffer buffer;
+        memset(&buffer, '\0', sizeof(buffer));
+        buffer.nesting_limit = CJSON_NESTING_LIMIT;
+        buffer.content = (const unsigned char*)numbers[i];
+        buffer.length = strlen(numbers[i]) + sizeof("");
+        buffer.hooks.allocate = counting_allocate;
+        buffer.hooks.deallocate = normal_deallocate;
+
+        allocations = 0;
+        TEST_ASSERT_TRUE(parse_number(item, &buffer));
+        TEST_ASSERT_EQUAL_INT(0, allocations);
+        TEST_ASSERT_TRUE(item->valuedouble == strtod(numbers[i], NULL));
+    }
+}
+
+/* xorshift64 */
+static cjson_uint64 next_random(cjson_uint64 * const state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/* random number literals with up to 25 digits in both parts and exponents beyond the range of double */
+static size_t random_literal(char *literal, cjson_uint64 * const state)
+{
+    size_t length = 0;
+    int digits = 0;
+    int i = 0;
+
+    if ((next_random(state) % 2) == 0)
+    {
+        literal[length++] = '-';
+    }
+
+    digits = (int)(next_random(state) % 26);
+    literal[length++] = (char)('0' + next_random(state) % 10);
+    for (i = 0; i < digits; i++)
+    {
+        literal[length++] = (char)('0' + next_random(state) % 10);
+    }
+
+    if ((next_random(state) % 2) == 0)
+    {
+        digits = 1 + (int)(next_random(state) % 25);
+        literal[length++] = '.';
+        for (i = 0; i < digits; i++)
+        {
+            literal[length++] = (char)('0' + next_random(state) % 10);
+        }
+    }
+
+    if ((next_random(state) % 2) == 0)
+    {
+        length += (size_t)sprintf(literal + length, "e%d", (int)(next_random(state) % 701) - 350);
+    }
+
+    literal[length] = '\0';
+    return length;
+}
+
+static void assert_same_as_strtod(const char *literal, size_t length)
+{
+    parse_buffer buffer;
+    double expected = strtod(literal, NULL);
+
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.nesting_limit = CJSON_NESTING_LIMIT;
+    buffer.content = (const unsigned char*)literal;
+    buffer.length = length + sizeof("");
+    buffer.hooks = global_hooks;
+
+    TEST_ASSERT_TRUE_MESSAGE(parse_number(item, &buffer), literal);
+    TEST_ASSERT_TRUE_MESSAGE(memcmp(&expected, &item->valuedouble, sizeof(expected)) == 0, literal);
+    TEST_ASSERT_TRUE_MESSAGE(buffer.offset == length, literal);
+}
+
+static void parse_number_should_match_strtod(void)
+{
+    char literal[128];
+    cjson_uint64 state = cjson_uint64_constant(0x2545F491, 0x4F6CDD1D);
+    double number = 0;
+    int i = 0;
+
+    for (i = 0; i < 200000; i++)
+    {
+        assert_same_as_strtod(literal, random_literal(literal, &state));
+    }
+
+    /* printed doubles, where the fast path matters most */
+    for (i = 0; i < 200000; i++)
+    {
+        next_random(&state);
+        memcpy(&number, &state, sizeof(number));
+        if (isnan(number) || isinf(number))
+        {
+            continue;
+        }
+
+        assert_same_as_strtod(literal, (size_t)sprintf(literal, "%.*g", 15 + (i % 3), number));
+        assert_same_as_strtod(literal, (size_t)sprintf(literal, "%.6f", (double)(state % 100000000) / 1000.0));
+    }
+}
+
+int CJSON_CDECL main(void)
+{
+    /* initialize cJSON item */
+    memset(item, 0, sizeof(cJSON));
+    UNITY_BEGIN();
+    RUN_TEST(parse_number_should_parse_zero);
+    RUN_TEST(parse_number_should_parse_negative_integers);
+    RUN_TEST(parse_number_should_parse_positive_integers);
+    RUN_TEST(parse_number_should_parse_positive_reals);
+    RUN_TEST(parse_number_should_parse_negative_reals);
+    RUN_TEST(parse_number_should_parse_big_numbers);
+    RUN_TEST(parse_number_should_fill_valueint_of_integer_literals);
+    RUN_TEST(parse_number_should_stop_where_strtod_stops);
+    RUN_TEST(parse_number_should_not_allocate);
+    RUN_TEST(parse_number_should_match_strtod);
+    return UNITY_END();
+}
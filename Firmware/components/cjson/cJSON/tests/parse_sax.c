@@ -0,0 +1,280 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+/* every event is appended to the log in a compact text form */
+typedef struct
+{
+    char log[512];
+    size_t events;
+    size_t stop_after;
+    const char *last_string;
+} event_log;
+
+static size_t allocations = 0;
+
+static void * CJSON_CDECL counting_malloc(size_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+/* work around MSVC error C2322: '...' address of dllimport '...' is not static */
+static void CJSON_CDECL normal_free(void *pointer)
+{
+    free(pointer);
+}
+
+static cJSON_Hooks counting_hooks = {
+    counting_malloc,
+    normal_free
+};
+
+static cJSON_bool log_event(event_log *events, const char *text, size_t length)
+{
+    size_t used = strlen(events->log);
+
+    TEST_ASSERT_TRUE_MESSAGE((used + length + 2) < sizeof(events->log), "Event log overflow.");
+    memcpy(events->log + used, text, length);
+    events->log[used + length] = ' ';
+    events->log[used + length + 1] = '\0';
+
+    events->events++;
+    return (events->stop_after == 0) || (events->events < events->stop_after);
+}
+
+static cJSON_bool on_start_object(void *user_data)
+{
+    return log_event((event_log*)user_data, "{", 1);
+}
+
+static cJSON_bool on_end_object(void *user_data)
+{
+    return log_event((event_log*)user_data, "}", 1);
+}
+
+static cJSON_bool on_start_array(void *user_data)
+{
+    return log_event((event_log*)user_data, "[", 1);
+}
+
+static cJSON_bool on_end_array(void *user_data)
+{
+    return log_event((event_log*)user_data, "]", 1);
+}
+
+static cJSON_bool on_key(void *user_data, const char *key, size_t length)
+{
+    event_log *events = (event_log*)user_data;
+    char text[64];
+
+    TEST_ASSERT_TRUE(length < (sizeof(text) - 1));
+    text[0] = ':';
+    memcpy(text + 1, key, length);
+    return log_event(events, text, length + 1);
+}
+
+static cJSON_bool on_string(void *user_data, const char *string, size_t length)
+{
+    event_log *events = (event_log*)user_data;
+
+    events->last_string = string;
+    return log_event(events, string, length);
+}
+
+static cJSON_bool on_number(void *user_data, double number)
+{
+    char text[32];
+
+    sprintf(text, "%g", number);
+    return log_event((event_log*)user_data, text, strlen(text));
+}
+
+static cJSON_bool on_boolean(void *user_data, cJSON_bool boolean)
+{
+    return boolean ? log_event((event_log*)user_data, "true", 4) : log_event((event_log*)user_data, "false", 5);
+}
+
+static cJSON_bool on_null(void *user_data)
+{
+    return log_event((event_log*)user_data, "null", 4);
+}
+
+static const cJSON_SAXHandler logging_handler = {
+    on_start_object,
+    on_end_object,
+    on_start_array,
+    on_end_array,
+    on_key,
+    on_string,
+    on_number,
+    on_boolean,
+    on_null
+};
+
+static cJSON_bool parse_sax(const char *json, event_log *events, char *scratch, size_t scratch_size)
+{
+    memset(events, '\0', sizeof(*events));
+    return cJSON_ParseSAX(json, strlen(json) + sizeof(""), &logging_handler, events, scratch, scratch_size);
+}
+
+static void parse_sax_should_report_events_in_document_order(void)
+{
+    event_log events;
+    char scratch[32];
+
+    TEST_ASSERT_TRUE(parse_sax("{\"a\": [1, 2.5, -3e2], \"b\": {\"c\": null, \"d\": true}, \"e\": false, \"f\": \"text\", \"g\": [], \"h\": {}}", &events, scratch, sizeof(scratch)));
+    TEST_ASSERT_EQUAL_STRING("{ :a [ 1 2.5 -300 ] :b { :c null :d true } :e false :f text :g [ ] :h { } } ", events.log);
+}
+
+static void parse_sax_should_report_single_values(void)
+{
+    event_log events;
+
+    TEST_ASSERT_TRUE(parse_sax("  \"value\"  ", &events, NULL, 0));
+    TEST_ASSERT_EQUAL_STRING("value ", events.log);
+    TEST_ASSERT_TRUE(parse_sax("42", &events, NULL, 0));
+    TEST_ASSERT_EQUAL_STRING("42 ", events.log);
+    TEST_ASSERT_TRUE(parse_sax("null", &events, NULL, 0));
+    TEST_ASSERT_EQUAL_STRING("null ", events.log);
+}
+
+static void parse_sax_should_pass_plain_strings_without_copying(void)
+{
+    const char json[] = "[\"plain\"]";
+    event_log events;
+
+    allocations = 0;
+    cJSON_InitHooks(&counting_hooks);
+    TEST_ASSERT_TRUE(parse_sax(json, &events, NULL, 0));
+    cJSON_InitHooks(NULL);
+
+    TEST_ASSERT_EQUAL_INT(0, allocations);
+    TEST_ASSERT_TRUE(events.last_string == (json + 2));
+}
+
+static void parse_sax_should_unescape_into_the_scratch_buffer(void)
+{
+    event_log events;
+    char scratch[16];
+
+    TEST_ASSERT_TRUE(parse_sax("[\"a\\tb\\u00e4\"]", &events, scratch, sizeof(scratch)));
+    TEST_ASSERT_TRUE(events.last_string == scratch);
+    TEST_ASSERT_EQUAL_STRING("[ a\tb\xc3\xa4 ] ", events.log);
+}
+
+static void parse_sax_should_fail_if_escapes_do_not_fit_into_scratch(void)
+{
+    event_log events;
+    char scratch[4];
+
+    TEST_ASSERT_FALSE(parse_sax("[\"\\n\"]", &events, NULL, 0));
+    TEST_ASSERT_FALSE(parse_sax("[\"abcd\\n\"]", &events, scratch, sizeof(scratch)));
+    TEST_ASSERT_TRUE(parse_sax("[\"ab\\n\"]", &events, scratch, sizeof(scratch)));
+}
+
+static void parse_sax_should_stop_when_a_callback_fails(void)
+{
+    const char json[] = "{\"a\": 1, \"b\": 2}";
+    event_log events;
+
+    memset(&events, '\0', sizeof(events));
+    events.stop_after = 3;
+    TEST_ASSERT_FALSE(cJSON_ParseSAX(json, sizeof(json), &logging_handler, &events, NULL, 0));
+    TEST_ASSERT_EQUAL_STRING("{ :a 1 ", events.log);
+}
+
+static void parse_sax_should_fail_on_invalid_input(void)
+{
+    const char json[] = "{\"a\": [1, 2}";
+    event_log events;
+
+    TEST_ASSERT_FALSE(parse_sax(json, &events, NULL, 0));
+    TEST_ASSERT_TRUE(cJSON_GetErrorPtr() == (json + 11));
+
+    TEST_ASSERT_FALSE(parse_sax("{\"a\" 1}", &events, NULL, 0));
+    TEST_ASSERT_FALSE(parse_sax("[\"unterminated]", &events, NULL, 0));
+    TEST_ASSERT_FALSE(parse_sax("nul", &events, NULL, 0));
+    TEST_ASSERT_FALSE(cJSON_ParseSAX(NULL, 1, &logging_handler, &events, NULL, 0));
+    TEST_ASSERT_FALSE(cJSON_ParseSAX("[]", 3, NULL, &events, NULL, 0));
+}
+
+static void parse_sax_should_respect_the_nesting_limit(void)
+{
+    char json[CJSON_NESTING_LIMIT + 2];
+    const cJSON_SAXHandler empty_handler = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+
+    memset(json, '[', sizeof(json) - 1);
+    json[sizeof(json) - 1] = '\0';
+    TEST_ASSERT_FALSE(cJSON_ParseSAX(json, sizeof(json), &empty_handler, NULL, NULL, 0));
+}
+
+static void parse_sax_should_parse_up_to_the_nesting_limit(void)
+{
+    /* the parser doesn't recurse, so this takes no more stack than a flat document */
+    char json[(2 * CJSON_NESTING_LIMIT) + 1];
+    const cJSON_SAXHandler empty_handler = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+
+    memset(json, '[', CJSON_NESTING_LIMIT);
+    memset(json + CJSON_NESTING_LIMIT, ']', CJSON_NESTING_LIMIT);
+    json[sizeof(json) - 1] = '\0';
+    TEST_ASSERT_TRUE(cJSON_ParseSAX(json, sizeof(json), &empty_handler, NULL, NULL, 0));
+
+    /* one level too deep, the error is at the bracket that opens it */
+    json[CJSON_NESTING_LIMIT] = '[';
+    TEST_ASSERT_FALSE(cJSON_ParseSAX(json, sizeof(json), &empty_handler, NULL, NULL, 0));
+    TEST_ASSERT_TRUE(cJSON_GetErrorPtr() == (json + CJSON_NESTING_LIMIT));
+}
+
+static void parse_sax_should_accept_a_handler_without_callbacks(void)
+{
+    const char json[] = "{\"a\": [1, \"x\\n\", true, null], \"b\": {}}";
+    const cJSON_SAXHandler empty_handler = { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL };
+    char scratch[8];
+
+    TEST_ASSERT_TRUE(cJSON_ParseSAX(json, sizeof(json), &empty_handler, NULL, scratch, sizeof(scratch)));
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(parse_sax_should_report_events_in_document_order);
+    RUN_TEST(parse_sax_should_report_single_values);
+    RUN_TEST(parse_sax_should_pass_plain_strings_without_copying);
+    RUN_TEST(parse_sax_should_unescape_into_the_scratch_buffer);
+    RUN_TEST(parse_sax_should_fail_if_escapes_do_not_fit_into_scratch);
+    RUN_TEST(parse_sax_should_stop_when_a_callback_fails);
+    RUN_TEST(parse_sax_should_fail_on_invalid_input);
+    RUN_TEST(parse_sax_should_respect_the_nesting_limit);
+    RUN_TEST(parse_sax_should_parse_up_to_the_nesting_limit);
+    RUN_TEST(parse_sax_should_accept_a_handler_without_callbacks);
+
+    return UNITY_END();
+}
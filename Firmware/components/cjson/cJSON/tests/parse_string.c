@@ -45,7 +45,9 @@ static void assert_is_string(cJSON *string_item)
 
 static void assert_parse_string(const char *string, const char *expected)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer buffer;
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.nesting_limit = CJSON_NESTING_LIMIT;
     buffer.content = (const unsigned char*)string;
     buffer.length = strlen(string) + sizeof("");
     buffer.hooks = global_hooks;
@@ -59,7 +61,9 @@ static void assert_parse_string(const char *string, const char *expected)
 
 static void assert_not_parse_string(const char * const string)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer buffer;
+    memset(&buffer, '\0', sizeof(buffer));
+    buffer.nesting_limit = CJSON_NESTING_LIMIT;
     buffer.content = (const unsigned char*)string;
     buffer.length = strlen(string) + sizeof("");
     buffer.hooks = global_hooks;
@@ -119,6 +123,42 @@ static void parse_string_should_parse_bug_94(void)
     reset(item);
 }
 
+/* the scanning kernels work on blocks, so every position within and across blocks has to be found */
+static void parse_string_should_find_quotes_and_escapes_at_every_position(void)
+{
+    char input[80];
+    char expected[80];
+    size_t length = 0;
+    size_t position = 0;
+
+    for (length = 0; length < 70; length++)
+    {
+        /* closing quote right after length characters, with high bytes to catch signed comparisons */
+        input[0] = '\"';
+        for (position = 0; position < length; position++)
+        {
+            input[position + 1] = (char)(((position % 3) == 0) ? 0xC3 : 'a' + (char)(position % 26));
+        }
+        input[length + 1] = '\"';
+        input[length + 2] = '\0';
+        memcpy(expected, input + 1, length);
+        expected[length] = '\0';
+        assert_parse_string(input, expected);
+
+        /* an escaped quote at the end of the run */
+        if (length > 0)
+        {
+            input[length] = '\\';
+            input[length + 1] = '\"';
+            input[length + 2] = '\"';
+            input[length + 3] = '\0';
+            expected[length - 1] = '\"';
+            expected[length] = '\0';
+            assert_parse_string(input, expected);
+        }
+    }
+}
+
 int CJSON_CDECL main(void)
 {
     /* initialize cJSON item and error pointer */
@@ -131,5 +171,6 @@ int CJSON_CDECL main(void)
     RUN_TEST(parse_string_should_not_parse_invalid_backslash);
     RUN_TEST(parse_string_should_parse_bug_94);
     RUN_TEST(parse_string_should_not_overflow_with_closing_backslash);
+    RUN_TEST(parse_string_should_find_quotes_and_escapes_at_every_position);
     return UNITY_END();
 }
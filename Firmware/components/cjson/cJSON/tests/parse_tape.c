@@ -0,0 +1,307 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static size_t allocations = 0;
+
+static void * CJSON_CDECL counting_malloc(size_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+/* work around MSVC error C2322: '...' address of dllimport '...' is not static */
+static void CJSON_CDECL normal_free(void *pointer)
+{
+    free(pointer);
+}
+
+static cJSON_Hooks counting_hooks = {
+    counting_malloc,
+    normal_free
+};
+
+static cJSON_Tape *parse_tape(const char *json)
+{
+    return cJSON_ParseTape(json, strlen(json));
+}
+
+static void parse_tape_should_navigate_values(void)
+{
+    const char json[] = "{\"name\": \"fan\", \"speed\": 75, \"ratio\": -2.5e-1, \"on\": true, \"off\": false, \"none\": null, \"list\": [1, [2, {}], \"x\"]}";
+    cJSON_Tape *tape = parse_tape(json);
+    cJSON_TapeIterator root;
+    cJSON_TapeIterator item;
+    cJSON_TapeIterator element;
+    size_t length = 0;
+
+    TEST_ASSERT_NOT_NULL(tape);
+    TEST_ASSERT_TRUE(cJSON_GetTapeRoot(tape, &root));
+    TEST_ASSERT_EQUAL_INT(cJSON_Object, cJSON_TapeType(&root));
+    TEST_ASSERT_EQUAL_INT(7, cJSON_TapeGetArraySize(&root));
+
+    TEST_ASSERT_TRUE(cJSON_TapeChild(&root, &item));
+    TEST_ASSERT_TRUE(cJSON_TapeGetKey(&item, &length) == (json + 2));
+    TEST_ASSERT_TRUE(length == 4);
+    TEST_ASSERT_TRUE(cJSON_TapeGetString(&item, &length) == (json + 10));
+    TEST_ASSERT_TRUE(length == 3);
+
+    TEST_ASSERT_TRUE(cJSON_TapeNext(&item));
+    TEST_ASSERT_EQUAL_INT(cJSON_Number, cJSON_TapeType(&item));
+    TEST_ASSERT_EQUAL_DOUBLE(75, cJSON_TapeGetNumber(&item));
+    TEST_ASSERT_NULL(cJSON_TapeGetString(&item, NULL));
+
+    TEST_ASSERT_TRUE(cJSON_TapeGetObjectItemCaseSensitive(&root, "ratio", &item));
+    TEST_ASSERT_EQUAL_DOUBLE(-0.25, cJSON_TapeGetNumber(&item));
+    TEST_ASSERT_TRUE(cJSON_TapeGetObjectItemCaseSensitive(&root, "on", &item));
+    TEST_ASSERT_EQUAL_INT(cJSON_True, cJSON_TapeType(&item));
+    TEST_ASSERT_TRUE(cJSON_TapeGetObjectItemCaseSensitive(&root, "off", &item));
+    TEST_ASSERT_EQUAL_INT(cJSON_False, cJSON_TapeType(&item));
+    TEST_ASSERT_TRUE(cJSON_TapeGetObjectItemCaseSensitive(&root, "none", &item));
+    TEST_ASSERT_EQUAL_INT(cJSON_NULL, cJSON_TapeType(&item));
+    TEST_ASSERT_FALSE(cJSON_TapeGetObjectItemCaseSensitive(&root, "Name", &item));
+    TEST_ASSERT_FALSE(cJSON_TapeGetObjectItemCaseSensitive(&root, "missing", &item));
+
+    TEST_ASSERT_TRUE(cJSON_TapeGetObjectItemCaseSensitive(&root, "list", &item));
+    TEST_ASSERT_FALSE(cJSON_TapeNext(&item));
+    TEST_ASSERT_EQUAL_INT(3, cJSON_TapeGetArraySize(&item));
+    TEST_ASSERT_TRUE(cJSON_TapeGetArrayItem(&item, 2, &element));
+    TEST_ASSERT_EQUAL_INT(cJSON_String, cJSON_TapeType(&element));
+    TEST_ASSERT_NULL(cJSON_TapeGetKey(&element, NULL));
+    TEST_ASSERT_FALSE(cJSON_TapeGetArrayItem(&item, 3, &element));
+
+    TEST_ASSERT_TRUE(cJSON_TapeGetArrayItem(&item, 1, &element));
+    TEST_ASSERT_EQUAL_INT(2, cJSON_TapeGetArraySize(&element));
+    TEST_ASSERT_TRUE(cJSON_TapeGetArrayItem(&element, 1, &item));
+    TEST_ASSERT_EQUAL_INT(cJSON_Object, cJSON_TapeType(&item));
+    TEST_ASSERT_FALSE(cJSON_TapeChild(&item, &element));
+    TEST_ASSERT_EQUAL_INT(0, cJSON_TapeGetArraySize(&item));
+
+    cJSON_DeleteTape(tape);
+}
+
+static void parse_tape_should_parse_single_values(void)
+{
+    cJSON_Tape *tape = NULL;
+    cJSON_TapeIterator root;
+    size_t length = 0;
+
+    tape = parse_tape("  \"value\"  ");
+    TEST_ASSERT_NOT_NULL(tape);
+    TEST_ASSERT_TRUE(cJSON_GetTapeRoot(tape, &root));
+    TEST_ASSERT_NOT_NULL(cJSON_TapeGetString(&root, &length));
+    TEST_ASSERT_TRUE(length == 5);
+    TEST_ASSERT_FALSE(cJSON_TapeNext(&root));
+    TEST_ASSERT_FALSE(cJSON_TapeChild(&root, &root));
+    cJSON_DeleteTape(tape);
+
+    tape = parse_tape("\xEF\xBB\xBF" "-12");
+    TEST_ASSERT_NOT_NULL(tape);
+    TEST_ASSERT_TRUE(cJSON_GetTapeRoot(tape, &root));
+    TEST_ASSERT_EQUAL_DOUBLE(-12, cJSON_TapeGetNumber(&root));
+    cJSON_DeleteTape(tape);
+
+    /* with the terminator, like cJSON_ParseWithLength */
+    tape = cJSON_ParseTape("null", sizeof("null"));
+    TEST_ASSERT_NOT_NULL(tape);
+    TEST_ASSERT_TRUE(cJSON_GetTapeRoot(tape, &root));
+    TEST_ASSERT_EQUAL_INT(cJSON_NULL, cJSON_TapeType(&root));
+    cJSON_DeleteTape(tape);
+}
+
+static void parse_tape_should_decode_escaped_strings(void)
+{
+    cJSON_Tape *tape = parse_tape("{\"a\\tb\": \"x\\u00e4\\n\", \"c\": \"\\\"\"}");
+    cJSON_TapeIterator root;
+    cJSON_TapeIterator item;
+    char buffer[16];
+    size_t length = 0;
+
+    TEST_ASSERT_NOT_NULL(tape);
+    TEST_ASSERT_TRUE(cJSON_GetTapeRoot(tape, &root));
+
+    TEST_ASSERT_TRUE(cJSON_TapeGetObjectItemCaseSensitive(&root, "a\tb", &item));
+    TEST_ASSERT_NULL(cJSON_TapeGetKey(&item, &length));
+    TEST_ASSERT_TRUE(length == 4);
+    TEST_ASSERT_TRUE(cJSON_TapeCopyKey(&item, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("a\tb", buffer);
+
+    TEST_ASSERT_NULL(cJSON_TapeGetString(&item, &length));
+    TEST_ASSERT_TRUE(length == 9);
+    TEST_ASSERT_FALSE(cJSON_TapeCopyString(&item, buffer, length));
+    TEST_ASSERT_TRUE(cJSON_TapeCopyString(&item, buffer, length + 1));
+    TEST_ASSERT_EQUAL_STRING("x\xc3\xa4\n", buffer);
+
+    TEST_ASSERT_TRUE(cJSON_TapeGetObjectItemCaseSensitive(&root, "c", &item));
+    TEST_ASSERT_TRUE(cJSON_TapeCopyString(&item, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("\"", buffer);
+
+    cJSON_DeleteTape(tape);
+}
+
+static void parse_tape_should_convert_to_cjson(void)
+{
+    const char *files[] = {
+        "inputs/test1", "inputs/test2", "inputs/test3", "inputs/test4", "inputs/test5",
+        "inputs/test7", "inputs/test8", "inputs/test9", "inputs/test10", "inputs/test11"
+    };
+    size_t i = 0;
+
+    for (i = 0; i < (sizeof(files) / sizeof(files[0])); i++)
+    {
+        char *json = read_file(files[i]);
+        cJSON *expected = NULL;
+        cJSON *converted = NULL;
+        cJSON_Tape *tape = NULL;
+        cJSON_TapeIterator root;
+
+        TEST_ASSERT_NOT_NULL(json);
+        expected = cJSON_Parse(json);
+        tape = parse_tape(json);
+        TEST_ASSERT_NOT_NULL_MESSAGE(tape, files[i]);
+        TEST_ASSERT_TRUE(cJSON_GetTapeRoot(tape, &root));
+        converted = cJSON_TapeToCJSON(&root);
+        TEST_ASSERT_NOT_NULL(converted);
+        TEST_ASSERT_TRUE_MESSAGE(cJSON_Compare(expected, converted, true), files[i]);
+
+        cJSON_Delete(converted);
+        cJSON_Delete(expected);
+        cJSON_DeleteTape(tape);
+        free(json);
+    }
+}
+
+static void parse_tape_should_convert_members_with_their_name(void)
+{
+    cJSON_Tape *tape = parse_tape("{\"payload\": {\"fanSpeed\": 75, \"modes\": [\"auto\", \"night\"]}}");
+    cJSON_TapeIterator root;
+    cJSON_TapeIterator payload;
+    cJSON *converted = NULL;
+    char *printed = NULL;
+
+    TEST_ASSERT_NOT_NULL(tape);
+    TEST_ASSERT_TRUE(cJSON_GetTapeRoot(tape, &root));
+    TEST_ASSERT_TRUE(cJSON_TapeChild(&root, &payload));
+    converted = cJSON_TapeToCJSON(&payload);
+    /* the tape isn't needed anymore */
+    cJSON_DeleteTape(tape);
+
+    TEST_ASSERT_NOT_NULL(converted);
+    TEST_ASSERT_EQUAL_STRING("payload", converted->string);
+    TEST_ASSERT_EQUAL_INT(75, cJSON_GetObjectItem(converted, "fanSpeed")->valueint);
+    TEST_ASSERT_TRUE(cJSON_GetObjectItem(converted, "modes")->child->prev == cJSON_GetArrayItem(cJSON_GetObjectItem(converted, "modes"), 1));
+    printed = cJSON_PrintUnformatted(converted);
+    TEST_ASSERT_EQUAL_STRING("{\"fanSpeed\":75,\"modes\":[\"auto\",\"night\"]}", printed);
+
+    cJSON_free(printed);
+    cJSON_Delete(converted);
+}
+
+static void parse_tape_should_fail_on_invalid_input(void)
+{
+    const char json[] = "{\"a\": [1, 2}";
+    const char *invalid[] = {
+        "", "  ", "{", "[", "]", "[1,]", "[,1]", "[1 2]", "{\"a\" 1}", "{\"a\":}", "{\"a\":1,}", "{1:2}",
+        "[\"unterminated]", "[\"\\x\"]", "[\"\\u12\"]", "nul", "truex", "[-]", "[1a]", "[1] 2", "{} {}", "[}", "{]"
+    };
+    size_t i = 0;
+
+    TEST_ASSERT_NULL(parse_tape(json));
+    TEST_ASSERT_TRUE(cJSON_GetErrorPtr() == (json + 11));
+
+    for (i = 0; i < (sizeof(invalid) / sizeof(invalid[0])); i++)
+    {
+        TEST_ASSERT_NULL_MESSAGE(parse_tape(invalid[i]), invalid[i]);
+    }
+    TEST_ASSERT_NULL(cJSON_ParseTape(NULL, 1));
+}
+
+static void parse_tape_should_respect_the_nesting_limit(void)
+{
+    char json[(2 * CJSON_NESTING_LIMIT) + 3];
+    cJSON_Tape *tape = NULL;
+
+    memset(json, '[', CJSON_NESTING_LIMIT);
+    memset(json + CJSON_NESTING_LIMIT, ']', CJSON_NESTING_LIMIT);
+    tape = cJSON_ParseTape(json, 2 * CJSON_NESTING_LIMIT);
+    TEST_ASSERT_NOT_NULL(tape);
+    cJSON_DeleteTape(tape);
+
+    memset(json, '[', CJSON_NESTING_LIMIT + 1);
+    memset(json + CJSON_NESTING_LIMIT + 1, ']', CJSON_NESTING_LIMIT + 1);
+    TEST_ASSERT_NULL(cJSON_ParseTape(json, (2 * CJSON_NESTING_LIMIT) + 2));
+}
+
+static void parse_tape_should_not_allocate_per_value(void)
+{
+    char *json = read_file("inputs/test5");
+    cJSON_Tape *tape = NULL;
+    cJSON_TapeIterator root;
+    cJSON_TapeIterator items;
+    cJSON_TapeIterator item;
+    size_t length = 0;
+
+    TEST_ASSERT_NOT_NULL(json);
+
+    allocations = 0;
+    cJSON_InitHooks(&counting_hooks);
+    tape = parse_tape(json);
+    cJSON_InitHooks(NULL);
+
+    /* structural index, open containers and the tape itself */
+    TEST_ASSERT_NOT_NULL(tape);
+    TEST_ASSERT_EQUAL_INT(3, allocations);
+
+    TEST_ASSERT_TRUE(cJSON_GetTapeRoot(tape, &root));
+    TEST_ASSERT_TRUE(cJSON_TapeGetObjectItemCaseSensitive(&root, "menu", &item));
+    TEST_ASSERT_TRUE(cJSON_TapeGetObjectItemCaseSensitive(&item, "items", &items));
+    TEST_ASSERT_EQUAL_INT(22, cJSON_TapeGetArraySize(&items));
+    TEST_ASSERT_TRUE(cJSON_TapeGetArrayItem(&items, 21, &item));
+    TEST_ASSERT_TRUE(cJSON_TapeGetObjectItemCaseSensitive(&item, "label", &item));
+    TEST_ASSERT_EQUAL_INT(0, strncmp(cJSON_TapeGetString(&item, &length), "About Adobe CVG Viewer...", length));
+
+    cJSON_DeleteTape(tape);
+    free(json);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(parse_tape_should_navigate_values);
+    RUN_TEST(parse_tape_should_parse_single_values);
+    RUN_TEST(parse_tape_should_decode_escaped_strings);
+    RUN_TEST(parse_tape_should_convert_to_cjson);
+    RUN_TEST(parse_tape_should_convert_members_with_their_name);
+    RUN_TEST(parse_tape_should_fail_on_invalid_input);
+    RUN_TEST(parse_tape_should_respect_the_nesting_limit);
+    RUN_TEST(parse_tape_should_not_allocate_per_value);
+
+    return UNITY_END();
+}
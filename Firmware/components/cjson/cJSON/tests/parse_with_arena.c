@@ -0,0 +1,261 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static void * CJSON_CDECL failing_malloc(size_t size)
+{
+    (void)size;
+    return NULL;
+}
+
+/* work around MSVC error C2322: '...' address of dllimport '...' is not static */
+static void CJSON_CDECL normal_free(void *pointer)
+{
+    free(pointer);
+}
+
+static cJSON_Hooks failing_hooks = {
+    failing_malloc,
+    normal_free
+};
+
+static const char command[] = "{\"commandId\":\"cmd-42\",\"commandType\":\"SET_FAN_SPEED\",\"payload\":{\"fanSpeed\":75,\"ratio\":0.25},\"tags\":[\"a\\nb\",null,true,false]}";
+
+static void parse_with_arena_should_parse_into_the_arena(void)
+{
+    double memory[256];
+    cJSON_Arena arena;
+    cJSON *root = NULL;
+    cJSON *payload = NULL;
+    cJSON *tags = NULL;
+
+    cJSON_InitArena(&arena, memory, sizeof(memory));
+
+    /* the hooks must not be touched */
+    cJSON_InitHooks(&failing_hooks);
+    root = cJSON_ParseWithArena(command, sizeof(command), &arena);
+    cJSON_InitHooks(NULL);
+
+    TEST_ASSERT_NOT_NULL(root);
+    TEST_ASSERT_TRUE(arena.used > 0);
+    TEST_ASSERT_TRUE(((unsigned char*)root >= arena.memory) && ((unsigned char*)root < (arena.memory + arena.used)));
+
+    TEST_ASSERT_EQUAL_STRING("cmd-42", cJSON_GetObjectItem(root, "commandId")->valuestring);
+    TEST_ASSERT_EQUAL_STRING("SET_FAN_SPEED", cJSON_GetObjectItem(root, "commandType")->valuestring);
+    payload = cJSON_GetObjectItem(root, "payload");
+    TEST_ASSERT_TRUE(cJSON_IsObject(payload));
+    TEST_ASSERT_EQUAL_INT(75, cJSON_GetObjectItem(payload, "fanSpeed")->valueint);
+    TEST_ASSERT_EQUAL_DOUBLE(0.25, cJSON_GetObjectItem(payload, "ratio")->valuedouble);
+    tags = cJSON_GetObjectItem(root, "tags");
+    TEST_ASSERT_EQUAL_INT(4, cJSON_GetArraySize(tags));
+    TEST_ASSERT_EQUAL_STRING("a\nb", cJSON_GetArrayItem(tags, 0)->valuestring);
+    TEST_ASSERT_TRUE(cJSON_IsNull(cJSON_GetArrayItem(tags, 1)));
+    TEST_ASSERT_TRUE(cJSON_IsTrue(cJSON_GetArrayItem(tags, 2)));
+    TEST_ASSERT_TRUE(cJSON_IsFalse(cJSON_GetArrayItem(tags, 3)));
+
+    TEST_ASSERT_BITS(cJSON_ItemInArena | cJSON_StringIsConst | cJSON_ValuestringIsConst,
+            cJSON_ItemInArena | cJSON_StringIsConst | cJSON_ValuestringIsConst, payload->type);
+
+    cJSON_ResetArena(&arena);
+    TEST_ASSERT_TRUE(arena.used == 0);
+}
+
+static void parse_with_arena_should_match_heap_parse(void)
+{
+    double memory[256];
+    cJSON_Arena arena;
+    cJSON *in_arena = NULL;
+    cJSON *on_heap = NULL;
+    char *printed_arena = NULL;
+    char *printed_heap = NULL;
+
+    cJSON_InitArena(&arena, memory, sizeof(memory));
+    in_arena = cJSON_ParseWithArena(command, sizeof(command), &arena);
+    on_heap = cJSON_Parse(command);
+    TEST_ASSERT_NOT_NULL(in_arena);
+    TEST_ASSERT_NOT_NULL(on_heap);
+
+    TEST_ASSERT_TRUE(cJSON_Compare(in_arena, on_heap, true));
+    printed_arena = cJSON_PrintUnformatted(in_arena);
+    printed_heap = cJSON_PrintUnformatted(on_heap);
+    TEST_ASSERT_EQUAL_STRING(printed_heap, printed_arena);
+
+    cJSON_free(printed_arena);
+    cJSON_free(printed_heap);
+    cJSON_Delete(on_heap);
+}
+
+static void parse_with_arena_should_roll_back_on_failure(void)
+{
+    double memory[256];
+    cJSON_Arena arena;
+    cJSON *first = NULL;
+    size_t used = 0;
+
+    cJSON_InitArena(&arena, memory, sizeof(memory));
+    first = cJSON_ParseWithArena("[1,2,3]", sizeof("[1,2,3]"), &arena);
+    TEST_ASSERT_NOT_NULL(first);
+    used = arena.used;
+
+    TEST_ASSERT_NULL(cJSON_ParseWithArena("{\"a\":[1,2,", sizeof("{\"a\":[1,2,"), &arena));
+    TEST_ASSERT_TRUE(arena.used == used);
+
+    /* the earlier parse is untouched */
+    TEST_ASSERT_EQUAL_INT(3, cJSON_GetArraySize(first));
+    TEST_ASSERT_EQUAL_INT(3, cJSON_GetArrayItem(first, 2)->valueint);
+}
+
+static void parse_with_arena_should_fail_if_the_arena_is_too_small(void)
+{
+    double memory[8];
+    cJSON_Arena arena;
+
+    cJSON_InitArena(&arena, memory, sizeof(memory));
+    TEST_ASSERT_NULL(cJSON_ParseWithArena(command, sizeof(command), &arena));
+    TEST_ASSERT_TRUE(arena.used == 0);
+}
+
+static void parse_with_arena_should_handle_unaligned_memory(void)
+{
+    double memory[256];
+    cJSON_Arena arena;
+    cJSON *root = NULL;
+
+    cJSON_InitArena(&arena, (unsigned char*)memory + 1, sizeof(memory) - 1);
+    TEST_ASSERT_TRUE(arena.size < (sizeof(memory) - 1));
+
+    root = cJSON_ParseWithArena(command, sizeof(command), &arena);
+    TEST_ASSERT_NOT_NULL(root);
+    TEST_ASSERT_EQUAL_INT(75, cJSON_GetObjectItem(cJSON_GetObjectItem(root, "payload"), "fanSpeed")->valueint);
+}
+
+static void parse_with_arena_should_handle_null(void)
+{
+    double memory[16];
+    cJSON_Arena arena;
+
+    cJSON_InitArena(NULL, memory, sizeof(memory));
+    cJSON_ResetArena(NULL);
+
+    cJSON_InitArena(&arena, NULL, 100);
+    TEST_ASSERT_NULL(cJSON_ParseWithArena("[]", sizeof("[]"), &arena));
+
+    cJSON_InitArena(&arena, memory, sizeof(memory));
+    TEST_ASSERT_NULL(cJSON_ParseWithArena(NULL, 10, &arena));
+    TEST_ASSERT_NULL(cJSON_ParseWithArena("[]", sizeof("[]"), NULL));
+}
+
+static void arena_items_should_survive_delete_and_duplicate(void)
+{
+    double memory[256];
+    cJSON_Arena arena;
+    cJSON *root = NULL;
+    cJSON *copy = NULL;
+    cJSON *payload = NULL;
+
+    cJSON_InitArena(&arena, memory, sizeof(memory));
+    root = cJSON_ParseWithArena(command, sizeof(command), &arena);
+    TEST_ASSERT_NOT_NULL(root);
+
+    /* deleting arena items is harmless */
+    payload = cJSON_DetachItemFromObject(root, "payload");
+    cJSON_Delete(payload);
+
+    copy = cJSON_Duplicate(root, true);
+    TEST_ASSERT_NOT_NULL(copy);
+    TEST_ASSERT_BITS(cJSON_ItemInArena | cJSON_ValuestringIsConst | cJSON_StringIsConst, 0, cJSON_GetObjectItem(copy, "commandId")->type);
+
+    /* the copy owns its memory, wipe the arena to prove it */
+    cJSON_ResetArena(&arena);
+    memset(memory, 0, sizeof(memory));
+
+    TEST_ASSERT_EQUAL_STRING("cmd-42", cJSON_GetObjectItem(copy, "commandId")->valuestring);
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(copy, "payload"));
+    cJSON_Delete(copy);
+}
+
+static void arena_items_should_accept_new_valuestrings(void)
+{
+    double memory[64];
+    cJSON_Arena arena;
+    cJSON *root = NULL;
+
+    cJSON_InitArena(&arena, memory, sizeof(memory));
+    root = cJSON_ParseWithArena("\"short\"", sizeof("\"short\""), &arena);
+    TEST_ASSERT_NOT_NULL(root);
+
+    TEST_ASSERT_NOT_NULL(cJSON_SetValuestring(root, "a much longer string"));
+    TEST_ASSERT_BITS(cJSON_ValuestringIsConst, 0, root->type);
+    TEST_ASSERT_EQUAL_STRING("a much longer string", root->valuestring);
+
+    /* frees the heap copy but not the item */
+    cJSON_Delete(root);
+}
+
+static void arena_items_should_be_referenced_from_heap_items(void)
+{
+    double memory[256];
+    cJSON_Arena arena;
+    cJSON *root = NULL;
+    cJSON *parent = cJSON_CreateObject();
+    cJSON *list = cJSON_CreateArray();
+
+    cJSON_InitArena(&arena, memory, sizeof(memory));
+    root = cJSON_ParseWithArena(command, sizeof(command), &arena);
+    TEST_ASSERT_NOT_NULL(root);
+
+    TEST_ASSERT_TRUE(cJSON_AddItemReferenceToObject(parent, "command", cJSON_GetObjectItem(root, "commandId")));
+    TEST_ASSERT_TRUE(cJSON_AddItemReferenceToArray(list, cJSON_GetObjectItem(root, "payload")));
+    TEST_ASSERT_BITS(cJSON_ItemInArena | cJSON_ValuestringIsConst, 0, cJSON_GetObjectItem(parent, "command")->type);
+    TEST_ASSERT_BITS(cJSON_ItemInArena, 0, cJSON_GetArrayItem(list, 0)->type);
+    TEST_ASSERT_EQUAL_STRING("cmd-42", cJSON_GetObjectItem(parent, "command")->valuestring);
+
+    /* the references are heap items and freed here, the arena items they point to are not */
+    cJSON_Delete(parent);
+    cJSON_Delete(list);
+    TEST_ASSERT_EQUAL_STRING("cmd-42", cJSON_GetObjectItem(root, "commandId")->valuestring);
+    cJSON_ResetArena(&arena);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(parse_with_arena_should_parse_into_the_arena);
+    RUN_TEST(parse_with_arena_should_match_heap_parse);
+    RUN_TEST(parse_with_arena_should_roll_back_on_failure);
+    RUN_TEST(parse_with_arena_should_fail_if_the_arena_is_too_small);
+    RUN_TEST(parse_with_arena_should_handle_unaligned_memory);
+    RUN_TEST(parse_with_arena_should_handle_null);
+    RUN_TEST(arena_items_should_survive_delete_and_duplicate);
+    RUN_TEST(arena_items_should_accept_new_valuestrings);
+    RUN_TEST(arena_items_should_be_referenced_from_heap_items);
+
+    return UNITY_END();
+}
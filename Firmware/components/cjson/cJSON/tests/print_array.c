@@ -34,7 +34,9 @@ static void assert_print_array(const char * const expected, const char * const i
     printbuffer formatted_buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
     printbuffer unformatted_buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
 
-    parse_buffer parsebuffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer parsebuffer;
+    memset(&parsebuffer, '\0', sizeof(parsebuffer));
+    parsebuffer.nesting_limit = CJSON_NESTING_LIMIT;
     parsebuffer.content = (const unsigned char*)input;
     parsebuffer.length = strlen(input) + sizeof("");
     parsebuffer.hooks = global_hooks;
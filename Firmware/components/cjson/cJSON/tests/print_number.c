@@ -88,7 +88,93 @@ static void print_number_should_print_positive_reals(void)
     assert_print_number("1000000000000", 10e11);
     assert_print_number("1.23e+129", 123e+127);
     assert_print_number("1.23e-126", 123e-128);
-    assert_print_number("3.1415926535897931", 3.1415926535897931);
+    assert_print_number("3.141592653589793", 3.1415926535897931);
+}
+
+static void print_number_should_print_shortest_representation(void)
+{
+    assert_print_number("0.1", 0.1);
+    assert_print_number("0.3", 0.3);
+    assert_print_number("0.30000000000000004", 0.1 + 0.2);
+    assert_print_number("0.3333333333333333", 1.0 / 3.0);
+    assert_print_number("24.5", 24.5);
+    assert_print_number("0.35", 0.35);
+    assert_print_number("0.0001", 0.0001);
+    assert_print_number("1e-05", 0.00001);
+    assert_print_number("123456789012345", 123456789012345.0);
+    assert_print_number("1e+15", 1e15);
+    assert_print_number("9007199254740992", 9007199254740992.0);
+    assert_print_number("123456.78901234567", 123456.78901234567);
+    assert_print_number("1.2345678901234568e+17", 123456789012345680.0);
+    assert_print_number("1.7976931348623157e+308", DBL_MAX);
+    assert_print_number("5e-324", DBL_MIN * DBL_EPSILON);
+}
+
+static void print_number_should_print_shortest_representation_on_boundaries(void)
+{
+    /* these lie exactly on a boundary of the double they read back as, which grisu can't decide */
+    assert_print_number("5e+22", 5e22);
+    assert_print_number("7e+22", 7e22);
+    assert_print_number("1e+23", 1e23);
+    assert_print_number("9e+22", 9e22);
+    assert_print_number("8.41e+21", 8.41e21);
+    assert_print_number("5.547e-310", 5.547e-310);
+    assert_print_number("18014398509481984", 18014398509481984.0);
+}
+
+static void print_number_should_round_trip_random_doubles(void)
+{
+    unsigned char printed[32];
+    cjson_uint64 state = cjson_uint64_constant(0x9E3779B9, 0x7F4A7C15);
+    cJSON item[1];
+    unsigned int i = 0;
+
+    for (i = 0; i < 100000; i++)
+    {
+        printbuffer buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+        double number = 0;
+        double parsed = 0;
+
+        /* xorshift64 over all bit patterns, skipping NaN and infinity */
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        memcpy(&number, &state, sizeof(number));
+        if (isnan(number) || isinf(number))
+        {
+            continue;
+        }
+
+        buffer.buffer = printed;
+        buffer.length = sizeof(printed);
+        buffer.noalloc = true;
+        buffer.hooks = global_hooks;
+
+        memset(item, 0, sizeof(item));
+        cJSON_SetNumberValue(item, number);
+        TEST_ASSERT_TRUE_MESSAGE(print_number(item, &buffer), "Failed to print number.");
+
+        parsed = strtod((const char*)printed, NULL);
+        TEST_ASSERT_TRUE_MESSAGE(memcmp(&parsed, &number, sizeof(number)) == 0 || (number == 0), "Printed number does not round trip.");
+
+        /* the fast path has to come up with the same digits as the exact algorithm */
+        if (number != 0)
+        {
+            unsigned char digits[18];
+            unsigned char exact_digits[18];
+            int length = 0;
+            int exact_length = 0;
+            int decimal_exponent = 0;
+            int exact_decimal_exponent = 0;
+            binary_float decomposed = decompose_double(fabs(number));
+
+            length = shortest_digits(digits, &decimal_exponent, &decomposed);
+            exact_length = bignum_digits(exact_digits, &exact_decimal_exponent, &decomposed);
+            TEST_ASSERT_EQUAL_INT(exact_length, length);
+            TEST_ASSERT_EQUAL_INT(exact_decimal_exponent, decimal_exponent);
+            TEST_ASSERT_EQUAL_MEMORY(exact_digits, digits, (size_t)length);
+        }
+    }
 }
 
 static void print_number_should_print_negative_reals(void)
@@ -118,6 +204,9 @@ int CJSON_CDECL main(void)
     RUN_TEST(print_number_should_print_negative_integers);
     RUN_TEST(print_number_should_print_positive_integers);
     RUN_TEST(print_number_should_print_positive_reals);
+    RUN_TEST(print_number_should_print_shortest_representation);
+    RUN_TEST(print_number_should_print_shortest_representation_on_boundaries);
+    RUN_TEST(print_number_should_round_trip_random_doubles);
     RUN_TEST(print_number_should_print_negative_reals);
     RUN_TEST(print_number_should_print_non_number);
 
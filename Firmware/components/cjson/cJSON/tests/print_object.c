@@ -33,9 +33,11 @@ static void assert_print_object(const char * const expected, const char * const
 
     printbuffer formatted_buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
     printbuffer unformatted_buffer = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
-    parse_buffer parsebuffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer parsebuffer;
 
     /* buffer for parsing */
+    memset(&parsebuffer, '\0', sizeof(parsebuffer));
+    parsebuffer.nesting_limit = CJSON_NESTING_LIMIT;
     parsebuffer.content = (const unsigned char*)input;
     parsebuffer.length = strlen(input) + sizeof("");
     parsebuffer.hooks = global_hooks;
@@ -65,6 +65,33 @@ static void print_string_should_print_utf8(void)
     assert_print_string("\"ü猫慕\"", "ü猫慕");
 }
 
+static void print_string_should_escape_at_every_position(void)
+{
+    char input[80];
+    char expected[96];
+    size_t length = 0;
+    size_t position = 0;
+
+    for (length = 1; length < 70; length++)
+    {
+        for (position = 0; position < length; position++)
+        {
+            memset(input, 'x', length);
+            input[length] = '\0';
+            input[position] = '\n';
+
+            expected[0] = '\"';
+            memset(expected + 1, 'x', length + 1);
+            expected[position + 1] = '\\';
+            expected[position + 2] = 'n';
+            expected[length + 2] = '\"';
+            expected[length + 3] = '\0';
+
+            assert_print_string(expected, input);
+        }
+    }
+}
+
 int CJSON_CDECL main(void)
 {
     /* initialize cJSON item */
@@ -73,6 +100,7 @@ int CJSON_CDECL main(void)
     RUN_TEST(print_string_should_print_empty_strings);
     RUN_TEST(print_string_should_print_ascii);
     RUN_TEST(print_string_should_print_utf8);
+    RUN_TEST(print_string_should_escape_at_every_position);
 
     return UNITY_END();
 }
@@ -0,0 +1,239 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static size_t allocations = 0;
+
+static void * CJSON_CDECL counting_malloc(size_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+/* work around MSVC error C2322: '...' address of dllimport '...' is not static */
+static void CJSON_CDECL normal_free(void *pointer)
+{
+    free(pointer);
+}
+
+static cJSON_Hooks counting_hooks = {
+    counting_malloc,
+    normal_free
+};
+
+/* writes {"name":"a\"b\n","numbers":[1,-0.5,1e+300,null],"flags":{"on":true,"off":false,"none":null},"empty":[]} */
+static cJSON_bool write_document(cJSON_Writer *writer, double not_a_number)
+{
+    cJSON_WriterBeginObject(writer);
+    cJSON_WriterKey(writer, "name");
+    cJSON_WriterString(writer, "a\"b\n");
+    cJSON_WriterKey(writer, "numbers");
+    cJSON_WriterBeginArray(writer);
+    cJSON_WriterNumber(writer, 1);
+    cJSON_WriterNumber(writer, -0.5);
+    cJSON_WriterNumber(writer, 1e300);
+    cJSON_WriterNumber(writer, not_a_number);
+    cJSON_WriterEndArray(writer);
+    cJSON_WriterKey(writer, "flags");
+    cJSON_WriterBeginObject(writer);
+    cJSON_WriterKey(writer, "on");
+    cJSON_WriterBool(writer, 1);
+    cJSON_WriterKey(writer, "off");
+    cJSON_WriterBool(writer, 0);
+    cJSON_WriterKey(writer, "none");
+    cJSON_WriterNull(writer);
+    cJSON_WriterEndObject(writer);
+    cJSON_WriterKey(writer, "empty");
+    cJSON_WriterBeginArray(writer);
+    cJSON_WriterEndArray(writer);
+
+    return cJSON_WriterEndObject(writer);
+}
+
+/* NaN prints as null, cJSON_CreateNumber can't be used for it because it converts it to valueint */
+static cJSON *create_document(void)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON *numbers = NULL;
+    cJSON *flags = NULL;
+
+    cJSON_AddStringToObject(root, "name", "a\"b\n");
+    numbers = cJSON_AddArrayToObject(root, "numbers");
+    cJSON_AddItemToArray(numbers, cJSON_CreateNumber(1));
+    cJSON_AddItemToArray(numbers, cJSON_CreateNumber(-0.5));
+    cJSON_AddItemToArray(numbers, cJSON_CreateNumber(1e300));
+    cJSON_AddItemToArray(numbers, cJSON_CreateNull());
+    flags = cJSON_AddObjectToObject(root, "flags");
+    cJSON_AddTrueToObject(flags, "on");
+    cJSON_AddFalseToObject(flags, "off");
+    cJSON_AddNullToObject(flags, "none");
+    cJSON_AddArrayToObject(root, "empty");
+
+    return root;
+}
+
+static void writer_should_write_like_print_unformatted(void)
+{
+    char buffer[256];
+    cJSON_Writer writer;
+    cJSON *root = NULL;
+    char *printed = NULL;
+    double zero = 0.0;
+
+    cJSON_InitWriter(&writer, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(write_document(&writer, zero / zero));
+
+    root = create_document();
+    printed = cJSON_PrintUnformatted(root);
+    TEST_ASSERT_NOT_NULL(printed);
+    TEST_ASSERT_EQUAL_STRING(printed, buffer);
+    TEST_ASSERT_EQUAL_INT(strlen(printed), cJSON_WriterLength(&writer));
+
+    cJSON_free(printed);
+    cJSON_Delete(root);
+}
+
+static void writer_should_not_allocate(void)
+{
+    char buffer[256];
+    cJSON_Writer writer;
+
+    allocations = 0;
+    cJSON_InitHooks(&counting_hooks);
+
+    cJSON_InitWriter(&writer, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(write_document(&writer, 0.0));
+    TEST_ASSERT_EQUAL_INT(0, allocations);
+
+    cJSON_InitHooks(NULL);
+}
+
+static void writer_should_write_top_level_values(void)
+{
+    char buffer[32];
+    cJSON_Writer writer;
+
+    cJSON_InitWriter(&writer, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(cJSON_WriterString(&writer, NULL));
+    TEST_ASSERT_EQUAL_STRING("\"\"", buffer);
+
+    cJSON_InitWriter(&writer, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(cJSON_WriterNumber(&writer, 2147483648.0));
+    TEST_ASSERT_EQUAL_STRING("2147483648", buffer);
+
+    cJSON_InitWriter(&writer, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(cJSON_WriterNumber(&writer, -42));
+    TEST_ASSERT_EQUAL_STRING("-42", buffer);
+}
+
+static void writer_should_fail_if_the_buffer_is_too_small(void)
+{
+    char buffer[256];
+    cJSON_Writer writer;
+    size_t length = 0;
+    size_t size = 0;
+
+    cJSON_InitWriter(&writer, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(write_document(&writer, 0.0));
+    length = cJSON_WriterLength(&writer);
+
+    /* every smaller buffer fails, and stays zero terminated */
+    for (size = 1; size <= length; size++)
+    {
+        char *small = (char*)malloc(size);
+        TEST_ASSERT_NOT_NULL(small);
+        cJSON_InitWriter(&writer, small, size);
+        TEST_ASSERT_FALSE(write_document(&writer, 0.0));
+        TEST_ASSERT_EQUAL_INT(0, cJSON_WriterLength(&writer));
+        TEST_ASSERT_TRUE(strlen(small) < size);
+        TEST_ASSERT_EQUAL_INT(0, strncmp(small, buffer, strlen(small)));
+        free(small);
+    }
+
+    /* exactly fits with the terminating zero */
+    {
+        char *exact = (char*)malloc(length + 1);
+        TEST_ASSERT_NOT_NULL(exact);
+        cJSON_InitWriter(&writer, exact, length + 1);
+        TEST_ASSERT_TRUE(write_document(&writer, 0.0));
+        TEST_ASSERT_EQUAL_STRING(buffer, exact);
+        free(exact);
+    }
+}
+
+static void writer_should_fail_once_something_did_not_fit(void)
+{
+    char buffer[8];
+    cJSON_Writer writer;
+
+    cJSON_InitWriter(&writer, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(cJSON_WriterBeginArray(&writer));
+    TEST_ASSERT_FALSE(cJSON_WriterString(&writer, "too long"));
+    /* would fit, but the document already lost a value */
+    TEST_ASSERT_FALSE(cJSON_WriterNumber(&writer, 1));
+    TEST_ASSERT_FALSE(cJSON_WriterEndArray(&writer));
+    TEST_ASSERT_EQUAL_INT(0, cJSON_WriterLength(&writer));
+    TEST_ASSERT_EQUAL_STRING("[", buffer);
+}
+
+static void writer_should_handle_null_arguments(void)
+{
+    char buffer[8];
+    cJSON_Writer writer;
+
+    cJSON_InitWriter(NULL, buffer, sizeof(buffer));
+    TEST_ASSERT_FALSE(cJSON_WriterBeginObject(NULL));
+    TEST_ASSERT_FALSE(cJSON_WriterEndObject(NULL));
+    TEST_ASSERT_FALSE(cJSON_WriterNumber(NULL, 1));
+    TEST_ASSERT_EQUAL_INT(0, cJSON_WriterLength(NULL));
+
+    cJSON_InitWriter(&writer, NULL, 8);
+    TEST_ASSERT_FALSE(cJSON_WriterNull(&writer));
+
+    cJSON_InitWriter(&writer, buffer, 0);
+    TEST_ASSERT_FALSE(cJSON_WriterNull(&writer));
+
+    cJSON_InitWriter(&writer, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(cJSON_WriterBeginObject(&writer));
+    TEST_ASSERT_FALSE(cJSON_WriterKey(&writer, NULL));
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(writer_should_write_like_print_unformatted);
+    RUN_TEST(writer_should_not_allocate);
+    RUN_TEST(writer_should_write_top_level_values);
+    RUN_TEST(writer_should_fail_if_the_buffer_is_too_small);
+    RUN_TEST(writer_should_fail_once_something_did_not_fit);
+    RUN_TEST(writer_should_handle_null_arguments);
+
+    return UNITY_END();
+}
@@ -0,0 +1,187 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static size_t allocations = 0;
+
+static void * CJSON_CDECL counting_malloc(size_t size)
+{
+    allocations++;
+    return malloc(size);
+}
+
+/* work around MSVC error C2322: '...' address of dllimport '...' is not static */
+static void CJSON_CDECL normal_free(void *pointer)
+{
+    free(pointer);
+}
+
+static cJSON_Hooks counting_hooks = {
+    counting_malloc,
+    normal_free
+};
+
+/* the measured length has to be exactly what is printed, and enough for cJSON_PrintPreallocated */
+static void assert_printed_length_is_exact(cJSON * const item, const cJSON_bool format)
+{
+    size_t length = cJSON_PrintedLength(item, format);
+    char *printed = NULL;
+    char *buffer = NULL;
+
+    allocations = 0;
+    cJSON_InitHooks(&counting_hooks);
+    printed = format ? cJSON_Print(item) : cJSON_PrintUnformatted(item);
+    cJSON_InitHooks(NULL);
+    TEST_ASSERT_NOT_NULL(printed);
+    TEST_ASSERT_TRUE(allocations == 1);
+    TEST_ASSERT_TRUE(strlen(printed) == length);
+
+    buffer = (char*)malloc(length + 1);
+    TEST_ASSERT_NOT_NULL(buffer);
+    TEST_ASSERT_TRUE(cJSON_PrintPreallocated(item, buffer, (int)length + 1, format));
+    TEST_ASSERT_EQUAL_STRING(printed, buffer);
+    TEST_ASSERT_FALSE(cJSON_PrintPreallocated(item, buffer, (int)length, format));
+
+    free(buffer);
+    cJSON_free(printed);
+}
+
+static void assert_printed_length_of_json(const char * const json)
+{
+    cJSON *item = cJSON_Parse(json);
+
+    TEST_ASSERT_NOT_NULL_MESSAGE(item, json);
+    assert_printed_length_is_exact(item, true);
+    assert_printed_length_is_exact(item, false);
+
+    cJSON_Delete(item);
+}
+
+static void printed_length_should_measure_values(void)
+{
+    assert_printed_length_of_json("null");
+    assert_printed_length_of_json("true");
+    assert_printed_length_of_json("false");
+    assert_printed_length_of_json("0");
+    assert_printed_length_of_json("-1.5e-300");
+    assert_printed_length_of_json("123456.78901234567");
+    assert_printed_length_of_json("\"\"");
+    assert_printed_length_of_json("\"plain\"");
+    assert_printed_length_of_json("\"esc\\\"ap\\\\e\\b\\f\\n\\r\\t\\u0001\\u001f\"");
+    assert_printed_length_of_json("\"\\u00e4\\u20ac\"");
+}
+
+static void printed_length_should_measure_arrays_and_objects(void)
+{
+    assert_printed_length_of_json("[]");
+    assert_printed_length_of_json("{}");
+    assert_printed_length_of_json("[[]]");
+    assert_printed_length_of_json("{\"a\": {}}");
+    assert_printed_length_of_json("[1, \"two\", [3, [4, {\"five\": 5}]], {}]");
+    assert_printed_length_of_json("{\"a\": {\"b\": {\"c\": [1, 2, {\"d\": null}]}}, \"e\\n\": \"f\", \"g\": []}");
+}
+
+static void printed_length_should_measure_the_example_files(void)
+{
+    const char * const files[] = {
+        "inputs/test1", "inputs/test2", "inputs/test3", "inputs/test4", "inputs/test5",
+        "inputs/test6", "inputs/test7", "inputs/test8", "inputs/test9", "inputs/test10", "inputs/test11"
+    };
+    size_t i = 0;
+
+    for (i = 0; i < (sizeof(files) / sizeof(files[0])); i++)
+    {
+        char *json = read_file(files[i]);
+        cJSON *item = NULL;
+
+        TEST_ASSERT_NOT_NULL_MESSAGE(json, files[i]);
+        item = cJSON_Parse(json);
+        if (item != NULL)
+        {
+            assert_printed_length_is_exact(item, true);
+            assert_printed_length_is_exact(item, false);
+            cJSON_Delete(item);
+        }
+        free(json);
+    }
+}
+
+static void printed_length_should_measure_raw_and_created_items(void)
+{
+    cJSON *object = cJSON_CreateObject();
+    cJSON *not_a_number = NULL;
+
+    TEST_ASSERT_NOT_NULL(cJSON_AddRawToObject(object, "raw", "{\"x\":[1,2]}"));
+    not_a_number = cJSON_AddNumberToObject(object, "nan", 0);
+    TEST_ASSERT_NOT_NULL(not_a_number);
+    /* printed as null */
+    not_a_number->valuedouble = NAN;
+    TEST_ASSERT_NOT_NULL(cJSON_AddNumberToObject(object, "big", 1e300));
+    TEST_ASSERT_TRUE(cJSON_AddItemToArray(object, cJSON_CreateString("no key")));
+    TEST_ASSERT_NOT_NULL(cJSON_AddStringToObject(object, "after", "value"));
+
+    assert_printed_length_is_exact(object, true);
+    assert_printed_length_is_exact(object, false);
+
+    cJSON_Delete(object);
+}
+
+static void printed_length_should_fail_on_invalid_items(void)
+{
+    cJSON invalid[1];
+    cJSON *array = cJSON_CreateArray();
+
+    memset(invalid, '\0', sizeof(invalid));
+    TEST_ASSERT_TRUE(cJSON_PrintedLength(NULL, true) == 0);
+    TEST_ASSERT_TRUE(cJSON_PrintedLength(invalid, true) == 0);
+
+    invalid->type = cJSON_Raw;
+    TEST_ASSERT_TRUE(cJSON_PrintedLength(invalid, false) == 0);
+
+    /* invalid items nested somewhere */
+    TEST_ASSERT_TRUE(cJSON_AddItemToArray(array, cJSON_CreateNull()));
+    TEST_ASSERT_TRUE(cJSON_AddItemReferenceToArray(array, invalid));
+    TEST_ASSERT_TRUE(cJSON_PrintedLength(array, false) == 0);
+    TEST_ASSERT_NULL(cJSON_PrintUnformatted(array));
+
+    cJSON_Delete(array);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(printed_length_should_measure_values);
+    RUN_TEST(printed_length_should_measure_arrays_and_objects);
+    RUN_TEST(printed_length_should_measure_the_example_files);
+    RUN_TEST(printed_length_should_measure_raw_and_created_items);
+    RUN_TEST(printed_length_should_fail_on_invalid_items);
+
+    return UNITY_END();
+}
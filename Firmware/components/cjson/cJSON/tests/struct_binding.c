@@ -0,0 +1,327 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+typedef enum { mode_auto, mode_manual, mode_sleep } fan_mode;
+
+typedef struct
+{
+    char id[16];
+    double temperature;
+    float humidity;
+    int rssi;
+    unsigned char fan_speed;
+    unsigned char power;
+    fan_mode mode;
+    short minimum;
+    unsigned long maximum;
+} device;
+
+static const char * const mode_names[] = { "AUTO", "MANUAL", "SLEEP" };
+
+enum { id_field, temperature_field, humidity_field, rssi_field, fan_speed_field, power_field, mode_field, limits_field, minimum_field, maximum_field, field_count };
+
+static const cJSON_Field device_fields[] = {
+    cJSON_FIELD(cJSON_FieldString, "id", device, id),
+    cJSON_FIELD(cJSON_FieldDouble, "temperature", device, temperature),
+    cJSON_FIELD(cJSON_FieldFloat, "humidity", device, humidity),
+    cJSON_FIELD(cJSON_FieldInt, "rssi", device, rssi),
+    cJSON_FIELD(cJSON_FieldUnsigned, "fanSpeed", device, fan_speed),
+    cJSON_FIELD(cJSON_FieldBool, "power", device, power),
+    cJSON_ENUM_FIELD("mode", device, mode, mode_names),
+    cJSON_OBJECT_FIELD("limits", 2),
+    cJSON_FIELD(cJSON_FieldInt, "minimum", device, minimum),
+    cJSON_FIELD(cJSON_FieldUnsigned, "maximum", device, maximum)
+};
+
+static const device sample = { "fan \"1\"", 24.125, 48.5f, -61, 75, 1, mode_manual, -300, 4000000000UL };
+
+static const char sample_json[] = "{\"id\":\"fan \\\"1\\\"\",\"temperature\":24.125,\"humidity\":48.5,\"rssi\":-61,\"fanSpeed\":75,\"power\":true,\"mode\":\"MANUAL\",\"limits\":{\"minimum\":-300,\"maximum\":4000000000}}";
+
+static cJSON_bool parse_device(const char *json, device *result, unsigned long *found)
+{
+    cJSON_Binding binding;
+    char scratch[32];
+    cJSON_bool parsed = false;
+
+    TEST_ASSERT_TRUE(cJSON_InitBinding(&binding, device_fields, field_count, result));
+    parsed = cJSON_ParseSAX(json, strlen(json), cJSON_GetBindingHandler(), &binding, scratch, sizeof(scratch));
+    *found = cJSON_GetBindingFound(&binding);
+
+    return parsed;
+}
+
+static void assert_devices_equal(const device *expected, const device *actual)
+{
+    TEST_ASSERT_EQUAL_STRING(expected->id, actual->id);
+    TEST_ASSERT_TRUE(expected->temperature == actual->temperature);
+    TEST_ASSERT_TRUE(expected->humidity == actual->humidity);
+    TEST_ASSERT_EQUAL_INT(expected->rssi, actual->rssi);
+    TEST_ASSERT_EQUAL_INT(expected->fan_speed, actual->fan_speed);
+    TEST_ASSERT_EQUAL_INT(expected->power, actual->power);
+    TEST_ASSERT_EQUAL_INT(expected->mode, actual->mode);
+    TEST_ASSERT_EQUAL_INT(expected->minimum, actual->minimum);
+    TEST_ASSERT_TRUE(expected->maximum == actual->maximum);
+}
+
+static void binding_should_write_fields(void)
+{
+    char buffer[256];
+    cJSON_Writer writer;
+
+    cJSON_InitWriter(&writer, buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(cJSON_WriterBeginObject(&writer));
+    TEST_ASSERT_TRUE(cJSON_WriterFields(&writer, device_fields, field_count, &sample));
+    TEST_ASSERT_TRUE(cJSON_WriterEndObject(&writer));
+    TEST_ASSERT_EQUAL_STRING(sample_json, buffer);
+}
+
+static void binding_should_round_trip(void)
+{
+    char buffer[256];
+    cJSON_Writer writer;
+    device result;
+    unsigned long found = 0;
+
+    cJSON_InitWriter(&writer, buffer, sizeof(buffer));
+    cJSON_WriterBeginObject(&writer);
+    cJSON_WriterFields(&writer, device_fields, field_count, &sample);
+    TEST_ASSERT_TRUE(cJSON_WriterEndObject(&writer));
+
+    memset(&result, '\0', sizeof(result));
+    TEST_ASSERT_TRUE(parse_device(buffer, &result, &found));
+    TEST_ASSERT_TRUE(found == ((1UL << field_count) - 1));
+    assert_devices_equal(&sample, &result);
+}
+
+static void binding_should_match_keys_like_get_object_item(void)
+{
+    device result;
+    unsigned long found = 0;
+
+    memset(&result, '\0', sizeof(result));
+    result.rssi = 7;
+    TEST_ASSERT_TRUE(parse_device("{\"FANSPEED\": 10, \"fanSpeed\": 20, \"other\": {\"temperature\": 1, \"list\": [1, {}]},"
+        " \"minimum\": 5, \"limits\": {\"Minimum\": -1, \"extra\": [true]}, \"humidity\": null, \"id\": \"a\"}", &result, &found));
+
+    TEST_ASSERT_EQUAL_INT(10, result.fan_speed);
+    TEST_ASSERT_TRUE(result.temperature == 0);
+    /* minimum only counts inside of limits */
+    TEST_ASSERT_EQUAL_INT(-1, result.minimum);
+    TEST_ASSERT_EQUAL_STRING("a", result.id);
+    /* missing members are left alone */
+    TEST_ASSERT_EQUAL_INT(7, result.rssi);
+    TEST_ASSERT_TRUE(found == ((1UL << fan_speed_field) | (1UL << limits_field) | (1UL << minimum_field) | (1UL << id_field)));
+}
+
+static void binding_should_reject_values_that_do_not_fit(void)
+{
+    device result;
+    unsigned long found = 0;
+
+    memset(&result, '\0', sizeof(result));
+    TEST_ASSERT_FALSE(parse_device("{\"fanSpeed\": 256}", &result, &found));
+    TEST_ASSERT_FALSE(parse_device("{\"fanSpeed\": -1}", &result, &found));
+    TEST_ASSERT_FALSE(parse_device("{\"minimum\": 0, \"limits\": {\"minimum\": 40000}}", &result, &found));
+    TEST_ASSERT_FALSE(parse_device("{\"rssi\": 1e10}", &result, &found));
+    TEST_ASSERT_FALSE(parse_device("{\"fanSpeed\": \"75\"}", &result, &found));
+    TEST_ASSERT_FALSE(parse_device("{\"id\": 1}", &result, &found));
+    TEST_ASSERT_FALSE(parse_device("{\"power\": 1}", &result, &found));
+    TEST_ASSERT_FALSE(parse_device("{\"limits\": 1}", &result, &found));
+    TEST_ASSERT_FALSE(parse_device("{\"limits\": []}", &result, &found));
+    TEST_ASSERT_FALSE(parse_device("{\"temperature\": {}}", &result, &found));
+    TEST_ASSERT_FALSE(parse_device("[]", &result, &found));
+    TEST_ASSERT_FALSE(parse_device("\"id\"", &result, &found));
+    TEST_ASSERT_FALSE(parse_device("null", &result, &found));
+
+    /* numbers are truncated */
+    TEST_ASSERT_TRUE(parse_device("{\"fanSpeed\": 255.9, \"rssi\": -2.5}", &result, &found));
+    TEST_ASSERT_EQUAL_INT(255, result.fan_speed);
+    TEST_ASSERT_EQUAL_INT(-2, result.rssi);
+}
+
+static void binding_should_map_enums_and_cut_strings(void)
+{
+    char buffer[256];
+    cJSON_Writer writer;
+    device result;
+    unsigned long found = 0;
+
+    memset(&result, '\0', sizeof(result));
+    TEST_ASSERT_TRUE(parse_device("{\"mode\": \"TURBO\", \"id\": \"0123456789abcdefghij\"}", &result, &found));
+    TEST_ASSERT_EQUAL_INT(3, result.mode);
+    TEST_ASSERT_EQUAL_STRING("0123456789abcde", result.id);
+
+    /* a mode without a name is written as null */
+    cJSON_InitWriter(&writer, buffer, sizeof(buffer));
+    cJSON_WriterBeginObject(&writer);
+    cJSON_WriterFields(&writer, device_fields + mode_field, 1, &result);
+    TEST_ASSERT_TRUE(cJSON_WriterEndObject(&writer));
+    TEST_ASSERT_EQUAL_STRING("{\"mode\":null}", buffer);
+
+    /* a string without a terminating zero can't be written */
+    memset(result.id, 'x', sizeof(result.id));
+    cJSON_InitWriter(&writer, buffer, sizeof(buffer));
+    cJSON_WriterBeginObject(&writer);
+    TEST_ASSERT_FALSE(cJSON_WriterFields(&writer, device_fields, field_count, &result));
+}
+
+static void binding_should_map_named_booleans(void)
+{
+    static const char * const power_names[] = { "OFF", "ON" };
+    static const cJSON_Field power_fields[] = {
+        cJSON_NAMED_BOOL_FIELD("power", device, power, power_names)
+    };
+    cJSON_Binding binding;
+    cJSON_Writer writer;
+    char buffer[32];
+    char scratch[16];
+    device result;
+
+    cJSON_InitWriter(&writer, buffer, sizeof(buffer));
+    cJSON_WriterBeginObject(&writer);
+    TEST_ASSERT_TRUE(cJSON_WriterFields(&writer, power_fields, 1, &sample));
+    TEST_ASSERT_TRUE(cJSON_WriterEndObject(&writer));
+    TEST_ASSERT_EQUAL_STRING("{\"power\":\"ON\"}", buffer);
+
+    memset(&result, '\0', sizeof(result));
+    TEST_ASSERT_TRUE(cJSON_InitBinding(&binding, power_fields, 1, &result));
+    TEST_ASSERT_TRUE(cJSON_ParseSAX(buffer, strlen(buffer), cJSON_GetBindingHandler(), &binding, scratch, sizeof(scratch)));
+    TEST_ASSERT_EQUAL_INT(1, result.power);
+
+    TEST_ASSERT_TRUE(cJSON_InitBinding(&binding, power_fields, 1, &result));
+    TEST_ASSERT_TRUE(cJSON_ParseSAX("{\"power\":\"OFF\"}", 15, cJSON_GetBindingHandler(), &binding, scratch, sizeof(scratch)));
+    TEST_ASSERT_EQUAL_INT(0, result.power);
+
+    /* true and false are taken as well, other names are rejected and leave the member alone */
+    TEST_ASSERT_TRUE(cJSON_InitBinding(&binding, power_fields, 1, &result));
+    TEST_ASSERT_TRUE(cJSON_ParseSAX("{\"power\":true}", 14, cJSON_GetBindingHandler(), &binding, scratch, sizeof(scratch)));
+    TEST_ASSERT_EQUAL_INT(1, result.power);
+    TEST_ASSERT_TRUE(cJSON_InitBinding(&binding, power_fields, 1, &result));
+    TEST_ASSERT_FALSE(cJSON_ParseSAX("{\"power\":\"MAYBE\"}", 17, cJSON_GetBindingHandler(), &binding, scratch, sizeof(scratch)));
+    TEST_ASSERT_EQUAL_INT(1, result.power);
+    TEST_ASSERT_EQUAL_INT(0, cJSON_GetBindingFound(&binding));
+}
+
+static void binding_should_write_floats_with_float_precision(void)
+{
+    static const cJSON_Field humidity_fields[] = {
+        cJSON_FIELD(cJSON_FieldFloat, "humidity", device, humidity)
+    };
+    static const float humidities[] = { 23.1f, -0.3f, 1e-7f, 3.4028235e38f, 16777216.0f, 1.4e-45f };
+    static const char * const printed[] = {
+        "{\"humidity\":23.1}",
+        "{\"humidity\":-0.3}",
+        "{\"humidity\":1e-07}",
+        "{\"humidity\":3.4028235e+38}",
+        "{\"humidity\":16777216}",
+        "{\"humidity\":1e-45}"
+    };
+    cJSON_Binding binding;
+    cJSON_Writer writer;
+    char buffer[64];
+    char scratch[16];
+    device value;
+    device result;
+    size_t i = 0;
+
+    memset(&value, '\0', sizeof(value));
+    for (i = 0; i < (sizeof(humidities) / sizeof(humidities[0])); i++)
+    {
+        value.humidity = humidities[i];
+        cJSON_InitWriter(&writer, buffer, sizeof(buffer));
+        cJSON_WriterBeginObject(&writer);
+        TEST_ASSERT_TRUE(cJSON_WriterFields(&writer, humidity_fields, 1, &value));
+        TEST_ASSERT_TRUE(cJSON_WriterEndObject(&writer));
+        TEST_ASSERT_EQUAL_STRING(printed[i], buffer);
+
+        /* the shorter digits still read back as the same float */
+        memset(&result, '\0', sizeof(result));
+        TEST_ASSERT_TRUE(cJSON_InitBinding(&binding, humidity_fields, 1, &result));
+        TEST_ASSERT_TRUE(cJSON_ParseSAX(buffer, strlen(buffer), cJSON_GetBindingHandler(), &binding, scratch, sizeof(scratch)));
+        TEST_ASSERT_TRUE(memcmp(&value.humidity, &result.humidity, sizeof(float)) == 0);
+    }
+}
+
+static void binding_should_work_with_the_incremental_parser(void)
+{
+    const size_t length = strlen(sample_json);
+    size_t split = 0;
+    char scratch[32];
+
+    for (split = 1; split < length; split++)
+    {
+        cJSON_Binding binding;
+        cJSON_Parser *parser = NULL;
+        device result;
+
+        memset(&result, '\0', sizeof(result));
+        TEST_ASSERT_TRUE(cJSON_InitBinding(&binding, device_fields, field_count, &result));
+        parser = cJSON_CreateParser(cJSON_GetBindingHandler(), &binding, scratch, sizeof(scratch));
+        TEST_ASSERT_NOT_NULL(parser);
+
+        TEST_ASSERT_TRUE(cJSON_ParserFeed(parser, sample_json, split));
+        TEST_ASSERT_TRUE(cJSON_ParserFeed(parser, sample_json + split, length - split));
+        TEST_ASSERT_TRUE(cJSON_ParserFinish(parser));
+        TEST_ASSERT_TRUE(cJSON_GetBindingFound(&binding) == ((1UL << field_count) - 1));
+        assert_devices_equal(&sample, &result);
+
+        cJSON_DeleteParser(parser);
+    }
+}
+
+static void binding_should_check_arguments(void)
+{
+    cJSON_Binding binding;
+    device result;
+
+    TEST_ASSERT_FALSE(cJSON_InitBinding(NULL, device_fields, field_count, &result));
+    TEST_ASSERT_FALSE(cJSON_InitBinding(&binding, NULL, field_count, &result));
+    TEST_ASSERT_FALSE(cJSON_InitBinding(&binding, device_fields, field_count, NULL));
+    TEST_ASSERT_FALSE(cJSON_InitBinding(&binding, device_fields, sizeof(unsigned long) * CHAR_BIT + 1, &result));
+    TEST_ASSERT_FALSE(cJSON_WriterFields(NULL, device_fields, field_count, &result));
+    TEST_ASSERT_EQUAL_INT(0, cJSON_GetBindingFound(NULL));
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(binding_should_write_fields);
+    RUN_TEST(binding_should_round_trip);
+    RUN_TEST(binding_should_match_keys_like_get_object_item);
+    RUN_TEST(binding_should_reject_values_that_do_not_fit);
+    RUN_TEST(binding_should_map_enums_and_cut_strings);
+    RUN_TEST(binding_should_map_named_booleans);
+    RUN_TEST(binding_should_write_floats_with_float_precision);
+    RUN_TEST(binding_should_work_with_the_incremental_parser);
+    RUN_TEST(binding_should_check_arguments);
+
+    return UNITY_END();
+}
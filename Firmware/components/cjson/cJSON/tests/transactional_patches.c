@@ -0,0 +1,132 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+#include "../cJSON_Utils.h"
+
+static const char shadow[] = "{\"state\":{\"fan\":{\"speed\":3,\"mode\":\"auto\"},\"filters\":[{\"id\":1},{\"id\":2},{\"id\":3}],\"power\":\"ON\"},\"version\":7}";
+
+/* apply the patches transactionally, they must fail with 'status' and leave the document untouched */
+static void assert_rolled_back(const char *document_json, const char *patches_json, int status)
+{
+    cJSON *document = cJSON_Parse(document_json);
+    cJSON *patches = cJSON_Parse(patches_json);
+    char *printed = NULL;
+
+    TEST_ASSERT_NOT_NULL(document);
+    TEST_ASSERT_NOT_NULL(patches);
+    TEST_ASSERT_EQUAL_INT(status, cJSONUtils_ApplyPatchesTransactionalCaseSensitive(document, patches));
+
+    printed = cJSON_PrintUnformatted(document);
+    TEST_ASSERT_EQUAL_STRING(document_json, printed);
+
+    cJSON_free(printed);
+    cJSON_Delete(patches);
+    cJSON_Delete(document);
+}
+
+static void transactional_patches_should_apply_like_apply_patches(void)
+{
+    const char patches_json[] = "[{\"op\":\"replace\",\"path\":\"/state/fan/speed\",\"value\":4},{\"op\":\"move\",\"from\":\"/state/power\",\"path\":\"/power\"},"
+        "{\"op\":\"copy\",\"from\":\"/state/filters/0\",\"path\":\"/state/filters/-\"},{\"op\":\"remove\",\"path\":\"/state/filters/1\"},"
+        "{\"op\":\"add\",\"path\":\"/state/fan/boost\",\"value\":true},{\"op\":\"test\",\"path\":\"/version\",\"value\":7}]";
+    cJSON *patches = cJSON_Parse(patches_json);
+    cJSON *expected = cJSON_Parse(shadow);
+    cJSON *document = cJSON_Parse(shadow);
+
+    TEST_ASSERT_EQUAL_INT(0, cJSONUtils_ApplyPatchesCaseSensitive(expected, patches));
+    TEST_ASSERT_EQUAL_INT(0, cJSONUtils_ApplyPatchesTransactionalCaseSensitive(document, patches));
+    TEST_ASSERT_TRUE(cJSON_Compare(document, expected, true));
+
+    cJSON_Delete(document);
+    cJSON_Delete(expected);
+    cJSON_Delete(patches);
+}
+
+static void transactional_patches_should_roll_back_all_operations(void)
+{
+    /* the last operation fails, status 13 */
+    assert_rolled_back(shadow, "[{\"op\":\"replace\",\"path\":\"/state/fan/speed\",\"value\":4},{\"op\":\"remove\",\"path\":\"/state/filters/0\"},"
+        "{\"op\":\"add\",\"path\":\"/state/filters/1\",\"value\":{\"id\":9}},{\"op\":\"remove\",\"path\":\"/missing\"}]", 13);
+    /* a failed test, status 1 */
+    assert_rolled_back(shadow, "[{\"op\":\"remove\",\"path\":\"/state/filters/2\"},{\"op\":\"remove\",\"path\":\"/state/filters/0\"},"
+        "{\"op\":\"test\",\"path\":\"/version\",\"value\":8}]", 1);
+}
+
+static void transactional_patches_should_restore_keys_of_moved_members(void)
+{
+    /* the moved members get new keys and positions, the rollback puts back both */
+    assert_rolled_back(shadow, "[{\"op\":\"move\",\"from\":\"/state/power\",\"path\":\"/state/fan/on\"},{\"op\":\"move\",\"from\":\"/state/fan\",\"path\":\"/ventilator\"},"
+        "{\"op\":\"move\",\"from\":\"/state/filters/0\",\"path\":\"/state/filters/-\"},{\"op\":\"add\",\"path\":\"/x/y\",\"value\":1}]", 9);
+}
+
+static void transactional_patches_should_roll_back_failed_moves(void)
+{
+    /* the moved member is detached before its new parent is looked up */
+    assert_rolled_back(shadow, "[{\"op\":\"move\",\"from\":\"/state/power\",\"path\":\"/missing/power\"}]", 9);
+    assert_rolled_back(shadow, "[{\"op\":\"replace\",\"path\":\"/version\",\"value\":8},"
+        "{\"op\":\"move\",\"from\":\"/state/fan\",\"path\":\"/state/filters/9\"}]", 10);
+    assert_rolled_back(shadow, "[{\"op\":\"move\",\"from\":\"/state/filters/0\",\"path\":\"/state/filters/first\"}]", 11);
+}
+
+static void transactional_patches_should_roll_back_replacing_the_root(void)
+{
+    assert_rolled_back(shadow, "[{\"op\":\"replace\",\"path\":\"\",\"value\":[1,2]},{\"op\":\"add\",\"path\":\"/0\",\"value\":0},{\"op\":\"add\",\"path\":\"/9\",\"value\":9}]", 10);
+    assert_rolled_back(shadow, "[{\"op\":\"remove\",\"path\":\"\"},{\"op\":\"add\",\"path\":\"/version\",\"value\":8}]", 9);
+}
+
+static void transactional_patches_should_reject_malformed_patches(void)
+{
+    cJSON *document = cJSON_Parse(shadow);
+    cJSON *patches = cJSON_CreateObject();
+
+    TEST_ASSERT_EQUAL_INT(1, cJSONUtils_ApplyPatchesTransactional(document, patches));
+    TEST_ASSERT_EQUAL_INT(1, cJSONUtils_ApplyPatchesTransactional(document, NULL));
+    cJSON_Delete(patches);
+
+    patches = cJSON_Parse("[{\"op\":\"replace\",\"path\":\"/version\",\"value\":8},{\"op\":\"invalid\",\"path\":\"/version\"}]");
+    TEST_ASSERT_EQUAL_INT(3, cJSONUtils_ApplyPatchesTransactional(document, patches));
+    TEST_ASSERT_EQUAL_INT(7, cJSON_GetObjectItemCaseSensitive(document, "version")->valueint);
+
+    cJSON_Delete(patches);
+    cJSON_Delete(document);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(transactional_patches_should_apply_like_apply_patches);
+    RUN_TEST(transactional_patches_should_roll_back_all_operations);
+    RUN_TEST(transactional_patches_should_restore_keys_of_moved_members);
+    RUN_TEST(transactional_patches_should_roll_back_failed_moves);
+    RUN_TEST(transactional_patches_should_roll_back_replacing_the_root);
+    RUN_TEST(transactional_patches_should_reject_malformed_patches);
+
+    return UNITY_END();
+}
@@ -6,17 +6,24 @@
 #include "wifi_manager.h"
 #include "esp_log.h"
 #include "cJSON.h"
+#include "json_binding.h"
+#include <stdio.h>
 #include <string.h>
 
 static const char *TAG = "MQTT_CLIENT";
 static esp_mqtt_client_handle_t mqtt_client = NULL;
 static bool mqtt_connected = false;
+// command being received, filled in over one or more MQTT_EVENT_DATA events
+static command_t pending_cmd;
 
 // topic definitions
 #define TELEMETRY_TOPIC "devices/" DEVICE_ID "/telemetry"
 #define COMMAND_TOPIC   "devices/" DEVICE_ID "/commands"
 #define ACK_TOPIC       "devices/" DEVICE_ID "/ack"
 
+// largest telemetry document, the ssid may take up to 6 bytes per character once escaped
+#define TELEMETRY_JSON_SIZE 512
+
 static void mqtt_event_handler(void *handler_args, esp_event_base_t base, int32_t event_id, void *event_data) {
     esp_mqtt_event_handle_t event = event_data;
 
@@ -40,28 +47,32 @@ static void mqtt_event_handler(void *handler_args, esp_event_base_t base, int32_
             break;
         
         case MQTT_EVENT_DATA:
-            ESP_LOGI(TAG,"MQTT_EVENT_DATA");
-            ESP_LOGI(TAG,"TOPIC=%.*s",event->topic_len, event->topic);
-            ESP_LOGI(TAG,"DATA=%.*s", event->data_len,event->data);
+            // messages larger than the client's buffer arrive as several events,
+            // only the first one (at offset 0) carries the topic
+            if (event->current_data_offset == 0) {
+                ESP_LOGI(TAG,"MQTT_EVENT_DATA");
+                ESP_LOGI(TAG,"TOPIC=%.*s",event->topic_len, event->topic);
+                command_handler_begin(&pending_cmd);
+            }
+            ESP_LOGI(TAG,"DATA=%.*s (%d/%d)", event->data_len,event->data,
+                     event->current_data_offset + event->data_len, event->total_data_len);
 
-            // hndle incoming commands
-            char data_buf[512];
-            int len = event->data_len < sizeof(data_buf) - 1 ? event->data_len : sizeof(data_buf) - 1;
-            memcpy(data_buf, event->data, len);
-            data_buf[len] = '\0';
+            // hndle incoming commands, parsed piece by piece straight out of the client's receive buffer
+            command_handler_feed(event->data, event->data_len);
+            if (event->current_data_offset + event->data_len < event->total_data_len) {
+                break;
+            }
 
-            // parse and execute command
-            command_t cmd;
-            esp_err_t ret = command_handler_parse(data_buf,&cmd);
+            esp_err_t ret = command_handler_finish();
 
             char ack_json[256];
             if (ret == ESP_OK) {
-                ret = command_handler_execute(&cmd);
+                ret = command_handler_execute(&pending_cmd);
                 if (ret == ESP_OK) {
-                    command_handler_build_ack(cmd.command_id, true, NULL, ack_json,sizeof(ack_json));
+                    command_handler_build_ack(pending_cmd.command_id, true, NULL, ack_json,sizeof(ack_json));
                     ESP_LOGI(TAG,"Command executed successfully");
                 } else {
-                    command_handler_build_ack(cmd.command_id,false,"Execution Failed",ack_json,sizeof(ack_json));
+                    command_handler_build_ack(pending_cmd.command_id,false,"Execution Failed",ack_json,sizeof(ack_json));
                 }
             } else {
                 command_handler_build_ack("unknown",false,"Parse error",ack_json,sizeof(ack_json));
@@ -110,30 +121,30 @@ esp_err_t mqtt_publish_telemetry(void) {
         return ESP_FAIL;
     }
 
-    device_state_t *state = device_state_get();
-
-    cJSON *root = cJSON_CreateObject();
-    cJSON_AddStringToObject(root, "deviceId", DEVICE_ID);
-    cJSON_AddNumberToObject(root, "temperature", state->sensors.temperature);
-    cJSON_AddNumberToObject(root, "humidity", state->sensors.humidity);
-    cJSON_AddNumberToObject(root, "pm1", state->sensors.pm1);
-    cJSON_AddNumberToObject(root, "pm25", state->sensors.pm25);
-    cJSON_AddNumberToObject(root, "pm10", state->sensors.pm10);
-    cJSON_AddNumberToObject(root, "voc", state->sensors.voc);
-    cJSON_AddNumberToObject(root, "soundLevel", state->sensors.sound_level);
-    cJSON_AddNumberToObject(root, "wifiRssi", wifi_get_rssi());
-    cJSON_AddStringToObject(root, "wifiSsid",wifi_get_ssid());
-    cJSON_AddNumberToObject(root, "fanSpeed", state->fan_speed);
-    cJSON_AddStringToObject(root, "powerState", state->power_state ? "ON" : "OFF");
-
-    char *json_str = cJSON_PrintUnformatted(root);
-
-    int msg_id = esp_mqtt_client_publish(mqtt_client,TELEMETRY_TOPIC,json_str,0,1,0);
-    ESP_LOGI(TAG,"Telemetry published, msg_id= %d",msg_id);
-    ESP_LOGI(TAG,"Temp : %.2f , Humidity : %.2f, PM2.5: %.2f",state->sensors.temperature, state->sensors.humidity,state->sensors.pm25);
+    // the state as published: the rssi of the connection instead of the simulated one
+    device_state_t state = *device_state_get();
+    snprintf(state.device_id, sizeof(state.device_id), "%s", DEVICE_ID);
+    state.sensors.wifi_rssi = wifi_get_rssi();
+
+    // written straight into a stack buffer from the field table, no tree and no heap allocation per tick
+    char json_str[TELEMETRY_JSON_SIZE];
+    cJSON_Writer writer;
+    cJSON_InitWriter(&writer, json_str, sizeof(json_str));
 
-    free(json_str);
-    cJSON_Delete(root);
+    cJSON_WriterBeginObject(&writer);
+    cJSON_WriterFields(&writer, device_state_fields, DEVICE_STATE_FIELD_COUNT, &state);
+    cJSON_WriterKey(&writer, "wifiSsid");
+    cJSON_WriterString(&writer, wifi_get_ssid());
+
+    // a failed call fails all later ones, so checking the last one is enough
+    if (!cJSON_WriterEndObject(&writer)) {
+        ESP_LOGE(TAG,"Telemetry does not fit into %d bytes", TELEMETRY_JSON_SIZE);
+        return ESP_FAIL;
+    }
+
+    int msg_id = esp_mqtt_client_publish(mqtt_client,TELEMETRY_TOPIC,json_str,(int)cJSON_WriterLength(&writer),1,0);
+    ESP_LOGI(TAG,"Telemetry published, msg_id= %d",msg_id);
+    ESP_LOGI(TAG,"Temp : %.2f , Humidity : %.2f, PM2.5: %.2f",state.sensors.temperature, state.sensors.humidity,state.sensors.pm25);
 
     return msg_id >=0 ? ESP_OK : ESP_FAIL;
 }
@@ -4,68 +4,105 @@
 #include "esp_log.h"
 #include <string.h>
 #include "config.h"
+#include "json_binding.h"
 
 static const char *TAG = "CMD_HANDLER";
 
-esp_err_t command_handler_parse(const char* json_str, command_t* cmd) {
-    if (!json_str || !cmd) {
-        return ESP_ERR_INVALID_ARG;
-    }
+#define FOUND(field) (1UL << (field))
 
-    cJSON *root = cJSON_Parse(json_str);
-    if (!root) {
-        ESP_LOGE(TAG, "Failed to parse JSON");
+// checks that the parsed command has everything it needs
+static esp_err_t finish_command(const command_t *cmd, unsigned long found) {
+    if (!(found & FOUND(COMMAND_FIELD_ID))) {
+        ESP_LOGE(TAG,"Missing CommandId");
         return ESP_FAIL;
     }
 
-    // extract commandID
-    cJSON *cmd_id = cJSON_GetObjectItem(root, "commandId");
-    if (!cmd_id || !cJSON_IsString(cmd_id)) {
-        ESP_LOGE(TAG,"Missing CommandId");
-        cJSON_Delete(root);
+    if (!(found & FOUND(COMMAND_FIELD_TYPE))) {
+        ESP_LOGE(TAG,"Missing commandType");
         return ESP_FAIL;
     }
-    strncpy(cmd->command_id, cmd_id->valuestring, sizeof(cmd->command_id) - 1);
 
-    // extract commandType
-    cJSON *cmd_type = cJSON_GetObjectItem(root,"commandType");
-    if (!cmd_type || !cJSON_IsString(cmd_type)) {
-        ESP_LOGE(TAG,"Missing commandType");
-        cJSON_Delete(root);
+    if (cmd->cmd_type == CMD_SET_FAN_SPEED) {
+        // fan speed is required once there is a payload
+        if ((found & FOUND(COMMAND_FIELD_PAYLOAD)) && !(found & FOUND(COMMAND_FIELD_FAN_SPEED))) {
+            ESP_LOGE(TAG,"Invalid FanSpeed");
+            return ESP_FAIL;
+        }
+    } else if (cmd->cmd_type == CMD_UNKNOWN) {
+        ESP_LOGE(TAG,"Unknown Command type");
         return ESP_FAIL;
     }
 
-    // parse command type
-    if (strcmp(cmd_type->valuestring, "SET_FAN_SPEED") == 0) {
-        cmd->cmd_type = CMD_SET_FAN_SPEED;
-
-        // extract fan speed from payload
-        cJSON *payload = cJSON_GetObjectItem(root,"payload");
-        if (payload) {
-            cJSON *fan_speed = cJSON_GetObjectItem(payload,"fanSpeed");
-            if (fan_speed && cJSON_IsNumber(fan_speed)) {
-                cmd->fan_speed = (uint8_t)fan_speed->valueint;
-            } else {
-                ESP_LOGE(TAG,"Invalid FanSpeed");
-                cJSON_Delete(root);
-                return ESP_FAIL;
-            }
+    return ESP_OK;
+}
+
+// state of the command that is arriving in pieces, only touched by the mqtt task
+static cJSON_Parser *stream_parser = NULL;
+static cJSON_Binding stream_binding;
+static command_t *stream_cmd = NULL;
+static bool stream_failed = false;
+// strings cut by the end of a piece (or with escape sequences) are put back together here
+static char stream_scratch[128];
+
+esp_err_t command_handler_begin(command_t* cmd) {
+    if (!cmd) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!stream_parser) {
+        stream_parser = cJSON_CreateParser(cJSON_GetBindingHandler(), &stream_binding, stream_scratch, sizeof(stream_scratch));
+        if (!stream_parser) {
+            ESP_LOGE(TAG, "Failed to create command parser");
+            return ESP_ERR_NO_MEM;
         }
-    } else if (strcmp(cmd_type->valuestring,"POWER_ON") == 0) {
-        cmd->cmd_type = CMD_POWER_ON;
-    } else if (strcmp(cmd_type->valuestring,"POWER_OFF") == 0) {
-        cmd->cmd_type = CMD_POWER_OFF;
-    } else {
-        ESP_LOGE(TAG,"Unknown Command type : %s",cmd_type->valuestring);
-        cmd->cmd_type = CMD_UNKNOWN;
-        cJSON_Delete(root);
+    }
+
+    cJSON_ResetParser(stream_parser);
+    memset(cmd, 0, sizeof(*cmd));
+    cJSON_InitBinding(&stream_binding, command_fields, COMMAND_FIELD_COUNT, cmd);
+    stream_cmd = cmd;
+    stream_failed = false;
+
+    return ESP_OK;
+}
+
+esp_err_t command_handler_feed(const char* chunk, size_t len) {
+    if (!stream_parser || !stream_cmd) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (stream_failed) {
+        return ESP_FAIL;
+    }
+
+    // events are handled as they arrive, nothing of the chunk is kept
+    if (!cJSON_ParserFeed(stream_parser, chunk, len)) {
+        ESP_LOGE(TAG, "Failed to parse JSON at byte %u", (unsigned)cJSON_GetParserOffset(stream_parser));
+        stream_failed = true;
         return ESP_FAIL;
     }
 
-    cJSON_Delete(root);
     return ESP_OK;
 }
 
+esp_err_t command_handler_finish(void) {
+    if (!stream_parser || !stream_cmd) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t ret = ESP_FAIL;
+    if (stream_failed) {
+        ret = ESP_FAIL;
+    } else if (!cJSON_ParserFinish(stream_parser)) {
+        ESP_LOGE(TAG, "Incomplete JSON");
+    } else {
+        ret = finish_command(stream_cmd, cJSON_GetBindingFound(&stream_binding));
+    }
+
+    stream_cmd = NULL;
+    return ret;
+}
+
 esp_err_t command_handler_execute(command_t* cmd) {
     if (!cmd) {
         return ESP_ERR_INVALID_ARG;
@@ -98,21 +135,25 @@ esp_err_t command_handler_execute(command_t* cmd) {
 }
 
 void command_handler_build_ack(const char* command_id, bool success, const char* error_msg, char* ack_json,size_t max_len) {
-    cJSON *root = cJSON_CreateObject();
+    cJSON_Writer writer;
+    cJSON_InitWriter(&writer, ack_json, max_len);
 
-    cJSON_AddStringToObject(root,"commandId", command_id);
-    cJSON_AddStringToObject(root,"status", success ? "success" : "failed");
+    cJSON_WriterBeginObject(&writer);
+    cJSON_WriterKey(&writer, "commandId");
+    cJSON_WriterString(&writer, command_id);
+    cJSON_WriterKey(&writer, "status");
+    cJSON_WriterString(&writer, success ? "success" : "failed");
 
     if (!success && error_msg) {
-        cJSON_AddStringToObject(root,"message",error_msg);
+        cJSON_WriterKey(&writer, "message");
+        cJSON_WriterString(&writer, error_msg);
     }
 
-    char *json_str = cJSON_PrintUnformatted(root);
-    if (json_str) {
-        strncpy(ack_json, json_str, max_len - 1);
-        ack_json[max_len - 1] = '\0';
-        free(json_str);
+    // better no ack than a cut off one
+    if (!cJSON_WriterEndObject(&writer)) {
+        ESP_LOGE(TAG, "ACK does not fit into %u bytes", (unsigned)max_len);
+        if (max_len > 0) {
+            ack_json[0] = '\0';
+        }
     }
-
-    cJSON_Delete(root);
 }
\ No newline at end of file
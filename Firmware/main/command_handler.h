@@ -5,8 +5,11 @@
 #include "esp_err.h"
 #include <stdbool.h>
 
-// parse incoming command from JSON string
-esp_err_t command_handler_parse(const char* json_str , command_t* cmd);
+// parse an incoming command that arrives in pieces: begin, feed every piece in order, then finish.
+// cmd has to stay valid until finish, which returns ESP_OK once it holds a complete command
+esp_err_t command_handler_begin(command_t* cmd);
+esp_err_t command_handler_feed(const char* chunk, size_t len);
+esp_err_t command_handler_finish(void);
 
 // execute parsed commnad
 esp_err_t command_handler_execute(command_t* cmd);
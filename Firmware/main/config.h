@@ -22,6 +22,17 @@ typedef struct {
     int wifi_rssi;
 } sensor_data_t;
 
+// JSON keys of the sensor readings, X(key, member, cJSON field type). json_binding.c turns them into field tables
+#define SENSOR_DATA_FIELDS(X) \
+    X("temperature", temperature, cJSON_FieldFloat) \
+    X("humidity", humidity, cJSON_FieldFloat) \
+    X("pm1", pm1, cJSON_FieldFloat) \
+    X("pm25", pm25, cJSON_FieldFloat) \
+    X("pm10", pm10, cJSON_FieldFloat) \
+    X("voc", voc, cJSON_FieldFloat) \
+    X("soundLevel", sound_level, cJSON_FieldFloat) \
+    X("wifiRssi", wifi_rssi, cJSON_FieldInt)
+
 // Device data struct
 typedef struct {
     char device_id[32];
@@ -30,12 +41,16 @@ typedef struct {
     sensor_data_t sensors;
 } device_state_t;
 
-// Command types
+// Command types and their names in commandType, X(type, name)
+#define COMMAND_TYPES(X) \
+    X(CMD_SET_FAN_SPEED, "SET_FAN_SPEED") \
+    X(CMD_POWER_ON, "POWER_ON") \
+    X(CMD_POWER_OFF, "POWER_OFF")
+
+#define COMMAND_TYPE_ENUM(type, name) type,
 typedef enum {
-    CMD_SET_FAN_SPEED,
-    CMD_POWER_ON,
-    CMD_POWER_OFF,
-    CMD_UNKNOWN
+    COMMAND_TYPES(COMMAND_TYPE_ENUM)
+    CMD_UNKNOWN // any other name
 } command_type_t;
 
 // command struct
@@ -0,0 +1,30 @@
+#include "json_binding.h"
+#include <stddef.h>
+
+#define SENSOR_DATA_FIELD(key, member, type) cJSON_FIELD(type, key, sensor_data_t, member),
+#define DEVICE_SENSOR_FIELD(key, member, type) cJSON_FIELD(type, key, device_state_t, sensors.member),
+#define COMMAND_TYPE_NAME(type, name) name,
+
+const cJSON_Field sensor_data_fields[SENSOR_DATA_FIELD_COUNT] = {
+    SENSOR_DATA_FIELDS(SENSOR_DATA_FIELD)
+};
+
+// power_state is a bool, so it gets a named bool field: any name but these two is rejected
+static const char * const power_state_names[] = { "OFF", "ON" };
+
+const cJSON_Field device_state_fields[DEVICE_STATE_FIELD_COUNT] = {
+    cJSON_FIELD(cJSON_FieldString, "deviceId", device_state_t, device_id),
+    SENSOR_DATA_FIELDS(DEVICE_SENSOR_FIELD)
+    cJSON_FIELD(cJSON_FieldUnsigned, "fanSpeed", device_state_t, fan_speed),
+    cJSON_NAMED_BOOL_FIELD("powerState", device_state_t, power_state, power_state_names),
+};
+
+// unknown names get the index after the last one, which is CMD_UNKNOWN
+static const char * const command_type_names[] = { COMMAND_TYPES(COMMAND_TYPE_NAME) };
+
+const cJSON_Field command_fields[COMMAND_FIELD_COUNT] = {
+    [COMMAND_FIELD_ID] = cJSON_FIELD(cJSON_FieldString, "commandId", command_t, command_id),
+    [COMMAND_FIELD_TYPE] = cJSON_ENUM_FIELD("commandType", command_t, cmd_type, command_type_names),
+    [COMMAND_FIELD_PAYLOAD] = cJSON_OBJECT_FIELD("payload", 1),
+    [COMMAND_FIELD_FAN_SPEED] = cJSON_FIELD(cJSON_FieldUnsigned, "fanSpeed", command_t, fan_speed),
+};
@@ -0,0 +1,29 @@
+#ifndef JSON_BINDING_H
+#define JSON_BINDING_H
+
+#include "cJSON.h"
+#include "config.h"
+
+// field tables that read and write the structs of config.h without a cJSON tree,
+// see cJSON_WriterFields and cJSON_InitBinding
+
+#define JSON_BINDING_COUNT_FIELD(key, member, type) + 1
+#define SENSOR_DATA_FIELD_COUNT (0 SENSOR_DATA_FIELDS(JSON_BINDING_COUNT_FIELD))
+
+// telemetry keys: deviceId, the sensor readings, fanSpeed and powerState
+#define DEVICE_STATE_FIELD_COUNT (SENSOR_DATA_FIELD_COUNT + 3)
+
+// a command, the index of a field is its bit in cJSON_GetBindingFound
+typedef enum {
+    COMMAND_FIELD_ID,
+    COMMAND_FIELD_TYPE,
+    COMMAND_FIELD_PAYLOAD,
+    COMMAND_FIELD_FAN_SPEED, // in payload
+    COMMAND_FIELD_COUNT
+} command_field_t;
+
+extern const cJSON_Field sensor_data_fields[SENSOR_DATA_FIELD_COUNT];
+extern const cJSON_Field device_state_fields[DEVICE_STATE_FIELD_COUNT];
+extern const cJSON_Field command_fields[COMMAND_FIELD_COUNT];
+
+#endif // JSON_BINDING_H